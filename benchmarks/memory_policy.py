@@ -0,0 +1,82 @@
+"""Benchmark the pair force and neighbor list kernels with each memory policy.
+
+Run on a multi-socket node to measure the effect of
+`hoomd.device.Device.memory_policy` on the threaded CPU kernels::
+
+    python3 benchmarks/memory_policy.py --num_cpu_threads 32 --pin_cpu_threads
+
+The script creates a new simulation for every policy, because the policy
+applies only to arrays allocated after it is set. It reports the milliseconds
+per evaluation of `hoomd.md.pair.LJ` and of the binned neighbor list build.
+"""
+
+import argparse
+
+import numpy as np
+
+import hoomd
+
+POLICIES = ('local', 'first_touch', 'interleave')
+
+
+def make_snapshot(communicator, n, a):
+    """Place n**3 particles on a perturbed cubic lattice."""
+    snap = hoomd.Snapshot(communicator)
+    if snap.communicator.rank == 0:
+        L = n * a
+        snap.configuration.box = [L, L, L, 0, 0, 0]
+        snap.particles.N = n**3
+        snap.particles.types = ['A']
+        x = np.linspace(-L / 2, L / 2, n, endpoint=False) + a / 2
+        position = np.stack(np.meshgrid(x, x, x), axis=-1).reshape(-1, 3)
+        rng = np.random.default_rng(1)
+        position += rng.uniform(-0.05 * a, 0.05 * a, size=position.shape)
+        snap.particles.position[:] = position
+    return snap
+
+
+def benchmark(policy, args):
+    """Time the pair force and the neighbor list build with one policy."""
+    device = hoomd.device.CPU(num_cpu_threads=args.num_cpu_threads)
+    device.pin_cpu_threads = args.pin_cpu_threads
+    device.memory_policy = policy
+
+    sim = hoomd.Simulation(device=device, seed=1)
+    sim.create_state_from_snapshot(
+        make_snapshot(device.communicator, args.n, args.a))
+
+    nlist = hoomd.md.nlist.Cell(full_list=True)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(0)
+
+    return (lj._cpp_obj.benchmark(args.num_iters),
+            nlist._cpp_obj.benchmark(args.num_iters), device)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--n',
+                        type=int,
+                        default=64,
+                        help='particles per lattice direction')
+    parser.add_argument('--a', type=float, default=1.2, help='lattice constant')
+    parser.add_argument('--num_iters', type=int, default=20)
+    parser.add_argument('--num_cpu_threads', type=int, default=None)
+    parser.add_argument('--pin_cpu_threads', action='store_true')
+    args = parser.parse_args()
+
+    results = {policy: benchmark(policy, args) for policy in POLICIES}
+
+    device = results[POLICIES[0]][2]
+    if device.communicator.rank == 0:
+        print(f'N = {args.n**3}, num_cpu_threads = {device.num_cpu_threads}, '
+              f'pin_cpu_threads = {device.pin_cpu_threads}')
+        print(f'{"memory_policy":<14}{"pair (ms)":>12}{"nlist (ms)":>12}')
+        for policy, (pair_time, nlist_time, _) in results.items():
+            print(f'{policy:<14}{pair_time:>12.3f}{nlist_time:>12.3f}')
+
+
+if __name__ == '__main__':
+    main()
@@ -242,11 +242,12 @@ class PYBIND11_EXPORT AABBTree
         }
 
     private:
-    AABBNode* m_nodes;                   //!< The nodes of the tree
-    unsigned int m_num_nodes;            //!< Number of nodes
-    unsigned int m_node_capacity;        //!< Capacity of the nodes array
-    unsigned int m_root;                 //!< Index to the root node of the tree
-    std::vector<unsigned int> m_mapping; //!< Reverse mapping to find node given a particle index
+    AABBNode* m_nodes;                     //!< The nodes of the tree
+    unsigned int m_num_nodes;              //!< Number of nodes
+    unsigned int m_node_capacity;          //!< Capacity of the nodes array
+    unsigned int m_root;                   //!< Index to the root node of the tree
+    std::vector<unsigned int> m_mapping;   //!< Reverse mapping to find node given a particle index
+    std::vector<unsigned int> m_build_idx; //!< Particle indices ordered during the build
 
     //! Initialize the tree to hold N particles
     inline void init(unsigned int N);
@@ -391,11 +392,12 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
     {
     init(N);
 
-    std::vector<unsigned int> idx;
+    // reuse the index list of the previous build, trees are rebuilt every time step
+    m_build_idx.resize(N);
     for (unsigned int i = 0; i < N; i++)
-        idx.push_back(i);
+        m_build_idx[i] = i;
 
-    m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
+    m_root = buildNode(aabbs, m_build_idx, 0, N, INVALID_NODE);
     updateSkip(m_root);
     }
 
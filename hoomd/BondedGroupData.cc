@@ -13,6 +13,9 @@
 
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+#include <iterator>
+
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -42,7 +45,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_colors_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << "s, n=" << group_size
                                 << ") " << endl;
@@ -85,7 +88,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_colors_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -262,8 +265,8 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
             m_type_mapping = snapshot.type_mapping;
             }
 
-        bcast(all_groups, 0, m_exec_conf->getMPICommunicator());
-        bcast(all_typeval, 0, m_exec_conf->getMPICommunicator());
+        bcast_vector(all_groups, 0, m_exec_conf->getMPICommunicator());
+        bcast_vector(all_typeval, 0, m_exec_conf->getMPICommunicator());
         bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
 
         // iterate over groups and add those that have local particles
@@ -716,6 +719,101 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+/*! Colors the local groups greedily in index order: every group receives the lowest color that is
+    not used by an earlier group sharing one of its particles.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildColors()
+    {
+    if (m_prof)
+        m_prof->push("color " + std::string(name) + "s");
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+
+    unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // list the groups of every particle, in increasing group index order
+    std::vector<unsigned int> ptl_start(N + 1, 0);
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; cur_group++)
+        {
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            unsigned int idx = h_rtag.data[h_groups.data[cur_group].tag[i]];
+
+            // incomplete groups are reported by the force computes
+            if (idx < N)
+                ptl_start[idx + 1]++;
+            }
+        }
+
+    for (unsigned int idx = 0; idx < N; ++idx)
+        ptl_start[idx + 1] += ptl_start[idx];
+
+    std::vector<unsigned int> ptl_groups(ptl_start[N]);
+    std::vector<unsigned int> ptl_count(ptl_start.begin(), ptl_start.end() - 1);
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; cur_group++)
+        {
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            unsigned int idx = h_rtag.data[h_groups.data[cur_group].tag[i]];
+            if (idx < N)
+                ptl_groups[ptl_count[idx]++] = cur_group;
+            }
+        }
+
+    // greedy coloring
+    std::vector<unsigned int> color(m_n_groups);
+    std::vector<unsigned int> color_used; // group index + 1 of the last group that saw each color
+    std::vector<unsigned int> color_size;
+
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; cur_group++)
+        {
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            unsigned int idx = h_rtag.data[h_groups.data[cur_group].tag[i]];
+            if (idx >= N)
+                continue;
+
+            for (unsigned int j = ptl_start[idx]; j < ptl_start[idx + 1]; ++j)
+                {
+                unsigned int other = ptl_groups[j];
+                if (other >= cur_group)
+                    break;
+                color_used[color[other]] = cur_group + 1;
+                }
+            }
+
+        unsigned int c = 0;
+        while (c < color_used.size() && color_used[c] == cur_group + 1)
+            c++;
+
+        if (c == color_used.size())
+            {
+            color_used.push_back(0);
+            color_size.push_back(0);
+            }
+
+        color[cur_group] = c;
+        color_size[c]++;
+        }
+
+    // sort the groups by color, keeping the index order within a color
+    unsigned int n_colors = (unsigned int)color_size.size();
+    m_color_offsets.resize(n_colors + 1);
+    m_color_offsets[0] = 0;
+    for (unsigned int c = 0; c < n_colors; ++c)
+        m_color_offsets[c + 1] = m_color_offsets[c] + color_size[c];
+
+    m_colored_groups.resize(m_n_groups);
+    std::vector<unsigned int> color_count(m_color_offsets.begin(), m_color_offsets.end() - 1);
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; cur_group++)
+        m_colored_groups[color_count[color[cur_group]]++] = cur_group;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -970,108 +1068,101 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::takeSnapshot(Snapsho
     // map to lookup snapshot index by tag
     std::map<unsigned int, unsigned int> index;
 
-    std::map<unsigned int, unsigned int> rtag_map;
-    for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
-        {
-        unsigned int tag = m_group_tag[group_idx];
-        assert(m_group_rtag[tag] == group_idx);
-
-        rtag_map.insert(std::pair<unsigned int, unsigned int>(tag, group_idx));
-        }
-
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
-        // gather local data
-        std::vector<typeval_t> typevals; // Group types or constraint values
-        std::vector<members_t> members;  // Group members
+        // group record that the snapshot gathers
+        struct group_element
+            {
+            typeval_t typeval; //!< Group type or constraint value
+            members_t members; //!< Group members
+            unsigned int tag;  //!< Group tag
+            };
 
+        // pack the local groups
+        std::vector<group_element> local(getN());
         for (unsigned int group_idx = 0; group_idx < getN(); ++group_idx)
             {
-            typevals.push_back(m_group_typeval[group_idx]);
-            members.push_back(m_groups[group_idx]);
+            local[group_idx].typeval = m_group_typeval[group_idx];
+            local[group_idx].members = m_groups[group_idx];
+            local[group_idx].tag = m_group_tag[group_idx];
             }
 
-        std::vector<std::vector<typeval_t>> typevals_proc; // Group types of every processor
-        std::vector<std::vector<members_t>> members_proc;  // Group members of every processor
-
-        std::vector<std::map<unsigned int, unsigned int>>
-            rtag_map_proc; // List of reverse-lookup maps
-
-        unsigned int size = m_exec_conf->getNRanks();
-
-        // resize arrays to accumulate group data of all ranks
-        typevals_proc.resize(size);
-        members_proc.resize(size);
-        rtag_map_proc.resize(size);
-
-        // gather all processors' data
-        gather_v(typevals, typevals_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(members, members_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(rtag_map, rtag_map_proc, 0, m_exec_conf->getMPICommunicator());
+        bool is_root = m_exec_conf->getRank() == 0;
 
-        if (m_exec_conf->getRank() == 0)
+        // on root, the snapshot index of every tag, the snapshot is in tag order
+        std::vector<unsigned int> snap_ids;
+        std::vector<bool> found;
+        if (is_root)
             {
             // allocate memory in snapshot
             snapshot.resize(getNGlobal());
 
-            assert(rtag_map_proc.size() == size);
-
-            // create single map of all group ranks and indices
-            // groups present on more than one processor will count as one group
-            std::map<unsigned int, std::pair<unsigned int, unsigned int>> rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < size; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(
-                        std::make_pair(it->first, std::make_pair(irank, it->second)));
-
-            // add groups to snapshot
-            std::map<unsigned int, std::pair<unsigned int, unsigned int>>::iterator rank_rtag_it;
-
-            // index in snapshot
+            if (!m_tag_set.empty())
+                snap_ids.resize(*m_tag_set.rbegin() + 1, GROUP_NOT_LOCAL);
             unsigned int snap_id = 0;
-
-            // loop through active tags
-            std::set<unsigned int>::iterator active_tag_it;
-            for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end();
-                 ++active_tag_it)
+            for (auto it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
                 {
-                unsigned int group_tag = *active_tag_it;
-                rank_rtag_it = rank_rtag_map.find(group_tag);
-                if (rank_rtag_it == rank_rtag_map.end())
-                    {
-                    m_exec_conf->msg->error() << endl
-                                              << "Could not find " << name << " " << group_tag
-                                              << " on any processor. " << endl
-                                              << endl;
-                    throw std::runtime_error("Error gathering " + std::string(name) + "s");
-                    }
+                snap_ids[*it] = snap_id;
 
                 // store tag in index
-                index.insert(std::make_pair(group_tag, snap_id));
+                index.insert(index.end(), std::make_pair(*it, snap_id));
+                snap_id++;
+                }
+            found.resize(m_tag_set.size(), false);
+            }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
+        // gather all processors' data, groups present on more than one processor arrive once
+        // from every processor and count as one group
+        auto consume = [&](const group_element* values, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                const group_element& g = values[i];
+                assert(g.tag < snap_ids.size());
+                unsigned int snap_id = snap_ids[g.tag];
+                found[snap_id] = true;
 
                 if (has_type_mapping)
                     {
-                    snapshot.type_id[snap_id] = typevals_proc[rank][idx].type;
+                    snapshot.type_id[snap_id] = g.typeval.type;
                     }
                 else
                     {
-                    snapshot.val[snap_id] = typevals_proc[rank][idx].val;
+                    snapshot.val[snap_id] = g.typeval.val;
                     }
-                snapshot.groups[snap_id] = members_proc[rank][idx];
-                snap_id++;
+                snapshot.groups[snap_id] = g.members;
+                }
+            };
+
+        gather_chunked(local, consume, 0, m_exec_conf->getMPICommunicator());
+
+        if (is_root)
+            {
+            std::vector<bool>::iterator missing = std::find(found.begin(), found.end(), false);
+            if (missing != found.end())
+                {
+                unsigned int group_tag = *std::next(m_tag_set.begin(), missing - found.begin());
+                m_exec_conf->msg->error() << endl
+                                          << "Could not find " << name << " " << group_tag
+                                          << " on any processor. " << endl
+                                          << endl;
+                throw std::runtime_error("Error gathering " + std::string(name) + "s");
                 }
             }
         }
     else
 #endif
         {
+        std::map<unsigned int, unsigned int> rtag_map;
+        for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
+            {
+            unsigned int tag = m_group_tag[group_idx];
+            assert(m_group_rtag[tag] == group_idx);
+
+            rtag_map.insert(std::pair<unsigned int, unsigned int>(tag, group_idx));
+            }
+
         // allocate memory in snapshot
         snapshot.resize(getNGlobal());
 
@@ -1117,6 +1208,132 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::takeSnapshot(Snapsho
     return index;
     }
 
+//! Initialize from the slices of a distributed snapshot
+/*! \param snapshot The groups of this rank
+
+    Every rank passes its own slice of the groups, which may be empty. The members are global
+    particle tags, so the particles must be initialized first. The type mapping is taken from rank
+    0. In parallel simulations, every rank in turn broadcasts its slice in chunks, and all ranks
+    keep the groups with local members. No rank holds more than its slice and one chunk at a time.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromDistributedSnapshot(
+    const Snapshot& snapshot)
+    {
+    // check that all fields in the snapshot have correct length, on all ranks together
+    int valid = snapshot.validate();
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &valid,
+                      1,
+                      MPI_INT,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot." << std::endl
+                                  << std::endl;
+        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    // the type or constraint value of a group in the snapshot
+    auto get_typeval = [&](unsigned int group_idx)
+        {
+        typeval_t t;
+        if (has_type_mapping)
+            t.type = snapshot.type_id[group_idx];
+        else
+            t.val = snapshot.val[group_idx];
+        return t;
+        };
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        bcast(m_type_mapping, 0, mpi_comm);
+
+        // group record that the ranks broadcast
+        struct group_element
+            {
+            typeval_t typeval; //!< Group type or constraint value
+            members_t members; //!< Group members
+            };
+
+        // all ranks add the groups in the same order, so they assign the same tags
+        for (unsigned int root = 0; root < m_exec_conf->getNRanks(); root++)
+            {
+            unsigned int group_idx = 0;
+            auto produce = [&](group_element* values, unsigned int n)
+                {
+                for (unsigned int i = 0; i < n; i++, group_idx++)
+                    {
+                    values[i].typeval = get_typeval(group_idx);
+                    values[i].members = snapshot.groups[group_idx];
+                    }
+                };
+
+            auto consume = [&](const group_element* values, unsigned int n)
+                {
+                for (unsigned int i = 0; i < n; i++)
+                    addBondedGroup(Group(values[i].typeval, values[i].members));
+                };
+
+            bcast_chunked<group_element>((unsigned int)snapshot.groups.size(),
+                                         produce,
+                                         consume,
+                                         root,
+                                         mpi_comm);
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
+            addBondedGroup(Group(get_typeval(group_idx), snapshot.groups[group_idx]));
+        }
+    }
+
+//! Take the local slice of a distributed snapshot
+/*! \param snapshot The snapshot to write the groups of this rank to
+
+    In parallel simulations, a group is stored on every rank that owns one of its members. Only
+    the rank that owns the first member writes it, so that the slices of all ranks together hold
+    every group exactly once. No communication is needed.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::takeDistributedSnapshot(
+    Snapshot& snapshot) const
+    {
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    snapshot.resize(0);
+    for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
+        {
+        const members_t& members = m_groups[group_idx];
+        if (h_rtag.data[members.tag[0]] >= m_pdata->getN())
+            continue;
+
+        snapshot.groups.push_back(members);
+        if (has_type_mapping)
+            snapshot.type_id.push_back(((typeval_t)m_group_typeval[group_idx]).type);
+        else
+            snapshot.val.push_back(((typeval_t)m_group_typeval[group_idx]).val);
+        }
+    snapshot.size = (unsigned int)snapshot.groups.size();
+
+    snapshot.type_mapping = m_type_mapping;
+    }
+
 #ifdef ENABLE_MPI
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::moveParticleGroups(
@@ -33,6 +33,12 @@ const unsigned int GROUP_NOT_LOCAL((unsigned int)0xffffffff);
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
 #include <type_traits>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -249,6 +255,12 @@ class BondedGroupData
     //! Take a snapshot
     virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
+    //! Initialize from the slices of a distributed snapshot
+    void initializeFromDistributedSnapshot(const Snapshot& snapshot);
+
+    //! Take the local slice of a distributed snapshot
+    void takeDistributedSnapshot(Snapshot& snapshot) const;
+
     //! Get local number of bonded groups
     unsigned int getN() const
         {
@@ -557,6 +569,75 @@ class BondedGroupData
         return m_gpu_n_groups;
         }
 
+    /*
+     * Group coloring for threaded force computations
+     */
+
+    //! Return the local groups sorted by color
+    /*! No two groups of the same color share a particle. Within a color, groups are listed in
+        increasing index order.
+     */
+    const std::vector<unsigned int>& getColoredGroups()
+        {
+        // rebuild coloring if necessary
+        if (m_colors_dirty)
+            {
+            rebuildColors();
+            m_colors_dirty = false;
+            }
+
+        return m_colored_groups;
+        }
+
+    //! Return the start of each color in the list returned by getColoredGroups()
+    const std::vector<unsigned int>& getColorOffsets()
+        {
+        // rebuild coloring if necessary
+        if (m_colors_dirty)
+            {
+            rebuildColors();
+            m_colors_dirty = false;
+            }
+
+        return m_color_offsets;
+        }
+
+    //! Call a function for every local group
+    /*! \param f Function called with the index of each local group
+
+        With TBB, the groups of one color are processed in parallel and the colors one after the
+        other. Because groups of the same color share no particle, \a f may accumulate into
+        per-particle arrays without synchronization. Each particle receives the contributions of
+        its groups in color order, independent of the number of threads. Without TBB, the groups
+        are processed in index order.
+    */
+    template<class Func> void forEachLocalGroup(const Func& f)
+        {
+#ifdef ENABLE_TBB
+        const std::vector<unsigned int>& colored_groups = getColoredGroups();
+        const std::vector<unsigned int>& color_offsets = getColorOffsets();
+
+        for (unsigned int color = 0; color + 1 < color_offsets.size(); ++color)
+            {
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(
+                        tbb::blocked_range<unsigned int>(color_offsets[color],
+                                                         color_offsets[color + 1]),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            for (unsigned int k = r.begin(); k != r.end(); ++k)
+                                f(colored_groups[k]);
+                        });
+                });
+            }
+#else
+        for (unsigned int i = 0; i < m_n_groups; ++i)
+            f(i);
+#endif
+        }
+
     /*
      * add/remove groups globally
      */
@@ -596,6 +677,7 @@ class BondedGroupData
         {
         // set flag to trigger rebuild of GPU table
         m_groups_dirty = true;
+        m_colors_dirty = true;
 
         // notify subscribers
         m_group_reorder_signal.emit();
@@ -605,6 +687,7 @@ class BondedGroupData
     void setDirty()
         {
         m_groups_dirty = true;
+        m_colors_dirty = true;
         }
 
     protected:
@@ -657,6 +740,10 @@ class BondedGroupData
 
     private:
     bool m_groups_dirty; //!< Is it necessary to rebuild the lookup-by-index table?
+    bool m_colors_dirty; //!< Is it necessary to rebuild the group coloring?
+
+    std::vector<unsigned int> m_colored_groups; //!< Local group indices sorted by color
+    std::vector<unsigned int> m_color_offsets;  //!< Start of each color in m_colored_groups
 
     Nano::Signal<void()> m_group_num_change_signal; //!< Signal that is triggered when groups are
                                                     //!< added or deleted (globally)
@@ -672,6 +759,9 @@ class BondedGroupData
     //! Helper function to rebuild lookup by index table
     void rebuildGPUTable();
 
+    //! Helper function to rebuild the group coloring
+    void rebuildColors();
+
     //! Resize internal tables
     /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
      */
@@ -10,6 +10,7 @@
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "HOOMDMPI.h"
+#include "HostArena.h"
 #include "System.h"
 
 #include <algorithm>
@@ -59,9 +60,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         // remove ghost groups
         m_gdata->removeAllGhostGroups();
 
-        // send map for rank updates
-        typedef std::multimap<unsigned int, rank_element_t> map_t;
-        map_t send_map;
+        // rank updates to send, paired with the destination rank
+        m_ranks_send_pairs.clear();
 
             {
             ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(),
@@ -196,7 +196,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                     if (incomplete)
                         // in initialization, send to all neighbors
                         for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                            send_map.insert(std::make_pair(h_unique_neighbors.data[ineigh], el));
+                            m_ranks_send_pairs.push_back(
+                                std::make_pair(h_unique_neighbors.data[ineigh], el));
                     else
                         // send to other ranks owning the bonded group
                         for (unsigned int j = 0; j < group_data::size; ++j)
@@ -205,7 +206,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                             bool rank_updated = mask & (1 << j);
                             // send out to ranks different from ours
                             if (rank != my_rank && !rank_updated)
-                                send_map.insert(std::make_pair(rank, el));
+                                m_ranks_send_pairs.push_back(std::make_pair(rank, el));
                             }
                     }
                 } // end loop over groups
@@ -216,7 +217,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
             {
             // output send data sorted by rank
-            for (typename map_t::iterator it = send_map.begin(); it != send_map.end(); ++it)
+            sortByRank(m_ranks_send_pairs);
+            for (auto it = m_ranks_send_pairs.begin(); it != m_ranks_send_pairs.end(); ++it)
                 {
                 m_ranks_sendbuf.push_back(it->second);
                 }
@@ -233,12 +235,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
             // Find start and end indices
             for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
-                {
-                typename map_t::iterator lower = send_map.lower_bound(h_unique_neighbors.data[i]);
-                typename map_t::iterator upper = send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(send_map.begin(), upper);
-                }
+                findRankRange(m_ranks_send_pairs,
+                              h_unique_neighbors.data[i],
+                              h_begin.data[i],
+                              h_end.data[i]);
             }
 
         /*
@@ -328,7 +328,9 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             if (m_comm.m_prof)
                 m_comm.m_prof->push("MPI send/recv");
 
-            std::vector<MPI_Request> reqs;
+            // reuse the request containers of the communicator
+            std::vector<MPI_Request>& reqs = m_comm.m_reqs;
+            reqs.clear();
             MPI_Request req;
 
             unsigned int send_bytes = 0;
@@ -368,7 +370,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(rank_element_t));
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
+            std::vector<MPI_Status>& stats = m_comm.m_stats;
+            stats.resize(reqs.size());
             MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof)
@@ -406,9 +409,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 }
             }
 
-        // send map for groups
-        typedef std::multimap<unsigned int, group_element_t> group_map_t;
-        group_map_t group_send_map;
+        // groups to send, paired with the destination rank
+        m_groups_send_pairs.clear();
 
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
@@ -466,7 +468,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                     for (unsigned int i = 0; i < group_data::size; ++i)
                         // are we sending to this rank?
                         if (mask & (1 << i))
-                            group_send_map.insert(std::make_pair(el.ranks.idx[i], el));
+                            m_groups_send_pairs.push_back(std::make_pair(el.ranks.idx[i], el));
 
                     // does this group still have local members
                     bool is_local = false;
@@ -496,36 +498,23 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
                                                                  access_location::host,
-                                                                 access_mode::read);
+                                                                 access_mode::readwrite);
             ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
                                                    access_location::host,
-                                                   access_mode::read);
+                                                   access_mode::readwrite);
             ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
                                                   access_location::host,
-                                                  access_mode::read);
+                                                  access_mode::readwrite);
             ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
                                                                     access_location::host,
-                                                                    access_mode::read);
-
-            // access alternate arrays to write to
-            ArrayHandle<typename group_data::members_t> h_groups_alt(m_gdata->getAltMembersArray(),
-                                                                     access_location::host,
-                                                                     access_mode::overwrite);
-            ArrayHandle<typeval_t> h_group_typeval_alt(m_gdata->getAltTypeValArray(),
-                                                       access_location::host,
-                                                       access_mode::overwrite);
-            ArrayHandle<unsigned int> h_group_tag_alt(m_gdata->getAltTags(),
-                                                      access_location::host,
-                                                      access_mode::overwrite);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks_alt(m_gdata->getAltRanksArray(),
-                                                                        access_location::host,
-                                                                        access_mode::overwrite);
+                                                                    access_mode::readwrite);
 
             // access rtags
             ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
                                                    access_location::host,
                                                    access_mode::readwrite);
 
+            // move the remaining groups down in place
             unsigned int ngroups = m_gdata->getN();
             unsigned int n = 0;
             for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
@@ -535,25 +524,23 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
                 if (keep)
                     {
-                    h_groups_alt.data[n] = h_groups.data[group_idx];
-                    h_group_typeval_alt.data[n] = h_group_typeval.data[group_idx];
-                    h_group_tag_alt.data[n] = group_tag;
-                    h_group_ranks_alt.data[n] = h_group_ranks.data[group_idx];
+                    if (n != group_idx)
+                        {
+                        h_groups.data[n] = h_groups.data[group_idx];
+                        h_group_typeval.data[n] = h_group_typeval.data[group_idx];
+                        h_group_tag.data[n] = group_tag;
+                        h_group_ranks.data[n] = h_group_ranks.data[group_idx];
 
-                    // rebuild rtags
-                    h_group_rtag.data[group_tag] = n++;
+                        // rebuild rtags
+                        h_group_rtag.data[group_tag] = n;
+                        }
+                    n++;
                     }
                 }
 
             new_ngroups = n;
             }
 
-        // make alternate arrays current
-        m_gdata->swapMemberArrays();
-        m_gdata->swapTypeArrays();
-        m_gdata->swapTagArrays();
-        m_gdata->swapRankArrays();
-
         assert(new_ngroups <= m_gdata->getN());
 
         // resize group arrays
@@ -565,8 +552,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         m_groups_sendbuf.clear();
 
         // output groups to send buffer in rank-sorted order
-        for (typename group_map_t::iterator it = group_send_map.begin(); it != group_send_map.end();
-             ++it)
+        sortByRank(m_groups_send_pairs);
+        for (auto it = m_groups_send_pairs.begin(); it != m_groups_send_pairs.end(); ++it)
             {
             m_groups_sendbuf.push_back(it->second);
             }
@@ -584,14 +571,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
             // Find start and end indices
             for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
-                {
-                typename group_map_t::iterator lower
-                    = group_send_map.lower_bound(h_unique_neighbors.data[i]);
-                typename group_map_t::iterator upper
-                    = group_send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(group_send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(group_send_map.begin(), upper);
-                }
+                findRankRange(m_groups_send_pairs,
+                              h_unique_neighbors.data[i],
+                              h_begin.data[i],
+                              h_end.data[i]);
             }
 
         /*
@@ -678,7 +661,9 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             if (m_comm.m_prof)
                 m_comm.m_prof->push("MPI send/recv");
 
-            std::vector<MPI_Request> reqs;
+            // reuse the request containers of the communicator
+            std::vector<MPI_Request>& reqs = m_comm.m_reqs;
+            reqs.clear();
             MPI_Request req;
 
             unsigned int send_bytes = 0;
@@ -718,7 +703,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(group_element_t));
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
+            std::vector<MPI_Status>& stats = m_comm.m_stats;
+            stats.resize(reqs.size());
             MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof)
@@ -953,7 +939,8 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
             m_comm.m_prof->push(m_exec_conf, m_gdata->getName());
 
         // send plan for groups
-        std::vector<unsigned int> group_plan(m_gdata->getN(), 0);
+        ArenaAllocator<unsigned int> arena_alloc(m_exec_conf->getHostArena());
+        ArenaVector<unsigned int> group_plan(m_gdata->getN(), 0, arena_alloc);
 
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
@@ -1022,7 +1009,7 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
              */
 
             // resize buffers
-            std::vector<unsigned int> plan_copybuf(m_gdata->getN(), 0);
+            ArenaVector<unsigned int> plan_copybuf(m_gdata->getN(), 0, arena_alloc);
             m_groups_sendbuf.resize(m_gdata->getN());
             unsigned int num_copy_ghosts;
             unsigned int num_recv_ghosts;
@@ -1235,8 +1222,9 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_body_copybuf(m_exec_conf), m_image_copybuf(m_exec_conf), m_velocity_copybuf(m_exec_conf),
       m_orientation_copybuf(m_exec_conf), m_plan_copybuf(m_exec_conf), m_tag_copybuf(m_exec_conf),
       m_netforce_copybuf(m_exec_conf), m_nettorque_copybuf(m_exec_conf),
-      m_netvirial_copybuf(m_exec_conf), m_netvirial_recvbuf(m_exec_conf), m_plan(m_exec_conf),
-      m_plan_reverse(m_exec_conf), m_tag_reverse(m_exec_conf),
+      m_netvirial_copybuf(m_exec_conf), m_netvirial_recvbuf(m_exec_conf),
+      m_pos_compressed_copybuf(m_exec_conf), m_pos_compressed_recvbuf(m_exec_conf),
+      m_plan(m_exec_conf), m_plan_reverse(m_exec_conf), m_tag_reverse(m_exec_conf),
       m_netforce_reverse_copybuf(m_exec_conf), m_netforce_reverse_recvbuf(m_exec_conf),
       m_r_ghost_max(Scalar(0.0)), m_r_extra_ghost_max(Scalar(0.0)), m_ghosts_added(0),
       m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
@@ -1424,6 +1412,9 @@ Communicator::~Communicator()
         .disconnect<Communicator, &Communicator::setPairsChanged>(this);
 
     MPI_Type_free(&m_mpi_pdata_element);
+
+    if (m_graph_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_graph_comm);
     }
 
 void Communicator::initializeNeighborArrays()
@@ -1530,6 +1521,109 @@ void Communicator::initializeNeighborArrays()
         }
     }
 
+void Communicator::setCompressGhostPositions(bool enable)
+    {
+    if (enable && m_decomposition->isRCB())
+        {
+        m_exec_conf->msg->error() << "comm: compressed ghost positions are not supported with a "
+                                     "recursive coordinate bisection"
+                                  << std::endl;
+        throw std::runtime_error("Error setting compressed ghost positions");
+        }
+
+    m_compress_ghost_positions = enable;
+    }
+
+void Communicator::setNeighborCollectives(bool enable)
+    {
+    if (enable && m_decomposition->isRCB())
+        {
+        m_exec_conf->msg->error()
+            << "comm: neighbor collectives are not supported with a recursive coordinate bisection"
+            << std::endl;
+        throw std::runtime_error("Error setting neighbor collectives");
+        }
+
+    if (enable == m_neighbor_collectives)
+        return;
+
+    m_neighbor_collectives = enable;
+
+    if (m_graph_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_graph_comm);
+    m_graph_plan_mask.clear();
+    m_graph_offsets.clear();
+
+    // the ghosts are exchanged again with the new pattern
+    forceMigrate();
+
+    if (!enable)
+        return;
+
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    uint3 mypos = m_decomposition->getGridPos();
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                           access_location::host,
+                                           access_mode::read);
+
+    // the neighbor at offset (ix, iy, iz) receives the particles whose plans include the
+    // corresponding faces, and we receive from the neighbor at the opposite offset. When there
+    // are two domains along a direction, a rank is the neighbor at both offsets and the graph
+    // has two edges between the same ranks, which MPI matches in the order they are listed.
+    std::vector<int> destinations;
+    std::vector<int> sources;
+    for (int iz = -1; iz <= 1; iz++)
+        for (int iy = -1; iy <= 1; iy++)
+            for (int ix = -1; ix <= 1; ix++)
+                {
+                // only if communicating along the nonzero directions, and exclude ourselves
+                if ((ix && di.getW() == 1) || (iy && di.getH() == 1) || (iz && di.getD() == 1)
+                    || (!ix && !iy && !iz))
+                    continue;
+
+                unsigned int plan_mask = 0;
+                plan_mask |= ix > 0 ? send_east : (ix < 0 ? send_west : 0);
+                plan_mask |= iy > 0 ? send_north : (iy < 0 ? send_south : 0);
+                plan_mask |= iz > 0 ? send_up : (iz < 0 ? send_down : 0);
+                m_graph_plan_mask.push_back(plan_mask);
+                m_graph_offsets.push_back(make_int3(ix, iy, iz));
+
+                int3 dest = make_int3((int)mypos.x + ix, (int)mypos.y + iy, (int)mypos.z + iz);
+                int3 src = make_int3((int)mypos.x - ix, (int)mypos.y - iy, (int)mypos.z - iz);
+                int3 dim = make_int3(di.getW(), di.getH(), di.getD());
+                dest.x = (dest.x + dim.x) % dim.x;
+                dest.y = (dest.y + dim.y) % dim.y;
+                dest.z = (dest.z + dim.z) % dim.z;
+                src.x = (src.x + dim.x) % dim.x;
+                src.y = (src.y + dim.y) % dim.y;
+                src.z = (src.z + dim.z) % dim.z;
+                destinations.push_back(h_cart_ranks.data[di(dest.x, dest.y, dest.z)]);
+                sources.push_back(h_cart_ranks.data[di(src.x, src.y, src.z)]);
+                }
+
+    // with a single domain, there is nothing to exchange
+    if (destinations.empty())
+        return;
+
+    MPI_Dist_graph_create_adjacent(m_mpi_comm,
+                                   (int)sources.size(),
+                                   &sources.front(),
+                                   MPI_UNWEIGHTED,
+                                   (int)destinations.size(),
+                                   &destinations.front(),
+                                   MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL,
+                                   0,
+                                   &m_graph_comm);
+
+    unsigned int n_neigh = (unsigned int)destinations.size();
+    m_graph_send_counts.resize(n_neigh);
+    m_graph_send_displs.resize(n_neigh);
+    m_graph_recv_counts.resize(n_neigh);
+    m_graph_recv_displs.resize(n_neigh);
+    m_graph_byte_counts.resize(4 * n_neigh);
+    }
+
 //! Interface to the communication methods.
 void Communicator::communicate(uint64_t timestep)
     {
@@ -1597,6 +1691,13 @@ void Communicator::migrateParticles()
     {
     m_exec_conf->msg->notice(7) << "Communicator: migrate particles" << std::endl;
 
+    if (m_decomposition->isRCB())
+        {
+        m_exec_conf->msg->error()
+            << "comm: use CommunicatorRCB with a recursive coordinate bisection" << std::endl;
+        throw std::runtime_error("Error during communication");
+        }
+
     updateGhostWidth();
 
     // check if simulation box is sufficiently large for domain decomposition
@@ -1683,8 +1784,7 @@ void Communicator::migrateParticles()
         m_constraints_changed = false;
 
         // fill send buffer
-        std::vector<unsigned int> comm_flag_out; // not currently used
-        m_pdata->removeParticles(m_sendbuf, comm_flag_out);
+        m_pdata->packParticles(m_sendbuf, m_comm_flags_out);
 
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
@@ -1700,37 +1800,44 @@ void Communicator::migrateParticles()
 
         unsigned int n_recv_ptls;
 
-        // communicate size of the message that will contain the particle data
-        m_reqs.resize(2);
-        m_stats.resize(2);
+        // send the size of the message and the particle data right away
+        m_reqs.resize(4);
+        m_stats.resize(4);
 
         unsigned int n_send_ptls = (unsigned int)m_sendbuf.size();
 
         MPI_Isend(&n_send_ptls, 1, MPI_UNSIGNED, send_neighbor, 0, m_mpi_comm, &m_reqs[0]);
         MPI_Irecv(&n_recv_ptls, 1, MPI_UNSIGNED, recv_neighbor, 0, m_mpi_comm, &m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
-
-        // Resize receive buffer
-        m_recvbuf.resize(n_recv_ptls);
-
-        // exchange particle data
-        m_reqs.resize(2);
-        m_stats.resize(2);
-        MPI_Isend(&m_sendbuf.front(),
+        MPI_Isend(m_sendbuf.data(),
                   n_send_ptls,
                   m_mpi_pdata_element,
                   send_neighbor,
                   1,
                   m_mpi_comm,
-                  &m_reqs[0]);
-        MPI_Irecv(&m_recvbuf.front(),
+                  &m_reqs[2]);
+
+        if (m_prof)
+            m_prof->pop();
+
+        // remove the sent particles while the messages are in flight
+        m_pdata->compactParticles();
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        MPI_Waitall(2, &m_reqs[0], &m_stats[0]);
+
+        // Resize receive buffer, it keeps its capacity from previous calls
+        m_recvbuf.resize(n_recv_ptls);
+
+        MPI_Irecv(m_recvbuf.data(),
                   n_recv_ptls,
                   m_mpi_pdata_element,
                   recv_neighbor,
                   1,
                   m_mpi_comm,
-                  &m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                  &m_reqs[3]);
+        MPI_Waitall(2, &m_reqs[2], &m_stats[2]);
 
         if (m_prof)
             m_prof->pop();
@@ -1858,8 +1965,9 @@ void Communicator::exchangeGhosts()
     ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body, access_location::host, access_mode::read);
     const Scalar3 box_dist = box.getNearestPlaneDistance();
-    std::vector<Scalar3> ghost_fractions(m_pdata->getNTypes());
-    std::vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes());
+    ArenaAllocator<Scalar3> arena_alloc(m_exec_conf->getHostArena());
+    ArenaVector<Scalar3> ghost_fractions(m_pdata->getNTypes(), arena_alloc);
+    ArenaVector<Scalar3> ghost_fractions_body(m_pdata->getNTypes(), arena_alloc);
     for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
         {
         ghost_fractions[cur_type] = h_r_ghost.data[cur_type] / box_dist;
@@ -1945,9 +2053,15 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    // the reverse net force is only implemented for the staged exchange
+    m_graph_ghosts = m_graph_comm != MPI_COMM_NULL && !flags[comm_flag::reverse_net_force];
+    if (m_graph_ghosts)
+        exchangeGhostsGraph(flags);
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
-        if (!isCommunicating(dir))
+        // skip the staged exchange when the ghosts were sent in a single stage
+        if (!isCommunicating(dir) || m_graph_ghosts)
             continue;
 
         m_num_copy_ghosts[dir] = 0;
@@ -2696,6 +2810,15 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
+    if (m_graph_ghosts)
+        {
+        beginUpdateGhostsGraph(getFlags());
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     // update data in these arrays
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
@@ -2707,7 +2830,53 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
         CommFlags flags = getFlags();
 
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && m_compress_ghost_positions)
+            {
+            m_pos_compressed_copybuf.resize(m_num_copy_ghosts[dir]);
+
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+            ArrayHandle<int3> h_pos_compressed_copybuf(m_pos_compressed_copybuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                             access_location::host,
+                                             access_mode::read);
+
+            // the domain we send to
+            int3 offset = make_int3(0, 0, 0);
+            if (dir == face_east)
+                offset.x = 1;
+            else if (dir == face_west)
+                offset.x = -1;
+            else if (dir == face_north)
+                offset.y = 1;
+            else if (dir == face_south)
+                offset.y = -1;
+            else if (dir == face_up)
+                offset.z = 1;
+            else if (dir == face_down)
+                offset.z = -1;
+
+            Scalar3 center, width;
+            getDomainFractions(offset, center, width);
+
+            // encode positions of ghost particles
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                h_pos_compressed_copybuf.data[ghost_idx]
+                    = compressGhostPosition(h_pos.data[idx], center, width);
+                }
+            }
+        else if (flags[comm_flag::position])
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -2809,7 +2978,45 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         size_t sz = 0;
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && m_compress_ghost_positions)
+            {
+            m_reqs.resize(2);
+            m_stats.resize(2);
+            m_pos_compressed_recvbuf.resize(m_num_recv_ghosts[dir]);
+
+            ArrayHandle<int3> h_pos_compressed_copybuf(m_pos_compressed_copybuf,
+                                                       access_location::host,
+                                                       access_mode::read);
+            ArrayHandle<int3> h_pos_compressed_recvbuf(m_pos_compressed_recvbuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+
+            MPI_Isend(h_pos_compressed_copybuf.data,
+                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(int3)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      1,
+                      m_mpi_comm,
+                      &m_reqs[0]);
+            MPI_Irecv(h_pos_compressed_recvbuf.data,
+                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(int3)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      1,
+                      m_mpi_comm,
+                      &m_reqs[1]);
+            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            decompressGhostPositions(h_pos_compressed_recvbuf.data,
+                                     h_pos.data + start_idx,
+                                     m_num_recv_ghosts[dir]);
+
+            sz += sizeof(int3);
+            }
+        else if (flags[comm_flag::position])
             {
             m_reqs.resize(2);
             m_stats.resize(2);
@@ -2965,6 +3172,15 @@ void Communicator::updateNetForce(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << oss.str() << std::endl;
 
+    if (m_graph_ghosts)
+        {
+        updateNetForceGraph(flags);
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     // Set some global counters
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
     unsigned int num_tot_recv_ghosts_reverse
@@ -3400,6 +3616,628 @@ void Communicator::removeGhostParticleTags()
     m_ghosts_added = 0;
     }
 
+/*! \param offset Grid offset of the domain from the local domain
+    \param center Center of the domain (output)
+    \param width Width of the domain (output)
+ */
+void Communicator::getDomainFractions(const int3& offset, Scalar3& center, Scalar3& width) const
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    uint3 pos = m_decomposition->getGridPos();
+    int3 dim = make_int3(di.getW(), di.getH(), di.getD());
+
+    unsigned int i = ((int)pos.x + offset.x + dim.x) % dim.x;
+    unsigned int j = ((int)pos.y + offset.y + dim.y) % dim.y;
+    unsigned int k = ((int)pos.z + offset.z + dim.z) % dim.z;
+
+    Scalar3 lo = make_scalar3(m_decomposition->getCumulativeFraction(0, i),
+                              m_decomposition->getCumulativeFraction(1, j),
+                              m_decomposition->getCumulativeFraction(2, k));
+    Scalar3 hi = make_scalar3(m_decomposition->getCumulativeFraction(0, i + 1),
+                              m_decomposition->getCumulativeFraction(1, j + 1),
+                              m_decomposition->getCumulativeFraction(2, k + 1));
+
+    center = Scalar(0.5) * (lo + hi);
+    width = hi - lo;
+    }
+
+//! Fixed point scale of the compressed ghost positions, in units of the domain width
+/*! A ghost lies within the ghost layer of the receiving domain, which is narrower than half the
+    domain, plus the distance the particle moved since the last migration. The scale leaves room
+    for offsets of up to two domain widths from the center.
+ */
+const Scalar ghost_position_scale = Scalar(1 << 30);
+
+/*! \param postype Position of the ghost
+    \param center Center of the receiving domain as a fraction of the global box
+    \param width Width of the receiving domain as a fraction of the global box
+    \returns The fractional offset of the ghost from the center of the receiving domain, in fixed
+             point units of width / 2^30
+
+    Along the communication directions, the offset is taken to the nearest periodic image of the
+    domain center. The receiver wraps the decoded position into its shifted box.
+ */
+int3 Communicator::compressGhostPosition(const Scalar4& postype,
+                                         const Scalar3& center,
+                                         const Scalar3& width) const
+    {
+    Scalar3 f = m_pdata->getGlobalBox().makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 d = f - center;
+
+    if (isCommunicating(face_east))
+        d.x -= slow::rint(d.x);
+    if (isCommunicating(face_north))
+        d.y -= slow::rint(d.y);
+    if (isCommunicating(face_up))
+        d.z -= slow::rint(d.z);
+
+    d.x = slow::rint(d.x / width.x * ghost_position_scale);
+    d.y = slow::rint(d.y / width.y * ghost_position_scale);
+    d.z = slow::rint(d.z / width.z * ghost_position_scale);
+
+    assert(fabs(d.x) < Scalar(2.0) * ghost_position_scale);
+    assert(fabs(d.y) < Scalar(2.0) * ghost_position_scale);
+    assert(fabs(d.z) < Scalar(2.0) * ghost_position_scale);
+
+    return make_int3(int(d.x), int(d.y), int(d.z));
+    }
+
+/*! \param compressed Compressed positions received from a neighbor
+    \param postype Positions of the ghosts to update (the types are kept)
+    \param n Number of ghosts
+ */
+void Communicator::decompressGhostPositions(const int3* compressed,
+                                            Scalar4* postype,
+                                            unsigned int n) const
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    Scalar3 center, width;
+    getDomainFractions(make_int3(0, 0, 0), center, width);
+    Scalar3 s = width / ghost_position_scale;
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        Scalar3 f = make_scalar3(center.x + Scalar(compressed[i].x) * s.x,
+                                 center.y + Scalar(compressed[i].y) * s.y,
+                                 center.z + Scalar(compressed[i].z) * s.z);
+        Scalar3 pos = global_box.makeCoordinates(f);
+        postype[i].x = pos.x;
+        postype[i].y = pos.y;
+        postype[i].z = pos.z;
+        }
+    }
+
+/*! \param send Packed values of the ghosts sent, ordered by neighbor
+    \param recv Array to write the values of the received ghosts to
+    \param width Number of values per ghost
+ */
+template<class T>
+void Communicator::exchangeGraphField(const T* send, T* recv, unsigned int width)
+    {
+    unsigned int n_neigh = (unsigned int)m_graph_send_counts.size();
+    int* send_bytes = &m_graph_byte_counts[0];
+    int* send_displs = &m_graph_byte_counts[n_neigh];
+    int* recv_bytes = &m_graph_byte_counts[2 * n_neigh];
+    int* recv_displs = &m_graph_byte_counts[3 * n_neigh];
+
+    int sz = int(width * sizeof(T));
+    for (unsigned int i = 0; i < n_neigh; ++i)
+        {
+        send_bytes[i] = m_graph_send_counts[i] * sz;
+        send_displs[i] = m_graph_send_displs[i] * sz;
+        recv_bytes[i] = m_graph_recv_counts[i] * sz;
+        recv_displs[i] = m_graph_recv_displs[i] * sz;
+        }
+
+    MPI_Neighbor_alltoallv(send,
+                           send_bytes,
+                           send_displs,
+                           MPI_BYTE,
+                           recv,
+                           recv_bytes,
+                           recv_displs,
+                           MPI_BYTE,
+                           m_graph_comm);
+    }
+
+/*! Every local particle is sent to all neighbors whose plan bits are a subset of its plan. This
+    reproduces the staged exchange, in which e.g. a particle marked for sending east and north is
+    sent east and north and forwarded from the eastern neighbor to the northern one.
+
+    \param flags The ghost communication flags
+ */
+void Communicator::exchangeGhostsGraph(const CommFlags& flags)
+    {
+    unsigned int n_neigh = (unsigned int)m_graph_plan_mask.size();
+    unsigned int n_local = m_pdata->getN();
+
+    // count the ghosts sent to every neighbor
+    std::fill(m_graph_send_counts.begin(), m_graph_send_counts.end(), 0);
+
+        {
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < n_local; idx++)
+            {
+            unsigned int plan = h_plan.data[idx];
+            if (!plan)
+                continue;
+
+            for (unsigned int i = 0; i < n_neigh; ++i)
+                if ((plan & m_graph_plan_mask[i]) == m_graph_plan_mask[i])
+                    m_graph_send_counts[i]++;
+            }
+        }
+
+    unsigned int n_send = 0;
+    for (unsigned int i = 0; i < n_neigh; ++i)
+        {
+        m_graph_send_displs[i] = n_send;
+        n_send += m_graph_send_counts[i];
+        }
+
+    // resize buffers
+    m_graph_copy_ghosts.resize(n_send);
+    m_plan_copybuf.resize(n_send);
+
+    if (flags[comm_flag::position])
+        m_pos_copybuf.resize(n_send);
+
+    if (flags[comm_flag::charge])
+        m_charge_copybuf.resize(n_send);
+
+    if (flags[comm_flag::body])
+        m_body_copybuf.resize(n_send);
+
+    if (flags[comm_flag::image])
+        m_image_copybuf.resize(n_send);
+
+    if (flags[comm_flag::diameter])
+        m_diameter_copybuf.resize(n_send);
+
+    if (flags[comm_flag::velocity])
+        m_velocity_copybuf.resize(n_send);
+
+    if (flags[comm_flag::orientation])
+        m_orientation_copybuf.resize(n_send);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+
+        // next free slot of every neighbor in the send buffers
+        ArenaVector<unsigned int> offset(m_graph_send_displs.begin(),
+                                         m_graph_send_displs.end(),
+                                         ArenaAllocator<unsigned int>(m_exec_conf->getHostArena()));
+
+        for (unsigned int idx = 0; idx < n_local; idx++)
+            {
+            unsigned int plan = h_plan.data[idx];
+            if (!plan)
+                continue;
+
+            for (unsigned int i = 0; i < n_neigh; ++i)
+                {
+                if ((plan & m_graph_plan_mask[i]) != m_graph_plan_mask[i])
+                    continue;
+
+                unsigned int j = offset[i]++;
+                if (flags[comm_flag::position])
+                    h_pos_copybuf.data[j] = h_pos.data[idx];
+                if (flags[comm_flag::charge])
+                    h_charge_copybuf.data[j] = h_charge.data[idx];
+                if (flags[comm_flag::diameter])
+                    h_diameter_copybuf.data[j] = h_diameter.data[idx];
+                if (flags[comm_flag::body])
+                    h_body_copybuf.data[j] = h_body.data[idx];
+                if (flags[comm_flag::image])
+                    h_image_copybuf.data[j] = h_image.data[idx];
+                if (flags[comm_flag::velocity])
+                    h_velocity_copybuf.data[j] = h_vel.data[idx];
+                if (flags[comm_flag::orientation])
+                    h_orientation_copybuf.data[j] = h_orientation.data[idx];
+                h_plan_copybuf.data[j] = plan;
+                m_graph_copy_ghosts[j] = h_tag.data[idx];
+                }
+            }
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    MPI_Neighbor_alltoall(&m_graph_send_counts.front(),
+                          1,
+                          MPI_INT,
+                          &m_graph_recv_counts.front(),
+                          1,
+                          MPI_INT,
+                          m_graph_comm);
+
+    unsigned int n_recv = 0;
+    for (unsigned int i = 0; i < n_neigh; ++i)
+        {
+        m_graph_recv_displs[i] = n_recv;
+        n_recv += m_graph_recv_counts[i];
+        }
+
+    // append ghosts at the end of particle data array
+    unsigned int start_idx = n_local + m_pdata->getNGhosts();
+
+    // accommodate new ghost particles
+    m_pdata->addGhostParticles(n_recv);
+
+    // resize plan array
+    m_plan.resize(n_local + m_pdata->getNGhosts());
+
+        {
+        ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf,
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf,
+                                             access_location::host,
+                                             access_mode::read);
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf,
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf,
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::read);
+
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+
+        // the ghost plans are sent along, as in the staged exchange
+        exchangeGraphField(h_plan_copybuf.data, h_plan.data + start_idx, 1);
+        exchangeGraphField(m_graph_copy_ghosts.data(), h_tag.data + start_idx, 1);
+
+        if (flags[comm_flag::position])
+            exchangeGraphField(h_pos_copybuf.data, h_pos.data + start_idx, 1);
+
+        if (flags[comm_flag::charge])
+            exchangeGraphField(h_charge_copybuf.data, h_charge.data + start_idx, 1);
+
+        if (flags[comm_flag::diameter])
+            exchangeGraphField(h_diameter_copybuf.data, h_diameter.data + start_idx, 1);
+
+        if (flags[comm_flag::velocity])
+            exchangeGraphField(h_velocity_copybuf.data, h_vel.data + start_idx, 1);
+
+        if (flags[comm_flag::orientation])
+            exchangeGraphField(h_orientation_copybuf.data, h_orientation.data + start_idx, 1);
+
+        if (flags[comm_flag::body])
+            exchangeGraphField(h_body_copybuf.data, h_body.data + start_idx, 1);
+
+        if (flags[comm_flag::image])
+            exchangeGraphField(h_image_copybuf.data, h_image.data + start_idx, 1);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    // wrap particle positions
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+
+        for (unsigned int idx = start_idx; idx < start_idx + n_recv; idx++)
+            {
+            // wrap particles received across a global boundary
+            shifted_box.wrap(h_pos.data[idx], h_image.data[idx]);
+            }
+        }
+
+        {
+        // set reverse-lookup tag -> idx
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+
+        for (unsigned int idx = start_idx; idx < start_idx + n_recv; idx++)
+            {
+            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+            assert(h_rtag.data[h_tag.data[idx]] == NOT_LOCAL);
+            h_rtag.data[h_tag.data[idx]] = idx;
+            }
+        }
+    }
+
+/*! \param flags The ghost communication flags
+ */
+void Communicator::beginUpdateGhostsGraph(const CommFlags& flags)
+    {
+    unsigned int n_send = (unsigned int)m_graph_copy_ghosts.size();
+    unsigned int start_idx = m_pdata->getN();
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    bool compress = flags[comm_flag::position] && m_compress_ghost_positions;
+    if (compress)
+        {
+        m_pos_compressed_copybuf.resize(n_send);
+        m_pos_compressed_recvbuf.resize(m_pdata->getNGhosts());
+        }
+    else if (flags[comm_flag::position])
+        m_pos_copybuf.resize(n_send);
+
+    if (flags[comm_flag::velocity])
+        m_velocity_copybuf.resize(n_send);
+
+    if (flags[comm_flag::orientation])
+        m_orientation_copybuf.resize(n_send);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        ArrayHandle<int3> h_pos_compressed_copybuf(m_pos_compressed_copybuf,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        ArrayHandle<int3> h_pos_compressed_recvbuf(m_pos_compressed_recvbuf,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        for (unsigned int i = 0; i < m_graph_send_counts.size(); ++i)
+            {
+            // the domain we send to
+            Scalar3 center, width;
+            if (compress)
+                getDomainFractions(m_graph_offsets[i], center, width);
+
+            unsigned int begin = m_graph_send_displs[i];
+            unsigned int end = begin + m_graph_send_counts[i];
+            for (unsigned int ghost_idx = begin; ghost_idx < end; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[m_graph_copy_ghosts[ghost_idx]];
+
+                assert(idx < m_pdata->getN());
+
+                if (compress)
+                    h_pos_compressed_copybuf.data[ghost_idx]
+                        = compressGhostPosition(h_pos.data[idx], center, width);
+                else if (flags[comm_flag::position])
+                    h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                if (flags[comm_flag::velocity])
+                    h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                if (flags[comm_flag::orientation])
+                    h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
+                }
+            }
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        if (compress)
+            {
+            exchangeGraphField(h_pos_compressed_copybuf.data, h_pos_compressed_recvbuf.data, 1);
+            decompressGhostPositions(h_pos_compressed_recvbuf.data,
+                                     h_pos.data + start_idx,
+                                     m_pdata->getNGhosts());
+            }
+        else if (flags[comm_flag::position])
+            exchangeGraphField(h_pos_copybuf.data, h_pos.data + start_idx, 1);
+
+        if (flags[comm_flag::velocity])
+            exchangeGraphField(h_velocity_copybuf.data, h_vel.data + start_idx, 1);
+
+        if (flags[comm_flag::orientation])
+            exchangeGraphField(h_orientation_copybuf.data, h_orientation.data + start_idx, 1);
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    // wrap particle positions (only if copying positions)
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+        for (unsigned int idx = start_idx; idx < start_idx + m_pdata->getNGhosts(); idx++)
+            {
+            // wrap particles received across a global boundary
+            int3 img = make_int3(0, 0, 0);
+            shifted_box.wrap(h_pos.data[idx], img);
+            }
+        }
+    }
+
+/*! \param flags The ghost communication flags
+ */
+void Communicator::updateNetForceGraph(const CommFlags& flags)
+    {
+    unsigned int n_send = (unsigned int)m_graph_copy_ghosts.size();
+    unsigned int start_idx = m_pdata->getN();
+    unsigned int n_ghosts = m_pdata->getNGhosts();
+
+    if (flags[comm_flag::net_force])
+        m_netforce_copybuf.resize(n_send);
+
+    if (flags[comm_flag::net_torque])
+        m_nettorque_copybuf.resize(n_send);
+
+    if (flags[comm_flag::net_virial])
+        {
+        m_netvirial_copybuf.resize(6 * n_send);
+        m_netvirial_recvbuf.resize(6 * n_ghosts);
+        }
+
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+    ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    ArrayHandle<Scalar> h_netvirial_copybuf(m_netvirial_copybuf,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<Scalar> h_netvirial_recvbuf(m_netvirial_recvbuf,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    unsigned int pitch = (unsigned int)m_pdata->getNetVirial().getPitch();
+
+    for (unsigned int ghost_idx = 0; ghost_idx < n_send; ghost_idx++)
+        {
+        unsigned int idx = h_rtag.data[m_graph_copy_ghosts[ghost_idx]];
+
+        assert(idx < m_pdata->getN());
+
+        if (flags[comm_flag::net_force])
+            h_netforce_copybuf.data[ghost_idx] = h_netforce.data[idx];
+        if (flags[comm_flag::net_torque])
+            h_nettorque_copybuf.data[ghost_idx] = h_nettorque.data[idx];
+        if (flags[comm_flag::net_virial])
+            {
+            // copy net virial into send buffer, transposing
+            for (unsigned int k = 0; k < 6; ++k)
+                h_netvirial_copybuf.data[6 * ghost_idx + k] = h_netvirial.data[k * pitch + idx];
+            }
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    if (flags[comm_flag::net_force])
+        exchangeGraphField(h_netforce_copybuf.data, h_netforce.data + start_idx, 1);
+
+    if (flags[comm_flag::net_torque])
+        exchangeGraphField(h_nettorque_copybuf.data, h_nettorque.data + start_idx, 1);
+
+    if (flags[comm_flag::net_virial])
+        exchangeGraphField(h_netvirial_copybuf.data, h_netvirial_recvbuf.data, 6);
+
+    if (m_prof)
+        m_prof->pop();
+
+    if (flags[comm_flag::net_virial])
+        {
+        // transpose the received virials back into the particle data
+        for (unsigned int i = 0; i < n_ghosts; ++i)
+            for (unsigned int k = 0; k < 6; ++k)
+                h_netvirial.data[k * pitch + start_idx + i] = h_netvirial_recvbuf.data[6 * i + k];
+        }
+    }
+
 const BoxDim Communicator::getShiftedBox() const
     {
     // construct the shifted global box for applying global boundary conditions
@@ -3505,6 +4343,12 @@ void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator>>(m, "Communicator")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition>>())
-        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
+        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition)
+        .def_property("neighbor_collectives",
+                      &Communicator::getNeighborCollectives,
+                      &Communicator::setNeighborCollectives)
+        .def_property("compress_ghost_positions",
+                      &Communicator::getCompressGhostPositions,
+                      &Communicator::setCompressGhostPositions);
     }
 #endif // ENABLE_MPI
@@ -19,6 +19,7 @@
 #include "HOOMDMath.h"
 #include "ParticleData.h"
 
+#include <algorithm>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
 
@@ -288,6 +289,70 @@ class PYBIND11_EXPORT Communicator
 
     //@}
 
+    //! Add to the wall time this rank spent computing forces
+    /*! \param time Wall time in nanoseconds
+
+        The integrator reports the time it spends in local force computations. The load balancer
+        uses it to measure the load of this rank.
+     */
+    void addComputeTime(int64_t time)
+        {
+        m_compute_time += time;
+        }
+
+    //! Get the total wall time this rank spent computing forces (in nanoseconds)
+    int64_t getComputeTime() const
+        {
+        return m_compute_time;
+        }
+
+    //! Set whether ghosts are exchanged with all neighbors in a single stage
+    /*! \param enable True to exchange ghosts over a distributed graph communicator
+
+        By default, ghosts are sent in six stages, one per face of the domain, and ghosts that are
+        needed by edge and corner neighbors are forwarded in the later stages. With neighbor
+        collectives enabled, every particle is sent directly to all (up to 26) neighbors that need
+        it with a single MPI_Neighbor_alltoallv per field, which pays the message latency once per
+        ghost update instead of six times.
+
+        The ghost plans are kept in the same form as in the staged exchange, so that the
+        communication of bonded groups is unchanged. When the reverse net force is requested,
+        ghosts are exchanged in stages.
+
+        Neighbor collectives require the grid decomposition, enabling them with a recursive
+        coordinate bisection is an error.
+
+        This is a collective call.
+     */
+    virtual void setNeighborCollectives(bool enable);
+
+    //! Get whether ghosts are exchanged with all neighbors in a single stage
+    bool getNeighborCollectives() const
+        {
+        return m_neighbor_collectives;
+        }
+
+    //! Set whether ghost position updates are compressed
+    /*! \param enable True to send ghost positions as fixed point numbers
+
+        Between two calls to exchangeGhosts(), beginUpdateGhosts() sends only the coordinates of
+        the ghosts, without their types, as three 32 bit fixed point numbers relative to the
+        center of the receiving domain in units of the domain width (see
+        compressGhostPosition()). This reduces the size of a position update from sizeof(Scalar4)
+        to 12 bytes per ghost. The error of a coordinate is at most 2^-31 times the width of the
+        receiving domain along each lattice vector.
+
+        Compression requires the grid decomposition, enabling it with a recursive coordinate
+        bisection is an error.
+     */
+    virtual void setCompressGhostPositions(bool enable);
+
+    //! Get whether ghost position updates are compressed
+    bool getCompressGhostPositions() const
+        {
+        return m_compress_ghost_positions;
+        }
+
     //! Force particle migration
     void forceMigrate()
         {
@@ -436,6 +501,42 @@ class PYBIND11_EXPORT Communicator
             m_groups_sendbuf; //!< Send buffer for group elements
         std::vector<typename group_data::packed_t>
             m_groups_recvbuf; //!< Receive buffer for group elements
+
+        //! Rank updates to send, paired with the destination rank
+        std::vector<std::pair<unsigned int, rank_element_t>> m_ranks_send_pairs;
+
+        //! Groups to send, paired with the destination rank
+        std::vector<std::pair<unsigned int, group_element_t>> m_groups_send_pairs;
+
+        //! Sort the elements to send by their destination rank
+        template<class T> static void sortByRank(std::vector<std::pair<unsigned int, T>>& pairs)
+            {
+            std::sort(pairs.begin(),
+                      pairs.end(),
+                      [](const std::pair<unsigned int, T>& a, const std::pair<unsigned int, T>& b)
+                      { return a.first < b.first; });
+            }
+
+        //! Find the range of the sorted elements that is sent to a rank
+        template<class T>
+        static void findRankRange(const std::vector<std::pair<unsigned int, T>>& pairs,
+                                  unsigned int rank,
+                                  unsigned int& begin,
+                                  unsigned int& end)
+            {
+            auto lower = std::lower_bound(pairs.begin(),
+                                          pairs.end(),
+                                          rank,
+                                          [](const std::pair<unsigned int, T>& p, unsigned int r)
+                                          { return p.first < r; });
+            auto upper = std::upper_bound(lower,
+                                          pairs.end(),
+                                          rank,
+                                          [](unsigned int r, const std::pair<unsigned int, T>& p)
+                                          { return r < p.first; });
+            begin = (unsigned int)(lower - pairs.begin());
+            end = (unsigned int)(upper - pairs.begin());
+            }
         };
 
     //! Returns true if we are communicating particles along a given direction
@@ -461,6 +562,29 @@ class PYBIND11_EXPORT Communicator
     //! Helper function to update the shifted box for ghost particle PBC
     const BoxDim getShiftedBox() const;
 
+    //! Get the center and width of a domain as fractions of the global box
+    void getDomainFractions(const int3& offset, Scalar3& center, Scalar3& width) const;
+
+    //! Encode a ghost position relative to the receiving domain
+    int3 compressGhostPosition(const Scalar4& postype,
+                               const Scalar3& center,
+                               const Scalar3& width) const;
+
+    //! Decode the ghost positions received from a neighbor
+    void decompressGhostPositions(const int3* compressed, Scalar4* postype, unsigned int n) const;
+
+    //! Exchange ghosts with all neighbors in a single stage
+    void exchangeGhostsGraph(const CommFlags& flags);
+
+    //! Update the ghosts that were exchanged in a single stage
+    void beginUpdateGhostsGraph(const CommFlags& flags);
+
+    //! Communicate the net force of the ghosts that were exchanged in a single stage
+    void updateNetForceGraph(const CommFlags& flags);
+
+    //! Send the packed values of the ghosts to all neighbors and receive theirs
+    template<class T> void exchangeGraphField(const T* send, T* recv, unsigned int width);
+
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< System definition
     std::shared_ptr<ParticleData> m_pdata;                     //!< Particle data
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
@@ -495,6 +619,8 @@ class PYBIND11_EXPORT Communicator
     GlobalVector<Scalar4> m_nettorque_copybuf;   //!< Buffer for net torque
     GlobalVector<Scalar> m_netvirial_copybuf;    //!< Buffer for net virial
     GlobalVector<Scalar> m_netvirial_recvbuf;    //!< Buffer for net virial (receive)
+    GlobalVector<int3> m_pos_compressed_copybuf; //!< Buffer for compressed ghost positions
+    GlobalVector<int3> m_pos_compressed_recvbuf; //!< Buffer for compressed positions (receive)
 
     GlobalVector<unsigned int>
         m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
@@ -584,6 +710,23 @@ class PYBIND11_EXPORT Communicator
     CommFlags m_flags;      //!< The ghost communication flags
     CommFlags m_last_flags; //!< Flags of last ghost exchange
 
+    int64_t m_compute_time = 0; //!< Wall time this rank spent computing forces (in ns)
+
+    bool m_compress_ghost_positions = false; //!< True if ghost position updates are compressed
+
+    /* Single stage ghost exchange */
+    bool m_neighbor_collectives = false;   //!< True if ghosts are sent in a single stage
+    MPI_Comm m_graph_comm = MPI_COMM_NULL; //!< Distributed graph communicator over the neighbors
+    bool m_graph_ghosts = false; //!< True if the current ghosts were sent in a single stage
+    std::vector<unsigned int> m_graph_plan_mask; //!< Plan bits needed to send to every neighbor
+    std::vector<int3> m_graph_offsets;           //!< Grid offset of every neighbor
+    std::vector<unsigned int> m_graph_copy_ghosts; //!< Tags of the ghosts sent, ordered by neighbor
+    std::vector<int> m_graph_send_counts; //!< Number of ghosts sent to every neighbor
+    std::vector<int> m_graph_send_displs; //!< Offset of every neighbor in the send buffers
+    std::vector<int> m_graph_recv_counts; //!< Number of ghosts received from every neighbor
+    std::vector<int> m_graph_recv_displs; //!< Offset of every neighbor in the received ghosts
+    std::vector<int> m_graph_byte_counts; //!< Scratch space for the counts and offsets in bytes
+
     bool m_comm_pending;             //!< If true, a communication is in process
     std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
     std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
@@ -666,8 +809,9 @@ class PYBIND11_EXPORT Communicator
         }
 
     private:
-    std::vector<pdata_element> m_sendbuf; //!< Buffer for particles that are sent
-    std::vector<pdata_element> m_recvbuf; //!< Buffer for particles that are received
+    std::vector<pdata_element> m_sendbuf;       //!< Buffer for particles that are sent
+    std::vector<pdata_element> m_recvbuf;       //!< Buffer for particles that are received
+    std::vector<unsigned int> m_comm_flags_out; //!< Communication flags of the sent particles
 
     /* Communication of bonded groups */
     GroupCommunicator<BondData> m_bond_comm; //!< Communication helper for bonds
@@ -27,6 +27,13 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
       m_pair_comm(*this, m_sysdef->getPairData())
     {
+    if (m_decomposition->isRCB())
+        {
+        m_exec_conf->msg->error()
+            << "comm: recursive coordinate bisection is not supported on the GPU" << std::endl;
+        throw std::runtime_error("Error initializing CommunicatorGPU");
+        }
+
     if (m_exec_conf->allConcurrentManagedAccess())
         {
         // inform the user to use a cuda-aware MPI
@@ -52,6 +59,26 @@ CommunicatorGPU::~CommunicatorGPU()
     hipEventDestroy(m_event);
     }
 
+void CommunicatorGPU::setNeighborCollectives(bool enable)
+    {
+    if (enable)
+        {
+        m_exec_conf->msg->error() << "comm: neighbor collectives are not supported on the GPU"
+                                  << std::endl;
+        throw std::runtime_error("Error setting neighbor collectives");
+        }
+    }
+
+void CommunicatorGPU::setCompressGhostPositions(bool enable)
+    {
+    if (enable)
+        {
+        m_exec_conf->msg->error() << "comm: compressed ghost positions are not supported on the GPU"
+                                  << std::endl;
+        throw std::runtime_error("Error setting compressed ghost positions");
+        }
+    }
+
 void CommunicatorGPU::allocateBuffers()
     {
     /*
@@ -69,6 +69,16 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     virtual void updateNetForce(uint64_t timestep);
     //@}
 
+    //! Set whether ghosts are exchanged with all neighbors in a single stage
+    /*! Neighbor collectives are not implemented on the GPU, enabling them is an error.
+     */
+    virtual void setNeighborCollectives(bool enable);
+
+    //! Set whether ghost position updates are compressed
+    /*! Compressed ghost positions are not implemented on the GPU, enabling them is an error.
+     */
+    virtual void setCompressGhostPositions(bool enable);
+
     //! Set maximum number of communication stages
     /*! \param max_stages Maximum number of communication stages
      */
@@ -0,0 +1,967 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CommunicatorRCB.cc
+    \brief Implements the CommunicatorRCB class
+*/
+
+#ifdef ENABLE_MPI
+
+#include "CommunicatorRCB.h"
+#include "Profiler.h"
+#include "System.h"
+
+#include <algorithm>
+
+namespace py = pybind11;
+using namespace std;
+
+//! Get a component of a vector
+static inline Scalar component(const Scalar3& v, unsigned int dim)
+    {
+    return (dim == 0) ? v.x : ((dim == 1) ? v.y : v.z);
+    }
+
+//! Set a component of a vector
+static inline int& component(int3& v, unsigned int dim)
+    {
+    return (dim == 0) ? v.x : ((dim == 1) ? v.y : v.z);
+    }
+
+//! Test if a domain spans the box along a direction
+static inline bool spans(const Scalar3& lo, const Scalar3& hi, unsigned int dim)
+    {
+    return component(lo, dim) == Scalar(0.0) && component(hi, dim) == Scalar(1.0);
+    }
+
+/*! \param lo_a Lower bound of domain a
+    \param hi_a Upper bound of domain a
+    \param lo_b Lower bound of domain b
+    \param hi_b Upper bound of domain b
+    \param w Ghost layer width
+    \returns A mask with bit s+1 set if domain a shifted by s overlaps the expanded domain b
+
+    All quantities are fractions of the global box along one direction.
+*/
+static inline unsigned char
+overlapShifts(Scalar lo_a, Scalar hi_a, Scalar lo_b, Scalar hi_b, Scalar w)
+    {
+    unsigned char mask = 0;
+    for (int s = -1; s <= 1; ++s)
+        {
+        if (lo_a + Scalar(s) <= hi_b + w && hi_a + Scalar(s) >= lo_b - w)
+            mask |= (unsigned char)(1 << (s + 1));
+        }
+    return mask;
+    }
+
+//! Constructor
+CommunicatorRCB::CommunicatorRCB(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<DomainDecomposition> decomposition)
+    : Communicator(sysdef, decomposition)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CommunicatorRCB" << endl;
+
+    if (!m_decomposition->isRCB())
+        {
+        m_exec_conf->msg->error()
+            << "comm: CommunicatorRCB requires a recursive coordinate bisection" << endl;
+        throw runtime_error("Error initializing CommunicatorRCB");
+        }
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "comm: recursive coordinate bisection is not supported on the GPU" << endl;
+        throw runtime_error("Error initializing CommunicatorRCB");
+        }
+    }
+
+//! Destructor
+CommunicatorRCB::~CommunicatorRCB()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CommunicatorRCB" << endl;
+    }
+
+/*! Two ranks are neighbors if the domain of the lower rank, shifted by -1, 0, or +1 box lengths
+    along every direction, overlaps the domain of the higher rank expanded by the ghost layer width.
+    Evaluating the test in the order of the ranks guarantees that both ranks agree.
+*/
+void CommunicatorRCB::findNeighbors()
+    {
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    const unsigned int my_rank = m_exec_conf->getRank();
+    const Scalar3 w = getGhostLayerMaxWidth() / m_pdata->getGlobalBox().getNearestPlaneDistance();
+
+    const Scalar3 my_lo = m_decomposition->getDomainLo(my_rank);
+    const Scalar3 my_hi = m_decomposition->getDomainHi(my_rank);
+
+    m_neighbor_ranks.clear();
+    m_neighbor_shifts.clear();
+    m_is_neighbor.assign(n_ranks, false);
+
+    for (unsigned int rank = 0; rank < n_ranks; ++rank)
+        {
+        if (rank == my_rank)
+            continue;
+
+        const Scalar3 lo = m_decomposition->getDomainLo(rank);
+        const Scalar3 hi = m_decomposition->getDomainHi(rank);
+        const unsigned int a = std::min(rank, my_rank);
+
+        bool neighbor = true;
+        unsigned char shifts[3];
+        for (unsigned int dim = 0; dim < 3; ++dim)
+            {
+            const Scalar w_dim = component(w, dim);
+
+            // the overlap between the lower and the higher rank
+            unsigned char overlap
+                = (a == my_rank) ? overlapShifts(component(my_lo, dim),
+                                                 component(my_hi, dim),
+                                                 component(lo, dim),
+                                                 component(hi, dim),
+                                                 w_dim)
+                                 : overlapShifts(component(lo, dim),
+                                                 component(hi, dim),
+                                                 component(my_lo, dim),
+                                                 component(my_hi, dim),
+                                                 w_dim);
+            neighbor = neighbor && overlap;
+
+            // the images of the local domain that overlap the neighbor
+            if (spans(lo, hi, dim))
+                shifts[dim] = 1 << 1;
+            else
+                shifts[dim] = overlapShifts(component(my_lo, dim),
+                                            component(my_hi, dim),
+                                            component(lo, dim),
+                                            component(hi, dim),
+                                            w_dim);
+            }
+
+        if (neighbor)
+            {
+            m_neighbor_ranks.push_back(rank);
+            m_neighbor_shifts.push_back(make_uchar3(shifts[0], shifts[1], shifts[2]));
+            m_is_neighbor[rank] = true;
+            }
+        }
+
+    m_exec_conf->msg->notice(7) << "CommunicatorRCB: " << m_neighbor_ranks.size() << " neighbors"
+                                << endl;
+    }
+
+/*! All ranks test the bounds of all domains, so that they raise the same error.
+ */
+void CommunicatorRCB::checkDomains()
+    {
+    if (m_sysdef->getBondData()->getNGlobal() || m_sysdef->getAngleData()->getNGlobal()
+        || m_sysdef->getDihedralData()->getNGlobal() || m_sysdef->getImproperData()->getNGlobal()
+        || m_sysdef->getConstraintData()->getNGlobal() || m_sysdef->getPairData()->getNGlobal())
+        {
+        m_exec_conf->msg->error()
+            << "comm: bonded groups are not supported with recursive coordinate bisection" << endl;
+        throw runtime_error("Error during communication");
+        }
+
+    const Scalar3 w = getGhostLayerMaxWidth() / m_pdata->getGlobalBox().getNearestPlaneDistance();
+    for (unsigned int rank = 0; rank < m_exec_conf->getNRanks(); ++rank)
+        {
+        const Scalar3 lo = m_decomposition->getDomainLo(rank);
+        const Scalar3 hi = m_decomposition->getDomainHi(rank);
+        for (unsigned int dim = 0; dim < 3; ++dim)
+            {
+            if (spans(lo, hi, dim))
+                continue;
+
+            if (component(hi, dim) - component(lo, dim) + Scalar(2.0) * component(w, dim)
+                >= Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "Communication error - " << endl;
+                m_exec_conf->msg->error()
+                    << "Simulation box too small for domain decomposition." << endl;
+                m_exec_conf->msg->error() << "r_ghost_max: " << getGhostLayerMaxWidth() << endl;
+                throw runtime_error("Error during communication");
+                }
+            }
+        }
+    }
+
+//! Transfer particles to the ranks that own them
+void CommunicatorRCB::migrateParticles()
+    {
+    m_exec_conf->msg->notice(7) << "CommunicatorRCB: migrate particles" << endl;
+
+    updateGhostWidth();
+
+    // the cuts may have changed
+    findNeighbors();
+    checkDomains();
+
+    if (m_prof)
+        m_prof->push("comm_migrate");
+
+    // remove ghost particles from system
+    m_pdata->removeAllGhostParticles();
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    const unsigned int my_rank = m_exec_conf->getRank();
+
+    // mark the particles that have left the domain with their destination rank + 1
+    int far = 0;
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flag(m_pdata->getCommFlags(),
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+
+        const BoxDim& box = m_pdata->getBox();
+        for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            {
+            const Scalar4& postype = h_pos.data[idx];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            Scalar3 f = box.makeFraction(pos);
+
+            h_comm_flag.data[idx] = 0;
+            if (f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+                && f.z >= Scalar(0.0) && f.z < Scalar(1.0))
+                continue;
+
+            int3 img = make_int3(0, 0, 0);
+            global_box.wrap(pos, img);
+            unsigned int dest = m_decomposition->placeParticle(global_box, pos, h_cart_ranks.data);
+            if (dest == my_rank)
+                continue;
+
+            h_comm_flag.data[idx] = dest + 1;
+            if (!m_is_neighbor[dest])
+                far = 1;
+            }
+        }
+
+    // remove the particles from the local domain
+    std::vector<unsigned int> comm_flags;
+    m_pdata->removeParticles(m_migrate_sendbuf, comm_flags);
+
+    // sort the particles by destination rank
+    std::vector<int> n_send(n_ranks, 0);
+    for (unsigned int i = 0; i < comm_flags.size(); ++i)
+        n_send[comm_flags[i] - 1]++;
+
+    std::vector<int> send_displs(n_ranks, 0);
+    for (unsigned int rank = 1; rank < n_ranks; ++rank)
+        send_displs[rank] = send_displs[rank - 1] + n_send[rank - 1];
+
+        {
+        std::vector<pdata_element> sorted(m_migrate_sendbuf.size());
+        std::vector<int> offs(send_displs);
+        for (unsigned int i = 0; i < comm_flags.size(); ++i)
+            sorted[offs[comm_flags[i] - 1]++] = m_migrate_sendbuf[i];
+        m_migrate_sendbuf.swap(sorted);
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    // particles that move beyond the neighbors require a collective exchange
+    MPI_Allreduce(MPI_IN_PLACE, &far, 1, MPI_INT, MPI_LOR, m_mpi_comm);
+
+    if (far)
+        {
+        std::vector<int> n_recv(n_ranks, 0);
+        MPI_Alltoall(&n_send.front(), 1, MPI_INT, &n_recv.front(), 1, MPI_INT, m_mpi_comm);
+
+        std::vector<int> recv_displs(n_ranks, 0);
+        for (unsigned int rank = 1; rank < n_ranks; ++rank)
+            recv_displs[rank] = recv_displs[rank - 1] + n_recv[rank - 1];
+
+        m_migrate_recvbuf.resize(recv_displs[n_ranks - 1] + n_recv[n_ranks - 1]);
+        MPI_Alltoallv(m_migrate_sendbuf.data(),
+                      &n_send.front(),
+                      &send_displs.front(),
+                      m_mpi_pdata_element,
+                      m_migrate_recvbuf.data(),
+                      &n_recv.front(),
+                      &recv_displs.front(),
+                      m_mpi_pdata_element,
+                      m_mpi_comm);
+        }
+    else
+        {
+        const unsigned int n_neigh = (unsigned int)m_neighbor_ranks.size();
+        std::vector<int> n_recv(n_neigh, 0);
+
+        m_reqs.resize(2 * n_neigh);
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+            {
+            unsigned int rank = m_neighbor_ranks[ineigh];
+            MPI_Isend(&n_send[rank], 1, MPI_INT, rank, 0, m_mpi_comm, &m_reqs[2 * ineigh]);
+            MPI_Irecv(&n_recv[ineigh], 1, MPI_INT, rank, 0, m_mpi_comm, &m_reqs[2 * ineigh + 1]);
+            }
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+
+        unsigned int n_recv_tot = 0;
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+            n_recv_tot += n_recv[ineigh];
+        m_migrate_recvbuf.resize(n_recv_tot);
+
+        m_reqs.clear();
+        unsigned int offs = 0;
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+            {
+            unsigned int rank = m_neighbor_ranks[ineigh];
+            MPI_Request req;
+            if (n_send[rank])
+                {
+                MPI_Isend(&m_migrate_sendbuf[send_displs[rank]],
+                          n_send[rank],
+                          m_mpi_pdata_element,
+                          rank,
+                          1,
+                          m_mpi_comm,
+                          &req);
+                m_reqs.push_back(req);
+                }
+            if (n_recv[ineigh])
+                {
+                MPI_Irecv(&m_migrate_recvbuf[offs],
+                          n_recv[ineigh],
+                          m_mpi_pdata_element,
+                          rank,
+                          1,
+                          m_mpi_comm,
+                          &req);
+                m_reqs.push_back(req);
+                }
+            offs += n_recv[ineigh];
+            }
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    // wrap received particles back into the global box
+    for (auto& p : m_migrate_recvbuf)
+        global_box.wrap(p.pos, p.image);
+
+    // fill particle data with received particles
+    m_pdata->addParticles(m_migrate_recvbuf);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param send Values to send, ordered by neighbor, \a width values per ghost
+    \param recv Destination of the received values, \a width values per ghost
+    \param width Number of values per ghost
+    \param tag MPI tag of the messages
+*/
+template<class T>
+void CommunicatorRCB::exchangeGhostField(const T* send, T* recv, unsigned int width, int tag)
+    {
+    m_reqs.clear();
+    for (unsigned int ineigh = 0; ineigh < m_neighbor_ranks.size(); ++ineigh)
+        {
+        MPI_Request req;
+        if (m_n_send_ghosts[ineigh])
+            {
+            MPI_Isend(send + width * m_send_begin[ineigh],
+                      int(width * m_n_send_ghosts[ineigh] * sizeof(T)),
+                      MPI_BYTE,
+                      m_neighbor_ranks[ineigh],
+                      tag,
+                      m_mpi_comm,
+                      &req);
+            m_reqs.push_back(req);
+            }
+        if (m_n_recv_ghosts[ineigh])
+            {
+            MPI_Irecv(recv + width * m_recv_begin[ineigh],
+                      int(width * m_n_recv_ghosts[ineigh] * sizeof(T)),
+                      MPI_BYTE,
+                      m_neighbor_ranks[ineigh],
+                      tag,
+                      m_mpi_comm,
+                      &req);
+            m_reqs.push_back(req);
+            }
+        }
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+    }
+
+//! Build a ghost particle list, exchange ghost particle data with neighboring ranks
+void CommunicatorRCB::exchangeGhosts()
+    {
+    updateGhostWidth();
+    checkDomains();
+
+    CommFlags flags = getFlags();
+    if (flags[comm_flag::reverse_net_force])
+        {
+        m_exec_conf->msg->error() << "comm: reverse net force communication is not supported "
+                                  << "with recursive coordinate bisection" << endl;
+        throw runtime_error("Error during communication");
+        }
+
+    if (m_prof)
+        m_prof->push("comm_ghost_exch");
+
+    m_exec_conf->msg->notice(7) << "CommunicatorRCB: exchange ghosts" << endl;
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int my_rank = m_exec_conf->getRank();
+    const unsigned int n_neigh = (unsigned int)m_neighbor_ranks.size();
+    const Scalar3 my_lo = m_decomposition->getDomainLo(my_rank);
+    const Scalar3 my_hi = m_decomposition->getDomainHi(my_rank);
+
+    // compute the ghost layer widths as fractions of the global box
+    const Scalar3 box_dist = global_box.getNearestPlaneDistance();
+    std::vector<Scalar3> ghost_fractions(m_pdata->getNTypes());
+    std::vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes());
+        {
+        ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
+                                           access_location::host,
+                                           access_mode::read);
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            {
+            ghost_fractions[cur_type] = h_r_ghost.data[cur_type] / box_dist;
+            ghost_fractions_body[cur_type] = h_r_ghost_body.data[cur_type] / box_dist;
+            }
+        }
+
+    m_ghost_tags.clear();
+    m_ghost_shifts.clear();
+    m_send_begin.resize(n_neigh);
+    m_n_send_ghosts.resize(n_neigh);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        // candidates lie within the ghost layer of a boundary of the local domain
+        std::vector<unsigned int> candidates;
+        std::vector<Scalar3> fractions;
+        std::vector<Scalar3> widths;
+        for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+            {
+            Scalar4 postype = h_pos.data[idx];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+
+            // get the ghost fraction for this particle type
+            const unsigned int type = __scalar_as_int(postype.w);
+            Scalar3 ghost_fraction = ghost_fractions[type];
+
+            if (h_body.data[idx] < MIN_FLOPPY)
+                {
+                ghost_fraction += ghost_fractions_body[type];
+                }
+
+            Scalar3 f = global_box.makeFraction(pos);
+            bool candidate = false;
+            for (unsigned int dim = 0; dim < 3; ++dim)
+                {
+                if (spans(my_lo, my_hi, dim))
+                    continue;
+                Scalar f_dim = component(f, dim);
+                Scalar g_dim = component(ghost_fraction, dim);
+                if (f_dim < component(my_lo, dim) + g_dim
+                    || f_dim >= component(my_hi, dim) - g_dim)
+                    candidate = true;
+                }
+
+            if (candidate)
+                {
+                candidates.push_back(idx);
+                fractions.push_back(f);
+                widths.push_back(ghost_fraction);
+                }
+            }
+
+        // assign every candidate to the neighbors whose ghost layer it lies in
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+            {
+            const unsigned int rank = m_neighbor_ranks[ineigh];
+            const Scalar3 lo = m_decomposition->getDomainLo(rank);
+            const Scalar3 hi = m_decomposition->getDomainHi(rank);
+            const uchar3 neigh_shifts = m_neighbor_shifts[ineigh];
+            const unsigned char masks[3] = {neigh_shifts.x, neigh_shifts.y, neigh_shifts.z};
+
+            m_send_begin[ineigh] = (unsigned int)m_ghost_tags.size();
+            for (unsigned int i = 0; i < candidates.size(); ++i)
+                {
+                int3 shift = make_int3(0, 0, 0);
+                bool send = true;
+                for (unsigned int dim = 0; dim < 3 && send; ++dim)
+                    {
+                    if (spans(lo, hi, dim))
+                        continue;
+
+                    // at most one image lies within the ghost layer
+                    Scalar f_dim = component(fractions[i], dim);
+                    Scalar g_dim = component(widths[i], dim);
+                    send = false;
+                    for (int s = -1; s <= 1; ++s)
+                        {
+                        if ((masks[dim] & (1 << (s + 1)))
+                            && f_dim + Scalar(s) >= component(lo, dim) - g_dim
+                            && f_dim + Scalar(s) < component(hi, dim) + g_dim)
+                            {
+                            component(shift, dim) = s;
+                            send = true;
+                            break;
+                            }
+                        }
+                    }
+
+                if (send)
+                    {
+                    m_ghost_tags.push_back(h_tag.data[candidates[i]]);
+                    m_ghost_shifts.push_back(shift);
+                    }
+                }
+            m_n_send_ghosts[ineigh] = (unsigned int)m_ghost_tags.size() - m_send_begin[ineigh];
+            }
+        }
+
+    // exchange the number of ghosts
+    m_n_recv_ghosts.resize(n_neigh);
+    m_reqs.resize(2 * n_neigh);
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+        {
+        unsigned int rank = m_neighbor_ranks[ineigh];
+        MPI_Isend(&m_n_send_ghosts[ineigh],
+                  1,
+                  MPI_UNSIGNED,
+                  rank,
+                  0,
+                  m_mpi_comm,
+                  &m_reqs[2 * ineigh]);
+        MPI_Irecv(&m_n_recv_ghosts[ineigh],
+                  1,
+                  MPI_UNSIGNED,
+                  rank,
+                  0,
+                  m_mpi_comm,
+                  &m_reqs[2 * ineigh + 1]);
+        }
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+
+    m_recv_begin.resize(n_neigh);
+    unsigned int n_recv_tot = 0;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+        {
+        m_recv_begin[ineigh] = n_recv_tot;
+        n_recv_tot += m_n_recv_ghosts[ineigh];
+        }
+
+    // pack the ghosts, we fill all fields, but send only those that are requested
+    const unsigned int n_send_tot = (unsigned int)m_ghost_tags.size();
+    m_tag_copybuf.resize(n_send_tot);
+    m_pos_copybuf.resize(n_send_tot);
+    m_charge_copybuf.resize(n_send_tot);
+    m_diameter_copybuf.resize(n_send_tot);
+    m_velocity_copybuf.resize(n_send_tot);
+    m_orientation_copybuf.resize(n_send_tot);
+    m_body_copybuf.resize(n_send_tot);
+    m_image_copybuf.resize(n_send_tot);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        ArrayHandle<unsigned int> h_tag_copybuf(m_tag_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf,
+                                          access_location::host,
+                                          access_mode::overwrite);
+
+        for (unsigned int i = 0; i < n_send_tot; ++i)
+            {
+            unsigned int idx = h_rtag.data[m_ghost_tags[i]];
+            const int3 shift = m_ghost_shifts[i];
+
+            // shift the ghost into the periodic image next to the neighbor
+            Scalar4 postype = h_pos.data[idx];
+            Scalar3 pos = global_box.shift(make_scalar3(postype.x, postype.y, postype.z), shift);
+            h_pos_copybuf.data[i] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+
+            int3 img = h_image.data[idx];
+            h_image_copybuf.data[i] = make_int3(img.x - shift.x, img.y - shift.y, img.z - shift.z);
+
+            h_tag_copybuf.data[i] = m_ghost_tags[i];
+            h_charge_copybuf.data[i] = h_charge.data[idx];
+            h_diameter_copybuf.data[i] = h_diameter.data[idx];
+            h_velocity_copybuf.data[i] = h_vel.data[idx];
+            h_orientation_copybuf.data[i] = h_orientation.data[idx];
+            h_body_copybuf.data[i] = h_body.data[idx];
+            }
+        }
+
+    // accommodate new ghost particles
+    const unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
+    m_pdata->addGhostParticles(n_recv_tot);
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+        {
+        ArrayHandle<unsigned int> h_tag_copybuf(m_tag_copybuf,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+        exchangeGhostField(h_tag_copybuf.data, h_tag.data + start_idx, 1, 1);
+        }
+
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        exchangeGhostField(h_pos_copybuf.data, h_pos.data + start_idx, 1, 2);
+        }
+
+    if (flags[comm_flag::charge])
+        {
+        ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf,
+                                             access_location::host,
+                                             access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+        exchangeGhostField(h_charge_copybuf.data, h_charge.data + start_idx, 1, 3);
+        }
+
+    if (flags[comm_flag::diameter])
+        {
+        ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        exchangeGhostField(h_diameter_copybuf.data, h_diameter.data + start_idx, 1, 4);
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        exchangeGhostField(h_velocity_copybuf.data, h_vel.data + start_idx, 1, 5);
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        exchangeGhostField(h_orientation_copybuf.data, h_orientation.data + start_idx, 1, 6);
+        }
+
+    if (flags[comm_flag::body])
+        {
+        ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf,
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        exchangeGhostField(h_body_copybuf.data, h_body.data + start_idx, 1, 7);
+        }
+
+    if (flags[comm_flag::image])
+        {
+        ArrayHandle<int3> h_image_copybuf(m_image_copybuf,
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        exchangeGhostField(h_image_copybuf.data, h_image.data + start_idx, 1, 8);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+        {
+        // set reverse-lookup tag -> idx
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+
+        for (unsigned int idx = start_idx; idx < start_idx + n_recv_tot; idx++)
+            {
+            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+            assert(h_rtag.data[h_tag.data[idx]] == NOT_LOCAL);
+            h_rtag.data[h_tag.data[idx]] = idx;
+            }
+        }
+
+    m_ghosts_added = m_pdata->getNGhosts();
+    m_last_flags = flags;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep The time step
+ */
+void CommunicatorRCB::beginUpdateGhosts(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    m_exec_conf->msg->notice(7) << "CommunicatorRCB: update ghosts" << endl;
+
+    CommFlags flags = getFlags();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int n_send_tot = (unsigned int)m_ghost_tags.size();
+    const unsigned int start_idx = m_pdata->getN();
+
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+            {
+            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
+                                               access_location::host,
+                                               access_mode::overwrite);
+            for (unsigned int i = 0; i < n_send_tot; ++i)
+                {
+                Scalar4 postype = h_pos.data[h_rtag.data[m_ghost_tags[i]]];
+                Scalar3 pos = global_box.shift(make_scalar3(postype.x, postype.y, postype.z),
+                                               m_ghost_shifts[i]);
+                h_pos_copybuf.data[i] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+                }
+            }
+
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+        exchangeGhostField(h_pos_copybuf.data, h_pos.data + start_idx, 1, 2);
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+            {
+            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                    access_location::host,
+                                                    access_mode::overwrite);
+            for (unsigned int i = 0; i < n_send_tot; ++i)
+                h_velocity_copybuf.data[i] = h_vel.data[h_rtag.data[m_ghost_tags[i]]];
+            }
+
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::read);
+        exchangeGhostField(h_velocity_copybuf.data, h_vel.data + start_idx, 1, 5);
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+            {
+            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+            for (unsigned int i = 0; i < n_send_tot; ++i)
+                h_orientation_copybuf.data[i] = h_orientation.data[h_rtag.data[m_ghost_tags[i]]];
+            }
+
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::read);
+        exchangeGhostField(h_orientation_copybuf.data, h_orientation.data + start_idx, 1, 6);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep The time step
+ */
+void CommunicatorRCB::updateNetForce(uint64_t timestep)
+    {
+    CommFlags flags = getFlags();
+    if (!flags[comm_flag::net_force] && !flags[comm_flag::net_torque]
+        && !flags[comm_flag::net_virial])
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_net_force");
+
+    m_exec_conf->msg->notice(7) << "CommunicatorRCB: update net force" << endl;
+
+    const unsigned int n_send_tot = (unsigned int)m_ghost_tags.size();
+    const unsigned int start_idx = m_pdata->getN();
+
+    if (flags[comm_flag::net_force])
+        {
+        m_netforce_copybuf.resize(n_send_tot);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        for (unsigned int i = 0; i < n_send_tot; ++i)
+            h_netforce_copybuf.data[i] = h_net_force.data[h_rtag.data[m_ghost_tags[i]]];
+
+        exchangeGhostField(h_netforce_copybuf.data, h_net_force.data + start_idx, 1, 9);
+        }
+
+    if (flags[comm_flag::net_torque])
+        {
+        m_nettorque_copybuf.resize(n_send_tot);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::host,
+                                          access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        for (unsigned int i = 0; i < n_send_tot; ++i)
+            h_nettorque_copybuf.data[i] = h_net_torque.data[h_rtag.data[m_ghost_tags[i]]];
+
+        exchangeGhostField(h_nettorque_copybuf.data, h_net_torque.data + start_idx, 1, 10);
+        }
+
+    if (flags[comm_flag::net_virial])
+        {
+        const unsigned int n_recv_tot = m_pdata->getNGhosts();
+        m_netvirial_copybuf.resize(6 * n_send_tot);
+        m_netvirial_recvbuf.resize(6 * n_recv_tot);
+
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_netvirial_copybuf(m_netvirial_copybuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        ArrayHandle<Scalar> h_netvirial_recvbuf(m_netvirial_recvbuf,
+                                                access_location::host,
+                                                access_mode::overwrite);
+
+        const size_t pitch = m_pdata->getNetVirial().getPitch();
+        for (unsigned int i = 0; i < n_send_tot; ++i)
+            {
+            unsigned int idx = h_rtag.data[m_ghost_tags[i]];
+            for (unsigned int j = 0; j < 6; ++j)
+                h_netvirial_copybuf.data[6 * i + j] = h_net_virial.data[j * pitch + idx];
+            }
+
+        exchangeGhostField(h_netvirial_copybuf.data, h_netvirial_recvbuf.data, 6, 11);
+
+        for (unsigned int i = 0; i < n_recv_tot; ++i)
+            for (unsigned int j = 0; j < 6; ++j)
+                h_net_virial.data[j * pitch + start_idx + i] = h_netvirial_recvbuf.data[6 * i + j];
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+//! Export CommunicatorRCB class to python
+void export_CommunicatorRCB(py::module& m)
+    {
+    py::class_<CommunicatorRCB, Communicator, std::shared_ptr<CommunicatorRCB>>(m,
+                                                                                "CommunicatorRCB")
+        .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition>>());
+    }
+
+#endif // ENABLE_MPI
@@ -0,0 +1,111 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CommunicatorRCB.h
+    \brief Defines the CommunicatorRCB class
+*/
+
+#ifndef __COMMUNICATOR_RCB_H__
+#define __COMMUNICATOR_RCB_H__
+
+#ifdef ENABLE_MPI
+
+#include "Communicator.h"
+
+#include <pybind11/pybind11.h>
+#include <vector>
+
+/*! \ingroup communication
+ */
+
+//! Class that handles MPI communication for a recursive coordinate bisection
+/*! The domains of a recursive coordinate bisection (see DomainDecomposition) do not form a grid,
+    so a domain may share a face with any number of other domains and the staged communication of
+    the base class along the six grid directions does not apply. CommunicatorRCB instead exchanges
+    particles and ghosts directly with every neighboring rank.
+
+    Two ranks are neighbors when the domain of one, or one of its periodic images, overlaps the
+    domain of the other expanded by the maximum ghost layer width. The neighbors are determined
+    from the domain bounds, which all ranks share, every time particles migrate. For every neighbor,
+    the communicator stores the periodic images of the local domain (per direction, one of -1, 0,
+    +1 box lengths) that overlap it. A ghost is sent with the one image that places it within the
+    ghost layer of the neighbor, and its position is shifted accordingly before sending.
+
+    Particles migrate directly to the rank that owns their new position. When any particle moves
+    to a rank that is not a neighbor, e.g. after the load balancer moved the cuts, all ranks use a
+    collective all-to-all exchange instead.
+
+    In every direction in which a domain does not span the box, the domain expanded by the ghost
+    layer on both sides must be narrower than the box, so that a ghost matches a single image.
+    Bonded groups, reverse net force communication and GPU execution are not supported.
+*/
+class PYBIND11_EXPORT CommunicatorRCB : public Communicator
+    {
+    public:
+    //! Constructor
+    /*! \param sysdef system definition the communicator is associated with
+     *  \param decomposition Information about the decomposition of the global simulation domain
+     */
+    CommunicatorRCB(std::shared_ptr<SystemDefinition> sysdef,
+                    std::shared_ptr<DomainDecomposition> decomposition);
+    virtual ~CommunicatorRCB();
+
+    //! \name communication methods
+    //@{
+
+    /*! Update the ghost particle positions, velocities and orientations
+     *
+     * \param timestep The time step
+     */
+    virtual void beginUpdateGhosts(uint64_t timestep);
+
+    //! Transfer particles to the ranks that own them
+    virtual void migrateParticles();
+
+    //! Build a ghost particle list, exchange ghost particle data with neighboring ranks
+    virtual void exchangeGhosts();
+
+    /*! Communicate the net particle force
+     * \param timestep The time step
+     */
+    virtual void updateNetForce(uint64_t timestep);
+    //@}
+
+    //! Get the neighboring ranks
+    const std::vector<unsigned int>& getNeighborRanks() const
+        {
+        return m_neighbor_ranks;
+        }
+
+    protected:
+    std::vector<unsigned int> m_neighbor_ranks; //!< Ranks of the neighboring domains
+    std::vector<uchar3> m_neighbor_shifts; //!< Per neighbor and direction, bit s+1 is set if the
+                                           //!< domain image shifted by s box lengths overlaps it
+    std::vector<bool> m_is_neighbor;       //!< Flag for every rank, true if it is a neighbor
+
+    std::vector<unsigned int> m_ghost_tags;   //!< Tags of the ghosts sent, ordered by neighbor
+    std::vector<int3> m_ghost_shifts;         //!< Image shift of every ghost sent
+    std::vector<unsigned int> m_send_begin;   //!< Begin index of every neighbor in the ghost lists
+    std::vector<unsigned int> m_n_send_ghosts; //!< Number of ghosts sent to every neighbor
+    std::vector<unsigned int> m_n_recv_ghosts; //!< Number of ghosts received from every neighbor
+    std::vector<unsigned int> m_recv_begin;    //!< Offset of every neighbor's ghosts
+
+    std::vector<pdata_element> m_migrate_sendbuf; //!< Buffer for particles that are sent
+    std::vector<pdata_element> m_migrate_recvbuf; //!< Buffer for particles that are received
+
+    //! Determine the neighboring ranks from the domain bounds
+    void findNeighbors();
+
+    //! Check that the domains are wide enough and that the system is supported
+    void checkDomains();
+
+    //! Send the packed values of the ghosts to the neighbors and receive theirs
+    template<class T>
+    void exchangeGhostField(const T* send, T* recv, unsigned int width, int tag);
+    };
+
+//! Export CommunicatorRCB class to python
+void export_CommunicatorRCB(pybind11::module& m);
+
+#endif // ENABLE_MPI
+#endif // __COMMUNICATOR_RCB_H__
@@ -33,7 +33,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          unsigned int ny,
                                          unsigned int nz,
                                          bool twolevel)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_layout(grid)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -62,7 +62,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          const std::vector<Scalar>& fxs,
                                          const std::vector<Scalar>& fys,
                                          const std::vector<Scalar>& fzs)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_layout(grid)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -104,6 +104,85 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
     initializeCumulativeFractions(try_fxs, try_fys, try_fzs);
     }
 
+/*!
+ * \param exec_conf The execution configuration
+ * \param L Box lengths of global box to sub-divide
+ * \param layout Layout of the domains
+ *
+ * The grid layout is the default grid with uniform cuts. The recursive coordinate bisection starts
+ * with cuts that divide the volume of the box in proportion to the number of ranks on either side.
+ */
+DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                         Scalar3 L,
+                                         layoutMode layout)
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_layout(layout)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
+
+    if (m_layout == grid)
+        {
+        initializeDomainGrid(L, 0, 0, 0, false);
+
+        std::vector<Scalar> cur_fxs(m_nx - 1, Scalar(1.0) / Scalar(m_nx));
+        std::vector<Scalar> cur_fys(m_ny - 1, Scalar(1.0) / Scalar(m_ny));
+        std::vector<Scalar> cur_fzs(m_nz - 1, Scalar(1.0) / Scalar(m_nz));
+        initializeCumulativeFractions(cur_fxs, cur_fys, cur_fzs);
+        return;
+        }
+
+    unsigned int nranks = m_exec_conf->getNRanks();
+
+    // the grid consists of a single domain that covers the box
+    m_nx = m_ny = m_nz = 1;
+    m_index = Index3D(1, 1, 1);
+    m_grid_pos = make_uint3(0, 0, 0);
+    m_max_n_node = 0;
+    m_twolevel = false;
+
+    GlobalArray<unsigned int> cart_ranks(nranks, m_exec_conf);
+    m_cart_ranks.swap(cart_ranks);
+
+    GlobalArray<unsigned int> cart_ranks_inv(nranks, m_exec_conf);
+    m_cart_ranks_inv.swap(cart_ranks_inv);
+
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_cart_ranks,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> h_cart_ranks_inv(m_cart_ranks_inv,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        for (unsigned int i = 0; i < nranks; ++i)
+            {
+            h_cart_ranks.data[i] = i;
+            h_cart_ranks_inv.data[i] = i;
+            }
+        }
+
+    initializeCumulativeFractions(std::vector<Scalar>(),
+                                  std::vector<Scalar>(),
+                                  std::vector<Scalar>());
+
+    // build the tree on the root so that all ranks agree on the topology
+    m_rcb_nodes.reserve(2 * nranks - 1);
+    if (m_exec_conf->getRank() == 0)
+        buildRCBTree(L, make_scalar3(0, 0, 0), make_scalar3(1, 1, 1), 0, nranks);
+    else
+        m_rcb_nodes.resize(2 * nranks - 1);
+    MPI_Bcast(&m_rcb_nodes[0],
+              int(m_rcb_nodes.size() * sizeof(rcb_node)),
+              MPI_BYTE,
+              0,
+              m_mpi_comm);
+
+    m_domain_lo.resize(nranks);
+    m_domain_hi.resize(nranks);
+    computeRCBDomains(0, make_scalar3(0, 0, 0), make_scalar3(1, 1, 1));
+
+    m_exec_conf->msg->notice(1) << "HOOMD-blue is using domain decomposition: " << nranks
+                                << " domains by recursive coordinate bisection." << std::endl;
+    }
+
 /*!
  * \param L Box lengths of global box to sub-divide
  * \param nx Requested number of domains along the x direction (0 == choose default)
@@ -587,6 +666,22 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim& global_box)
     BoxDim box = global_box;
     Scalar3 L = global_box.getL();
 
+    if (m_layout == rcb)
+        {
+        const Scalar3 lo_frac = m_domain_lo[m_exec_conf->getRank()];
+        const Scalar3 hi_frac = m_domain_hi[m_exec_conf->getRank()];
+
+        // we are periodic in a direction along which the domain spans the whole box
+        uchar3 periodic
+            = make_uchar3(lo_frac.x == Scalar(0.0) && hi_frac.x == Scalar(1.0) ? 1 : 0,
+                          lo_frac.y == Scalar(0.0) && hi_frac.y == Scalar(1.0) ? 1 : 0,
+                          lo_frac.z == Scalar(0.0) && hi_frac.z == Scalar(1.0) ? 1 : 0);
+
+        box.setLoHi(global_box.getLo() + lo_frac * L, global_box.getLo() + hi_frac * L);
+        box.setPeriodic(periodic);
+        return box;
+        }
+
     // position of this domain in the grid
     Scalar3 lo_cum_frac = make_scalar3(m_cum_frac_x[m_grid_pos.x],
                                        m_cum_frac_y[m_grid_pos.y],
@@ -641,6 +736,19 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
         throw std::runtime_error("Error placing particle");
         }
 
+    if (m_layout == rcb)
+        {
+        // descend the bisection tree, particles slightly outside the box go to the nearest domain
+        unsigned int node = 0;
+        while (m_rcb_nodes[node].n > 1)
+            {
+            const rcb_node& cur = m_rcb_nodes[node];
+            const Scalar f_dim = (cur.dim == 0) ? f.x : ((cur.dim == 1) ? f.y : f.z);
+            node = (f_dim < cur.cut) ? cur.left : cur.right;
+            }
+        return m_rcb_nodes[node].first;
+        }
+
     // compute the box the particle should be placed into
     // use the lower_bound (the first element that does not compare last < the search term)
     // then, the domain to place into is it-1 (since we want to place into the one that it actually
@@ -676,6 +784,132 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
     return rank;
     }
 
+/*!
+ * \param cuts Cumulative fraction of the global box at the cut of every node of the bisection tree
+ * \param root Rank to broadcast the cuts from
+ *
+ * The entries of \a cuts that correspond to leaf nodes are ignored.
+ *
+ * \note Setting the cuts is a collective call requiring all ranks to participate in order to keep
+ * the decomposition properly synchronized between ranks.
+ */
+void DomainDecomposition::setRCBCuts(const std::vector<Scalar>& cuts, unsigned int root)
+    {
+    bool valid = (m_layout == rcb && cuts.size() == m_rcb_nodes.size());
+    bcast(valid, root, m_mpi_comm);
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "comm: invalid cuts for recursive coordinate bisection"
+                                  << std::endl;
+        throw std::runtime_error("comm: invalid cuts for recursive coordinate bisection");
+        }
+
+    std::vector<Scalar> new_cuts(m_rcb_nodes.size());
+    if (m_exec_conf->getRank() == root)
+        new_cuts = cuts;
+    MPI_Bcast(&new_cuts[0], int(new_cuts.size()), MPI_HOOMD_SCALAR, root, m_mpi_comm);
+
+    for (unsigned int i = 0; i < m_rcb_nodes.size(); ++i)
+        {
+        if (m_rcb_nodes[i].n > 1)
+            m_rcb_nodes[i].cut = new_cuts[i];
+        }
+
+    computeRCBDomains(0, make_scalar3(0, 0, 0), make_scalar3(1, 1, 1));
+    }
+
+//! Get a component of a vector
+static inline Scalar& component(Scalar3& v, unsigned int dim)
+    {
+    return (dim == 0) ? v.x : ((dim == 1) ? v.y : v.z);
+    }
+
+/*!
+ * \param L Box lengths of global box
+ * \param lo Lower corner of the part of the box (fractions)
+ * \param hi Upper corner of the part of the box (fractions)
+ * \param first First rank in the part
+ * \param n Number of ranks in the part
+ * \returns The index of the node
+ *
+ * The part is cut along its longest dimension so that the volume on either side is proportional to
+ * the number of ranks on that side.
+ */
+unsigned int DomainDecomposition::buildRCBTree(Scalar3 L,
+                                               Scalar3 lo,
+                                               Scalar3 hi,
+                                               unsigned int first,
+                                               unsigned int n)
+    {
+    unsigned int idx = (unsigned int)m_rcb_nodes.size();
+    rcb_node node;
+    node.first = first;
+    node.n = n;
+    node.dim = 0;
+    node.cut = Scalar(0.0);
+    node.left = node.right = idx;
+    m_rcb_nodes.push_back(node);
+
+    if (n == 1)
+        return idx;
+
+    // cut the longest dimension, but never z in 2D
+    Scalar3 ext = (hi - lo) * L;
+    unsigned int dim = 0;
+    if (ext.y > ext.x)
+        dim = 1;
+    if (L.z > Scalar(0.0) && ext.z > component(ext, dim))
+        dim = 2;
+
+    unsigned int n_left = n / 2;
+    Scalar cut = component(lo, dim)
+                 + (component(hi, dim) - component(lo, dim)) * Scalar(n_left) / Scalar(n);
+
+    Scalar3 hi_left = hi;
+    component(hi_left, dim) = cut;
+    Scalar3 lo_right = lo;
+    component(lo_right, dim) = cut;
+
+    unsigned int left = buildRCBTree(L, lo, hi_left, first, n_left);
+    unsigned int right = buildRCBTree(L, lo_right, hi, first + n_left, n - n_left);
+
+    m_rcb_nodes[idx].dim = dim;
+    m_rcb_nodes[idx].cut = cut;
+    m_rcb_nodes[idx].left = left;
+    m_rcb_nodes[idx].right = right;
+    return idx;
+    }
+
+/*!
+ * \param node Index of the node
+ * \param lo Lower corner of the node (fractions)
+ * \param hi Upper corner of the node (fractions)
+ */
+void DomainDecomposition::computeRCBDomains(unsigned int node, Scalar3 lo, Scalar3 hi)
+    {
+    const rcb_node& cur = m_rcb_nodes[node];
+    if (cur.n == 1)
+        {
+        m_domain_lo[cur.first] = lo;
+        m_domain_hi[cur.first] = hi;
+        return;
+        }
+
+    if (!(cur.cut > component(lo, cur.dim) && cur.cut < component(hi, cur.dim)))
+        {
+        m_exec_conf->msg->error() << "comm: bisection cut lies outside of its domain" << std::endl;
+        throw std::runtime_error("comm: invalid cuts for recursive coordinate bisection");
+        }
+
+    Scalar3 hi_left = hi;
+    component(hi_left, cur.dim) = cur.cut;
+    Scalar3 lo_right = lo;
+    component(lo_right, cur.dim) = cur.cut;
+
+    computeRCBDomains(cur.left, lo, hi_left);
+    computeRCBDomains(cur.right, lo_right, hi);
+    }
+
 void DomainDecomposition::findCommonNodes()
     {
     // get MPI node name
@@ -729,7 +963,10 @@ void DomainDecomposition::initializeTwoLevel()
 //! Export DomainDecomposition class to python
 void export_DomainDecomposition(py::module& m)
     {
-    py::class_<DomainDecomposition, std::shared_ptr<DomainDecomposition>>(m, "DomainDecomposition")
+    py::class_<DomainDecomposition, std::shared_ptr<DomainDecomposition>> decomposition(
+        m,
+        "DomainDecomposition");
+    decomposition
         .def(py::init<std::shared_ptr<ExecutionConfiguration>,
                       Scalar3,
                       unsigned int,
@@ -741,6 +978,15 @@ void export_DomainDecomposition(py::module& m)
                       const std::vector<Scalar>&,
                       const std::vector<Scalar>&,
                       const std::vector<Scalar>&>())
-        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions);
+        .def(py::init<std::shared_ptr<ExecutionConfiguration>,
+                      Scalar3,
+                      DomainDecomposition::layoutMode>())
+        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+        .def("isRCB", &DomainDecomposition::isRCB);
+
+    py::enum_<DomainDecomposition::layoutMode>(decomposition, "layoutMode")
+        .value("grid", DomainDecomposition::grid)
+        .value("rcb", DomainDecomposition::rcb)
+        .export_values();
     }
 #endif // ENABLE_MPI
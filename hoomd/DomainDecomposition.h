@@ -45,11 +45,40 @@
  * behavior is reverted to the normal default with uniform cuts along each dimension.
  *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
+ *
+ *  <b>Recursive coordinate bisection</b>
+ *
+ *  In a grid, every cut plane spans the whole box, so a dense region constrains all domains in the
+ * slab that contains it. With the rcb layout, the box is instead cut recursively into two parts
+ * with (nearly) equal numbers of ranks, along the longest dimension of each part. Every cut only
+ * spans the part of the box that it divides, and the LoadBalancer can move it independently of all
+ * other cuts. The cuts form a binary tree (rcb_node) with one leaf per rank, and all ranks hold the
+ * full tree and the boxes of all domains. The grid accessors describe a single domain in this
+ * layout; use getDomainLo() and getDomainHi() instead. CommunicatorRCB implements the particle
+ * migration and ghost exchange for this layout.
  */
 class PYBIND11_EXPORT DomainDecomposition
     {
 #ifdef ENABLE_MPI
     public:
+    //! Layouts of the domains
+    enum layoutMode
+        {
+        grid, //!< Rectilinear grid of domains
+        rcb   //!< Recursive coordinate bisection
+        };
+
+    //! A node of the recursive coordinate bisection tree
+    struct rcb_node
+        {
+        unsigned int first; //!< First rank in the node
+        unsigned int n;     //!< Number of ranks in the node (1 for a leaf)
+        unsigned int dim;   //!< Dimension of the cut (0=x, 1=y, 2=z)
+        Scalar cut;         //!< Cumulative fraction of the global box at the cut
+        unsigned int left;  //!< Index of the child node below the cut
+        unsigned int right; //!< Index of the child node above the cut
+        };
+
     //! Constructor
     /*! \param exec_conf The execution configuration
      * \param L Box lengths of global box to sub-divide
@@ -72,9 +101,49 @@ class PYBIND11_EXPORT DomainDecomposition
                         const std::vector<Scalar>& fys,
                         const std::vector<Scalar>& fzs);
 
+    //! Constructor for a given layout
+    DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                        Scalar3 L,
+                        layoutMode layout);
+
     //! Calculate MPI ranks of neighboring domain.
     unsigned int getNeighborRank(unsigned int dir) const;
 
+    //! Get the layout of the domains
+    layoutMode getLayout() const
+        {
+        return m_layout;
+        }
+
+    //! Returns true if the domains are a recursive coordinate bisection of the box
+    bool isRCB() const
+        {
+        return m_layout == rcb;
+        }
+
+    //! Get the nodes of the bisection tree (the root is node 0)
+    const std::vector<rcb_node>& getRCBNodes() const
+        {
+        return m_rcb_nodes;
+        }
+
+    //! Collectively set the cuts of the bisection tree from a given rank
+    void setRCBCuts(const std::vector<Scalar>& cuts, unsigned int root);
+
+    //! Get the lower corner of the domain of a rank as a fraction of the global box
+    Scalar3 getDomainLo(unsigned int rank) const
+        {
+        assert(rank < m_domain_lo.size());
+        return m_domain_lo[rank];
+        }
+
+    //! Get the upper corner of the domain of a rank as a fraction of the global box
+    Scalar3 getDomainHi(unsigned int rank) const
+        {
+        assert(rank < m_domain_hi.size());
+        return m_domain_hi[rank];
+        }
+
     //! Get domain indexer
     const Index3D& getDomainIndexer() const
         {
@@ -230,7 +299,22 @@ class PYBIND11_EXPORT DomainDecomposition
     std::vector<Scalar> m_cum_frac_x; //!< Cumulative fractions in x below cut plane index
     std::vector<Scalar> m_cum_frac_y; //!< Cumulative fractions in y below cut plane index
     std::vector<Scalar> m_cum_frac_z; //!< Cumulative fractions in z below cut plane index
-#endif                                // ENABLE_MPI
+
+    layoutMode m_layout;               //!< Layout of the domains
+    std::vector<rcb_node> m_rcb_nodes; //!< Nodes of the bisection tree
+    std::vector<Scalar3> m_domain_lo;  //!< Lower corner of the domain of every rank (fractions)
+    std::vector<Scalar3> m_domain_hi;  //!< Upper corner of the domain of every rank (fractions)
+
+    //! Helper method to build the bisection tree of a part of the box
+    unsigned int buildRCBTree(Scalar3 L,
+                              Scalar3 lo,
+                              Scalar3 hi,
+                              unsigned int first,
+                              unsigned int n);
+
+    //! Helper method to compute the domain of every rank from the cuts
+    void computeRCBDomains(unsigned int node, Scalar3 lo, Scalar3 hi);
+#endif // ENABLE_MPI
     };
 
 #ifdef ENABLE_MPI
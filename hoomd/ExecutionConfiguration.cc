@@ -5,6 +5,7 @@
 
 #include "ExecutionConfiguration.h"
 #include "HOOMDVersion.h"
+#include "HostArena.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -20,8 +21,12 @@
 namespace py = pybind11;
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
@@ -32,12 +37,113 @@ using namespace std;
 #include "CachedAllocator.h"
 #endif
 
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(ENABLE_TBB) && defined(__linux__)
+#include <sched.h>
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 /*! \file ExecutionConfiguration.cc
     \brief Defines ExecutionConfiguration and related classes
 */
 
 // initialize static variables
 bool ExecutionConfiguration::s_gpu_scan_complete = false;
+
+//! Host buffers smaller than this are placed, cleared, and copied by the calling thread
+const size_t numa_min_bytes = 1 << 20;
+
+#ifdef ENABLE_TBB
+//! Pins the worker threads of a task arena to CPUs
+/*! When a worker thread joins the arena, it is pinned to one CPU chosen by its slot in the arena.
+    The threads that call into the arena are not pinned and keep the affinity of the process.
+
+    TBB shares its worker threads between arenas. A worker gets the affinity mask of the process
+    back when it leaves the arena, and the destructor restores the mask of the workers that are
+    still in the arena, so that no thread stays pinned after pinning is disabled or the arena is
+    replaced.
+*/
+class ThreadPinningObserver : public tbb::task_scheduler_observer
+    {
+    public:
+    //! Constructor
+    /*! \param arena Arena whose worker threads are pinned
+        \param cpus CPUs to pin the threads to
+    */
+    ThreadPinningObserver(tbb::task_arena& arena, const std::vector<unsigned int>& cpus)
+        : tbb::task_scheduler_observer(arena), m_cpus(cpus)
+        {
+#ifdef __linux__
+        // the calling thread is never pinned, it has the affinity mask of the process
+        CPU_ZERO(&m_process_cpu_set);
+        if (sched_getaffinity(0, sizeof(m_process_cpu_set), &m_process_cpu_set) != 0)
+            m_cpus.clear();
+#endif
+        observe(true);
+        }
+
+    virtual ~ThreadPinningObserver()
+        {
+        observe(false);
+
+#ifdef __linux__
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (pid_t tid : m_pinned_threads)
+            sched_setaffinity(tid, sizeof(m_process_cpu_set), &m_process_cpu_set);
+#endif
+        }
+
+    //! Pin a worker thread when it joins the arena
+    virtual void on_scheduler_entry(bool is_worker)
+        {
+#ifdef __linux__
+        int slot = tbb::this_task_arena::current_thread_index();
+        if (!is_worker || slot < 0 || m_cpus.size() == 0)
+            return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(m_cpus[slot % m_cpus.size()], &cpu_set);
+        sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pinned_threads.insert((pid_t)syscall(SYS_gettid));
+#endif
+        }
+
+    //! Restore the affinity mask of the process when a worker thread leaves the arena
+    virtual void on_scheduler_exit(bool is_worker)
+        {
+#ifdef __linux__
+        if (!is_worker || m_cpus.size() == 0)
+            return;
+
+        sched_setaffinity(0, sizeof(m_process_cpu_set), &m_process_cpu_set);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pinned_threads.erase((pid_t)syscall(SYS_gettid));
+#endif
+        }
+
+    private:
+    std::vector<unsigned int> m_cpus; //!< CPUs to pin the threads to
+#ifdef __linux__
+    cpu_set_t m_process_cpu_set;      //!< Affinity mask of the process
+    std::set<pid_t> m_pinned_threads; //!< Worker threads that are currently pinned
+    std::mutex m_mutex;               //!< Protects m_pinned_threads
+#endif
+    };
+#endif
 std::vector<std::string> ExecutionConfiguration::s_gpu_scan_messages;
 std::vector<int> ExecutionConfiguration::s_capable_gpu_ids;
 std::vector<std::string> ExecutionConfiguration::s_capable_gpu_descriptions;
@@ -77,6 +183,21 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
     msg->notice(5) << "Constructing ExecutionConfiguration: ( " << s.str() << ") " << endl;
     exec_mode = mode;
 
+    m_host_arena = std::unique_ptr<HostArena>(new HostArena());
+
+#ifdef __linux__
+    // query the NUMA nodes the process may allocate memory on, for the interleave policy
+    m_numa_nodes.resize(1024 / (8 * sizeof(unsigned long)), 0);
+    if (syscall(SYS_get_mempolicy,
+                nullptr,
+                m_numa_nodes.data(),
+                m_numa_nodes.size() * 8 * sizeof(unsigned long),
+                nullptr,
+                MPOL_F_MEMS_ALLOWED)
+        != 0)
+        m_numa_nodes.clear();
+#endif
+
 #if defined(ENABLE_HIP)
     // scan the available GPUs
     scanGPUs();
@@ -213,6 +334,41 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
 #ifdef ENABLE_TBB
     unsigned int num_threads = std::thread::hardware_concurrency();
 
+#ifdef __linux__
+    // The MPI launcher may bind every rank to a subset of the CPUs, e.g. one socket per rank in
+    // hybrid MPI and thread execution. Size the thread team of the rank to these CPUs.
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+        {
+        for (unsigned int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+            if (CPU_ISSET(cpu, &cpu_set))
+                m_cpus.push_back(cpu);
+            }
+        }
+
+    if (m_cpus.size() > 0)
+        num_threads = (unsigned int)m_cpus.size();
+#endif
+
+#ifdef ENABLE_MPI
+    // Ranks that the launcher did not bind share all CPUs of the node. Split the CPUs between the
+    // ranks on the node so that they do not oversubscribe it.
+    MPI_Comm node_comm;
+    int ranks_per_node = 1;
+    MPI_Comm_split_type(m_mpi_config->getHOOMDWorldCommunicator(),
+                        MPI_COMM_TYPE_SHARED,
+                        0,
+                        MPI_INFO_NULL,
+                        &node_comm);
+    MPI_Comm_size(node_comm, &ranks_per_node);
+    MPI_Comm_free(&node_comm);
+
+    if (ranks_per_node > 1 && num_threads >= std::thread::hardware_concurrency())
+        num_threads = std::max(1u, num_threads / (unsigned int)ranks_per_node);
+#endif
+
     char* env;
     if ((env = getenv("OMP_NUM_THREADS")) != NULL)
         {
@@ -253,6 +409,138 @@ ExecutionConfiguration::~ExecutionConfiguration()
 #endif
     }
 
+#ifdef ENABLE_TBB
+/*! \param num_threads Number of threads in the task arena
+ */
+void ExecutionConfiguration::setNumThreads(unsigned int num_threads)
+    {
+    // the observer must not outlive the arena it observes
+    m_thread_pinning.reset();
+    m_task_arena = std::make_shared<tbb::task_arena>(num_threads);
+    m_num_threads = num_threads;
+
+    if (m_pin_threads)
+        m_thread_pinning = std::make_shared<ThreadPinningObserver>(*m_task_arena, m_cpus);
+    }
+
+/*! \param pin_threads true to pin the worker threads
+ */
+void ExecutionConfiguration::setPinThreads(bool pin_threads)
+    {
+#ifndef __linux__
+    if (pin_threads)
+        {
+        msg->error() << "Pinning threads is only supported on Linux." << endl;
+        throw runtime_error("Error setting thread pinning.");
+        }
+#endif
+
+    m_pin_threads = pin_threads;
+    m_thread_pinning.reset();
+    if (m_pin_threads && m_task_arena)
+        m_thread_pinning = std::make_shared<ThreadPinningObserver>(*m_task_arena, m_cpus);
+    }
+#endif
+
+/*! \param policy The memory policy
+ */
+void ExecutionConfiguration::setMemoryPolicy(memoryPolicy policy)
+    {
+    if (policy == interleave && m_numa_nodes.size() == 0)
+        {
+        msg->error() << "Interleaving memory across NUMA nodes is not supported on this system."
+                     << endl;
+        throw runtime_error("Error setting memory policy.");
+        }
+
+    m_memory_policy = policy;
+    }
+
+/*! \param ptr Start of the buffer
+    \param bytes Size of the buffer in bytes
+
+    With the interleave policy, bind the whole pages inside the buffer to all allowed nodes in
+    turn. The kernel places the pages when they are first touched.
+*/
+void ExecutionConfiguration::placeHostMemory(void* ptr, size_t bytes) const
+    {
+#ifdef __linux__
+    if (m_memory_policy != interleave || bytes < numa_min_bytes)
+        return;
+
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = ((uintptr_t)ptr + page_size - 1) / page_size * page_size;
+    uintptr_t end = ((uintptr_t)ptr + bytes) / page_size * page_size;
+    if (end <= begin)
+        return;
+
+    // the placement is a hint, memory is still usable if mbind fails
+    if (syscall(SYS_mbind,
+                (void*)begin,
+                (unsigned long)(end - begin),
+                MPOL_INTERLEAVE,
+                m_numa_nodes.data(),
+                m_numa_nodes.size() * 8 * sizeof(unsigned long),
+                0)
+        != 0)
+        msg->notice(7) << "Failed to interleave host memory across NUMA nodes" << endl;
+#endif
+    }
+
+/*! \param ptr Start of the buffer
+    \param bytes Size of the buffer in bytes
+*/
+void ExecutionConfiguration::clearHostMemory(void* ptr, size_t bytes) const
+    {
+#ifdef ENABLE_TBB
+    if (m_memory_policy == first_touch && bytes >= numa_min_bytes)
+        {
+        // contiguous blocks, one per thread, split like the static partition of the pair force and
+        // neighbor list loops
+        char* data = (char*)ptr;
+        m_task_arena->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, bytes),
+                    [&](const tbb::blocked_range<size_t>& r)
+                    { memset(data + r.begin(), 0, r.size()); },
+                    tbb::static_partitioner());
+            });
+        return;
+        }
+#endif
+
+    memset(ptr, 0, bytes);
+    }
+
+/*! \param dest Destination buffer
+    \param src Source buffer
+    \param bytes Number of bytes to copy
+*/
+void ExecutionConfiguration::copyHostMemory(void* dest, const void* src, size_t bytes) const
+    {
+#ifdef ENABLE_TBB
+    if (m_memory_policy == first_touch && bytes >= numa_min_bytes)
+        {
+        char* dest_data = (char*)dest;
+        const char* src_data = (const char*)src;
+        m_task_arena->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<size_t>(0, bytes),
+                    [&](const tbb::blocked_range<size_t>& r)
+                    { memcpy(dest_data + r.begin(), src_data + r.begin(), r.size()); },
+                    tbb::static_partitioner());
+            });
+        return;
+        }
+#endif
+
+    memcpy(dest, src, bytes);
+    }
+
 #if defined(ENABLE_HIP)
 
 std::pair<unsigned int, unsigned int>
@@ -680,18 +968,38 @@ void export_ExecutionConfiguration(py::module& m)
         .def("getRank", &ExecutionConfiguration::getRank)
 #ifdef ENABLE_TBB
         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
+        .def("setPinThreads", &ExecutionConfiguration::setPinThreads)
+        .def("getPinThreads", &ExecutionConfiguration::getPinThreads)
 #endif
+        .def("setMemoryPolicy", &ExecutionConfiguration::setMemoryPolicy)
+        .def("getMemoryPolicy", &ExecutionConfiguration::getMemoryPolicy)
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
-        .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
+        .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices)
+        .def("getHostArena",
+             &ExecutionConfiguration::getHostArena,
+             py::return_value_policy::reference_internal);
 
     py::enum_<ExecutionConfiguration::executionMode>(executionconfiguration, "executionMode")
         .value("GPU", ExecutionConfiguration::executionMode::GPU)
         .value("CPU", ExecutionConfiguration::executionMode::CPU)
         .value("AUTO", ExecutionConfiguration::executionMode::AUTO)
         .export_values();
+
+    py::enum_<ExecutionConfiguration::memoryPolicy>(executionconfiguration, "memoryPolicy")
+        .value("local", ExecutionConfiguration::memoryPolicy::local)
+        .value("first_touch", ExecutionConfiguration::memoryPolicy::first_touch)
+        .value("interleave", ExecutionConfiguration::memoryPolicy::interleave)
+        .export_values();
+
+    py::class_<HostArena>(m, "HostArena")
+        .def("getBytesInUse", &HostArena::getBytesInUse)
+        .def("getPeakBytes", &HostArena::getPeakBytes)
+        .def("getCapacity", &HostArena::getCapacity)
+        .def("getNumAllocations", &HostArena::getNumAllocations)
+        .def("getNumSystemAllocations", &HostArena::getNumSystemAllocations);
     }
@@ -30,6 +30,7 @@
 
 #ifdef ENABLE_TBB
 #include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
 #endif
 
 #include "MemoryTraceback.h"
@@ -51,6 +52,9 @@
 class CachedAllocator;
 #endif
 
+//! Forward declaration
+class HostArena;
+
 //! Defines the execution configuration for the simulation
 /*! \ingroup data_structs
     ExecutionConfiguration is a data structure needed to support the hybrid CPU/GPU code. It
@@ -80,6 +84,14 @@ class PYBIND11_EXPORT ExecutionConfiguration
         AUTO, //!< Auto select between GPU and CPU
         };
 
+    //! Placement of the host memory of large arrays on the NUMA nodes
+    enum memoryPolicy
+        {
+        local,       //!< Place pages on the node of the thread that allocates the array
+        first_touch, //!< Clear arrays with all threads, each page is placed on its thread's node
+        interleave,  //!< Interleave pages across all nodes the process may use
+        };
+
     //! Constructor
     ExecutionConfiguration(executionMode mode = AUTO,
                            std::vector<int> gpu_id = std::vector<int>(),
@@ -263,10 +275,23 @@ class PYBIND11_EXPORT ExecutionConfiguration
 
 #ifdef ENABLE_TBB
     //! set number of TBB threads
-    void setNumThreads(unsigned int num_threads)
+    void setNumThreads(unsigned int num_threads);
+
+    //! Set whether the TBB worker threads are pinned to CPUs
+    /*! \param pin_threads true to pin the worker threads
+
+        Every worker thread is pinned to one of the CPUs in the affinity mask the process had when
+        the ExecutionConfiguration was constructed. In hybrid MPI and thread execution, bind every
+        rank to one socket (or NUMA domain) with the MPI launcher: the threads of the rank then stay
+        on that socket and keep accessing the memory they first touched. Pinning is only available
+        on Linux.
+    */
+    void setPinThreads(bool pin_threads);
+
+    //! Get whether the TBB worker threads are pinned to CPUs
+    bool getPinThreads() const
         {
-        m_task_arena = std::make_shared<tbb::task_arena>(num_threads);
-        m_num_threads = num_threads;
+        return m_pin_threads;
         }
 
     std::shared_ptr<tbb::task_arena> getTaskArena() const
@@ -301,6 +326,12 @@ class PYBIND11_EXPORT ExecutionConfiguration
         }
 #endif
 
+    //! Returns the arena for temporary host memory that lives until the end of the time step
+    HostArena& getHostArena() const
+        {
+        return *m_host_arena;
+        }
+
     //! Set up memory tracing
     void setMemoryTracing(bool enable)
         {
@@ -321,6 +352,36 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get() != nullptr;
         }
 
+    //! Set the placement policy for the host memory of large arrays
+    /*! \param policy The memory policy
+
+        The policy applies to arrays allocated after it is set. With first_touch, the threads of
+        the task arena clear (and copy) large arrays in contiguous blocks with a static partition.
+        The pair force and binned neighbor list loops split the particles with the same static
+        partition, so each thread touches the pages it works on there first. The blocks line up
+        exactly when an array holds no spare capacity beyond the local particles. Other threaded
+        loops balance their work dynamically and do not follow the placement. Pin the threads (see
+        setPinThreads()) so that they stay on the nodes of these pages. interleave spreads the
+        pages evenly across the nodes, which balances the memory bandwidth of all nodes when the
+        access pattern is not known. interleave is only available on Linux.
+    */
+    void setMemoryPolicy(memoryPolicy policy);
+
+    //! Get the placement policy for the host memory of large arrays
+    memoryPolicy getMemoryPolicy() const
+        {
+        return m_memory_policy;
+        }
+
+    //! Apply the memory policy to a newly allocated host buffer before it is touched
+    void placeHostMemory(void* ptr, size_t bytes) const;
+
+    //! Zero a host buffer following the memory policy
+    void clearHostMemory(void* ptr, size_t bytes) const;
+
+    //! Copy a host buffer following the memory policy
+    void copyHostMemory(void* dest, const void* src, size_t bytes) const;
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -418,11 +479,21 @@ class PYBIND11_EXPORT ExecutionConfiguration
         m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
 #endif
 
+    std::unique_ptr<HostArena> m_host_arena; //!< Arena for temporary host memory
+
 #ifdef ENABLE_TBB
     std::shared_ptr<tbb::task_arena> m_task_arena; //!< The TBB task arena
     unsigned int m_num_threads;                    //!<  The number of TBB threads used
+    bool m_pin_threads = false;                    //!< True if the worker threads are pinned
+    std::vector<unsigned int> m_cpus;              //!< CPUs in the affinity mask of the process
+
+    //! Pins the worker threads of the task arena, destroyed before the arena
+    std::shared_ptr<tbb::task_scheduler_observer> m_thread_pinning;
 #endif
 
+    memoryPolicy m_memory_policy = local;    //!< Placement of large host arrays
+    std::vector<unsigned long> m_numa_nodes; //!< Mask of the NUMA nodes the process may use
+
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
 
@@ -14,6 +14,7 @@
 #endif
 
 #include <iostream>
+#include <limits>
 using namespace std;
 
 #include <pybind11/numpy.h>
@@ -28,7 +29,7 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-    : Compute(sysdef), m_particles_sorted(false)
+    : Compute(sysdef), m_particles_sorted(false), m_energy_skipped(false)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -126,6 +127,16 @@ void ForceCompute::reallocate()
     updateGPUAdvice();
     }
 
+/*! \post m_force and m_virial are zero on the host
+ */
+void ForceCompute::zeroForces()
+    {
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    }
+
 void ForceCompute::updateGPUAdvice()
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
@@ -204,9 +215,15 @@ ForceCompute::~ForceCompute()
     }
 
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
+    Returns NaN when the last call to compute() skipped the potential energy.
  */
 Scalar ForceCompute::calcEnergySum()
     {
+    if (m_energy_skipped)
+        {
+        return std::numeric_limits<Scalar>::quiet_NaN();
+        }
+
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
     double pe_total = 0.0;
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
@@ -323,6 +340,11 @@ std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup>
 
 pybind11::object ForceCompute::getEnergiesPython()
     {
+    if (m_energy_skipped)
+        {
+        return pybind11::none();
+        }
+
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
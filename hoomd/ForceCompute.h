@@ -176,6 +176,28 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         return false;
         }
 
+    //! Returns true if this ForceCompute can add its forces to arrays it does not own
+    /*! Force computes that return true implement accumulateForces(). The integrator then adds
+        their forces directly to the net force, and their own arrays are only filled when compute()
+        is called on them (e.g. to log their energy).
+    */
+    virtual bool supportsAccumulation()
+        {
+        return false;
+        }
+
+    //! Add the forces, energies, and virials to the given arrays
+    /*! \param timestep Current time step
+        \param force Per-particle force and energy array to add to
+        \param virial Per-particle virial array to add to
+    */
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial)
+        {
+        throw std::runtime_error("This force compute does not support accumulation");
+        }
+
     protected:
     bool m_particles_sorted; //!< Flag set to true when particles are resorted in memory
 
@@ -193,6 +215,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Reallocate internal arrays
     void reallocate();
 
+    //! Zero the force and virial arrays
+    void zeroForces();
+
     //! Update GPU memory hints
     void updateGPUAdvice();
 
@@ -217,6 +242,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// True when the last computation left the potential energy out of m_force
+    bool m_energy_skipped;
+
     //! Actually perform the computation of the forces
     /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
         the base class compute() when the forces need to be computed.
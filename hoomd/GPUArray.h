@@ -981,6 +981,10 @@ template<class T> void GPUArray<T>::allocate()
         throw std::runtime_error("Error allocating GPUArray.");
         }
 
+    // place the pages on the NUMA nodes before they are touched
+    if (m_exec_conf)
+        m_exec_conf->placeHostMemory(host_ptr, m_num_elements * sizeof(T));
+
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
 
 #ifdef ENABLE_HIP
@@ -1045,8 +1049,12 @@ template<class T> void GPUArray<T>::memclear(size_t first)
     assert(h_data);
     assert(first < m_num_elements);
 
-    // clear memory
-    memset((void*)(h_data.get() + first), 0, sizeof(T) * (m_num_elements - first));
+    // clear memory, this touches the pages first
+    if (m_exec_conf)
+        m_exec_conf->clearHostMemory((void*)(h_data.get() + first),
+                                     sizeof(T) * (m_num_elements - first));
+    else
+        memset((void*)(h_data.get() + first), 0, sizeof(T) * (m_num_elements - first));
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1345,6 +1353,9 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         throw std::runtime_error("Error allocating GPUArray.");
         }
 
+    if (m_exec_conf)
+        m_exec_conf->placeHostMemory(h_tmp, num_elements * sizeof(T));
+
 #ifdef ENABLE_HIP
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
         {
@@ -1356,12 +1367,20 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         CHECK_CUDA_ERROR();
         }
 #endif
-    // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * num_elements);
-
-    // copy over data
+    // clear memory and copy over data
     size_t num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
-    memcpy((void*)h_tmp, (void*)h_data.get(), sizeof(T) * num_copy_elements);
+    if (m_exec_conf)
+        {
+        m_exec_conf->clearHostMemory((void*)h_tmp, sizeof(T) * num_elements);
+        m_exec_conf->copyHostMemory((void*)h_tmp,
+                                    (void*)h_data.get(),
+                                    sizeof(T) * num_copy_elements);
+        }
+    else
+        {
+        memset((void*)h_tmp, 0, sizeof(T) * num_elements);
+        memcpy((void*)h_tmp, (void*)h_data.get(), sizeof(T) * num_copy_elements);
+        }
 
     // update smart pointer
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
@@ -1411,6 +1430,9 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
         throw std::runtime_error("Error allocating GPUArray.");
         }
 
+    if (m_exec_conf)
+        m_exec_conf->placeHostMemory(h_tmp, size);
+
 #ifdef ENABLE_HIP
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
         {
@@ -1422,7 +1444,10 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
 #endif
 
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * new_pitch * new_height);
+    if (m_exec_conf)
+        m_exec_conf->clearHostMemory((void*)h_tmp, size);
+    else
+        memset((void*)h_tmp, 0, size);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
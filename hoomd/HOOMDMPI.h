@@ -21,6 +21,8 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <vector>
 
@@ -485,5 +487,455 @@ template<typename T> void recv(T& val, const unsigned int src, const MPI_Comm mp
     delete[] buf;
     }
 
+//! Get the MPI datatype of a trivially copyable type
+/*! The datatype is a contiguous sequence of sizeof(T) bytes, committed on first use. All ranks must
+    share the same data layout, as they do for the particle data that the communicator sends as
+    MPI_BYTE.
+*/
+template<typename T> MPI_Datatype get_mpi_datatype()
+    {
+    static MPI_Datatype datatype = MPI_DATATYPE_NULL;
+    if (datatype == MPI_DATATYPE_NULL)
+        {
+        MPI_Type_contiguous((int)sizeof(T), MPI_BYTE, &datatype);
+        MPI_Type_commit(&datatype);
+        }
+    return datatype;
+    }
+
+//! Broadcast a vector of trivially copyable values without serializing it
+template<typename T>
+void bcast_vector(std::vector<T>& values, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    unsigned int n = (unsigned int)values.size();
+    MPI_Bcast(&n, 1, MPI_UNSIGNED, root, mpi_comm);
+    values.resize(n);
+    MPI_Bcast(values.data(), n, get_mpi_datatype<T>(), root, mpi_comm);
+    }
+
+//! Default size of the chunks that gather_chunked() and scatter_chunked() send to and from root
+const size_t mpi_chunk_bytes = 16 * 1024 * 1024;
+
+//! Communicators for a two level gather to, or scatter from, a root rank
+/*! The ranks on one node share a node communicator. Its rank 0, the node leader, is the root on the
+    root's node and the lowest rank on all other nodes. The node leaders share the leader
+    communicator, in which the root is rank 0. Data travels between the root and a node as a stream
+    of chunks that the node leader relays to and from the ranks on its node.
+
+    By default, a node holds the ranks that share memory. A positive \a ranks_per_node instead
+    places consecutive ranks of \a mpi_comm in groups of that size, which emulates several nodes on
+    one machine.
+*/
+class MPINodeHierarchy
+    {
+    public:
+    //! Constructor
+    /*! \param root Rank of the root in \a mpi_comm
+        \param mpi_comm Communicator to split
+        \param ranks_per_node Number of ranks on a node, 0 to split by shared memory
+    */
+    MPINodeHierarchy(unsigned int root, const MPI_Comm mpi_comm, int ranks_per_node = 0)
+        {
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        int key = (rank == (int)root) ? 0 : 1;
+
+        if (ranks_per_node > 0)
+            MPI_Comm_split(mpi_comm, rank / ranks_per_node, key, &m_node_comm);
+        else
+            MPI_Comm_split_type(mpi_comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &m_node_comm);
+        MPI_Comm_rank(m_node_comm, &m_node_rank);
+        MPI_Comm_size(m_node_comm, &m_node_size);
+
+        MPI_Comm_split(mpi_comm, m_node_rank == 0 ? 0 : MPI_UNDEFINED, key, &m_leader_comm);
+        m_n_leaders = 0;
+        if (m_leader_comm != MPI_COMM_NULL)
+            MPI_Comm_size(m_leader_comm, &m_n_leaders);
+        }
+
+    MPINodeHierarchy(const MPINodeHierarchy&) = delete;
+    MPINodeHierarchy& operator=(const MPINodeHierarchy&) = delete;
+
+    //! Destructor
+    ~MPINodeHierarchy()
+        {
+        if (m_leader_comm != MPI_COMM_NULL)
+            MPI_Comm_free(&m_leader_comm);
+        MPI_Comm_free(&m_node_comm);
+        }
+
+    MPI_Comm m_node_comm;   //!< Ranks on the same node
+    MPI_Comm m_leader_comm; //!< Node leaders, MPI_COMM_NULL on other ranks
+    int m_node_rank;        //!< Rank in the node communicator
+    int m_node_size;        //!< Number of ranks on the node
+    int m_n_leaders;        //!< Number of node leaders, 0 on other ranks
+    };
+
+//! Receive a sequence of pieces from a rank until \a count values have arrived
+template<typename T>
+void recv_pieces(T* out_values, unsigned int count, int src, const MPI_Comm mpi_comm)
+    {
+    MPI_Datatype datatype = get_mpi_datatype<T>();
+    unsigned int received = 0;
+    while (received < count)
+        {
+        MPI_Status status;
+        int n;
+        MPI_Recv(out_values + received,
+                 count - received,
+                 datatype,
+                 src,
+                 0,
+                 mpi_comm,
+                 &status);
+        MPI_Get_count(&status, datatype, &n);
+        received += n;
+        }
+    }
+
+//! Gather vectors of trivially copyable values to root in chunks of bounded size
+/*! \param in_values Values of this rank
+    \param consume Called on root as consume(const T* values, unsigned int n) for every chunk
+    \param root Rank that receives the values
+    \param mpi_comm Communicator
+    \param chunk_bytes Size of the chunks
+    \param ranks_per_node Number of ranks on a node, see MPINodeHierarchy
+
+    The values are not serialized and do not arrive in order of rank. Every node leader packs the
+    values of its node into chunks and sends them to root, so root holds one chunk at a time.
+*/
+template<typename T, typename Consumer>
+void gather_chunked(const std::vector<T>& in_values,
+                    Consumer consume,
+                    unsigned int root,
+                    const MPI_Comm mpi_comm,
+                    size_t chunk_bytes = mpi_chunk_bytes,
+                    int ranks_per_node = 0)
+    {
+    MPI_Datatype datatype = get_mpi_datatype<T>();
+    unsigned int chunk_size = (unsigned int)std::max(chunk_bytes / sizeof(T), size_t(1));
+    MPINodeHierarchy h(root, mpi_comm, ranks_per_node);
+
+    // the node leaders learn the number of values of every rank on their node
+    unsigned int count = (unsigned int)in_values.size();
+    std::vector<unsigned int> node_counts(h.m_node_size);
+    MPI_Gather(&count, 1, MPI_UNSIGNED, node_counts.data(), 1, MPI_UNSIGNED, 0, h.m_node_comm);
+
+    // every rank sends its values in pieces that fit into a chunk
+    if (h.m_node_rank != 0)
+        {
+        for (unsigned int offset = 0; offset < count; offset += chunk_size)
+            MPI_Send(in_values.data() + offset,
+                     std::min(chunk_size, count - offset),
+                     datatype,
+                     0,
+                     0,
+                     h.m_node_comm);
+        return;
+        }
+
+    unsigned int node_total = 0;
+    for (int i = 0; i < h.m_node_size; i++)
+        node_total += node_counts[i];
+    std::vector<unsigned int> leader_totals(h.m_n_leaders);
+    MPI_Gather(&node_total,
+               1,
+               MPI_UNSIGNED,
+               leader_totals.data(),
+               1,
+               MPI_UNSIGNED,
+               0,
+               h.m_leader_comm);
+
+    int leader_rank;
+    MPI_Comm_rank(h.m_leader_comm, &leader_rank);
+    std::vector<T> chunk(chunk_size);
+
+    if (leader_rank == 0)
+        {
+        // root consumes the values of its own node as they arrive
+        consume(in_values.data(), count);
+        for (int i = 1; i < h.m_node_size; i++)
+            {
+            for (unsigned int offset = 0; offset < node_counts[i]; offset += chunk_size)
+                {
+                unsigned int n = std::min(chunk_size, node_counts[i] - offset);
+                MPI_Recv(chunk.data(), n, datatype, i, 0, h.m_node_comm, MPI_STATUS_IGNORE);
+                consume(chunk.data(), n);
+                }
+            }
+
+        // and then the chunks of the other nodes
+        for (int leader = 1; leader < h.m_n_leaders; leader++)
+            {
+            unsigned int received = 0;
+            while (received < leader_totals[leader])
+                {
+                MPI_Status status;
+                int n;
+                MPI_Recv(chunk.data(), chunk_size, datatype, leader, 0, h.m_leader_comm, &status);
+                MPI_Get_count(&status, datatype, &n);
+                consume(chunk.data(), n);
+                received += n;
+                }
+            }
+        }
+    else
+        {
+        // pack the pieces of the node into chunks and relay them to root
+        unsigned int fill = 0;
+        for (int i = 0; i < h.m_node_size; i++)
+            {
+            for (unsigned int offset = 0; offset < node_counts[i]; offset += chunk_size)
+                {
+                unsigned int n = std::min(chunk_size, node_counts[i] - offset);
+                if (fill + n > chunk_size)
+                    {
+                    MPI_Send(chunk.data(), fill, datatype, 0, 0, h.m_leader_comm);
+                    fill = 0;
+                    }
+
+                if (i == 0)
+                    std::copy(in_values.begin() + offset,
+                              in_values.begin() + offset + n,
+                              chunk.begin() + fill);
+                else
+                    MPI_Recv(chunk.data() + fill,
+                             n,
+                             datatype,
+                             i,
+                             0,
+                             h.m_node_comm,
+                             MPI_STATUS_IGNORE);
+                fill += n;
+                }
+            }
+        if (fill > 0)
+            MPI_Send(chunk.data(), fill, datatype, 0, 0, h.m_leader_comm);
+        }
+    }
+
+//! Scatter trivially copyable values from root in chunks of bounded size
+/*! \param counts Number of values for every rank, only referenced on root
+    \param produce Called on root as produce(unsigned int rank, T* values, unsigned int n) to write
+           the next n values for rank
+    \param out_values Values of this rank
+    \param root Rank that sends the values
+    \param mpi_comm Communicator
+    \param chunk_bytes Size of the chunks
+    \param ranks_per_node Number of ranks on a node, see MPINodeHierarchy
+
+    Root produces the values of every rank in chunks and sends them to the node leader, which relays
+    them to the ranks on its node. Root never holds more than one chunk of values for other ranks.
+*/
+template<typename T, typename Producer>
+void scatter_chunked(const std::vector<unsigned int>& counts,
+                     Producer produce,
+                     std::vector<T>& out_values,
+                     unsigned int root,
+                     const MPI_Comm mpi_comm,
+                     size_t chunk_bytes = mpi_chunk_bytes,
+                     int ranks_per_node = 0)
+    {
+    MPI_Datatype datatype = get_mpi_datatype<T>();
+    unsigned int chunk_size = (unsigned int)std::max(chunk_bytes / sizeof(T), size_t(1));
+    MPINodeHierarchy h(root, mpi_comm, ranks_per_node);
+
+    unsigned int count;
+    MPI_Scatter(counts.data(), 1, MPI_UNSIGNED, &count, 1, MPI_UNSIGNED, root, mpi_comm);
+    out_values.resize(count);
+
+    // the node leaders learn the ranks and number of values of every rank on their node
+    int rank;
+    MPI_Comm_rank(mpi_comm, &rank);
+    std::vector<int> node_ranks(h.m_node_size);
+    std::vector<unsigned int> node_counts(h.m_node_size);
+    MPI_Gather(&rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT, 0, h.m_node_comm);
+    MPI_Gather(&count, 1, MPI_UNSIGNED, node_counts.data(), 1, MPI_UNSIGNED, 0, h.m_node_comm);
+
+    if (h.m_node_rank != 0)
+        {
+        recv_pieces(out_values.data(), count, 0, h.m_node_comm);
+        return;
+        }
+
+    int leader_rank;
+    MPI_Comm_rank(h.m_leader_comm, &leader_rank);
+
+    // root learns the ranks on every node
+    std::vector<int> leader_sizes(h.m_n_leaders);
+    MPI_Gather(&h.m_node_size, 1, MPI_INT, leader_sizes.data(), 1, MPI_INT, 0, h.m_leader_comm);
+    std::vector<int> leader_displs(h.m_n_leaders, 0);
+    std::vector<int> all_node_ranks;
+    if (leader_rank == 0)
+        {
+        for (int leader = 1; leader < h.m_n_leaders; leader++)
+            leader_displs[leader] = leader_displs[leader - 1] + leader_sizes[leader - 1];
+        all_node_ranks.resize(leader_displs.back() + leader_sizes.back());
+        }
+    MPI_Gatherv(node_ranks.data(),
+                h.m_node_size,
+                MPI_INT,
+                all_node_ranks.data(),
+                leader_sizes.data(),
+                leader_displs.data(),
+                MPI_INT,
+                0,
+                h.m_leader_comm);
+
+    std::vector<T> chunk(chunk_size);
+
+    if (leader_rank == 0)
+        {
+        // root sends the values of its own node directly
+        produce(rank, out_values.data(), count);
+        for (int i = 1; i < h.m_node_size; i++)
+            {
+            for (unsigned int offset = 0; offset < node_counts[i]; offset += chunk_size)
+                {
+                unsigned int n = std::min(chunk_size, node_counts[i] - offset);
+                produce(node_ranks[i], chunk.data(), n);
+                MPI_Send(chunk.data(), n, datatype, i, 0, h.m_node_comm);
+                }
+            }
+
+        // and packs the values of the other nodes into chunks, in the order of their ranks
+        for (int leader = 1; leader < h.m_n_leaders; leader++)
+            {
+            unsigned int fill = 0;
+            for (int i = 0; i < leader_sizes[leader]; i++)
+                {
+                int dest = all_node_ranks[leader_displs[leader] + i];
+                unsigned int remaining = counts[dest];
+                while (remaining > 0)
+                    {
+                    unsigned int n = std::min(remaining, chunk_size - fill);
+                    produce(dest, chunk.data() + fill, n);
+                    fill += n;
+                    remaining -= n;
+                    if (fill == chunk_size)
+                        {
+                        MPI_Send(chunk.data(), fill, datatype, leader, 0, h.m_leader_comm);
+                        fill = 0;
+                        }
+                    }
+                }
+            if (fill > 0)
+                MPI_Send(chunk.data(), fill, datatype, leader, 0, h.m_leader_comm);
+            }
+        }
+    else
+        {
+        // relay the chunks from root to the ranks on the node
+        int i = 0;
+        unsigned int offset = 0;
+        while (i < h.m_node_size && node_counts[i] == 0)
+            i++;
+        while (i < h.m_node_size)
+            {
+            MPI_Status status;
+            int n;
+            MPI_Recv(chunk.data(), chunk_size, datatype, 0, 0, h.m_leader_comm, &status);
+            MPI_Get_count(&status, datatype, &n);
+
+            // split the chunk at the boundaries between ranks
+            unsigned int pos = 0;
+            while (pos < (unsigned int)n)
+                {
+                unsigned int m = std::min((unsigned int)n - pos, node_counts[i] - offset);
+                if (i == 0)
+                    std::copy(chunk.begin() + pos,
+                              chunk.begin() + pos + m,
+                              out_values.begin() + offset);
+                else
+                    MPI_Send(chunk.data() + pos, m, datatype, i, 0, h.m_node_comm);
+                pos += m;
+                offset += m;
+                if (offset == node_counts[i])
+                    {
+                    offset = 0;
+                    i++;
+                    while (i < h.m_node_size && node_counts[i] == 0)
+                        i++;
+                    }
+                }
+            }
+        }
+    }
+
+//! Broadcast trivially copyable values from root in chunks of bounded size
+/*! \param count Number of values, only referenced on root
+    \param produce Called on root as produce(T* values, unsigned int n) to write the next n values
+    \param consume Called on every rank as consume(const T* values, unsigned int n) for every chunk
+    \param root Rank that sends the values
+    \param mpi_comm Communicator
+    \param chunk_bytes Size of the chunks
+
+    No rank holds more than one chunk of the values at a time.
+*/
+template<typename T, typename Producer, typename Consumer>
+void bcast_chunked(unsigned int count,
+                   Producer produce,
+                   Consumer consume,
+                   unsigned int root,
+                   const MPI_Comm mpi_comm,
+                   size_t chunk_bytes = mpi_chunk_bytes)
+    {
+    MPI_Datatype datatype = get_mpi_datatype<T>();
+    unsigned int chunk_size = (unsigned int)std::max(chunk_bytes / sizeof(T), size_t(1));
+    int rank;
+    MPI_Comm_rank(mpi_comm, &rank);
+
+    MPI_Bcast(&count, 1, MPI_UNSIGNED, root, mpi_comm);
+    std::vector<T> chunk(std::min(chunk_size, count));
+    for (unsigned int offset = 0; offset < count; offset += chunk_size)
+        {
+        unsigned int n = std::min(chunk_size, count - offset);
+        if ((unsigned int)rank == root)
+            produce(chunk.data(), n);
+        MPI_Bcast(chunk.data(), n, datatype, root, mpi_comm);
+        consume(chunk.data(), n);
+        }
+    }
+
+//! Exchange trivially copyable values between all ranks
+/*! \param send_values Values to send, ordered by destination rank
+    \param send_counts Number of values for every rank
+    \param recv_values Values received, ordered by source rank
+    \param mpi_comm Communicator
+*/
+template<typename T>
+void all_to_all_v(const std::vector<T>& send_values,
+                  const std::vector<int>& send_counts,
+                  std::vector<T>& recv_values,
+                  const MPI_Comm mpi_comm)
+    {
+    int n_ranks;
+    MPI_Comm_size(mpi_comm, &n_ranks);
+
+    std::vector<int> recv_counts(n_ranks);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    std::vector<int> send_displs(n_ranks, 0);
+    std::vector<int> recv_displs(n_ranks, 0);
+    for (int i = 1; i < n_ranks; i++)
+        {
+        send_displs[i] = send_displs[i - 1] + send_counts[i - 1];
+        recv_displs[i] = recv_displs[i - 1] + recv_counts[i - 1];
+        }
+    recv_values.resize(recv_displs.back() + recv_counts.back());
+
+    MPI_Datatype datatype = get_mpi_datatype<T>();
+    MPI_Alltoallv(send_values.data(),
+                  send_counts.data(),
+                  send_displs.data(),
+                  datatype,
+                  recv_values.data(),
+                  recv_counts.data(),
+                  recv_displs.data(),
+                  datatype,
+                  mpi_comm);
+    }
+
 #endif // ENABLE_MPI
 #endif // __HOOMD_MPI_H__
@@ -0,0 +1,260 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file HostArena.h
+    \brief Declares an arena allocator for temporary host memory and an STL allocator using it
+*/
+
+#ifndef __HOST_ARENA_H__
+#define __HOST_ARENA_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//! Arena for temporary host memory that lives at most until the end of the time step
+/*! Allocations advance an offset in a block of memory. System::run() calls reset() at the
+    beginning of every time step, which releases all allocations at once. Freeing the most recent
+    allocation returns its memory to the arena right away, so scoped temporaries that are freed in
+    reverse order of allocation reuse the same memory even between resets.
+
+    When a time step needs more memory than the current block holds, the arena allocates additional
+    blocks. The next reset() replaces them by a single block large enough for all of them, so that
+    the time steps in the steady state do not call the system allocator.
+
+    Memory from the arena must not be kept beyond the end of the time step. The arena is not thread
+    safe, only allocate from it on the thread that drives the simulation.
+*/
+class __attribute__((visibility("default"))) HostArena
+    {
+    public:
+    //! Constructor
+    /*! \param min_block_bytes Minimum size of a block of memory
+     */
+    HostArena(size_t min_block_bytes = 1024 * 1024)
+        : m_min_block_bytes(min_block_bytes), m_bytes_in_use(0), m_peak_bytes(0),
+          m_num_allocations(0), m_num_system_allocations(0)
+        {
+        }
+
+    HostArena(const HostArena&) = delete;
+    HostArena& operator=(const HostArena&) = delete;
+
+    //! Destructor
+    ~HostArena()
+        {
+        releaseBlocks();
+        }
+
+    //! Allocate temporary memory
+    /*! \param num_bytes Number of bytes to allocate
+        \param alignment Alignment of the memory in bytes, at most 32
+        \returns a pointer to the memory
+    */
+    void* allocate(size_t num_bytes, size_t alignment = 32)
+        {
+        m_num_allocations++;
+
+        if (m_blocks.size() == 0 || !fits(m_blocks.back(), num_bytes, alignment))
+            {
+            // grow geometrically so that the number of blocks per time step stays small
+            size_t block_bytes = std::max(num_bytes, m_min_block_bytes);
+            if (m_blocks.size())
+                block_bytes = std::max(block_bytes, 2 * m_blocks.back().size);
+            addBlock(block_bytes);
+            }
+
+        Block& block = m_blocks.back();
+        size_t offset = alignOffset(block.offset, alignment);
+        m_bytes_in_use += offset + num_bytes - block.offset;
+        block.offset = offset + num_bytes;
+        m_peak_bytes = std::max(m_peak_bytes, m_bytes_in_use);
+        return block.data + offset;
+        }
+
+    //! Free temporary memory
+    /*! \param ptr Pointer returned by allocate()
+        \param num_bytes Number of bytes passed to allocate()
+
+        Only the most recent allocation returns its memory before the next reset().
+    */
+    void deallocate(void* ptr, size_t num_bytes)
+        {
+        if (m_blocks.size() == 0 || ptr == nullptr)
+            return;
+
+        Block& block = m_blocks.back();
+        char* p = (char*)ptr;
+        if (p >= block.data && p + num_bytes == block.data + block.offset)
+            {
+            size_t offset = p - block.data;
+            m_bytes_in_use -= block.offset - offset;
+            block.offset = offset;
+            }
+        }
+
+    //! Release all allocations
+    void reset()
+        {
+        if (m_blocks.size() > 1)
+            {
+            // coalesce the blocks, the next time step likely needs as much memory
+            size_t block_bytes = getCapacity();
+            releaseBlocks();
+            addBlock(block_bytes);
+            }
+        else if (m_blocks.size() == 1)
+            {
+            m_blocks.back().offset = 0;
+            }
+
+        m_bytes_in_use = 0;
+        }
+
+    //! Get the number of bytes currently allocated from the arena
+    size_t getBytesInUse() const
+        {
+        return m_bytes_in_use;
+        }
+
+    //! Get the largest number of bytes allocated from the arena at any time
+    size_t getPeakBytes() const
+        {
+        return m_peak_bytes;
+        }
+
+    //! Get the total size of the blocks held by the arena
+    size_t getCapacity() const
+        {
+        size_t capacity = 0;
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            capacity += it->size;
+        return capacity;
+        }
+
+    //! Get the number of allocations served by the arena
+    unsigned long long getNumAllocations() const
+        {
+        return m_num_allocations;
+        }
+
+    //! Get the number of blocks the arena requested from the system allocator
+    unsigned long long getNumSystemAllocations() const
+        {
+        return m_num_system_allocations;
+        }
+
+    private:
+    //! A block of memory
+    struct Block
+        {
+        char* data;    //!< Start of the block
+        size_t size;   //!< Size of the block in bytes
+        size_t offset; //!< Offset of the first free byte
+        };
+
+    std::vector<Block> m_blocks; //!< Blocks of memory, allocations come from the last one
+    size_t m_min_block_bytes;    //!< Minimum size of a block
+    size_t m_bytes_in_use;       //!< Number of bytes currently allocated
+    size_t m_peak_bytes;         //!< Largest number of bytes allocated at any time
+    unsigned long long m_num_allocations;        //!< Number of allocations served
+    unsigned long long m_num_system_allocations; //!< Number of blocks allocated
+
+    //! Round an offset up to the given alignment
+    static size_t alignOffset(size_t offset, size_t alignment)
+        {
+        return (offset + alignment - 1) / alignment * alignment;
+        }
+
+    //! Test if an allocation fits into a block
+    static bool fits(const Block& block, size_t num_bytes, size_t alignment)
+        {
+        return alignOffset(block.offset, alignment) + num_bytes <= block.size;
+        }
+
+    //! Allocate a new block from the system
+    void addBlock(size_t block_bytes)
+        {
+        void* data = nullptr;
+        // blocks are 32 byte aligned for AVX
+        if (posix_memalign(&data, 32, block_bytes) != 0)
+            throw std::bad_alloc();
+
+        Block block;
+        block.data = (char*)data;
+        block.size = block_bytes;
+        block.offset = 0;
+        m_blocks.push_back(block);
+        m_num_system_allocations++;
+        }
+
+    //! Free all blocks
+    void releaseBlocks()
+        {
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            free(it->data);
+        m_blocks.clear();
+        }
+    };
+
+//! STL allocator that draws memory from a HostArena
+/*! Containers using this allocator hold temporaries that must not outlive the time step, see
+    HostArena.
+*/
+template<class T> class ArenaAllocator
+    {
+    public:
+    typedef T value_type;
+
+    //! Constructor
+    /*! \param arena Arena to allocate from
+     */
+    ArenaAllocator(HostArena& arena) : m_arena(&arena) { }
+
+    //! Rebind constructor
+    template<class U> ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.getArena()) { }
+
+    //! Allocate memory for n elements
+    T* allocate(size_t n)
+        {
+        return (T*)m_arena->allocate(n * sizeof(T), std::max(alignof(T), size_t(32)));
+        }
+
+    //! Free memory for n elements
+    void deallocate(T* ptr, size_t n)
+        {
+        m_arena->deallocate(ptr, n * sizeof(T));
+        }
+
+    //! Get the arena
+    HostArena* getArena() const
+        {
+        return m_arena;
+        }
+
+    private:
+    HostArena* m_arena; //!< The arena to allocate from
+    };
+
+template<class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+    {
+    return a.getArena() == b.getArena();
+    }
+
+template<class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+    {
+    return a.getArena() != b.getArena();
+    }
+
+//! A std::vector holding temporaries in a HostArena
+template<class T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // __HOST_ARENA_H__
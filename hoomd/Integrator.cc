@@ -10,6 +10,7 @@ namespace py = pybind11;
 #endif
 
 #ifdef ENABLE_MPI
+#include "ClockSource.h"
 #include "Communicator.h"
 #endif
 
@@ -197,12 +198,20 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
    \a m_net_virial \note The summation step is performed <b>on the CPU</b> and will result in a lot
    of data traffic back and forth if the forces and/or integrator are on the GPU. Call
    computeNetForcesGPU() to sum the forces on the GPU
+
+   When m_accumulate_forces is set, force computes that support accumulation add their forces
+   directly to the net force arrays. Their own force arrays are then not computed in this step.
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
+#ifdef ENABLE_MPI
+    ClockSource clk;
+#endif
+
     for (auto& force : m_forces)
         {
-        force->compute(timestep);
+        if (!(m_accumulate_forces && force->supportsAccumulation()))
+            force->compute(timestep);
         }
 
     if (m_prof)
@@ -211,13 +220,12 @@ void Integrator::computeNetForce(uint64_t timestep)
         m_prof->push("Net force");
         }
 
-    Scalar external_virial[6];
-    Scalar external_energy;
+    // access the net force and virial arrays
+    const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+
         {
-        // access the net force and virial arrays
-        const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
-        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
-        const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
         ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar4> h_net_torque(net_torque,
@@ -228,11 +236,40 @@ void Integrator::computeNetForce(uint64_t timestep)
         memset((void*)h_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
         memset((void*)h_net_virial.data, 0, sizeof(Scalar) * net_virial.getNumElements());
         memset((void*)h_net_torque.data, 0, sizeof(Scalar4) * net_torque.getNumElements());
+        }
 
-        for (unsigned int i = 0; i < 6; ++i)
-            external_virial[i] = Scalar(0.0);
+    Scalar external_virial[6];
+    Scalar external_energy;
+    for (unsigned int i = 0; i < 6; ++i)
+        external_virial[i] = Scalar(0.0);
 
-        external_energy = Scalar(0.0);
+    external_energy = Scalar(0.0);
+
+    // forces in accumulation mode add directly to the net force
+    if (m_accumulate_forces)
+        {
+        for (const auto& force : m_forces)
+            {
+            if (!force->supportsAccumulation())
+                continue;
+
+            force->accumulateForces(timestep, net_force, net_virial);
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                external_virial[k] += force->getExternalVirial(k);
+                }
+
+            external_energy += force->getExternalEnergy();
+            }
+        }
+
+        {
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_torque(net_torque,
+                                          access_location::host,
+                                          access_mode::readwrite);
 
         // now, add up the net forces
         // also sum up forces for ghosts, in case they are needed by the communicator
@@ -245,6 +282,9 @@ void Integrator::computeNetForce(uint64_t timestep)
 
         for (const auto& force : m_forces)
             {
+            if (m_accumulate_forces && force->supportsAccumulation())
+                continue;
+
             GlobalArray<Scalar4>& h_force_array = force->getForceArray();
             GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
@@ -299,6 +339,12 @@ void Integrator::computeNetForce(uint64_t timestep)
         m_prof->pop();
         }
 
+#ifdef ENABLE_MPI
+    // the time spent computing forces measures the load of this rank for the load balancer
+    if (m_comm)
+        m_comm->addComputeTime(clk.getTime());
+#endif
+
     // return early if there are no constraint forces or no HalfStepHook set
     if (m_constraint_forces.size() == 0)
         return;
@@ -974,6 +1020,9 @@ void export_Integrator(py::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>, Scalar>())
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
+        .def_property("accumulate_forces",
+                      &Integrator::getAccumulateForces,
+                      &Integrator::setAccumulateForces)
         .def_property_readonly("forces", &Integrator::getForces)
         .def_property_readonly("constraints", &Integrator::getConstraintForces);
     }
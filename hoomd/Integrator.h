@@ -92,6 +92,22 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Return the timestep
     Scalar getDeltaT();
 
+    /// Set whether forces that support it add directly to the net force
+    /** @param accumulate_forces When true, computeNetForce() has force computes that support
+        accumulation add their forces directly to the net force arrays instead of computing their
+        own arrays first.
+    */
+    void setAccumulateForces(bool accumulate_forces)
+        {
+        m_accumulate_forces = accumulate_forces;
+        }
+
+    /// Get whether forces that support it add directly to the net force
+    bool getAccumulateForces()
+        {
+        return m_accumulate_forces;
+        }
+
     /// Update the number of degrees of freedom for a group
     /** @param group Group to set the degrees of freedom for.
      */
@@ -152,6 +168,9 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
+    /// True when forces that support it add directly to the net force
+    bool m_accumulate_forces = false;
+
     /// helper function to compute initial accelerations
     void computeAccelerations(uint64_t timestep);
 
@@ -33,10 +33,11 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<Trigger> trigger)
     : Tuner(sysdef, trigger), m_decomposition(decomposition),
       m_mpi_comm(m_exec_conf->getMPICommunicator()), m_max_imbalance(Scalar(1.0)),
-      m_recompute_max_imbalance(true), m_needs_migrate(false), m_needs_recount(false),
+      m_recompute_max_imbalance(true), m_balance_time(false), m_damping(Scalar(0.5)), m_cost(0.0),
+      m_last_compute_time(0), m_needs_migrate(false), m_needs_recount(false),
       m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)), m_N_own(m_pdata->getN()),
-      m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0), m_n_iterations(0),
-      m_n_rebalances(0)
+      m_last_imbalance(1.0), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
+      m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
 
@@ -45,6 +46,13 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
     m_enable_x = (di.getW() > 1);
     m_enable_y = (di.getH() > 1);
     m_enable_z = (di.getD() > 1);
+
+    // a bisection may cut along any direction
+    if (m_decomposition->isRCB())
+        {
+        m_enable_x = m_enable_y = true;
+        m_enable_z = (m_sysdef->getNDimensions() == 3);
+        }
     }
 
 LoadBalancer::~LoadBalancer()
@@ -52,6 +60,51 @@ LoadBalancer::~LoadBalancer()
     m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
     }
 
+/*!
+ * \returns "particles" or "time"
+ */
+std::string LoadBalancer::getMetric()
+    {
+    return m_balance_time ? "time" : "particles";
+    }
+
+/*!
+ * \param metric Name of the load metric, "particles" or "time"
+ */
+void LoadBalancer::setMetric(const std::string& metric)
+    {
+    if (metric == "particles")
+        {
+        m_balance_time = false;
+        }
+    else if (metric == "time")
+        {
+        // start a new measurement
+        if (!m_balance_time)
+            m_cost = 0.0;
+        m_balance_time = true;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "comm.balance: unknown load metric " << metric << endl;
+        throw invalid_argument("Invalid load metric " + metric);
+        }
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * \param damping Weight of the previous estimate of the cost per particle in [0, 1)
+ */
+void LoadBalancer::setDamping(Scalar damping)
+    {
+    if (damping < Scalar(0.0) || damping >= Scalar(1.0))
+        {
+        m_exec_conf->msg->error() << "comm.balance: damping must be in [0, 1)" << endl;
+        throw invalid_argument("Invalid damping");
+        }
+    m_damping = damping;
+    }
+
 /*!
  * \param timestep Current time step of the simulation
  *
@@ -70,6 +123,9 @@ void LoadBalancer::update(uint64_t timestep)
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
+    if (m_balance_time)
+        measureCost();
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -87,7 +143,8 @@ void LoadBalancer::update(uint64_t timestep)
         = Scalar(2.0) * m_comm->getGhostLayerMaxWidth() / box.getNearestPlaneDistance();
 
     // compute the current imbalance always for the average in printed stats
-    m_total_max_imbalance += getMaxImbalance();
+    m_last_imbalance = getMaxImbalance();
+    m_total_max_imbalance += m_last_imbalance;
     ++m_n_calls;
 
     // attempt load balancing
@@ -97,56 +154,67 @@ void LoadBalancer::update(uint64_t timestep)
         // increment the number of attempted balances
         ++m_n_iterations;
 
-        for (unsigned int dim = 0;
-             dim < m_sysdef->getNDimensions() && getMaxImbalance() > m_tolerance;
-             ++dim)
+        if (m_decomposition->isRCB())
             {
-            Scalar L_i(0.0);
-            Scalar min_frac_i(0.0);
-            if (dim == 0)
-                {
-                if (!m_enable_x || di.getW() == 1)
-                    continue; // skip this dimension if balancing is turned off
-                L_i = L.x;
-                min_frac_i = min_domain_frac.x;
-                }
-            else if (dim == 1)
+            if (adjustRCB(min_domain_frac))
                 {
-                if (!m_enable_y || di.getH() == 1)
-                    continue;
-                L_i = L.y;
-                min_frac_i = min_domain_frac.y;
+                m_pdata->setGlobalBox(box); // force a domain resizing to trigger
+                signalResize();
                 }
-            else
+            }
+        else
+            {
+            for (unsigned int dim = 0;
+                 dim < m_sysdef->getNDimensions() && getMaxImbalance() > m_tolerance;
+                 ++dim)
                 {
-                if (!m_enable_z || di.getD() == 1)
-                    continue;
-                L_i = L.z;
-                min_frac_i = min_domain_frac.z;
-                }
+                Scalar L_i(0.0);
+                Scalar min_frac_i(0.0);
+                if (dim == 0)
+                    {
+                    if (!m_enable_x || di.getW() == 1)
+                        continue; // skip this dimension if balancing is turned off
+                    L_i = L.x;
+                    min_frac_i = min_domain_frac.x;
+                    }
+                else if (dim == 1)
+                    {
+                    if (!m_enable_y || di.getH() == 1)
+                        continue;
+                    L_i = L.y;
+                    min_frac_i = min_domain_frac.y;
+                    }
+                else
+                    {
+                    if (!m_enable_z || di.getD() == 1)
+                        continue;
+                    L_i = L.z;
+                    min_frac_i = min_domain_frac.z;
+                    }
 
-            vector<unsigned int> N_i;
-            bool adjusted = false;
+                vector<double> load_i;
+                bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+                // reduce the load in the slice along dim
+                bool active = reduce(load_i, dim, reduce_root);
 
-            // attempt an adjustment
-            vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
-            if (active)
-                {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
-                }
+                // attempt an adjustment
+                vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
+                if (active)
+                    {
+                    adjusted = adjust(cum_frac, load_i, L_i, min_frac_i);
+                    }
 
-            // broadcast if an adjustment has been made on the root
-            bcast(adjusted, reduce_root, m_mpi_comm);
+                // broadcast if an adjustment has been made on the root
+                bcast(adjusted, reduce_root, m_mpi_comm);
 
-            // update the cumulative fractions and signal
-            if (adjusted)
-                {
-                m_decomposition->setCumulativeFractions(dim, cum_frac, reduce_root);
-                m_pdata->setGlobalBox(box); // force a domain resizing to trigger
-                signalResize();
+                // update the cumulative fractions and signal
+                if (adjusted)
+                    {
+                    m_decomposition->setCumulativeFractions(dim, cum_frac, reduce_root);
+                    m_pdata->setGlobalBox(box); // force a domain resizing to trigger
+                    signalResize();
+                    }
                 }
             }
 
@@ -168,15 +236,21 @@ void LoadBalancer::update(uint64_t timestep)
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * Computes the imbalance factor I = W / <W> of the load W for each rank, and computes the maximum
+ * among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        double load = getLoad();
+        double total_load = double(m_pdata->getNGlobal());
+        if (m_balance_time)
+            MPI_Allreduce(&load, &total_load, 1, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+        Scalar cur_imb = (total_load > 0.0)
+                             ? Scalar(load / (total_load / double(m_exec_conf->getNRanks())))
+                             : Scalar(1.0);
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -191,37 +265,74 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * Measures the cost per particle on this rank from the time spent computing forces since the
+ * previous measurement, and averages it with the previous estimate weighted by the damping factor.
+ * Ranks that have no measurement (e.g. because they own no particles) use the average cost of the
+ * other ranks. If no rank has a measurement, the cost is 1 and the particles are balanced.
+ *
+ * \note All ranks must call this method since it involves collective MPI calls.
+ */
+void LoadBalancer::measureCost()
+    {
+    // we need a communicator, but don't want to check for it in release builds
+    assert(m_comm);
+
+    int64_t compute_time = m_comm->getComputeTime();
+    int64_t elapsed = compute_time - m_last_compute_time;
+    m_last_compute_time = compute_time;
+
+    unsigned int N = m_pdata->getN();
+    if (N > 0 && elapsed > 0)
+        {
+        double cost = double(elapsed) / double(N);
+        if (m_cost > 0.0)
+            m_cost = double(m_damping) * m_cost + (1.0 - double(m_damping)) * cost;
+        else
+            m_cost = cost;
+        }
+
+    // average the cost over the ranks that have a measurement
+    double sum[2] = {m_cost, m_cost > 0.0 ? 1.0 : 0.0};
+    MPI_Allreduce(MPI_IN_PLACE, sum, 2, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+    if (sum[1] == 0.0)
+        m_cost = 1.0;
+    else if (m_cost <= 0.0)
+        m_cost = sum[0] / sum[1];
+
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * \param load_i Vector holding the total load of each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a load_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a load_i holds the load of each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
- * return value. As a result, only \a reduce_root actually needs to allocate memory for \a N_i.
+ * return value. As a result, only \a reduce_root actually needs to allocate memory for \a load_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a
  * reduce_root. This operation may be suboptimal for very large numbers of processors, and could be
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
-                          unsigned int dim,
-                          unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<double>& load_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1)
+    if (load_i.size() == 1)
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<double> load_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    double load = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&load, 1, MPI_DOUBLE, &load_per_rank[0], 1, MPI_DOUBLE, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -231,57 +342,57 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<double> load_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        load_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = load_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear();
-        N_i.resize(di.getW());
+        load_i.clear();
+        load_i.resize(di.getW());
         for (unsigned int i = 0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            load_i[i] = 0.0;
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int j = 0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i, j, k)];
+                    load_i[i] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear();
-        N_i.resize(di.getH());
+        load_i.clear();
+        load_i.resize(di.getH());
         for (unsigned int j = 0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            load_i[j] = 0.0;
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i, j, k)];
+                    load_i[j] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear();
-        N_i.resize(di.getD());
+        load_i.clear();
+        load_i.resize(di.getD());
         for (unsigned int k = 0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            load_i[k] = 0.0;
             for (unsigned int j = 0; j < di.getH(); ++j)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i, j, k)];
+                    load_i[k] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
@@ -298,7 +409,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param load_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -317,31 +428,33 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<double>& load_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (load_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const double target = accumulate(load_i.begin(), load_i.end(), 0.0) / double(load_i.size());
+    if (target <= 0.0)
+        return false;
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(load_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i = 0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(load_i.size());
+    for (unsigned int i = 0; i < load_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = Scalar(load_i[i] / target);
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (load_i[i] > 0.0)
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
                      + m_max_scale); // as in gromacs, use half the imbalance factor to scale
@@ -366,7 +479,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to
     // enforce the inequality constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)load_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2 * m, n + m);
     A(0, 0) = 1.0;
@@ -455,6 +568,219 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     return false;
     }
 
+//! Get a component of a vector
+static inline Scalar component(const Scalar3& v, unsigned int dim)
+    {
+    return (dim == 0) ? v.x : ((dim == 1) ? v.y : v.z);
+    }
+
+//! Set a component of a vector
+static inline Scalar& component(Scalar3& v, unsigned int dim)
+    {
+    return (dim == 0) ? v.x : ((dim == 1) ? v.y : v.z);
+    }
+
+//! Count the largest number of domains stacked along a direction below a node
+static unsigned int countStacked(const std::vector<DomainDecomposition::rcb_node>& nodes,
+                                 unsigned int node,
+                                 unsigned int dim)
+    {
+    const DomainDecomposition::rcb_node& cur = nodes[node];
+    if (cur.n == 1)
+        return 1;
+
+    unsigned int left = countStacked(nodes, cur.left, dim);
+    unsigned int right = countStacked(nodes, cur.right, dim);
+    return (cur.dim == dim) ? left + right : std::max(left, right);
+    }
+
+//! Compute the bounds of every node below a node of a bisection tree
+static void computeNodeBounds(const std::vector<DomainDecomposition::rcb_node>& nodes,
+                              const std::vector<Scalar>& cuts,
+                              unsigned int node,
+                              Scalar3 lo,
+                              Scalar3 hi,
+                              std::vector<Scalar3>& node_lo,
+                              std::vector<Scalar3>& node_hi)
+    {
+    node_lo[node] = lo;
+    node_hi[node] = hi;
+
+    const DomainDecomposition::rcb_node& cur = nodes[node];
+    if (cur.n == 1)
+        return;
+
+    Scalar3 hi_left = hi;
+    component(hi_left, cur.dim) = cuts[node];
+    Scalar3 lo_right = lo;
+    component(lo_right, cur.dim) = cuts[node];
+    computeNodeBounds(nodes, cuts, cur.left, lo, hi_left, node_lo, node_hi);
+    computeNodeBounds(nodes, cuts, cur.right, lo_right, hi, node_lo, node_hi);
+    }
+
+/*!
+ * \param min_domain_frac Minimum domain size along each dimension as a fraction of the global box
+ * \returns true if a cut was moved
+ *
+ * The cuts are placed one level of the tree at a time, so that the load below a node is binned
+ * with the bounds the node has after its ancestors moved. The binned load of all nodes on a level
+ * is summed over the ranks in a single reduction. Within the bin that contains the target load,
+ * the cut is interpolated linearly.
+ *
+ * \note All ranks must call this method since it involves collective MPI calls.
+ */
+bool LoadBalancer::adjustRCB(const Scalar3& min_domain_frac)
+    {
+    const unsigned int n_bins = 64;
+    const std::vector<DomainDecomposition::rcb_node>& nodes = m_decomposition->getRCBNodes();
+    const unsigned int n_nodes = (unsigned int)nodes.size();
+    const bool enable[3] = {m_enable_x, m_enable_y, m_enable_z};
+
+    std::vector<Scalar> cuts(n_nodes);
+    for (unsigned int i = 0; i < n_nodes; ++i)
+        cuts[i] = nodes[i].cut;
+
+    // the depth of every node in the tree, the children always follow their parent
+    std::vector<unsigned int> depth(n_nodes, 0);
+    unsigned int max_depth = 0;
+    for (unsigned int i = 0; i < n_nodes; ++i)
+        {
+        if (nodes[i].n > 1)
+            {
+            depth[nodes[i].left] = depth[i] + 1;
+            depth[nodes[i].right] = depth[i] + 1;
+            max_depth = std::max(max_depth, depth[i] + 1);
+            }
+        }
+
+    // the fractional positions of the particles in the global box
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    std::vector<Scalar3> f(m_pdata->getN());
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            {
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+            int3 img = make_int3(0, 0, 0);
+            global_box.wrap(pos, img);
+            f[idx] = global_box.makeFraction(pos);
+            }
+        }
+    const double weight = m_balance_time ? m_cost : 1.0;
+
+    std::vector<Scalar3> node_lo(n_nodes);
+    std::vector<Scalar3> node_hi(n_nodes);
+    bool adjusted = false;
+    for (unsigned int level = 0; level < max_depth; ++level)
+        {
+        computeNodeBounds(nodes,
+                          cuts,
+                          0,
+                          make_scalar3(0, 0, 0),
+                          make_scalar3(1, 1, 1),
+                          node_lo,
+                          node_hi);
+
+        // the internal nodes on this level
+        std::vector<unsigned int> slot(n_nodes, 0);
+        std::vector<unsigned int> level_nodes;
+        for (unsigned int i = 0; i < n_nodes; ++i)
+            {
+            if (depth[i] == level && nodes[i].n > 1)
+                {
+                slot[i] = (unsigned int)level_nodes.size();
+                level_nodes.push_back(i);
+                }
+            }
+
+        // bin the load below every node along its cut direction
+        std::vector<double> hist(level_nodes.size() * n_bins, 0.0);
+        for (unsigned int idx = 0; idx < f.size(); ++idx)
+            {
+            unsigned int node = 0;
+            while (depth[node] < level && nodes[node].n > 1)
+                node = (component(f[idx], nodes[node].dim) < cuts[node]) ? nodes[node].left
+                                                                           : nodes[node].right;
+            if (depth[node] != level || nodes[node].n == 1)
+                continue;
+
+            const unsigned int dim = nodes[node].dim;
+            const Scalar lo = component(node_lo[node], dim);
+            const Scalar hi = component(node_hi[node], dim);
+            int bin = int((component(f[idx], dim) - lo) / (hi - lo) * Scalar(n_bins));
+            bin = std::max(0, std::min(int(n_bins) - 1, bin));
+            hist[slot[node] * n_bins + bin] += weight;
+            }
+        MPI_Allreduce(MPI_IN_PLACE,
+                      hist.data(),
+                      (int)hist.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_mpi_comm);
+
+        for (unsigned int cur = 0; cur < level_nodes.size(); ++cur)
+            {
+            const unsigned int node = level_nodes[cur];
+            const unsigned int dim = nodes[node].dim;
+            if (!enable[dim])
+                continue;
+
+            const double* node_hist = &hist[cur * n_bins];
+            double total = 0.0;
+            for (unsigned int bin = 0; bin < n_bins; ++bin)
+                total += node_hist[bin];
+            if (total <= 0.0)
+                continue;
+
+            // split the load in proportion to the number of ranks on either side
+            const Scalar lo = component(node_lo[node], dim);
+            const Scalar hi = component(node_hi[node], dim);
+            const Scalar bin_width = (hi - lo) / Scalar(n_bins);
+            const double target = total * double(nodes[nodes[node].left].n) / double(nodes[node].n);
+            Scalar cut = hi;
+            double sum = 0.0;
+            for (unsigned int bin = 0; bin < n_bins; ++bin)
+                {
+                if (sum + node_hist[bin] >= target && node_hist[bin] > 0.0)
+                    {
+                    cut = lo + bin_width * (Scalar(bin) + Scalar((target - sum) / node_hist[bin]));
+                    break;
+                    }
+                sum += node_hist[bin];
+                }
+
+            // every domain on either side must hold the ghost layer
+            const Scalar min_frac = std::max(component(min_domain_frac, dim),
+                                             Scalar(1e-3) * (hi - lo));
+            const Scalar lower = lo + Scalar(countStacked(nodes, nodes[node].left, dim)) * min_frac;
+            const Scalar upper
+                = hi - Scalar(countStacked(nodes, nodes[node].right, dim)) * min_frac;
+            if (lower >= upper)
+                continue;
+
+            // limit the move to a fraction of the node extent
+            const Scalar old_cut = std::max(lower, std::min(upper, cuts[node]));
+            const Scalar max_move = m_max_scale * (hi - lo);
+            cut = std::max(old_cut - max_move, std::min(old_cut + max_move, cut));
+            cut = std::max(lower, std::min(upper, cut));
+
+            if (cut != cuts[node])
+                {
+                cuts[node] = cut;
+                adjusted = true;
+                }
+            }
+        }
+
+    // all ranks computed the same cuts, take them from the root to rule out roundoff differences
+    bcast(adjusted, 0, m_mpi_comm);
+    if (adjusted)
+        m_decomposition->setRCBCuts(cuts, 0);
+    return adjusted;
+    }
+
 /*!
  * \param cnts Map holding result of number of particles on each rank that neighbors the local rank
  */
@@ -466,6 +792,30 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
                                            access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
+
+    // the bisection domains do not form a grid, a particle may go to any rank after the cuts moved
+    if (m_decomposition->isRCB())
+        {
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        for (unsigned int cur_p = 0; cur_p < m_pdata->getN(); ++cur_p)
+            {
+            const Scalar4 cur_postype = h_pos.data[cur_p];
+            Scalar3 cur_pos = make_scalar3(cur_postype.x, cur_postype.y, cur_postype.z);
+            const Scalar3 f = box.makeFraction(cur_pos);
+            if (f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+                && f.z >= Scalar(0.0) && f.z < Scalar(1.0))
+                continue;
+
+            int3 img = make_int3(0, 0, 0);
+            global_box.wrap(cur_pos, img);
+            unsigned int cur_rank
+                = m_decomposition->placeParticle(global_box, cur_pos, h_cart_ranks.data);
+            if (cur_rank != m_exec_conf->getRank())
+                cnts[cur_rank]++;
+            }
+        return;
+        }
+
     const Index3D& di = m_decomposition->getDomainIndexer();
     const uint3 rank_pos = m_decomposition->getGridPos();
 
@@ -539,6 +889,9 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
  * Neighboring ranks then perform send/receive calls, and count the new number of particles they own
  * as the number they owned locally plus the number received minus the number sent.
  *
+ * With the recursive coordinate bisection, particles may be sent to any rank, and the counts are
+ * summed over all ranks instead.
+ *
  * \note All ranks must participate in this call since it involves send/receive operations between
  * neighboring domains.
  */
@@ -548,6 +901,32 @@ void LoadBalancer::computeOwnedParticles()
     if (!m_needs_recount)
         return;
 
+    if (m_decomposition->isRCB())
+        {
+        std::map<unsigned int, unsigned int> cnts;
+        countParticlesOffRank(cnts);
+
+        std::vector<unsigned int> n_send_ptls(m_exec_conf->getNRanks(), 0);
+        int N_own = m_pdata->getN();
+        for (auto it = cnts.begin(); it != cnts.end(); ++it)
+            {
+            n_send_ptls[it->first] = it->second;
+            N_own -= it->second;
+            }
+
+        unsigned int n_recv_ptls = 0;
+        MPI_Reduce_scatter_block(n_send_ptls.data(),
+                                 &n_recv_ptls,
+                                 1,
+                                 MPI_UNSIGNED,
+                                 MPI_SUM,
+                                 m_mpi_comm);
+        N_own += n_recv_ptls;
+
+        resetNOwn(N_own);
+        return;
+        }
+
     // count the particles that are off the rank
     ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(),
                                              access_location::host,
@@ -624,6 +1003,12 @@ void export_LoadBalancer(py::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("metric", &LoadBalancer::getMetric, &LoadBalancer::setMetric)
+        .def_property("damping", &LoadBalancer::getDamping, &LoadBalancer::setDamping)
+        .def_property_readonly("imbalance", &LoadBalancer::getImbalance)
+        .def_property_readonly("largest_imbalance", &LoadBalancer::getLargestImbalance)
+        .def_property_readonly("average_imbalance", &LoadBalancer::getAverageImbalance)
+        .def_property_readonly("num_rebalances", &LoadBalancer::getNumRebalances);
     }
 #endif // ENABLE_MPI
@@ -27,8 +27,16 @@
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between
- * them. The load imbalance is defined as the number of particles owned by a rank divided by the
- * average number of particles per rank if the particles had a uniform distribution.
+ * them. The load imbalance is defined as the load of a rank divided by the average load per rank.
+ * By default, the load is the number of particles owned by the rank.
+ *
+ * When the load metric is time, the load of a rank is its number of particles times the measured
+ * cost per particle on that rank. The cost per particle is the wall time the integrator spent
+ * computing forces on the rank since the previous balancing step (see
+ * Communicator::getComputeTime()), divided by the number of particles. Successive measurements are
+ * averaged with an exponential moving average that weights the previous estimate by the damping
+ * factor, which suppresses oscillations of the domain boundaries caused by timing noise and by the
+ * lag between moving a boundary and measuring its effect.
  *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load
  * balance, subject to the following constraints that are imposed to both maintain a stable
@@ -40,6 +48,12 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost
  * function is the deviation of the domain sizes from the proposed rescaled width.
  *
+ * For a recursive coordinate bisection, the cuts of the bisection tree are placed one level at a
+ * time. The load of each node on the current level is binned along its cut direction, and the cut
+ * moves toward the position that splits the load in proportion to the number of ranks on either
+ * side. A cut moves by at most 5% of the extent of its node, and leaves enough room for the ghost
+ * layer in every domain below it.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Tuner
@@ -142,6 +156,45 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         return m_enable_z;
         }
 
+    //! Get the load metric
+    std::string getMetric();
+
+    //! Set the load metric
+    void setMetric(const std::string& metric);
+
+    //! Get the damping of the measured cost per particle
+    Scalar getDamping() const
+        {
+        return m_damping;
+        }
+
+    //! Set the damping of the measured cost per particle
+    void setDamping(Scalar damping);
+
+    //! Get the maximum load imbalance before the last balancing step
+    Scalar getImbalance() const
+        {
+        return m_last_imbalance;
+        }
+
+    //! Get the largest maximum load imbalance since the statistics were reset
+    Scalar getLargestImbalance() const
+        {
+        return m_max_max_imbalance;
+        }
+
+    //! Get the average maximum load imbalance before balancing since the statistics were reset
+    Scalar getAverageImbalance() const
+        {
+        return m_n_calls > 0 ? Scalar(m_total_max_imbalance / double(m_n_calls)) : Scalar(1.0);
+        }
+
+    //! Get the number of rebalances performed since the statistics were reset
+    uint64_t getNumRebalances() const
+        {
+        return m_n_rebalances;
+        }
+
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
@@ -159,8 +212,24 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     Scalar m_max_imbalance;         //!< Maximum imbalance
     bool m_recompute_max_imbalance; //!< Flag if maximum imbalance needs to be computed
 
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Get the load of this rank
+    double getLoad()
+        {
+        if (m_balance_time)
+            return double(getNOwn()) * m_cost;
+        else
+            return double(getNOwn());
+        }
+
+    //! Measure the cost per particle on this rank
+    void measureCost();
+    bool m_balance_time;         //!< Flag to balance the measured time instead of particles
+    Scalar m_damping;            //!< Weight of the previous cost estimate
+    double m_cost;               //!< Estimated cost per particle on this rank
+    int64_t m_last_compute_time; //!< Compute time of this rank at the last measurement
+
+    //! Reduce the load per rank down to one dimension
+    bool reduce(std::vector<double>& load_i, unsigned int dim, unsigned int reduce_root);
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -172,11 +241,14 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<double>& load_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
     bool m_needs_migrate; //!< Flag to signal that migration is necessary
 
+    //! Adjust the cuts of a recursive coordinate bisection
+    bool adjustRCB(const Scalar3& min_domain_frac);
+
     //! Compute the number of particles on each rank after an adjustment
     void computeOwnedParticles();
 
@@ -213,6 +285,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     private:
     unsigned int m_N_own; //!< Number of particles owned by this rank
 
+    Scalar m_last_imbalance;      //!< The imbalance of the last check
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
     uint64_t m_n_calls;           //!< The number of times the updater was called
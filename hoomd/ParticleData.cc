@@ -22,9 +22,11 @@
 #include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
 #include <stdlib.h>
@@ -895,10 +897,11 @@ void ParticleData::maybe_rebuild_tag_cache()
 
 /*! \return true If and only if all particles are in the simulation box
  */
-template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>& snap)
+template<class Real>
+bool ParticleData::inBox(const SnapshotParticleData<Real>& snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (distributed || m_exec_conf->getRank() == 0)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -924,7 +927,18 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
             }
         }
 #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && distributed)
+        {
+        int all_in_box = in_box;
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &all_in_box,
+                      1,
+                      MPI_INT,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        in_box = all_in_box;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -932,6 +946,151 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+/*! \param idx Index of the particle, for error messages
+    \param pos Position of the particle, wrapped into the box on return
+    \param img Image of the particle, updated on return
+    \param cart_ranks Map from cartesian domain index to rank
+    \returns the rank that owns the particle, or a value greater or equal to the number of ranks
+              if the particle is out of bounds
+*/
+unsigned int ParticleData::placeSnapshotParticle(unsigned int idx,
+                                                 Scalar3& pos,
+                                                 int3& img,
+                                                 const unsigned int* cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = m_global_box;
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i = int(f.x * ((Scalar)di.getW()));
+    int j = int(f.y * ((Scalar)di.getH()));
+    int k = int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0, 0, 0);
+    if (i == (int)di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int)di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int)di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << idx << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z
+                                  << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z
+                                  << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z
+                                  << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z
+                                  << ")" << std::endl;
+        }
+    return rank;
+    }
+#endif
+
+/*! \param local Particles of this rank
+    \param nglobal Global number of particles
+
+    \post the particle data arrays hold the given particles, the tags 0 to nglobal - 1 are active
+*/
+void ParticleData::setLocalParticles(const std::vector<snapshot_element>& local,
+                                     unsigned int nglobal)
+    {
+    m_nparticles = (unsigned int)local.size();
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        // we have to reset all previous rtags, to remove 'leftover' ghosts
+        unsigned int max_tag = (unsigned int)m_rtag.size();
+        for (unsigned int tag = 0; tag < max_tag; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+    // Load particle data
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+    ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                       access_location::host,
+                                       access_mode::overwrite);
+    ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        const snapshot_element& p = local[idx];
+        h_pos.data[idx] = make_scalar4(p.pos.x, p.pos.y, p.pos.z, __int_as_scalar(p.type));
+        h_vel.data[idx] = make_scalar4(p.vel.x, p.vel.y, p.vel.z, p.mass);
+        h_accel.data[idx] = p.accel;
+        h_charge.data[idx] = p.charge;
+        h_diameter.data[idx] = p.diameter;
+        h_image.data[idx] = p.image;
+        h_tag.data[idx] = p.tag;
+        h_rtag.data[p.tag] = idx;
+        h_body.data[idx] = p.body;
+        h_orientation.data[idx] = p.orientation;
+        h_angmom.data[idx] = p.angmom;
+        h_inertia.data[idx] = p.inertia;
+
+        h_comm_flag.data[idx] = 0; // initialize with zero
+        }
+    }
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
@@ -970,149 +1129,68 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather box information from all processors
         unsigned int root = 0;
-
-        // Define per-processor particle data
-        std::vector<std::vector<Scalar3>> pos_proc;       // Position array of every processor
-        std::vector<std::vector<Scalar3>> vel_proc;       // Velocities array of every processor
-        std::vector<std::vector<Scalar3>> accel_proc;     // Accelerations array of every processor
-        std::vector<std::vector<unsigned int>> type_proc; // Particle types array of every processor
-        std::vector<std::vector<Scalar>> mass_proc;   // Particle masses array of every processor
-        std::vector<std::vector<Scalar>> charge_proc; // Particle charges array of every processor
-        std::vector<std::vector<Scalar>>
-            diameter_proc;                         // Particle diameters array of every processor
-        std::vector<std::vector<int3>> image_proc; // Particle images array of every processor
-        std::vector<std::vector<unsigned int>> body_proc;   // Body ids of every processor
-        std::vector<std::vector<Scalar4>> orientation_proc; // Orientations of every processor
-        std::vector<std::vector<Scalar4>> angmom_proc;      // Angular momenta of every processor
-        std::vector<std::vector<Scalar3>> inertia_proc;     // Angular momenta of every processor
-        std::vector<std::vector<unsigned int>> tag_proc;    // Global tags of every processor
-        std::vector<unsigned int> N_proc; // Number of particles on every processor
-
-        // resize to number of ranks in communicator
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
         unsigned int my_rank = m_exec_conf->getRank();
 
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        tag_proc.resize(size);
-        N_proc.resize(size, 0);
-
-        if (my_rank == 0)
-            {
-            ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
-                                                   access_location::host,
-                                                   access_mode::read);
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
+        // wrap a particle into the box and determine the rank that owns it
+        auto place = [&](unsigned int snap_idx, Scalar3& pos, int3& img)
+            {
+            pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            img = snapshot.image[snap_idx];
+            unsigned int rank = placeSnapshotParticle(snap_idx, pos, img, h_cart_ranks.data);
+            if (rank >= n_ranks)
+                throw std::runtime_error("Error initializing from snapshot.");
+            return rank;
+            };
+
+        // on root, the snapshot index of every tag and the tags ordered by rank
+        std::vector<unsigned int> tag_snap_idx;
+        std::vector<unsigned int> rank_tags;
+        std::vector<unsigned int> rank_begin;
+        std::vector<unsigned int> N_proc; // Number of particles on every processor
 
-            BoxDim global_box = m_global_box;
+        if (my_rank == root)
+            {
+            std::vector<unsigned int> tag_rank;
+            tag_snap_idx.reserve(snapshot.size);
+            tag_rank.reserve(snapshot.size);
+            N_proc.resize(n_ranks, 0);
 
-            // loop over particles in snapshot, place them into domains
-            for (typename std::vector<vec3<Real>>::const_iterator it = snapshot.pos.begin();
-                 it != snapshot.pos.end();
-                 it++)
+            // tags are assigned in snapshot order
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                 {
-                unsigned int snap_idx = (unsigned int)(it - snapshot.pos.begin());
-
                 // if requested, do not initialize constituent particles of bodies
                 if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
                     {
                     continue;
                     }
 
-                // determine domain the particle is placed into
-                Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i = int(f.x * ((Scalar)di.getW()));
-                int j = int(f.y * ((Scalar)di.getH()));
-                int k = int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0, 0, 0);
-                if (i == (int)di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int)di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int)di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
-                int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank
-                    = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error()
-                        << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error()
-                        << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error()
-                        << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", "
-                                              << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", "
-                                              << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
-
-                // fill up per-processor data structures
-                pos_proc[rank].push_back(pos);
-                image_proc[rank].push_back(img);
-                vel_proc[rank].push_back(vec_to_scalar3(snapshot.vel[snap_idx]));
-                accel_proc[rank].push_back(vec_to_scalar3(snapshot.accel[snap_idx]));
-                type_proc[rank].push_back(snapshot.type[snap_idx]);
-                mass_proc[rank].push_back(snapshot.mass[snap_idx]);
-                charge_proc[rank].push_back(snapshot.charge[snap_idx]);
-                diameter_proc[rank].push_back(snapshot.diameter[snap_idx]);
-                body_proc[rank].push_back(snapshot.body[snap_idx]);
-                orientation_proc[rank].push_back(quat_to_scalar4(snapshot.orientation[snap_idx]));
-                angmom_proc[rank].push_back(quat_to_scalar4(snapshot.angmom[snap_idx]));
-                inertia_proc[rank].push_back(vec_to_scalar3(snapshot.inertia[snap_idx]));
-                tag_proc[rank].push_back(nglobal++);
+                Scalar3 pos;
+                int3 img;
+                unsigned int rank = place(snap_idx, pos, img);
+                tag_snap_idx.push_back(snap_idx);
+                tag_rank.push_back(rank);
                 N_proc[rank]++;
 
                 // determine max typeid on root rank
                 max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
                 }
+            nglobal = (unsigned int)tag_snap_idx.size();
+
+            // sort the tags by rank
+            rank_begin.resize(n_ranks, 0);
+            for (unsigned int rank = 1; rank < n_ranks; rank++)
+                rank_begin[rank] = rank_begin[rank - 1] + N_proc[rank - 1];
+            std::vector<unsigned int> rank_end(rank_begin);
+            rank_tags.resize(nglobal);
+            for (unsigned int tag = 0; tag < nglobal; tag++)
+                rank_tags[rank_end[tag_rank[tag]]++] = tag;
             }
 
         // get type mapping
@@ -1129,103 +1207,32 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // broadcast global number of particles
         bcast(nglobal, root, mpi_comm);
 
-        // resize array for reverse-lookup tags
-        m_rtag.resize(nglobal);
-
-        // Local particle data
-        std::vector<Scalar3> pos;
-        std::vector<Scalar3> vel;
-        std::vector<Scalar3> accel;
-        std::vector<unsigned int> type;
-        std::vector<Scalar> mass;
-        std::vector<Scalar> charge;
-        std::vector<Scalar> diameter;
-        std::vector<int3> image;
-        std::vector<unsigned int> body;
-        std::vector<Scalar4> orientation;
-        std::vector<Scalar4> angmom;
-        std::vector<Scalar3> inertia;
-        std::vector<unsigned int> tag;
-
-        // distribute particle data
-        scatter_v(pos_proc, pos, root, mpi_comm);
-        scatter_v(vel_proc, vel, root, mpi_comm);
-        scatter_v(accel_proc, accel, root, mpi_comm);
-        scatter_v(type_proc, type, root, mpi_comm);
-        scatter_v(mass_proc, mass, root, mpi_comm);
-        scatter_v(charge_proc, charge, root, mpi_comm);
-        scatter_v(diameter_proc, diameter, root, mpi_comm);
-        scatter_v(image_proc, image, root, mpi_comm);
-        scatter_v(body_proc, body, root, mpi_comm);
-        scatter_v(orientation_proc, orientation, root, mpi_comm);
-        scatter_v(angmom_proc, angmom, root, mpi_comm);
-        scatter_v(inertia_proc, inertia, root, mpi_comm);
-        scatter_v(tag_proc, tag, root, mpi_comm);
-
-        // distribute number of particles
-        scatter_v(N_proc, m_nparticles, root, mpi_comm);
-
-            {
-            // reset all reverse lookup tags to NOT_LOCAL flag
-            ArrayHandle<unsigned int> h_rtag(getRTags(),
-                                             access_location::host,
-                                             access_mode::overwrite);
-
-            // we have to reset all previous rtags, to remove 'leftover' ghosts
-            unsigned int max_tag = (unsigned int)m_rtag.size();
-            for (unsigned int tag = 0; tag < max_tag; tag++)
-                h_rtag.data[tag] = NOT_LOCAL;
-            }
-
-        // update list of active tags
-        for (unsigned int tag = 0; tag < nglobal; tag++)
+        // distribute particle data, root packs the particles of one chunk at a time
+        auto produce = [&](unsigned int rank, snapshot_element* values, unsigned int n)
             {
-            m_tag_set.insert(tag);
-            }
-
-        // Now that active tag list has changed, invalidate the cache
-        m_invalid_cached_tags = true;
-
-        // resize particle data
-        resize(m_nparticles);
-
-        // Load particle data
-        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
-        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
-        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_orientation(m_orientation,
-                                           access_location::host,
-                                           access_mode::overwrite);
-        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
-        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
-        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
-                                              access_location::host,
-                                              access_mode::overwrite);
-        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int tag = rank_tags[rank_begin[rank]++];
+                unsigned int snap_idx = tag_snap_idx[tag];
+                snapshot_element& p = values[i];
+                place(snap_idx, p.pos, p.image);
+                p.vel = vec_to_scalar3(snapshot.vel[snap_idx]);
+                p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+                p.type = snapshot.type[snap_idx];
+                p.mass = snapshot.mass[snap_idx];
+                p.charge = snapshot.charge[snap_idx];
+                p.diameter = snapshot.diameter[snap_idx];
+                p.body = snapshot.body[snap_idx];
+                p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+                p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+                p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+                p.tag = tag;
+                }
+            };
 
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            h_pos.data[idx]
-                = make_scalar4(pos[idx].x, pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
-            h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
-            h_accel.data[idx] = accel[idx];
-            h_charge.data[idx] = charge[idx];
-            h_diameter.data[idx] = diameter[idx];
-            h_image.data[idx] = image[idx];
-            h_tag.data[idx] = tag[idx];
-            h_rtag.data[tag[idx]] = idx;
-            h_body.data[idx] = body[idx];
-            h_orientation.data[idx] = orientation[idx];
-            h_angmom.data[idx] = angmom[idx];
-            h_inertia.data[idx] = inertia[idx];
-
-            h_comm_flag.data[idx] = 0; // initialize with zero
-            }
+        std::vector<snapshot_element> local;
+        scatter_chunked(N_proc, produce, local, root, mpi_comm);
+        setLocalParticles(local, nglobal);
         }
     else
 #endif
@@ -1371,164 +1378,100 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather a global snapshot
-        std::vector<Scalar3> pos(m_nparticles);
-        std::vector<Scalar3> vel(m_nparticles);
-        std::vector<Scalar3> accel(m_nparticles);
-        std::vector<unsigned int> type(m_nparticles);
-        std::vector<Scalar> mass(m_nparticles);
-        std::vector<Scalar> charge(m_nparticles);
-        std::vector<Scalar> diameter(m_nparticles);
-        std::vector<int3> image(m_nparticles);
-        std::vector<unsigned int> body(m_nparticles);
-        std::vector<Scalar4> orientation(m_nparticles);
-        std::vector<Scalar4> angmom(m_nparticles);
-        std::vector<Scalar3> inertia(m_nparticles);
-        std::vector<unsigned int> tag(m_nparticles);
-        std::map<unsigned int, unsigned int> rtag_map;
+        // pack the local particles
+        std::vector<snapshot_element> local(m_nparticles);
         for (unsigned int idx = 0; idx < m_nparticles; idx++)
             {
-            pos[idx]
+            snapshot_element& p = local[idx];
+            p.pos
                 = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
-            vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
-            accel[idx] = h_accel.data[idx];
-            type[idx] = __scalar_as_int(h_pos.data[idx].w);
-            mass[idx] = h_vel.data[idx].w;
-            charge[idx] = h_charge.data[idx];
-            diameter[idx] = h_diameter.data[idx];
-            image[idx] = h_image.data[idx];
-            image[idx].x -= m_o_image.x;
-            image[idx].y -= m_o_image.y;
-            image[idx].z -= m_o_image.z;
-            body[idx] = h_body.data[idx];
-            orientation[idx] = h_orientation.data[idx];
-            angmom[idx] = h_angmom.data[idx];
-            inertia[idx] = h_inertia.data[idx];
-
-            // insert reverse lookup global tag -> idx
-            rtag_map.insert(std::pair<unsigned int, unsigned int>(h_tag.data[idx], idx));
+            p.vel = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
+            p.accel = h_accel.data[idx];
+            p.type = __scalar_as_int(h_pos.data[idx].w);
+            p.mass = h_vel.data[idx].w;
+            p.charge = h_charge.data[idx];
+            p.diameter = h_diameter.data[idx];
+            p.image = h_image.data[idx];
+            p.image.x -= m_o_image.x;
+            p.image.y -= m_o_image.y;
+            p.image.z -= m_o_image.z;
+            p.body = h_body.data[idx];
+            p.orientation = h_orientation.data[idx];
+            p.angmom = h_angmom.data[idx];
+            p.inertia = h_inertia.data[idx];
+            p.tag = h_tag.data[idx];
             }
 
-        std::vector<std::vector<Scalar3>> pos_proc;       // Position array of every processor
-        std::vector<std::vector<Scalar3>> vel_proc;       // Velocities array of every processor
-        std::vector<std::vector<Scalar3>> accel_proc;     // Accelerations array of every processor
-        std::vector<std::vector<unsigned int>> type_proc; // Particle types array of every processor
-        std::vector<std::vector<Scalar>> mass_proc;   // Particle masses array of every processor
-        std::vector<std::vector<Scalar>> charge_proc; // Particle charges array of every processor
-        std::vector<std::vector<Scalar>>
-            diameter_proc;                         // Particle diameters array of every processor
-        std::vector<std::vector<int3>> image_proc; // Particle images array of every processor
-        std::vector<std::vector<unsigned int>> body_proc;   // Body ids of every processor
-        std::vector<std::vector<Scalar4>> orientation_proc; // Orientations of every processor
-        std::vector<std::vector<Scalar4>> angmom_proc;      // Angular momenta of every processor
-        std::vector<std::vector<Scalar3>> inertia_proc;     // Moments of inertia of every processor
-
-        std::vector<std::map<unsigned int, unsigned int>>
-            rtag_map_proc; // List of reverse-lookup maps
-
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
-        unsigned int rank = m_exec_conf->getRank();
-
-        // resize to number of ranks in communicator
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        rtag_map_proc.resize(size);
-
         unsigned int root = 0;
+        bool is_root = m_exec_conf->getRank() == root;
 
-        // collect all particle data on the root processor
-        gather_v(pos, pos_proc, root, mpi_comm);
-        gather_v(vel, vel_proc, root, mpi_comm);
-        gather_v(accel, accel_proc, root, mpi_comm);
-        gather_v(type, type_proc, root, mpi_comm);
-        gather_v(mass, mass_proc, root, mpi_comm);
-        gather_v(charge, charge_proc, root, mpi_comm);
-        gather_v(diameter, diameter_proc, root, mpi_comm);
-        gather_v(image, image_proc, root, mpi_comm);
-        gather_v(body, body_proc, root, mpi_comm);
-        gather_v(orientation, orientation_proc, root, mpi_comm);
-        gather_v(angmom, angmom_proc, root, mpi_comm);
-        gather_v(inertia, inertia_proc, root, mpi_comm);
-
-        // gather the reverse-lookup maps
-        gather_v(rtag_map, rtag_map_proc, root, mpi_comm);
-
-        if (rank == root)
+        // on root, the snapshot index of every tag, the snapshot is in tag order
+        std::vector<unsigned int> snap_ids;
+        std::vector<bool> found;
+        if (is_root)
             {
             // allocate memory in snapshot
             snapshot.resize(getNGlobal());
 
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            assert(rtag_map_proc.size() == n_ranks);
-
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int>> rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(
-                        std::pair<unsigned int, std::pair<unsigned int, unsigned int>>(
-                            it->first,
-                            std::pair<unsigned int, unsigned int>(irank, it->second)));
-
-            // add particles to snapshot
             assert(m_tag_set.size() == getNGlobal());
-            std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
-
-            std::map<unsigned int, std::pair<unsigned int, unsigned int>>::iterator rank_rtag_it;
-            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
+            if (!m_tag_set.empty())
+                snap_ids.resize(getMaximumTag() + 1, NOT_LOCAL);
+            unsigned int snap_id = 0;
+            for (auto it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
                 {
-                unsigned int tag = *tag_set_it;
-                assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
-
-                if (rank_rtag_it == rank_rtag_map.end())
-                    {
-                    m_exec_conf->msg->error()
-                        << endl
-                        << "Could not find particle " << tag << " on any processor. " << endl
-                        << endl;
-                    throw std::runtime_error("Error gathering ParticleData");
-                    }
-
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
+                snap_ids[*it] = snap_id;
 
                 // store tag in index map
-                index.insert(std::make_pair(tag, snap_id));
-
-                snapshot.pos[snap_id] = vec3<Real>(pos_proc[rank][idx]);
-                snapshot.vel[snap_id] = vec3<Real>(vel_proc[rank][idx]);
-                snapshot.accel[snap_id] = vec3<Real>(accel_proc[rank][idx]);
-                snapshot.type[snap_id] = type_proc[rank][idx];
-                snapshot.mass[snap_id] = Real(mass_proc[rank][idx]);
-                snapshot.charge[snap_id] = Real(charge_proc[rank][idx]);
-                snapshot.diameter[snap_id] = Real(diameter_proc[rank][idx]);
-                snapshot.image[snap_id] = image_proc[rank][idx];
-                snapshot.body[snap_id] = body_proc[rank][idx];
-                snapshot.orientation[snap_id] = quat<Real>(orientation_proc[rank][idx]);
-                snapshot.angmom[snap_id] = quat<Real>(angmom_proc[rank][idx]);
-                snapshot.inertia[snap_id] = vec3<Real>(inertia_proc[rank][idx]);
+                index.insert(index.end(), std::make_pair(*it, snap_id));
+                snap_id++;
+                }
+            found.resize(getNGlobal(), false);
+            }
+
+        // collect all particle data on the root processor, one chunk at a time
+        auto consume = [&](const snapshot_element* values, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                const snapshot_element& p = values[i];
+                assert(p.tag < snap_ids.size());
+                unsigned int snap_id = snap_ids[p.tag];
+                found[snap_id] = true;
+
+                snapshot.pos[snap_id] = vec3<Real>(p.pos);
+                snapshot.vel[snap_id] = vec3<Real>(p.vel);
+                snapshot.accel[snap_id] = vec3<Real>(p.accel);
+                snapshot.type[snap_id] = p.type;
+                snapshot.mass[snap_id] = Real(p.mass);
+                snapshot.charge[snap_id] = Real(p.charge);
+                snapshot.diameter[snap_id] = Real(p.diameter);
+                snapshot.image[snap_id] = p.image;
+                snapshot.body[snap_id] = p.body;
+                snapshot.orientation[snap_id] = quat<Real>(p.orientation);
+                snapshot.angmom[snap_id] = quat<Real>(p.angmom);
+                snapshot.inertia[snap_id] = vec3<Real>(p.inertia);
 
                 // make sure the position stored in the snapshot is within the boundaries
                 Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
                 m_global_box.wrap(tmp, snapshot.image[snap_id]);
                 snapshot.pos[snap_id] = vec3<Real>(tmp);
+                }
+            };
 
-                std::advance(tag_set_it, 1);
+        gather_chunked(local, consume, root, mpi_comm);
+
+        if (is_root)
+            {
+            std::vector<bool>::iterator missing = std::find(found.begin(), found.end(), false);
+            if (missing != found.end())
+                {
+                unsigned int tag = *std::next(m_tag_set.begin(), missing - found.begin());
+                m_exec_conf->msg->error()
+                    << endl
+                    << "Could not find particle " << tag << " on any processor. " << endl
+                    << endl;
+                throw std::runtime_error("Error gathering ParticleData");
                 }
             }
         }
@@ -1587,6 +1530,322 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
     return index;
     }
 
+/*! \param tags Tags of the particles of this rank
+    \param nglobal Total number of particles on all ranks
+    \returns true on all ranks if the tags of all ranks together are 0 to nglobal - 1, each once
+
+    In parallel simulations, every rank checks one contiguous block of tags, so that no rank needs
+    to hold all tags.
+*/
+bool ParticleData::checkDistributedTags(const std::vector<unsigned int>& tags, unsigned int nglobal)
+    {
+    int valid = 1;
+    unsigned int n_ranks = 1;
+    unsigned int rank = 0;
+
+    // the tags in the block of this rank
+    std::vector<unsigned int> block_tags;
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        n_ranks = m_exec_conf->getNRanks();
+        rank = m_exec_conf->getRank();
+
+        // send every tag to the rank that checks it, block r holds the tags t with t * n_ranks /
+        // nglobal == r
+        std::vector<int> send_counts(n_ranks, 0);
+        for (auto it = tags.begin(); it != tags.end(); ++it)
+            {
+            if (*it >= nglobal)
+                valid = 0;
+            else
+                send_counts[(unsigned long long)*it * n_ranks / nglobal]++;
+            }
+
+        std::vector<int> send_begin(n_ranks, 0);
+        for (unsigned int i = 1; i < n_ranks; i++)
+            send_begin[i] = send_begin[i - 1] + send_counts[i - 1];
+        std::vector<unsigned int> sendbuf(send_begin.back() + send_counts.back());
+        for (auto it = tags.begin(); it != tags.end(); ++it)
+            {
+            if (*it < nglobal)
+                sendbuf[send_begin[(unsigned long long)*it * n_ranks / nglobal]++] = *it;
+            }
+
+        all_to_all_v(sendbuf, send_counts, block_tags, m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        block_tags = tags;
+        }
+
+    // the first tag of block r is ceil(r * nglobal / n_ranks)
+    unsigned long long n = nglobal;
+    unsigned int begin = (unsigned int)((n * rank + n_ranks - 1) / n_ranks);
+    unsigned int end = (unsigned int)((n * (rank + 1) + n_ranks - 1) / n_ranks);
+
+    // with every tag in range and no duplicates, the block is complete if the count matches
+    if (block_tags.size() != end - begin)
+        valid = 0;
+
+    std::vector<bool> seen(end - begin, false);
+    for (auto it = block_tags.begin(); it != block_tags.end() && valid; ++it)
+        {
+        if (*it < begin || *it >= end || seen[*it - begin])
+            valid = 0;
+        else
+            seen[*it - begin] = true;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &valid,
+                      1,
+                      MPI_INT,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return valid;
+    }
+
+//! Initialize from the slices of a distributed snapshot
+/*! \param snapshot The particles of this rank
+    \param tags Global tag of every particle in \a snapshot
+
+    Every rank passes its own slice of the particles, which may be empty. Together, the slices must
+    hold the tags 0 to N-1, each exactly once, where N is the total number of particles in all
+    slices. In parallel simulations, every rank sends the particles of its slice directly to the
+    ranks that own them, so no rank ever holds more than its slice and its local particles. The
+    type mapping is taken from rank 0.
+*/
+template<class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                                     const std::vector<unsigned int>& tags)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot"
+                                << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    int valid = snapshot.validate() && tags.size() == snapshot.size;
+    int accel_set = snapshot.is_accel_set;
+    unsigned int nglobal = snapshot.size;
+    m_type_mapping = snapshot.type_mapping;
+
+#ifdef ENABLE_MPI
+    // check the slices of all ranks before sending particles, so that all ranks throw together
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &accel_set, 1, MPI_INT, MPI_LOR, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        bcast(m_type_mapping, 0, mpi_comm);
+        }
+#endif
+
+    if (!valid)
+        {
+        throw std::runtime_error("Invalid particle data in snapshot.");
+        }
+
+    if (!checkDistributedTags(tags, nglobal))
+        {
+        m_exec_conf->msg->error() << "init.*: the particle tags of a distributed snapshot must be "
+                                  << "0 to " << nglobal << "-1, each on exactly one rank."
+                                  << std::endl;
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    // it is an error for particles of any slice to be outside of the box
+    if (!inBox(snapshot, true))
+        {
+        m_exec_conf->msg->error() << "init.*: Not all particles were found inside the given box."
+                                  << std::endl;
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    // pack the particles of the slice
+    unsigned int max_typeid = 0;
+    std::vector<snapshot_element> slice(snapshot.size);
+    for (unsigned int i = 0; i < snapshot.size; i++)
+        {
+        snapshot_element& p = slice[i];
+        p.pos = vec_to_scalar3(snapshot.pos[i]);
+        p.vel = vec_to_scalar3(snapshot.vel[i]);
+        p.accel = vec_to_scalar3(snapshot.accel[i]);
+        p.type = snapshot.type[i];
+        p.mass = snapshot.mass[i];
+        p.charge = snapshot.charge[i];
+        p.diameter = snapshot.diameter[i];
+        p.image = snapshot.image[i];
+        p.body = snapshot.body[i];
+        p.orientation = quat_to_scalar4(snapshot.orientation[i]);
+        p.angmom = quat_to_scalar4(snapshot.angmom[i]);
+        p.inertia = vec_to_scalar3(snapshot.inertia[i]);
+        p.tag = tags[i];
+
+        max_typeid = std::max(max_typeid, p.type);
+        }
+
+    std::vector<snapshot_element> local;
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+
+        // determine the rank that owns every particle of the slice
+        std::vector<unsigned int> dest(slice.size());
+        std::vector<int> send_counts(n_ranks, 0);
+        int out_of_bounds = 0;
+
+            {
+            ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                                   access_location::host,
+                                                   access_mode::read);
+
+            for (unsigned int i = 0; i < slice.size(); i++)
+                {
+                unsigned int rank = placeSnapshotParticle(slice[i].tag,
+                                                          slice[i].pos,
+                                                          slice[i].image,
+                                                          h_cart_ranks.data);
+                if (rank >= n_ranks)
+                    {
+                    out_of_bounds = 1;
+                    rank = m_exec_conf->getRank();
+                    }
+                dest[i] = rank;
+                send_counts[rank]++;
+                }
+            }
+
+        MPI_Allreduce(MPI_IN_PLACE, &out_of_bounds, 1, MPI_INT, MPI_LOR, mpi_comm);
+        if (out_of_bounds)
+            {
+            throw std::runtime_error("Error initializing from snapshot.");
+            }
+
+        // sort the particles by rank and send them to their owners
+        std::vector<int> send_begin(n_ranks, 0);
+        for (unsigned int rank = 1; rank < n_ranks; rank++)
+            send_begin[rank] = send_begin[rank - 1] + send_counts[rank - 1];
+        std::vector<snapshot_element> sendbuf(slice.size());
+        for (unsigned int i = 0; i < slice.size(); i++)
+            sendbuf[send_begin[dest[i]]++] = slice[i];
+        std::vector<snapshot_element>().swap(slice);
+
+        all_to_all_v(sendbuf, send_counts, local, mpi_comm);
+
+        MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+        }
+    else
+#endif
+        {
+        local.swap(slice);
+        }
+
+    setLocalParticles(local, nglobal);
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+
+    if (nglobal != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+
+//! Take the local slice of a distributed snapshot
+/*! \param snapshot The snapshot to write the local particles to
+    \param tags Filled with the tag of every particle in \a snapshot
+
+    Every rank writes the particles it owns, in local index order and without any communication.
+*/
+template<class Real>
+void ParticleData::takeDistributedSnapshot(SnapshotParticleData<Real>& snapshot,
+                                           std::vector<unsigned int>& tags)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: taking distributed snapshot" << std::endl;
+
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_orientation, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+
+    snapshot.resize(m_nparticles);
+    tags.resize(m_nparticles);
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        snapshot.pos[idx] = vec3<Real>(
+            make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin);
+        snapshot.vel[idx]
+            = vec3<Real>(make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z));
+        snapshot.accel[idx] = vec3<Real>(h_accel.data[idx]);
+        snapshot.type[idx] = __scalar_as_int(h_pos.data[idx].w);
+        snapshot.mass[idx] = Real(h_vel.data[idx].w);
+        snapshot.charge[idx] = Real(h_charge.data[idx]);
+        snapshot.diameter[idx] = Real(h_diameter.data[idx]);
+        snapshot.image[idx] = h_image.data[idx];
+        snapshot.image[idx].x -= m_o_image.x;
+        snapshot.image[idx].y -= m_o_image.y;
+        snapshot.image[idx].z -= m_o_image.z;
+        snapshot.body[idx] = h_body.data[idx];
+        snapshot.orientation[idx] = quat<Real>(h_orientation.data[idx]);
+        snapshot.angmom[idx] = quat<Real>(h_angmom.data[idx]);
+        snapshot.inertia[idx] = vec3<Real>(h_inertia.data[idx]);
+        tags[idx] = h_tag.data[idx];
+
+        // make sure the position stored in the snapshot is within the boundaries
+        Scalar3 tmp = vec_to_scalar3(snapshot.pos[idx]);
+        m_global_box.wrap(tmp, snapshot.image[idx]);
+        snapshot.pos[idx] = vec3<Real>(tmp);
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+    snapshot.is_accel_set = m_accel_set;
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -2717,6 +2976,11 @@ ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>&
                                              bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template void ParticleData::initializeFromDistributedSnapshot<double>(
+    const SnapshotParticleData<double>& snapshot,
+    const std::vector<unsigned int>& tags);
+template void ParticleData::takeDistributedSnapshot<double>(SnapshotParticleData<double>& snapshot,
+                                                            std::vector<unsigned int>& tags);
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const BoxDim& global_box,
@@ -2727,6 +2991,11 @@ ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& s
                                             bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template void ParticleData::initializeFromDistributedSnapshot<float>(
+    const SnapshotParticleData<float>& snapshot,
+    const std::vector<unsigned int>& tags);
+template void ParticleData::takeDistributedSnapshot<float>(SnapshotParticleData<float>& snapshot,
+                                                           std::vector<unsigned int>& tags);
 
 void export_ParticleData(py::module& m)
     {
@@ -2779,6 +3048,7 @@ void export_ParticleData(py::module& m)
         .def("setAngularMomentum", &ParticleData::setAngularMomentum)
         .def("setMomentsOfInertia", &ParticleData::setMomentsOfInertia)
         .def("setPressureFlag", &ParticleData::setPressureFlag)
+        .def("setEnergyFlag", &ParticleData::setEnergyFlag)
         .def("getMaximumTag", &ParticleData::getMaximumTag)
         .def("addParticle", &ParticleData::addParticle)
         .def("removeParticle", &ParticleData::removeParticle)
@@ -2848,15 +3118,6 @@ template<class Real> bool SnapshotParticleData<Real>::validate() const
     }
 
 #ifdef ENABLE_MPI
-//! Select non-zero communication lags
-struct comm_flag_select : std::unary_function<const unsigned int, bool>
-    {
-    bool operator()(const unsigned int comm_flag) const
-        {
-        return comm_flag;
-        }
-    };
-
 /*! \note This method may only be used during communication or when
  *        no ghost particles are present, because ghost particle values
  *        are undefined after calling this method.
@@ -2864,40 +3125,96 @@ struct comm_flag_select : std::unary_function<const unsigned int, bool>
 void ParticleData::removeParticles(std::vector<pdata_element>& out,
                                    std::vector<unsigned int>& comm_flags)
     {
+    packParticles(out, comm_flags);
+    compactParticles();
+    }
+
+void ParticleData::packParticles(std::vector<pdata_element>& out,
+                                 std::vector<unsigned int>& comm_flags)
+    {
     if (m_prof)
         m_prof->push("pack");
 
-    unsigned int num_remove_ptls = 0;
+    // the buffers keep their capacity from previous calls
+    out.clear();
+    comm_flags.clear();
 
         {
-        // access particle data tags and rtags
+        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(getAngularMomentumArray(),
+                                      access_location::host,
+                                      access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(getMomentsOfInertiaArray(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_torque(getNetTorqueArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(getNetVirial(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
         ArrayHandle<unsigned int> h_comm_flags(getCommFlags(),
                                                access_location::host,
                                                access_mode::read);
 
-        // set all rtags of ptls with comm_flag != 0 to NOT_LOCAL and count removed particles
+        unsigned int net_virial_pitch = (unsigned int)m_net_virial.getPitch();
         unsigned int N = getN();
         for (unsigned int i = 0; i < N; ++i)
-            if (h_comm_flags.data[i])
-                {
-                unsigned int tag = h_tag.data[i];
-                assert(tag <= getMaximumTag());
-                h_rtag.data[tag] = NOT_LOCAL;
-                num_remove_ptls++;
-                }
+            {
+            if (!h_comm_flags.data[i])
+                continue;
+
+            unsigned int tag = h_tag.data[i];
+            assert(tag <= getMaximumTag());
+            h_rtag.data[tag] = NOT_LOCAL;
+
+            // write to packed array
+            pdata_element p;
+            p.pos = h_pos.data[i];
+            p.vel = h_vel.data[i];
+            p.accel = h_accel.data[i];
+            p.charge = h_charge.data[i];
+            p.diameter = h_diameter.data[i];
+            p.image = h_image.data[i];
+            p.body = h_body.data[i];
+            p.orientation = h_orientation.data[i];
+            p.angmom = h_angmom.data[i];
+            p.inertia = h_inertia.data[i];
+            p.net_force = h_net_force.data[i];
+            p.net_torque = h_net_torque.data[i];
+            for (unsigned int j = 0; j < 6; ++j)
+                p.net_virial[j] = h_net_virial.data[net_virial_pitch * j + i];
+            p.tag = tag;
+            out.push_back(p);
+            comm_flags.push_back(h_comm_flags.data[i]);
+            }
         }
 
-    unsigned int old_nparticles = getN();
-    unsigned int new_nparticles = m_nparticles - num_remove_ptls;
+    if (m_prof)
+        m_prof->pop();
+    }
 
-    // resize output buffers
-    out.resize(num_remove_ptls);
-    comm_flags.resize(num_remove_ptls);
+/*! \note This method may only be used during communication or when
+ *        no ghost particles are present, because ghost particle values
+ *        are undefined after calling this method.
+ */
+void ParticleData::compactParticles()
+    {
+    if (m_prof)
+        m_prof->push("compact");
 
-    // resize particle data using amortized O(1) array resizing
-    resize(new_nparticles);
+    unsigned int old_nparticles = getN();
+    unsigned int n = 0;
 
         {
         // access particle data arrays
@@ -2932,147 +3249,57 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
         ArrayHandle<Scalar> h_net_virial(getNetVirial(),
                                          access_location::host,
                                          access_mode::readwrite);
-
         ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
-
-        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::read);
-
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
         ArrayHandle<unsigned int> h_comm_flags(getCommFlags(),
                                                access_location::host,
                                                access_mode::readwrite);
 
-        ArrayHandle<Scalar4> h_pos_alt(m_pos_alt, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_vel_alt(m_vel_alt, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar3> h_accel_alt(m_accel_alt,
-                                         access_location::host,
-                                         access_mode::overwrite);
-        ArrayHandle<Scalar> h_charge_alt(m_charge_alt,
-                                         access_location::host,
-                                         access_mode::overwrite);
-        ArrayHandle<Scalar> h_diameter_alt(m_diameter_alt,
-                                           access_location::host,
-                                           access_mode::overwrite);
-        ArrayHandle<int3> h_image_alt(m_image_alt, access_location::host, access_mode::overwrite);
-        ArrayHandle<unsigned int> h_body_alt(m_body_alt,
-                                             access_location::host,
-                                             access_mode::overwrite);
-        ArrayHandle<Scalar4> h_orientation_alt(m_orientation_alt,
-                                               access_location::host,
-                                               access_mode::overwrite);
-        ArrayHandle<Scalar4> h_angmom_alt(m_angmom_alt,
-                                          access_location::host,
-                                          access_mode::overwrite);
-        ArrayHandle<Scalar3> h_inertia_alt(m_inertia_alt,
-                                           access_location::host,
-                                           access_mode::overwrite);
-        ArrayHandle<Scalar4> h_net_force_alt(m_net_force_alt,
-                                             access_location::host,
-                                             access_mode::overwrite);
-        ArrayHandle<Scalar4> h_net_torque_alt(m_net_torque_alt,
-                                              access_location::host,
-                                              access_mode::overwrite);
-        ArrayHandle<Scalar> h_net_virial_alt(m_net_virial_alt,
-                                             access_location::host,
-                                             access_mode::overwrite);
-        ArrayHandle<unsigned int> h_tag_alt(m_tag_alt,
-                                            access_location::host,
-                                            access_mode::overwrite);
-
-        unsigned int n = 0;
-        unsigned int m = 0;
+        // move the remaining particles down in place, in a single pass over all fields. The
+        // particles before the first removed one stay where they are.
         unsigned int net_virial_pitch = (unsigned int)m_net_virial.getPitch();
         for (unsigned int i = 0; i < old_nparticles; ++i)
             {
-            unsigned int tag = h_tag.data[i];
-            if (h_rtag.data[tag] != NOT_LOCAL)
+            if (h_comm_flags.data[i])
+                continue;
+
+            if (n != i)
                 {
-                // copy over to alternate pdata arrays
-                h_pos_alt.data[n] = h_pos.data[i];
-                h_vel_alt.data[n] = h_vel.data[i];
-                h_accel_alt.data[n] = h_accel.data[i];
-                h_charge_alt.data[n] = h_charge.data[i];
-                h_diameter_alt.data[n] = h_diameter.data[i];
-                h_image_alt.data[n] = h_image.data[i];
-                h_body_alt.data[n] = h_body.data[i];
-                h_orientation_alt.data[n] = h_orientation.data[i];
-                h_angmom_alt.data[n] = h_angmom.data[i];
-                h_inertia_alt.data[n] = h_inertia.data[i];
-                h_net_force_alt.data[n] = h_net_force.data[i];
-                h_net_torque_alt.data[n] = h_net_torque.data[i];
+                h_pos.data[n] = h_pos.data[i];
+                h_vel.data[n] = h_vel.data[i];
+                h_accel.data[n] = h_accel.data[i];
+                h_charge.data[n] = h_charge.data[i];
+                h_diameter.data[n] = h_diameter.data[i];
+                h_image.data[n] = h_image.data[i];
+                h_body.data[n] = h_body.data[i];
+                h_orientation.data[n] = h_orientation.data[i];
+                h_angmom.data[n] = h_angmom.data[i];
+                h_inertia.data[n] = h_inertia.data[i];
+                h_net_force.data[n] = h_net_force.data[i];
+                h_net_torque.data[n] = h_net_torque.data[i];
                 for (unsigned int j = 0; j < 6; ++j)
-                    h_net_virial_alt.data[net_virial_pitch * j + n]
+                    h_net_virial.data[net_virial_pitch * j + n]
                         = h_net_virial.data[net_virial_pitch * j + i];
-                h_tag_alt.data[n] = h_tag.data[i];
-                ++n;
-                }
-            else
-                {
-                // write to packed array
-                pdata_element p;
-                p.pos = h_pos.data[i];
-                p.vel = h_vel.data[i];
-                p.accel = h_accel.data[i];
-                p.charge = h_charge.data[i];
-                p.diameter = h_diameter.data[i];
-                p.image = h_image.data[i];
-                p.body = h_body.data[i];
-                p.orientation = h_orientation.data[i];
-                p.angmom = h_angmom.data[i];
-                p.inertia = h_inertia.data[i];
-                p.net_force = h_net_force.data[i];
-                p.net_torque = h_net_torque.data[i];
-                for (unsigned int j = 0; j < 6; ++j)
-                    p.net_virial[j] = h_net_virial.data[net_virial_pitch * j + i];
-                p.tag = h_tag.data[i];
-                out[m++] = p;
+
+                unsigned int tag = h_tag.data[i];
+                assert(tag <= getMaximumTag());
+                h_tag.data[n] = tag;
+                h_rtag.data[tag] = n;
+                h_comm_flags.data[n] = 0;
                 }
+            ++n;
             }
-
-        // write out non-zero communication flags
-        std::remove_copy_if(h_comm_flags.data,
-                            h_comm_flags.data + old_nparticles,
-                            comm_flags.begin(),
-                            std::not1(comm_flag_select()));
-
-        // reset communication flags to zero
-        std::fill(h_comm_flags.data, h_comm_flags.data + new_nparticles, 0);
         }
 
-    // swap particle data arrays
-    swapPositions();
-    swapVelocities();
-    swapAccelerations();
-    swapCharges();
-    swapDiameters();
-    swapImages();
-    swapBodies();
-    swapOrientations();
-    swapAngularMomenta();
-    swapMomentsOfInertia();
-    swapNetForce();
-    swapNetTorque();
-    swapNetVirial();
-    swapTags();
-
-        {
-        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::read);
-
-        // recompute rtags (particles have moved)
-        for (unsigned int idx = 0; idx < m_nparticles; ++idx)
-            {
-            // reset rtag of this ptl
-            unsigned int tag = h_tag.data[idx];
-            assert(tag <= getMaximumTag());
-            h_rtag.data[tag] = idx;
-            }
-        }
+    // shrinking does not reallocate the arrays
+    resize(n);
 
     if (m_prof)
         m_prof->pop();
 
     // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    if (n != old_nparticles)
+        notifyParticleSort();
     }
 
 //! Remove particles from local domain and append new particle data
@@ -3155,10 +3382,9 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
         // reset communication flags
         std::fill(h_comm_flags.data + old_nparticles, h_comm_flags.data + new_nparticles, 0);
 
-        // recompute rtags
-        for (unsigned int idx = 0; idx < m_nparticles; ++idx)
+        // set the rtags of the new particles, the others did not move
+        for (unsigned int idx = old_nparticles; idx < new_nparticles; ++idx)
             {
-            // reset rtag of this ptl
             unsigned int tag = h_tag.data[idx];
             assert(tag <= getMaximumTag());
             h_rtag.data[tag] = idx;
@@ -3169,7 +3395,8 @@ void ParticleData::addParticles(const std::vector<pdata_element>& in)
         m_prof->pop();
 
     // notify subscribers that particle data order has been changed
-    notifyParticleSort();
+    if (num_add_ptls)
+        notifyParticleSort();
     }
 
 #ifdef ENABLE_HIP
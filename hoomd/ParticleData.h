@@ -81,8 +81,10 @@ struct pdata_flag
         {
         pressure_tensor = 0,       //!< Bit id in PDataFlags for the full virial
         rotational_kinetic_energy, //!< Bit id in PDataFlags for the rotational kinetic energy
-        external_field_virial      //!< Bit id in PDataFlags for the external virial contribution of
+        external_field_virial,     //!< Bit id in PDataFlags for the external virial contribution of
                                    //!< volume change
+        potential_energy,          //!< Bit id in PDataFlags for the per-particle potential energy
+        skip_potential_energy      //!< Bit id in PDataFlags to leave the potential energy out
         };
     };
 
@@ -271,6 +273,26 @@ struct pdata_element
     Scalar net_virial[6]; //!< net virial
     };
 
+//! Particle record that snapshots gather, scatter and exchange
+/*! Unlike pdata_element, it carries only the fields in the snapshot.
+ */
+struct snapshot_element
+    {
+    Scalar3 pos;         //!< Position
+    Scalar3 vel;         //!< Velocity
+    Scalar3 accel;       //!< Acceleration
+    Scalar3 inertia;     //!< Moments of inertia
+    Scalar4 orientation; //!< Orientation
+    Scalar4 angmom;      //!< Angular momentum
+    Scalar mass;         //!< Mass
+    Scalar charge;       //!< Charge
+    Scalar diameter;     //!< Diameter
+    int3 image;          //!< Image
+    unsigned int type;   //!< Type id
+    unsigned int body;   //!< Body id
+    unsigned int tag;    //!< Global tag
+    };
+
 //! Manages all of the data arrays for the particles
 /*! <h1> General </h1>
     ParticleData stores and manages particle coordinates, velocities, accelerations, type,
@@ -319,6 +341,10 @@ struct pdata_element
     These fields are:
      - pdata_flag::pressure_tensor - specify that the full virial tensor is valid
      - pdata_flag::external_field_virial - specify that an external virial contribution is valid
+     - pdata_flag::potential_energy - request the potential energy in the net force
+     - pdata_flag::skip_potential_energy - specify that the potential energy in the net force is
+       not valid. System sets it when no object requests pdata_flag::potential_energy, so flags
+       set without it keep the energy.
 
     If these flags are not set, these arrays can still be read but their values may be incorrect.
 
@@ -1126,6 +1152,13 @@ class PYBIND11_EXPORT ParticleData
         m_flags[pdata_flag::pressure_tensor] = 1;
         }
 
+    /// Enable potential energy computations
+    void setEnergyFlag()
+        {
+        m_flags[pdata_flag::potential_energy] = 1;
+        m_flags[pdata_flag::skip_potential_energy] = 0;
+        }
+
     //! Set the external contribution to the virial
     void setExternalVirial(unsigned int i, Scalar v)
         {
@@ -1167,6 +1200,16 @@ class PYBIND11_EXPORT ParticleData
     template<class Real>
     std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
+    //! Initialize from the slices of a distributed snapshot
+    template<class Real>
+    void initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                           const std::vector<unsigned int>& tags);
+
+    //! Take the local slice of a distributed snapshot
+    template<class Real>
+    void takeDistributedSnapshot(SnapshotParticleData<Real>& snapshot,
+                                 std::vector<unsigned int>& tags);
+
     //! Add ghost particles at the end of the local particle data
     void addGhostParticles(const unsigned int nghosts);
 
@@ -1210,6 +1253,24 @@ class PYBIND11_EXPORT ParticleData
      */
     void removeParticles(std::vector<pdata_element>& out, std::vector<unsigned int>& comm_flags);
 
+    //! Pack the particles flagged for sending into a buffer
+    /*! \param out Buffer into which particle data is packed
+     *  \param comm_flags Buffer into which communication flags is packed
+     *
+     *  Packs all particles for which comm_flag>0 and marks them as not local. The particles stay
+     *  in the particle data arrays until compactParticles() is called, so that the packed data can
+     *  be sent while the arrays are compacted. The buffers keep their capacity between calls.
+     */
+    void packParticles(std::vector<pdata_element>& out, std::vector<unsigned int>& comm_flags);
+
+    //! Remove the particles flagged for sending from the particle data
+    /*! The remaining particles are moved down in place.
+     *
+     *  \post The particle data arrays remain compact. Any ghost atoms
+     *        are invalidated.
+     */
+    void compactParticles();
+
     //! Add new local particles
     /*! \param in List of particle data elements to fill the particle data with
      */
@@ -1415,8 +1476,24 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to check that particles of a snapshot are in the box
     /*! \return true If and only if all particles are in the simulation box
      * \param Snapshot to check
+     * \param distributed True when every rank checks its own slice of a distributed snapshot
      */
-    template<class Real> bool inBox(const SnapshotParticleData<Real>& snap);
+    template<class Real>
+    bool inBox(const SnapshotParticleData<Real>& snap, bool distributed = false);
+
+#ifdef ENABLE_MPI
+    //! Helper function to wrap a snapshot particle into the box and find the rank that owns it
+    unsigned int placeSnapshotParticle(unsigned int idx,
+                                       Scalar3& pos,
+                                       int3& img,
+                                       const unsigned int* cart_ranks);
+#endif
+
+    //! Helper function to replace the local particles, used when initializing from snapshots
+    void setLocalParticles(const std::vector<snapshot_element>& local, unsigned int nglobal);
+
+    //! Helper function to check that the tags of a distributed snapshot are 0 to nglobal - 1
+    bool checkDistributedTags(const std::vector<unsigned int>& tags, unsigned int nglobal);
 
     //! Update the CUDA memory hints
     void setGPUAdvice();
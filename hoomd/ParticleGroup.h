@@ -240,13 +240,20 @@ class PYBIND11_EXPORT ParticleGroup
         return h_handle.data[idx] == 1;
         }
 
+    //! Number of group members summed serially before the partial sums are combined
+    /*! Threaded reductions over the group members split them into blocks of this size, so that
+        the partial sums and the result do not depend on the number of threads.
+    */
+    static const unsigned int reduction_block_size = 512;
+
     //! Direct access to the index list
     /*! \returns A GPUArray for directly accessing the index list, intended for use in using groups
        on the GPU \note The caller \b must \b not write to or change the array.
 
         \note This method CAN access the particle data tag array if the index is rebuilt.
               Hence, the tag array may not be accessed in the same scope in which this method is
-       called.
+              called. Callers that need both acquire the handle to the index array first: once
+              the index is rebuilt, the handle stays valid while the tag array is accessed.
     */
     const GlobalArray<unsigned int>& getIndexArray() const
         {
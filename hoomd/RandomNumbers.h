@@ -25,6 +25,10 @@
 #include <type_traits>
 #pragma GCC diagnostic pop
 
+#if !defined(__HIPCC__) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace r123
     {
 using std::make_signed;
@@ -264,6 +268,236 @@ DEVICE inline r123::Philox4x32::ctr_type RandomGenerator::operator()()
     return u;
     }
 
+#ifndef __HIPCC__
+//! Replays a stream of precomputed random values
+/*! RandomStream is a drop in replacement for RandomGenerator in the distributions below. It returns
+    the values that RandomGeneratorBatch precomputed for one counter and evaluates the Philox
+    generator itself for any values past the end of the batch. The sequence is identical to that of
+    a RandomGenerator constructed from the same Seed and Counter.
+*/
+class RandomStream
+    {
+    public:
+    /** Construct a stream
+
+        @param key RNG key.
+        @param counter Initial value of the RNG counter.
+        @param values Precomputed values for the first *n_values* steps of the stream.
+        @param n_values Number of precomputed values.
+    */
+    RandomStream(const r123::Philox4x32::key_type& key,
+                 const r123::Philox4x32::ctr_type& counter,
+                 const r123::Philox4x32::ctr_type* values,
+                 unsigned int n_values)
+        : m_key(key), m_ctr(counter), m_values(values), m_n_values(n_values), m_step(0)
+        {
+        }
+
+    /// Generate uniformly distributed 128-bit values
+    inline r123::Philox4x32::ctr_type operator()()
+        {
+        r123::Philox4x32::ctr_type u;
+        if (m_step < m_n_values)
+            {
+            u = m_values[m_step];
+            }
+        else
+            {
+            r123::Philox4x32 rng;
+            r123::Philox4x32::ctr_type ctr = m_ctr;
+            ctr.v[0] += m_step;
+            u = rng(ctr, m_key);
+            }
+        m_step++;
+        return u;
+        }
+
+    private:
+    r123::Philox4x32::key_type m_key;           //!< RNG key
+    r123::Philox4x32::ctr_type m_ctr;           //!< Initial RNG counter
+    const r123::Philox4x32::ctr_type* m_values; //!< Precomputed values
+    unsigned int m_n_values;                    //!< Number of precomputed values
+    unsigned int m_step;                        //!< Number of values drawn so far
+    };
+
+//! Philox random number generator evaluated for many counters at once
+/*! Loops that construct one RandomGenerator per particle (or pair) spend much of their time in the
+    10 rounds of Philox, which the compiler cannot vectorize across loop iterations.
+    RandomGeneratorBatch evaluates the first *n_values* steps of up to #width streams that share
+    one Seed in a single pass. The rounds use AVX2 integer multiplies when the compiler targets
+    AVX2, and a portable loop over the streams otherwise.
+
+    Fill the streams with setStream(), call generate(), and pass the RandomStream returned by
+    getStream() to the distributions in place of a RandomGenerator:
+
+    \code
+    RandomGeneratorBatch batch(hoomd::Seed(id, timestep, seed), 3);
+    for (unsigned int lane = 0; lane < n; lane++)
+        batch.setStream(lane, hoomd::Counter(tag[lane]));
+    batch.generate(n);
+    ...
+    RandomStream rng = batch.getStream(lane);
+    Scalar x = UniformDistribution<Scalar>(-1, 1)(rng);
+    \endcode
+
+    Each stream produces exactly the same values as RandomGenerator(seed, counter) so results do not
+    depend on whether the batch or the scalar generator is used. Streams may draw more than
+    *n_values* values, the extra values are evaluated one at a time.
+*/
+class RandomGeneratorBatch
+    {
+    public:
+    /// Number of streams evaluated together
+    static const unsigned int width = 8;
+
+    /// Maximum number of values precomputed per stream
+    static const unsigned int max_values = 16;
+
+    /** Construct a batch generator
+
+        @param seed RNG seed shared by all streams.
+        @param n_values Number of values to precompute per stream (at most max_values).
+    */
+    RandomGeneratorBatch(const Seed& seed, unsigned int n_values)
+        : m_key(seed.getKey()), m_n_values(n_values < max_values ? n_values : max_values)
+        {
+        for (unsigned int lane = 0; lane < width; lane++)
+            for (unsigned int w = 0; w < 4; w++)
+                m_ctr[w][lane] = 0;
+        }
+
+    /** Set the counter of one stream
+
+        @param lane Stream index in [0, width).
+        @param counter Initial value of the RNG counter.
+    */
+    inline void setStream(unsigned int lane, const Counter& counter)
+        {
+        const r123::Philox4x32::ctr_type& ctr = counter.getCounter();
+        for (unsigned int w = 0; w < 4; w++)
+            m_ctr[w][lane] = ctr.v[w];
+        }
+
+    /** Evaluate the values of all streams
+
+        @param n_streams Number of streams that have been set, the others are evaluated but ignored.
+    */
+    inline void generate(unsigned int n_streams = width);
+
+    /** Get a stream
+
+        @param lane Stream index in [0, width).
+        @returns A generator that replays the values of stream *lane*.
+    */
+    inline RandomStream getStream(unsigned int lane) const
+        {
+        r123::Philox4x32::ctr_type ctr
+            = {{m_ctr[0][lane], m_ctr[1][lane], m_ctr[2][lane], m_ctr[3][lane]}};
+        return RandomStream(m_key, ctr, m_values[lane], m_n_values);
+        }
+
+    private:
+    r123::Philox4x32::key_type m_key; //!< RNG key
+    unsigned int m_n_values;          //!< Number of values precomputed per stream
+
+    uint32_t m_ctr[4][width];                               //!< Stream counters (by word)
+    r123::Philox4x32::ctr_type m_values[width][max_values]; //!< Precomputed values
+    };
+
+inline void RandomGeneratorBatch::generate(unsigned int n_streams)
+    {
+    // Philox4x32-10, see random123/philox.h
+    const uint32_t M0 = 0xD2511F53;
+    const uint32_t M1 = 0xCD9E8D57;
+    const uint32_t W0 = 0x9E3779B9;
+    const uint32_t W1 = 0xBB67AE85;
+
+    for (unsigned int k = 0; k < m_n_values; k++)
+        {
+        uint32_t c[4][width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            c[0][lane] = m_ctr[0][lane] + k;
+            c[1][lane] = m_ctr[1][lane];
+            c[2][lane] = m_ctr[2][lane];
+            c[3][lane] = m_ctr[3][lane];
+            }
+
+#if defined(__AVX2__)
+        __m256i c0 = _mm256_loadu_si256((const __m256i*)c[0]);
+        __m256i c1 = _mm256_loadu_si256((const __m256i*)c[1]);
+        __m256i c2 = _mm256_loadu_si256((const __m256i*)c[2]);
+        __m256i c3 = _mm256_loadu_si256((const __m256i*)c[3]);
+        const __m256i m0 = _mm256_set1_epi32(int(M0));
+        const __m256i m1 = _mm256_set1_epi32(int(M1));
+        uint32_t k0 = m_key.v[0];
+        uint32_t k1 = m_key.v[1];
+
+        for (unsigned int round = 0; round < 10; round++)
+            {
+            if (round > 0)
+                {
+                k0 += W0;
+                k1 += W1;
+                }
+
+            // 32x32 -> 64 bit products of the even and odd words
+            __m256i p0_even = _mm256_mul_epu32(c0, m0);
+            __m256i p0_odd = _mm256_mul_epu32(_mm256_srli_epi64(c0, 32), m0);
+            __m256i p1_even = _mm256_mul_epu32(c2, m1);
+            __m256i p1_odd = _mm256_mul_epu32(_mm256_srli_epi64(c2, 32), m1);
+
+            __m256i lo0 = _mm256_blend_epi32(p0_even, _mm256_slli_epi64(p0_odd, 32), 0xAA);
+            __m256i hi0 = _mm256_blend_epi32(_mm256_srli_epi64(p0_even, 32), p0_odd, 0xAA);
+            __m256i lo1 = _mm256_blend_epi32(p1_even, _mm256_slli_epi64(p1_odd, 32), 0xAA);
+            __m256i hi1 = _mm256_blend_epi32(_mm256_srli_epi64(p1_even, 32), p1_odd, 0xAA);
+
+            __m256i new0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+            __m256i new2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+            c0 = new0;
+            c1 = lo1;
+            c2 = new2;
+            c3 = lo0;
+            }
+
+        _mm256_storeu_si256((__m256i*)c[0], c0);
+        _mm256_storeu_si256((__m256i*)c[1], c1);
+        _mm256_storeu_si256((__m256i*)c[2], c2);
+        _mm256_storeu_si256((__m256i*)c[3], c3);
+#else
+        uint32_t k0 = m_key.v[0];
+        uint32_t k1 = m_key.v[1];
+
+        for (unsigned int round = 0; round < 10; round++)
+            {
+            if (round > 0)
+                {
+                k0 += W0;
+                k1 += W1;
+                }
+
+            for (unsigned int lane = 0; lane < width; lane++)
+                {
+                uint64_t p0 = uint64_t(M0) * c[0][lane];
+                uint64_t p1 = uint64_t(M1) * c[2][lane];
+                uint32_t new0 = uint32_t(p1 >> 32) ^ c[1][lane] ^ k0;
+                uint32_t new2 = uint32_t(p0 >> 32) ^ c[3][lane] ^ k1;
+                c[0][lane] = new0;
+                c[1][lane] = uint32_t(p1);
+                c[2][lane] = new2;
+                c[3][lane] = uint32_t(p0);
+                }
+            }
+#endif
+
+        for (unsigned int lane = 0; lane < n_streams; lane++)
+            {
+            m_values[lane][k] = {{c[0][lane], c[1][lane], c[2][lane], c[3][lane]}};
+            }
+        }
+    }
+#endif // __HIPCC__
+
 namespace detail
     {
 //! Generate a uniform random uint32_t
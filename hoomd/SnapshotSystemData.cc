@@ -8,6 +8,7 @@
  */
 
 #include "SnapshotSystemData.h"
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 namespace py = pybind11;
 
@@ -99,9 +100,36 @@ void SnapshotSystemData<Real>::broadcast_all(unsigned int root,
 #endif
     }
 
+template<class Real>
+void DistributedSnapshotSystemData<Real>::broadcast_box(std::shared_ptr<MPIConfiguration> mpi_conf)
+    {
+#ifdef ENABLE_MPI
+    if (mpi_conf->getNRanks() > 1)
+        {
+        bcast(global_box, 0, mpi_conf->getCommunicator());
+        bcast(dimensions, 0, mpi_conf->getCommunicator());
+        }
+#endif
+    }
+
+/*! \returns a numpy array that wraps the particle tags.
+    The raw data is referenced by the numpy array, modifications to the numpy array will modify the
+    snapshot. The tags are resized to the number of particles in the slice first.
+*/
+template<class Real>
+py::object DistributedSnapshotSystemData<Real>::getParticleTagsNP(pybind11::object self)
+    {
+    auto self_cpp = self.cast<DistributedSnapshotSystemData<Real>*>();
+    self_cpp->particle_tags.resize(self_cpp->particle_data.size);
+
+    return pybind11::array(self_cpp->particle_tags.size(), self_cpp->particle_tags.data(), self);
+    }
+
 // instantiate both float and double snapshots
 template struct PYBIND11_EXPORT SnapshotSystemData<float>;
 template struct PYBIND11_EXPORT SnapshotSystemData<double>;
+template struct PYBIND11_EXPORT DistributedSnapshotSystemData<float>;
+template struct PYBIND11_EXPORT DistributedSnapshotSystemData<double>;
 
 void export_SnapshotSystemData(py::module& m)
     {
@@ -140,4 +168,40 @@ void export_SnapshotSystemData(py::module& m)
         .def("_broadcast_box", &SnapshotSystemData<double>::broadcast_box)
         .def("_broadcast", &SnapshotSystemData<double>::broadcast)
         .def("_broadcast_all", &SnapshotSystemData<double>::broadcast_all);
+
+    py::class_<DistributedSnapshotSystemData<float>,
+               std::shared_ptr<DistributedSnapshotSystemData<float>>>(
+        m,
+        "DistributedSnapshotSystemData_float")
+        .def(py::init<>())
+        .def_readwrite("_dimensions", &DistributedSnapshotSystemData<float>::dimensions)
+        .def_readwrite("_global_box", &DistributedSnapshotSystemData<float>::global_box)
+        .def_readonly("particles", &DistributedSnapshotSystemData<float>::particle_data)
+        .def_property_readonly("particle_tags",
+                               &DistributedSnapshotSystemData<float>::getParticleTagsNP)
+        .def_readonly("bonds", &DistributedSnapshotSystemData<float>::bond_data)
+        .def_readonly("angles", &DistributedSnapshotSystemData<float>::angle_data)
+        .def_readonly("dihedrals", &DistributedSnapshotSystemData<float>::dihedral_data)
+        .def_readonly("impropers", &DistributedSnapshotSystemData<float>::improper_data)
+        .def_readonly("constraints", &DistributedSnapshotSystemData<float>::constraint_data)
+        .def_readonly("pairs", &DistributedSnapshotSystemData<float>::pair_data)
+        .def("_broadcast_box", &DistributedSnapshotSystemData<float>::broadcast_box);
+
+    py::class_<DistributedSnapshotSystemData<double>,
+               std::shared_ptr<DistributedSnapshotSystemData<double>>>(
+        m,
+        "DistributedSnapshotSystemData_double")
+        .def(py::init<>())
+        .def_readwrite("_dimensions", &DistributedSnapshotSystemData<double>::dimensions)
+        .def_readwrite("_global_box", &DistributedSnapshotSystemData<double>::global_box)
+        .def_readonly("particles", &DistributedSnapshotSystemData<double>::particle_data)
+        .def_property_readonly("particle_tags",
+                               &DistributedSnapshotSystemData<double>::getParticleTagsNP)
+        .def_readonly("bonds", &DistributedSnapshotSystemData<double>::bond_data)
+        .def_readonly("angles", &DistributedSnapshotSystemData<double>::angle_data)
+        .def_readonly("dihedrals", &DistributedSnapshotSystemData<double>::dihedral_data)
+        .def_readonly("impropers", &DistributedSnapshotSystemData<double>::improper_data)
+        .def_readonly("constraints", &DistributedSnapshotSystemData<double>::constraint_data)
+        .def_readonly("pairs", &DistributedSnapshotSystemData<double>::pair_data)
+        .def("_broadcast_box", &DistributedSnapshotSystemData<double>::broadcast_box);
     }
@@ -83,6 +83,48 @@ template<class Real> struct SnapshotSystemData
     void broadcast_all(unsigned int root, std::shared_ptr<ExecutionConfiguration> exec_conf);
     };
 
+//! Structure holding the slice of the system data that belongs to one rank
+/*! A DistributedSnapshotSystemData holds the same data as a SnapshotSystemData, but every rank
+ * keeps only its own slice of the particles and bonded groups instead of the root rank holding all
+ * of them. Particles carry their global tags in particle_tags, and the members of bonded groups
+ * are global particle tags. Together, the slices of all ranks hold every particle and bonded group
+ * exactly once. Any partition of the tags works for initialization, which sends every particle to
+ * the rank that owns it. Slices taken from a SystemDefinition hold the particles that the rank
+ * owns and the groups whose first member it owns.
+ *
+ * The box, dimensions and type mappings on rank 0 apply to all ranks.
+ *
+ * \ingroup data_structs
+ */
+template<class Real> struct DistributedSnapshotSystemData
+    {
+    unsigned int dimensions;                  //!< The dimensionality of the system
+    BoxDim global_box;                        //!< The dimensions of the simulation box
+    SnapshotParticleData<Real> particle_data; //!< The particles of this rank
+    std::vector<unsigned int> particle_tags;  //!< Global tag of every particle of this rank
+    BondData::Snapshot bond_data;             //!< The bonds of this rank
+    AngleData::Snapshot angle_data;           //!< The angles of this rank
+    DihedralData::Snapshot dihedral_data;     //!< The dihedrals of this rank
+    ImproperData::Snapshot improper_data;     //!< The impropers of this rank
+    ConstraintData::Snapshot constraint_data; //!< The constraints of this rank
+    PairData::Snapshot pair_data;             //!< The pairs of this rank
+
+    //! Constructor
+    DistributedSnapshotSystemData()
+        {
+        dimensions = 3;
+        }
+
+    // Broadcast information from rank 0 to all ranks
+    /*! \param mpi_conf The MPI configuration
+        Broadcasts the box and dimensions.
+    */
+    void broadcast_box(std::shared_ptr<MPIConfiguration> mpi_conf);
+
+    //! Get the particle tags as a numpy array
+    static pybind11::object getParticleTagsNP(pybind11::object self);
+    };
+
 //! Export SnapshotParticleData to python
 
 void export_SnapshotSystemData(pybind11::module& m);
@@ -8,6 +8,7 @@
 */
 
 #include "System.h"
+#include "HostArena.h"
 #include "SignalHandler.h"
 
 #ifdef ENABLE_MPI
@@ -46,6 +47,9 @@ System::System(std::shared_ptr<SystemDefinition> sysdef, uint64_t initial_tstep)
     {
     // sanity check
     assert(m_sysdef);
+
+    // compute the potential energy on every step unless the user opts out
+    m_default_flags[pdata_flag::potential_energy] = 1;
     m_exec_conf = m_sysdef->getParticleData()->getExecConf();
 
 #ifdef ENABLE_MPI
@@ -131,6 +135,9 @@ void System::run(uint64_t nsteps, bool write_at_start)
     // run the steps
     for (uint64_t count = 0; count < nsteps; count++)
         {
+        // temporaries from the previous time step are no longer in use
+        m_exec_conf->getHostArena().reset();
+
         for (auto& tuner : m_tuners)
             {
             if ((*tuner->getTrigger())(m_cur_tstep))
@@ -316,6 +323,8 @@ PDataFlags System::determineFlags(uint64_t tstep)
             flags |= tuner->getRequestedPDataFlags();
         }
 
+    // the computes leave the potential energy out only when nothing requests it
+    flags[pdata_flag::skip_potential_energy] = !flags[pdata_flag::potential_energy];
     return flags;
     }
 
@@ -344,6 +353,8 @@ void export_System(py::module& m)
         .def("getCurrentTimeStep", &System::getCurrentTimeStep)
         .def("setPressureFlag", &System::setPressureFlag)
         .def("getPressureFlag", &System::getPressureFlag)
+        .def("setEnergyFlag", &System::setEnergyFlag)
+        .def("getEnergyFlag", &System::getEnergyFlag)
         .def_property_readonly("walltime", &System::getCurrentWalltime)
         .def_property_readonly("final_timestep", &System::getEndStep)
         .def_property_readonly("analyzers", &System::getAnalyzers)
@@ -169,6 +169,18 @@ class PYBIND11_EXPORT System
         return m_default_flags[pdata_flag::pressure_tensor];
         }
 
+    /// Set potential energy computation particle data flag
+    void setEnergyFlag(bool flag)
+        {
+        m_default_flags[pdata_flag::potential_energy] = flag;
+        }
+
+    /// Get the potential energy computation particle data flag
+    bool getEnergyFlag()
+        {
+        return m_default_flags[pdata_flag::potential_energy];
+        }
+
     private:
     std::vector<std::pair<std::shared_ptr<Analyzer>,
                           std::shared_ptr<Trigger>>>
@@ -100,6 +100,31 @@ SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<Real>> sna
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData());
     }
 
+/*! Initializes the *Data classes from the slices of a distributed snapshot, see
+    initializeFromDistributedSnapshot().
+    \param snapshot Slice of the distributed snapshot that belongs to this rank
+    \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout
+*/
+template<class Real>
+SystemDefinition::SystemDefinition(std::shared_ptr<DistributedSnapshotSystemData<Real>> snapshot,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    m_n_dimensions = 3;
+    m_particle_data = std::shared_ptr<ParticleData>(
+        new ParticleData(0, snapshot->global_box, 0, exec_conf, decomposition));
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, 0));
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, 0));
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, 0));
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, 0));
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, 0));
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, 0));
+    m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData());
+
+    initializeFromDistributedSnapshot(snapshot);
+    }
+
 /*! Sets the dimensionality of the system.  When quantities involving the dof of
     the system are computed, such as T, P, etc., the dimensionality is needed.
     Therefore, the dimensionality must be set before any temperature/pressure
@@ -168,6 +193,59 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr<SnapshotSystemData
     m_pair_data->initializeFromSnapshot(snapshot->pair_data);
     }
 
+/*! Every rank takes the particles it owns and the bonded groups whose first member it owns,
+    without any communication.
+*/
+template<class Real>
+std::shared_ptr<DistributedSnapshotSystemData<Real>> SystemDefinition::takeDistributedSnapshot()
+    {
+    std::shared_ptr<DistributedSnapshotSystemData<Real>> snap(
+        new DistributedSnapshotSystemData<Real>);
+
+    snap->dimensions = m_n_dimensions;
+    snap->global_box = m_particle_data->getGlobalBox();
+
+    m_particle_data->takeDistributedSnapshot(snap->particle_data, snap->particle_tags);
+    m_bond_data->takeDistributedSnapshot(snap->bond_data);
+    m_angle_data->takeDistributedSnapshot(snap->angle_data);
+    m_dihedral_data->takeDistributedSnapshot(snap->dihedral_data);
+    m_improper_data->takeDistributedSnapshot(snap->improper_data);
+    m_constraint_data->takeDistributedSnapshot(snap->constraint_data);
+    m_pair_data->takeDistributedSnapshot(snap->pair_data);
+
+    return snap;
+    }
+
+//! Re-initialize the system from a distributed snapshot
+/*! \param snapshot Slice of the distributed snapshot that belongs to this rank
+
+    All ranks must call this method with their slices. The box and dimensions of rank 0 apply.
+*/
+template<class Real>
+void SystemDefinition::initializeFromDistributedSnapshot(
+    std::shared_ptr<DistributedSnapshotSystemData<Real>> snapshot)
+    {
+    std::shared_ptr<const ExecutionConfiguration> exec_conf = m_particle_data->getExecConf();
+
+    m_n_dimensions = snapshot->dimensions;
+
+#ifdef ENABLE_MPI
+    // in MPI simulations, broadcast dimensionality from rank zero
+    if (m_particle_data->getDomainDecomposition())
+        bcast(m_n_dimensions, 0, exec_conf->getMPICommunicator());
+#endif
+
+    m_particle_data->setGlobalBox(snapshot->global_box);
+    m_particle_data->initializeFromDistributedSnapshot(snapshot->particle_data,
+                                                       snapshot->particle_tags);
+    m_bond_data->initializeFromDistributedSnapshot(snapshot->bond_data);
+    m_angle_data->initializeFromDistributedSnapshot(snapshot->angle_data);
+    m_dihedral_data->initializeFromDistributedSnapshot(snapshot->dihedral_data);
+    m_improper_data->initializeFromDistributedSnapshot(snapshot->improper_data);
+    m_constraint_data->initializeFromDistributedSnapshot(snapshot->constraint_data);
+    m_pair_data->initializeFromDistributedSnapshot(snapshot->pair_data);
+    }
+
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -175,6 +253,14 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<f
 template std::shared_ptr<SnapshotSystemData<float>> SystemDefinition::takeSnapshot<float>();
 template void SystemDefinition::initializeFromSnapshot<float>(
     std::shared_ptr<SnapshotSystemData<float>> snapshot);
+template SystemDefinition::SystemDefinition(
+    std::shared_ptr<DistributedSnapshotSystemData<float>> snapshot,
+    std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<DomainDecomposition> decomposition);
+template std::shared_ptr<DistributedSnapshotSystemData<float>>
+SystemDefinition::takeDistributedSnapshot<float>();
+template void SystemDefinition::initializeFromDistributedSnapshot<float>(
+    std::shared_ptr<DistributedSnapshotSystemData<float>> snapshot);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -182,6 +268,14 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<d
 template std::shared_ptr<SnapshotSystemData<double>> SystemDefinition::takeSnapshot<double>();
 template void SystemDefinition::initializeFromSnapshot<double>(
     std::shared_ptr<SnapshotSystemData<double>> snapshot);
+template SystemDefinition::SystemDefinition(
+    std::shared_ptr<DistributedSnapshotSystemData<double>> snapshot,
+    std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<DomainDecomposition> decomposition);
+template std::shared_ptr<DistributedSnapshotSystemData<double>>
+SystemDefinition::takeDistributedSnapshot<double>();
+template void SystemDefinition::initializeFromDistributedSnapshot<double>(
+    std::shared_ptr<DistributedSnapshotSystemData<double>> snapshot);
 
 void export_SystemDefinition(py::module& m)
     {
@@ -214,6 +308,16 @@ void export_SystemDefinition(py::module& m)
                       std::shared_ptr<DomainDecomposition>>())
         .def(py::init<std::shared_ptr<SnapshotSystemData<double>>,
                       std::shared_ptr<ExecutionConfiguration>>())
+        .def(py::init<std::shared_ptr<DistributedSnapshotSystemData<float>>,
+                      std::shared_ptr<ExecutionConfiguration>,
+                      std::shared_ptr<DomainDecomposition>>())
+        .def(py::init<std::shared_ptr<DistributedSnapshotSystemData<float>>,
+                      std::shared_ptr<ExecutionConfiguration>>())
+        .def(py::init<std::shared_ptr<DistributedSnapshotSystemData<double>>,
+                      std::shared_ptr<ExecutionConfiguration>,
+                      std::shared_ptr<DomainDecomposition>>())
+        .def(py::init<std::shared_ptr<DistributedSnapshotSystemData<double>>,
+                      std::shared_ptr<ExecutionConfiguration>>())
         .def("setNDimensions", &SystemDefinition::setNDimensions)
         .def("getNDimensions", &SystemDefinition::getNDimensions)
         .def("getParticleData", &SystemDefinition::getParticleData)
@@ -228,6 +332,12 @@ void export_SystemDefinition(py::module& m)
         .def("takeSnapshot_double", &SystemDefinition::takeSnapshot<double>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<float>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
+        .def("takeDistributedSnapshot_float", &SystemDefinition::takeDistributedSnapshot<float>)
+        .def("takeDistributedSnapshot_double", &SystemDefinition::takeDistributedSnapshot<double>)
+        .def("initializeFromDistributedSnapshot",
+             &SystemDefinition::initializeFromDistributedSnapshot<float>)
+        .def("initializeFromDistributedSnapshot",
+             &SystemDefinition::initializeFromDistributedSnapshot<double>)
         .def("getSeed", &SystemDefinition::getSeed)
         .def("setSeed", &SystemDefinition::setSeed);
     }
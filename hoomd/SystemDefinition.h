@@ -29,6 +29,9 @@ class Communicator;
 //! Forward declaration of SnapshotSystemData
 template<class Real> struct SnapshotSystemData;
 
+//! Forward declaration of DistributedSnapshotSystemData
+template<class Real> struct DistributedSnapshotSystemData;
+
 //! Container class for all data needed to define the MD system
 /*! SystemDefinition is a big bucket where all of the data defining the MD system goes.
     Everything is stored as a shared pointer for quick and easy access from within C++
@@ -94,6 +97,14 @@ class PYBIND11_EXPORT SystemDefinition
                      std::shared_ptr<DomainDecomposition> decomposition
                      = std::shared_ptr<DomainDecomposition>());
 
+    //! Construct from a distributed snapshot
+    template<class Real>
+    SystemDefinition(std::shared_ptr<DistributedSnapshotSystemData<Real>> snapshot,
+                     std::shared_ptr<ExecutionConfiguration> exec_conf
+                     = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration()),
+                     std::shared_ptr<DomainDecomposition> decomposition
+                     = std::shared_ptr<DomainDecomposition>());
+
     //! Set the dimensionality of the system
     void setNDimensions(unsigned int);
 
@@ -175,6 +186,15 @@ class PYBIND11_EXPORT SystemDefinition
     template<class Real>
     void initializeFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot);
 
+    //! Return the slice of a distributed snapshot that belongs to this rank
+    template<class Real>
+    std::shared_ptr<DistributedSnapshotSystemData<Real>> takeDistributedSnapshot();
+
+    //! Re-initialize the system from a distributed snapshot
+    template<class Real>
+    void initializeFromDistributedSnapshot(
+        std::shared_ptr<DistributedSnapshotSystemData<Real>> snapshot);
+
     private:
     unsigned int m_n_dimensions;                       //!< Dimensionality of the system
     uint16_t m_seed = 0;                               //!< Random number seed
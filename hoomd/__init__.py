@@ -54,7 +54,7 @@ if version.dem_built:
 from hoomd.simulation import Simulation
 from hoomd.state import State
 from hoomd.operations import Operations
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd import tune
 from hoomd import logging
 from hoomd import custom
@@ -70,6 +70,31 @@ def simulation_factory(device):
     return make_simulation
 
 
+@pytest.fixture(scope='session')
+def run_with_num_cpu_threads(device):
+    """Call a function with different numbers of CPU threads.
+
+    Returns a function ``run(compute, num_cpu_threads=(1, 4))`` that calls
+    ``compute()`` once with `device.num_cpu_threads
+    <hoomd.device.Device.num_cpu_threads>` set to each of the given values and
+    returns the list of results. `device` is session scoped, so ``run``
+    restores its thread settings before it returns.
+    """
+
+    def run(compute, num_cpu_threads=(1, 4)):
+        saved = (device.num_cpu_threads, device.pin_cpu_threads)
+        try:
+            results = []
+            for n in num_cpu_threads:
+                device.num_cpu_threads = n
+                results.append(compute())
+            return results
+        finally:
+            device.num_cpu_threads, device.pin_cpu_threads = saved
+
+    return run
+
+
 @pytest.fixture(scope='session')
 def two_particle_snapshot_factory(device):
     """Make a snapshot with two particles."""
@@ -30,9 +30,10 @@ class Action(metaclass=_AbstractLoggable):
     to a `hoomd.update.CustomUpdater`, `hoomd.write.CustomWriter`, or
     `hoomd.tune.CustomTuner` constructor.
 
-    If the pressure, rotational kinetic energy, or external field virial is
-    needed for a subclass, the flags attribute of the class needs to be set with
-    the appropriate flags from the internal `Action.Flags` enumeration.
+    If the pressure, rotational kinetic energy, external field virial, or
+    potential energy is needed for a subclass, the flags attribute of the class
+    needs to be set with the appropriate flags from the internal `Action.Flags`
+    enumeration.
 
     .. code-block:: python
 
@@ -90,10 +91,12 @@ class Action(metaclass=_AbstractLoggable):
         * PRESSURE_TENSOR = 0
         * ROTATIONAL_KINETIC_ENERGY = 1
         * EXTERNAL_FIELD_VIRIAL = 2
+        * POTENTIAL_ENERGY = 3
         """
         PRESSURE_TENSOR = 0
         ROTATIONAL_KINETIC_ENERGY = 1
         EXTERNAL_FIELD_VIRIAL = 2
+        POTENTIAL_ENERGY = 3
 
     flags = []
     log_quantities = {}
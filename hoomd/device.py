@@ -24,8 +24,26 @@ class Device:
     HOOMD will use this value. You can also set `num_cpu_threads` explicitly.
 
     Note:
-        At this time **very few** features in HOOMD use TBB for threading.
-        Most users should employ MPI for parallel simulations.
+        Only some of the CPU code paths in HOOMD use TBB for threading: pair
+        potentials with a full neighbor list, the binned neighbor list build,
+        bonds, NVE, NVT and Langevin integration, thermodynamic quantities, and
+        HPMC. Most users should employ MPI for parallel simulations.
+
+    .. rubric:: Hybrid MPI and threads
+
+    On multi-socket nodes, you can run one MPI rank per socket (or NUMA
+    domain) and use the cores of the socket with threads. Bind every rank to
+    its socket with the MPI launcher, e.g. ``mpirun --map-by ppr:1:socket
+    --bind-to socket``. The default number of threads is the number of CPUs
+    the rank is bound to, so every rank owns a thread team that fills its
+    socket. Ranks that are not bound split the CPUs of the node evenly. Set
+    `pin_cpu_threads` to keep the threads on their CPUs and close to the memory
+    they access. Fewer ranks mean fewer and larger domains and less ghost
+    communication.
+
+    Pair potentials on the CPU compute the forces with threads only when their
+    neighbor list stores each pair for both particles, see
+    `hoomd.md.nlist.NList.full_list`.
     """
 
     def __init__(self, communicator, notice_level, msg_file, shared_msg_file):
@@ -116,6 +134,79 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def pin_cpu_threads(self):
+        """bool: Pin the TBB threads to CPUs.
+
+        When `True`, pin every TBB worker thread to one of the CPUs the process
+        may run on. Pinning is only available on Linux.
+        """
+        if not hoomd.version.tbb_enabled:
+            return False
+        else:
+            return self._cpp_exec_conf.getPinThreads()
+
+    @pin_cpu_threads.setter
+    def pin_cpu_threads(self, pin_cpu_threads):
+        if not hoomd.version.tbb_enabled:
+            self._cpp_msg.warning(
+                "HOOMD was compiled without thread support, ignoring request "
+                "to pin threads.\n")
+        else:
+            self._cpp_exec_conf.setPinThreads(bool(pin_cpu_threads))
+
+    @property
+    def memory_policy(self):
+        """str: Placement of large host arrays on the NUMA nodes.
+
+        * ``'local'`` - Place the memory on the node of the thread that
+          allocates it.
+        * ``'first_touch'`` - Clear new arrays with all TBB threads in
+          contiguous blocks, so that the memory of each block is placed on the
+          node of its thread. The pair force and binned neighbor list loops
+          give every thread the same block of particles. The blocks line up
+          best when the arrays hold few more particles than are in use. Other
+          threaded loops do not follow this placement. Combine with
+          `pin_cpu_threads`.
+        * ``'interleave'`` - Spread the memory evenly across all nodes the
+          process may use (Linux only).
+
+        The policy applies to arrays allocated after it is set. Set it before
+        creating the simulation state. When every MPI rank is bound to one
+        socket, ``'local'`` already places the memory on that socket.
+        """
+        return self._cpp_exec_conf.getMemoryPolicy().name
+
+    @memory_policy.setter
+    def memory_policy(self, memory_policy):
+        policies = _hoomd.ExecutionConfiguration.memoryPolicy.__members__
+        if memory_policy not in policies:
+            raise ValueError(f"memory_policy must be one of {list(policies)}")
+        self._cpp_exec_conf.setMemoryPolicy(policies[memory_policy])
+
+    @property
+    def host_arena_statistics(self):
+        """dict: Statistics of the arena for temporary host memory.
+
+        HOOMD allocates temporary host buffers that live for one time step from
+        an arena, which it resets at the start of every step. Once the arena
+        has grown to the size one step needs, steps no longer allocate memory
+        from the system.
+
+        * ``bytes_in_use`` - Bytes currently allocated from the arena.
+        * ``peak_bytes`` - Largest number of bytes allocated at any time.
+        * ``capacity`` - Bytes held by the arena.
+        * ``num_allocations`` - Number of allocations served by the arena.
+        * ``num_system_allocations`` - Number of times the arena allocated
+          memory from the system.
+        """
+        arena = self._cpp_exec_conf.getHostArena()
+        return dict(bytes_in_use=arena.getBytesInUse(),
+                    peak_bytes=arena.getPeakBytes(),
+                    capacity=arena.getCapacity(),
+                    num_allocations=arena.getNumAllocations(),
+                    num_system_allocations=arena.getNumSystemAllocations())
+
 
 def _create_messenger(mpi_config, notice_level, msg_file, shared_msg_file):
     msg = _hoomd.Messenger(mpi_config)
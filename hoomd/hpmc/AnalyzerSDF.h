@@ -17,6 +17,12 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -79,6 +85,8 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
       - Suitably chosen navg results in the average being written out just before a restart -
    enabling full restart capabilities.
       - Fully uses the MPI domain decomposition to compute the SDF fast in large jobs.
+      - Loops over the local particles in parallel with TBB, accumulating per-thread histograms
+   that are summed at the end. The integer bin counts are independent of the number of threads.
 
     \b Storage <br>
 
@@ -336,6 +344,7 @@ template<class Shape> void AnalyzerSDF<Shape>::zeroHistogram()
    multiple times to increment the counters for averaging, and it operates without any communication
       - The integrator performs the ghost exchange (with the ghost width extra that we add)
       - Only on writeOutput() do we need to sum the per-rank histograms into a global histogram
+      - With TBB, each thread counts into its own histogram, which are summed before returning
 */
 template<class Shape> void AnalyzerSDF<Shape>::countHistogram(uint64_t timestep)
     {
@@ -357,77 +366,103 @@ template<class Shape> void AnalyzerSDF<Shape>::countHistogram(uint64_t timestep)
     const std::vector<param_type, managed_allocator<param_type>>& params = m_mc->getParams();
 
     // loop through N particles
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+#ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_hist(
+        std::vector<unsigned int>(m_hist.size(), 0));
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        size_t min_bin = m_hist.size();
-
-        // read in the current position and orientation
-        Scalar4 postype_i = h_postype.data[i];
-        Scalar4 orientation_i = h_orientation.data[i];
-        Shape shape_i(quat<Scalar>(orientation_i), params[__scalar_as_int(postype_i.w)]);
-        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
-
-        // construct the AABB around the particle's circumsphere
-        // pad with enough extra width so that when scaled by lmax, found particles might touch
-        detail::AABB aabb_i_local(vec3<Scalar>(0, 0, 0),
-                                  shape_i.getCircumsphereDiameter() / Scalar(2) + extra_width);
-
-        size_t n_images = image_list.size();
-        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-            {
-            vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
-            detail::AABB aabb = aabb_i_local;
-            aabb.translate(pos_i_image);
-
-            // stackless search
-            for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                 cur_node_idx++)
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                [&](const tbb::blocked_range<unsigned int>& r)
                 {
-                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
-                    {
-                    if (aabb_tree.isNodeLeaf(cur_node_idx))
+                    std::vector<unsigned int>& hist = thread_hist.local();
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+#else
+    std::vector<unsigned int>& hist = m_hist;
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+#endif
                         {
-                        for (unsigned int cur_p = 0;
-                             cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                             cur_p++)
+                        size_t min_bin = m_hist.size();
+
+                        // read in the current position and orientation
+                        Scalar4 postype_i = h_postype.data[i];
+                        Scalar4 orientation_i = h_orientation.data[i];
+                        Shape shape_i(quat<Scalar>(orientation_i), params[__scalar_as_int(postype_i.w)]);
+                        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                        // construct the AABB around the particle's circumsphere
+                        // pad with enough extra width so that when scaled by lmax, found particles might touch
+                        detail::AABB aabb_i_local(vec3<Scalar>(0, 0, 0),
+                                                  shape_i.getCircumsphereDiameter() / Scalar(2) + extra_width);
+
+                        size_t n_images = image_list.size();
+                        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                             {
-                            // read in its position and orientation
-                            unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                            // skip i==j in the 0 image
-                            if (cur_image == 0 && i == j)
-                                continue;
-
-                            Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
-
-                            // put particles in coordinate system of particle i
-                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-
-                            size_t bin = computeBin(r_ij,
-                                                    quat<Scalar>(orientation_i),
-                                                    quat<Scalar>(orientation_j),
-                                                    params[__scalar_as_int(postype_i.w)],
-                                                    params[__scalar_as_int(postype_j.w)]);
-
-                            if (bin >= 0)
-                                min_bin = std::min(min_bin, bin);
-                            }
-                        }
-                    }
-                else
-                    {
-                    // skip ahead
-                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                    }
-                } // end loop over AABB nodes
-            }     // end loop over images
-
-        // record the minimum bin
-        if ((unsigned int)min_bin < m_hist.size())
-            m_hist[min_bin]++;
-
-        } // end loop over all particles
+                            vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+                            detail::AABB aabb = aabb_i_local;
+                            aabb.translate(pos_i_image);
+
+                            // stackless search
+                            for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
+                                 cur_node_idx++)
+                                {
+                                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                    {
+                                    if (aabb_tree.isNodeLeaf(cur_node_idx))
+                                        {
+                                        for (unsigned int cur_p = 0;
+                                             cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
+                                             cur_p++)
+                                            {
+                                            // read in its position and orientation
+                                            unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                            // skip i==j in the 0 image
+                                            if (cur_image == 0 && i == j)
+                                                continue;
+
+                                            Scalar4 postype_j = h_postype.data[j];
+                                            Scalar4 orientation_j = h_orientation.data[j];
+
+                                            // put particles in coordinate system of particle i
+                                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                            size_t bin = computeBin(r_ij,
+                                                                    quat<Scalar>(orientation_i),
+                                                                    quat<Scalar>(orientation_j),
+                                                                    params[__scalar_as_int(postype_i.w)],
+                                                                    params[__scalar_as_int(postype_j.w)]);
+
+                                            if (bin >= 0)
+                                                min_bin = std::min(min_bin, bin);
+                                            }
+                                        }
+                                    }
+                                else
+                                    {
+                                    // skip ahead
+                                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                                    }
+                                } // end loop over AABB nodes
+                            }     // end loop over images
+
+                        // record the minimum bin
+                        if ((unsigned int)min_bin < m_hist.size())
+                            hist[min_bin]++;
+                        } // end loop over all particles
+#ifdef ENABLE_TBB
+                });
+        }); // end task arena execute()
+
+    // sum the per-thread histograms
+    for (auto it = thread_hist.begin(); it != thread_hist.end(); ++it)
+        {
+        for (size_t bin = 0; bin < m_hist.size(); bin++)
+            m_hist[bin] += (*it)[bin];
+        }
+#endif
     }
 
 /*! \param r_ij Vector pointing from particle i to j (already wrapped into the box)
@@ -0,0 +1,106 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "HPMCPrecisionSetup.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#include <vector>
+
+/*! \file CircumsphereList.h
+    \brief Declaration of CircumsphereList
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hpmc
+    {
+namespace detail
+    {
+//! Structure-of-arrays list of circumscribing spheres
+/*! The implicit depletant code tests every inserted depletant against all particles that overlap the
+    insertion volume. Storing the circumspheres of these particles contiguously allows the compiler to
+    vectorize the distance test, so that the exact shape overlap tests only need to be called for the
+    spheres flagged by computeOverlapMask().
+
+    The mask is conservative: the contact distance is padded by a small relative tolerance so that
+    no sphere pair accepted by check_circumsphere_overlap() is ever rejected by the mask, regardless of
+    the order in which the vectorized loop evaluates the floating point operations. Callers must still
+    apply the exact circumsphere check to the flagged entries.
+
+    \ingroup hpmc_data_structs
+*/
+class CircumsphereList
+    {
+    public:
+    //! Remove all spheres from the list
+    void clear()
+        {
+        m_x.clear();
+        m_y.clear();
+        m_z.clear();
+        m_d.clear();
+        }
+
+    //! Append a sphere
+    /*! \param r Center of the sphere
+        \param d Diameter of the sphere
+    */
+    void push_back(const vec3<Scalar>& r, OverlapReal d)
+        {
+        m_x.push_back(r.x);
+        m_y.push_back(r.y);
+        m_z.push_back(r.z);
+        m_d.push_back(d);
+        }
+
+    //! Get the number of spheres in the list
+    unsigned int size() const
+        {
+        return (unsigned int)m_d.size();
+        }
+
+    //! Flag the spheres that may overlap with a test sphere
+    /*! \param r Center of the test sphere
+        \param d Diameter of the test sphere
+        \param mask Output array with at least size() elements. mask[m] is set to 1 if sphere m may
+                    overlap the test sphere, and 0 if it definitely does not.
+        \returns The number of flagged spheres
+    */
+    unsigned int computeOverlapMask(const vec3<Scalar>& r, OverlapReal d, unsigned char* mask) const
+        {
+        const unsigned int n = size();
+        const Scalar* __restrict__ x = m_x.data();
+        const Scalar* __restrict__ y = m_y.data();
+        const Scalar* __restrict__ z = m_z.data();
+        const OverlapReal* __restrict__ diam = m_d.data();
+        const OverlapReal pad = OverlapReal(1.0) + OverlapReal(1e-4);
+
+        unsigned int n_flagged = 0;
+        for (unsigned int m = 0; m < n; ++m)
+            {
+            Scalar dx = x[m] - r.x;
+            Scalar dy = y[m] - r.y;
+            Scalar dz = z[m] - r.z;
+            OverlapReal rsq = OverlapReal(dx * dx + dy * dy + dz * dz);
+            OverlapReal DaDb = d + diam[m];
+            unsigned char flag = (rsq * OverlapReal(4.0) <= DaDb * DaDb * pad);
+            mask[m] = flag;
+            n_flagged += flag;
+            }
+        return n_flagged;
+        }
+
+    private:
+    std::vector<Scalar> m_x;      //!< x coordinates of the sphere centers
+    std::vector<Scalar> m_y;      //!< y coordinates of the sphere centers
+    std::vector<Scalar> m_z;      //!< z coordinates of the sphere centers
+    std::vector<OverlapReal> m_d; //!< Sphere diameters
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
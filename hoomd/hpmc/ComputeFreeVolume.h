@@ -21,12 +21,25 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
+#include <limits>
 #include <pybind11/pybind11.h>
 
 namespace hpmc
     {
 //! Template class for a free volume integration analyzer
-/*!
+/*! The CPU implementation evaluates the test insertions in parallel with TBB. Every sample draws
+    from its own RNG stream (keyed on the sample index), so the result does not depend on the number
+    of threads.
+
+    When a target relative error is set, samples are drawn in batches of num_samples until the
+    standard error of the free volume estimate, relative to the estimate, falls below the target or
+    max_num_samples samples have been drawn.
+
     \ingroup hpmc_integrators
 */
 template<class Shape> class ComputeFreeVolume : public Compute
@@ -52,6 +65,46 @@ template<class Shape> class ComputeFreeVolume : public Compute
         m_n_sample = n_sample;
         }
 
+    //! Get the target relative error
+    Scalar getTargetRelativeError()
+        {
+        return m_target_rel_err;
+        }
+
+    //! Set the target relative error
+    /*! \param target_rel_err Stop sampling when the relative error of the estimate falls below this
+        value. Set to 0 to always evaluate exactly num_samples samples.
+    */
+    void setTargetRelativeError(Scalar target_rel_err)
+        {
+        if (target_rel_err < Scalar(0.0))
+            {
+            throw std::domain_error("target_relative_error must be non-negative");
+            }
+        m_target_rel_err = target_rel_err;
+        }
+
+    //! Get the maximum number of samples to evaluate when a target relative error is set
+    unsigned int getMaxNumSamples()
+        {
+        return m_max_n_sample;
+        }
+
+    //! Set the maximum number of samples to evaluate when a target relative error is set
+    void setMaxNumSamples(unsigned int max_n_sample)
+        {
+        m_max_n_sample = max_n_sample;
+        }
+
+    //! Get the number of samples used in the last evaluation (summed over all ranks)
+    unsigned int getNumSamplesUsed()
+        {
+        return m_n_sample_used;
+        }
+
+    //! Get the relative error of the free volume estimate
+    Scalar getRelativeError();
+
     //! Get the type of depletant particle
     std::string getTestParticleType()
         {
@@ -88,20 +141,43 @@ template<class Shape> class ComputeFreeVolume : public Compute
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< The parent integrator
     std::shared_ptr<CellList> m_cl;                  //!< The cell list
 
-    unsigned int m_type;     //!< Type of depletant particle to generate
-    unsigned int m_n_sample; //!< Number of sampling depletants to generate
+    unsigned int m_type;          //!< Type of depletant particle to generate
+    unsigned int m_n_sample;      //!< Number of sampling depletants to generate
+    Scalar m_target_rel_err;      //!< Target relative error (0 to disable early stopping)
+    unsigned int m_max_n_sample;  //!< Maximum number of samples with early stopping
+    unsigned int m_n_sample_used; //!< Number of samples used in the last evaluation
 
     GPUArray<unsigned int> m_n_overlap_all; //!< Number of overlap volume particles in box
 
     //! Return an estimate of the overlap volume
     virtual void computeFreeVolume(uint64_t timestep);
+
+    //! Count the overlapping test insertions in a range of samples on the local rank
+    unsigned int countOverlappingSamples(uint64_t timestep, unsigned int first, unsigned int last);
+
+    //! Compute the relative standard error of the free volume estimate
+    /*! \param n_sample Number of samples
+        \param n_overlap Number of overlapping samples
+
+        The free volume fraction p is estimated by the binomial proportion of non-overlapping
+        samples, with variance p (1-p) / n_sample.
+    */
+    static Scalar computeRelativeError(unsigned int n_sample, unsigned int n_overlap)
+        {
+        if (n_sample == 0 || n_overlap >= n_sample)
+            return std::numeric_limits<Scalar>::infinity();
+
+        Scalar p = Scalar(n_sample - n_overlap) / Scalar(n_sample);
+        return sqrt((Scalar(1.0) - p) / (p * Scalar(n_sample)));
+        }
     };
 
 template<class Shape>
 ComputeFreeVolume<Shape>::ComputeFreeVolume(std::shared_ptr<SystemDefinition> sysdef,
                                             std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
                                             std::shared_ptr<CellList> cl)
-    : Compute(sysdef), m_mc(mc), m_cl(cl), m_type(0), m_n_sample(0)
+    : Compute(sysdef), m_mc(mc), m_cl(cl), m_type(0), m_n_sample(0), m_target_rel_err(0.0),
+      m_max_n_sample(10000000), m_n_sample_used(0)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing ComputeFreeVolume" << std::endl;
 
@@ -131,163 +207,222 @@ template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
  */
 template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t timestep)
     {
-    unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
-    unsigned int ndim = this->m_sysdef->getNDimensions();
-
     this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
 
     // update AABB tree
-    const detail::AABBTree& aabb_tree = this->m_mc->buildAABBTree();
+    this->m_mc->buildAABBTree();
 
     // update the image list
-    std::vector<vec3<Scalar>> image_list = this->m_mc->updateImageList();
-
-    uint16_t seed = m_sysdef->getSeed();
+    this->m_mc->updateImageList();
 
     if (m_prof)
         m_prof->push("Free volume");
 
-    // only check if AABB tree is populated
-    if (m_pdata->getN() + m_pdata->getNGhosts())
-        {
-        // access particle data and system box
-        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        const BoxDim& box = m_pdata->getBox();
+    // generate n_sample random test depletants in the global box
+    unsigned int n_sample = m_n_sample;
+    unsigned int n_ranks = 1;
 
-        // access parameters and interaction matrix
-        const std::vector<typename Shape::param_type,
-                          managed_allocator<typename Shape::param_type>>& params
-            = m_mc->getParams();
+#ifdef ENABLE_MPI
+    n_ranks = this->m_exec_conf->getNRanks();
+    n_sample /= n_ranks;
+#endif
 
-        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                             access_location::host,
-                                             access_mode::read);
-        const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    unsigned int overlap_count = 0;
+    unsigned int overlap_count_global = 0;
+    unsigned int n_sample_local = 0;
 
-        // generate n_sample random test depletants in the global box
-        unsigned int n_sample = m_n_sample;
+    // draw batches of samples until the requested accuracy is reached, all ranks agree on the
+    // global counts and therefore stop after the same batch
+    do
+        {
+        overlap_count
+            += countOverlappingSamples(timestep, n_sample_local, n_sample_local + n_sample);
+        n_sample_local += n_sample;
+        overlap_count_global = overlap_count;
 
 #ifdef ENABLE_MPI
-        n_sample /= this->m_exec_conf->getNRanks();
+        if (m_comm)
+            {
+            MPI_Allreduce(&overlap_count,
+                          &overlap_count_global,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
 #endif
 
-        for (unsigned int i = 0; i < n_sample; i++)
-            {
-            // select a random particle coordinate in the box
-            hoomd::RandomGenerator rng_i(
-                hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
-                hoomd::Counter(m_exec_conf->getRank(), i));
+        m_n_sample_used = n_sample_local * n_ranks;
+        } while (m_target_rel_err > Scalar(0.0) && n_sample > 0
+                 && m_n_sample_used + n_sample * n_ranks <= m_max_n_sample
+                 && computeRelativeError(m_n_sample_used, overlap_count_global)
+                        > m_target_rel_err);
 
-            Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::overwrite);
+    *h_n_overlap_all.data = overlap_count_global;
 
-            Scalar3 f = make_scalar3(xrand, yrand, zrand);
-            vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
+    if (m_prof)
+        m_prof->pop();
+    }
 
-            Shape shape_i(quat<Scalar>(), params[m_type]);
-            if (shape_i.hasOrientation())
-                {
-                shape_i.orientation = generateRandomOrientation(rng_i, ndim);
-                }
+/*! \param timestep Current time step
+    \param first Index of the first sample
+    \param last One past the index of the last sample
 
-            // check for overlaps with neighboring particle's positions
-            bool overlap = false;
-            detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+    \returns The number of test insertions in [first, last) that overlap with a particle
+*/
+template<class Shape>
+unsigned int ComputeFreeVolume<Shape>::countOverlappingSamples(uint64_t timestep,
+                                                               unsigned int first,
+                                                               unsigned int last)
+    {
+    unsigned int overlap_count = 0;
+
+    // only check if AABB tree is populated
+    if (!(m_pdata->getN() + m_pdata->getNGhosts()))
+        return overlap_count;
+
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    uint16_t seed = m_sysdef->getSeed();
+    unsigned int rank = m_exec_conf->getRank();
+
+    const detail::AABBTree& aabb_tree = this->m_mc->buildAABBTree();
+    const std::vector<vec3<Scalar>>& image_list = this->m_mc->updateImageList();
+
+    // access particle data and system box
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+
+    // access parameters and interaction matrix
+    const std::vector<typename Shape::param_type, managed_allocator<typename Shape::param_type>>&
+        params
+        = m_mc->getParams();
+
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                         access_location::host,
+                                         access_mode::read);
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
 
-            // All image boxes (including the primary)
-            const unsigned int n_images = (unsigned int)image_list.size();
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            overlap_count = tbb::parallel_reduce(
+                tbb::blocked_range<unsigned int>(first, last),
+                0u,
+                [&](const tbb::blocked_range<unsigned int>& r, unsigned int count) -> unsigned int
                 {
-                vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i_image);
-
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                     cur_node_idx++)
-                    {
-                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+#else
+    unsigned int& count = overlap_count;
+    for (unsigned int i = first; i < last; i++)
+#endif
                         {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                                 cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                        // every sample has its own RNG stream, independent of the thread executing it
+                        hoomd::RandomGenerator rng_i(
+                            hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
+                            hoomd::Counter(rank, i));
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
+                        // select a random particle coordinate in the box
+                        Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                        Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                        Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
 
-                                // load the position and orientation of the j particle
-                                postype_j = h_postype.data[j];
-                                orientation_j = h_orientation.data[j];
+                        Scalar3 f = make_scalar3(xrand, yrand, zrand);
+                        vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        Shape shape_i(quat<Scalar>(), params[m_type]);
+                        if (shape_i.hasOrientation())
+                            {
+                            shape_i.orientation = generateRandomOrientation(rng_i, ndim);
+                            }
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+                        // check for overlaps with neighboring particle's positions
+                        bool overlap = false;
+                        unsigned int err_count = 0;
+                        detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
 
-                                if (h_overlaps.data[overlap_idx(m_type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, err_count))
+                        // All image boxes (including the primary)
+                        const unsigned int n_images = (unsigned int)image_list.size();
+                        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                            {
+                            vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+                            detail::AABB aabb = aabb_i_local;
+                            aabb.translate(pos_i_image);
+
+                            // stackless search
+                            for (unsigned int cur_node_idx = 0;
+                                 cur_node_idx < aabb_tree.getNumNodes();
+                                 cur_node_idx++)
+                                {
+                                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
                                     {
-                                    overlap = true;
-                                    break;
+                                    if (aabb_tree.isNodeLeaf(cur_node_idx))
+                                        {
+                                        for (unsigned int cur_p = 0;
+                                             cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
+                                             cur_p++)
+                                            {
+                                            // read in its position and orientation
+                                            unsigned int j
+                                                = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                            // load the position and orientation of the j particle
+                                            Scalar4 postype_j = h_postype.data[j];
+                                            Scalar4 orientation_j = h_orientation.data[j];
+
+                                            // put particles in coordinate system of particle i
+                                            vec3<Scalar> r_ij
+                                                = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                            Shape shape_j(quat<Scalar>(orientation_j),
+                                                          params[typ_j]);
+
+                                            if (h_overlaps.data[overlap_idx(m_type, typ_j)]
+                                                && check_circumsphere_overlap(r_ij,
+                                                                              shape_i,
+                                                                              shape_j)
+                                                && test_overlap(r_ij, shape_i, shape_j, err_count))
+                                                {
+                                                overlap = true;
+                                                break;
+                                                }
+                                            }
+                                        }
+                                    }
+                                else
+                                    {
+                                    // skip ahead
+                                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
                                     }
-                                }
-                            }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
-
-                    if (overlap)
-                        break;
-                    } // end loop over AABB nodes
-
-                if (overlap)
-                    break;
-                } // end loop over images
 
-            if (overlap)
-                {
-                overlap_count++;
-                }
-            } // end loop through all particles
+                                if (overlap)
+                                    break;
+                                } // end loop over AABB nodes
 
-        } // end lexical scope
+                            if (overlap)
+                                break;
+                            } // end loop over images
 
-#ifdef ENABLE_MPI
-    if (m_comm)
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &overlap_count,
-                      1,
-                      MPI_UNSIGNED,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        }
+                        if (overlap)
+                            {
+                            count++;
+                            }
+                        } // end loop over samples
+#ifdef ENABLE_TBB
+                    return count;
+                },
+                [](unsigned int x, unsigned int y) -> unsigned int { return x + y; });
+        }); // end task arena execute()
 #endif
 
-    if (m_prof)
-        m_prof->pop();
-
-    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
-                                              access_location::host,
-                                              access_mode::overwrite);
-    *h_n_overlap_all.data = overlap_count;
+    return overlap_count;
     }
 
 // \return the free volume.
@@ -298,14 +433,8 @@ template<class Shape> Scalar ComputeFreeVolume<Shape>::getFreeVolume()
                                               access_location::host,
                                               access_mode::read);
 
-    // generate n_sample random test depletants in the global box
-    unsigned int n_sample = m_n_sample;
-
-#ifdef ENABLE_MPI
-    // in MPI, for small n_sample we can encounter round-off issues
-    unsigned int n_ranks = this->m_exec_conf->getNRanks();
-    n_sample = (n_sample / n_ranks) * n_ranks;
-#endif
+    // the number of samples actually drawn in the last evaluation, summed over ranks
+    unsigned int n_sample = m_n_sample_used;
 
     // total free volume
     const BoxDim& global_box = this->m_pdata->getGlobalBox();
@@ -315,6 +444,15 @@ template<class Shape> Scalar ComputeFreeVolume<Shape>::getFreeVolume()
     return V_free;
     }
 
+// \return the relative standard error of the free volume estimate
+template<class Shape> Scalar ComputeFreeVolume<Shape>::getRelativeError()
+    {
+    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::read);
+    return computeRelativeError(m_n_sample_used, *h_n_overlap_all.data);
+    }
+
 //! Export this hpmc analyzer to python
 /*! \param name Name of the class in the exported python module
     \tparam Shape An instantiation of ComputeFreeVolume<Shape> will be exported
@@ -333,7 +471,15 @@ template<class Shape> void export_ComputeFreeVolume(pybind11::module& m, const s
         .def_property("test_particle_type",
                       &ComputeFreeVolume<Shape>::getTestParticleType,
                       &ComputeFreeVolume<Shape>::setTestParticleType)
-        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume);
+        .def_property("target_relative_error",
+                      &ComputeFreeVolume<Shape>::getTargetRelativeError,
+                      &ComputeFreeVolume<Shape>::setTargetRelativeError)
+        .def_property("max_num_samples",
+                      &ComputeFreeVolume<Shape>::getMaxNumSamples,
+                      &ComputeFreeVolume<Shape>::setMaxNumSamples)
+        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume)
+        .def_property_readonly("relative_error", &ComputeFreeVolume<Shape>::getRelativeError)
+        .def_property_readonly("num_samples_used", &ComputeFreeVolume<Shape>::getNumSamplesUsed);
     }
 
     } // end namespace hpmc
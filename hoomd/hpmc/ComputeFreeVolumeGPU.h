@@ -267,6 +267,9 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
 
 #ifdef ENABLE_MPI
         n_sample /= this->m_exec_conf->getNRanks();
+        this->m_n_sample_used = n_sample * this->m_exec_conf->getNRanks();
+#else
+        this->m_n_sample_used = n_sample;
 #endif
 
         detail::hpmc_free_volume_args_t free_volume_args(n_sample,
@@ -0,0 +1,329 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "HPMCPrecisionSetup.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#include <algorithm>
+
+/*! \file GJKRaycast.h
+    \brief Ray casting against convex shapes given by their support functions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hpmc
+    {
+namespace detail
+    {
+//! Support function of a translated shape B minus a shape A, in the space frame
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+
+    Like CompositeSupportFunc3D, but evaluates the Minkowski difference in the space frame and in
+    Scalar precision, so that ray casts of long sweeps keep their accuracy.
+
+    \ingroup minkowski
+*/
+template<class SupportFuncA, class SupportFuncB> class SweepSupportFunc
+    {
+    public:
+    //! Construct the support function
+    /*! \param _sa Support function for shape A
+        \param _sb Support function for shape B
+        \param _r_ab Vector pointing from a's center to b's center
+        \param _q_a Orientation of shape A
+        \param _q_b Orientation of shape B
+    */
+    SweepSupportFunc(const SupportFuncA& _sa,
+                     const SupportFuncB& _sb,
+                     const vec3<Scalar>& _r_ab,
+                     const quat<Scalar>& _q_a,
+                     const quat<Scalar>& _q_b)
+        : sa(_sa), sb(_sb), r_ab(_r_ab), q_a(_q_a), q_b(_q_b)
+        {
+        }
+
+    //! Compute the support function
+    /*! \param n Direction (in the space frame)
+        \returns S_B(n) - S_A(-n) in the space frame
+    */
+    vec3<Scalar> operator()(const vec3<Scalar>& n) const
+        {
+        vec3<Scalar> SB_n
+            = rotate(q_b, vec3<Scalar>(sb(vec3<OverlapReal>(rotate(conj(q_b), n))))) + r_ab;
+        vec3<Scalar> SA_n = rotate(q_a, vec3<Scalar>(sa(vec3<OverlapReal>(rotate(conj(q_a), -n)))));
+        return SB_n - SA_n;
+        }
+
+    private:
+    const SupportFuncA& sa;    //!< Support function for shape A
+    const SupportFuncB& sb;    //!< Support function for shape B
+    const vec3<Scalar>& r_ab;  //!< Vector pointing from a's center to b's center
+    const quat<Scalar>& q_a;   //!< Orientation of shape A
+    const quat<Scalar>& q_b;   //!< Orientation of shape B
+    };
+
+//! Evaluate a 2D support function in the xy plane of a 3D frame
+/*! \tparam SupportFunc2D Support function class type taking and returning vec2<OverlapReal>
+
+    \ingroup minkowski
+*/
+template<class SupportFunc2D> class SupportFunc2DIn3D
+    {
+    public:
+    //! Construct the support function
+    SupportFunc2DIn3D(const SupportFunc2D& _s) : s(_s) { }
+
+    //! Compute the support function
+    vec3<OverlapReal> operator()(const vec3<OverlapReal>& n) const
+        {
+        vec2<OverlapReal> p = s(vec2<OverlapReal>(n.x, n.y));
+        return vec3<OverlapReal>(p.x, p.y, OverlapReal(0.0));
+        }
+
+    private:
+    const SupportFunc2D s; //!< The 2D support function
+    };
+
+//! Find the point of minimum norm in the convex hull of up to four points
+/*! \param y The points
+    \param n Number of points
+    \param subset (out) Bit mask of the points that span the face containing the closest point
+    \returns The point of minimum norm
+
+    Every subset of the points is projected onto its affine hull. Projections with non-negative
+    barycentric coordinates lie in the convex hull, and the shortest of them is the point of minimum
+    norm. Degenerate subsets (collinear or coplanar) are skipped; a lower dimensional face always
+    spans the same point in that case.
+*/
+inline vec3<Scalar>
+closest_point_on_simplex(const vec3<Scalar>* y, unsigned int n, unsigned int& subset)
+    {
+    vec3<Scalar> best = y[0];
+    Scalar best_sq = dot(y[0], y[0]);
+    subset = 1;
+
+    for (unsigned int mask = 1; mask < (1u << n); ++mask)
+        {
+        // collect the points in this subset
+        unsigned int idx[4];
+        unsigned int k = 0;
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            if (mask & (1u << i))
+                idx[k++] = i;
+            }
+
+        const vec3<Scalar>& y0 = y[idx[0]];
+        vec3<Scalar> v;
+
+        if (k == 1)
+            {
+            v = y0;
+            }
+        else
+            {
+            // minimize |y0 + sum_i mu_i e_i|^2 with e_i = y_i - y0
+            vec3<Scalar> e[3];
+            for (unsigned int i = 1; i < k; ++i)
+                e[i - 1] = y[idx[i]] - y0;
+
+            const unsigned int m = k - 1;
+            Scalar G[3][3];
+            Scalar b[3];
+            Scalar scale = Scalar(0.0);
+            for (unsigned int i = 0; i < m; ++i)
+                {
+                for (unsigned int j = 0; j < m; ++j)
+                    G[i][j] = dot(e[i], e[j]);
+                b[i] = -dot(e[i], y0);
+                scale = std::max(scale, G[i][i]);
+                }
+
+            Scalar mu[3];
+            const Scalar eps = Scalar(1e-12);
+            if (m == 1)
+                {
+                if (G[0][0] <= eps * scale || G[0][0] == Scalar(0.0))
+                    continue;
+                mu[0] = b[0] / G[0][0];
+                }
+            else if (m == 2)
+                {
+                Scalar det = G[0][0] * G[1][1] - G[0][1] * G[1][0];
+                if (fabs(det) <= eps * scale * scale)
+                    continue;
+                mu[0] = (b[0] * G[1][1] - G[0][1] * b[1]) / det;
+                mu[1] = (G[0][0] * b[1] - b[0] * G[1][0]) / det;
+                }
+            else
+                {
+                Scalar c00 = G[1][1] * G[2][2] - G[1][2] * G[2][1];
+                Scalar c01 = G[1][2] * G[2][0] - G[1][0] * G[2][2];
+                Scalar c02 = G[1][0] * G[2][1] - G[1][1] * G[2][0];
+                Scalar det = G[0][0] * c00 + G[0][1] * c01 + G[0][2] * c02;
+                if (fabs(det) <= eps * scale * scale * scale)
+                    continue;
+
+                // Cramer's rule
+                mu[0] = (b[0] * c00 + G[0][1] * (b[2] * G[1][2] - b[1] * G[2][2])
+                         + G[0][2] * (b[1] * G[2][1] - b[2] * G[1][1]))
+                        / det;
+                mu[1] = (G[0][0] * (b[1] * G[2][2] - G[1][2] * b[2])
+                         + b[0] * (G[1][2] * G[2][0] - G[1][0] * G[2][2])
+                         + G[0][2] * (G[1][0] * b[2] - b[1] * G[2][0]))
+                        / det;
+                mu[2] = (G[0][0] * (G[1][1] * b[2] - b[1] * G[2][1])
+                         + G[0][1] * (b[1] * G[2][0] - G[1][0] * b[2])
+                         + b[0] * (G[1][0] * G[2][1] - G[1][1] * G[2][0]))
+                        / det;
+                }
+
+            // barycentric coordinates must be non-negative for the point to lie in the hull
+            Scalar mu_sum = Scalar(0.0);
+            bool inside = true;
+            for (unsigned int i = 0; i < m; ++i)
+                {
+                if (mu[i] < Scalar(0.0))
+                    inside = false;
+                mu_sum += mu[i];
+                }
+            if (!inside || mu_sum > Scalar(1.0))
+                continue;
+
+            v = y0;
+            for (unsigned int i = 0; i < m; ++i)
+                v += mu[i] * e[i];
+            }
+
+        Scalar v_sq = dot(v, v);
+        if (v_sq < best_sq)
+            {
+            best = v;
+            best_sq = v_sq;
+            subset = mask;
+            }
+        }
+
+    return best;
+    }
+
+//! Cast a ray against a convex set given by its support function
+/*! \param sc Support function of the convex set C
+    \param r Ray direction
+    \param lambda_max Maximum ray parameter to consider
+    \param tol Absolute distance tolerance
+    \param lambda (out) Smallest ray parameter at which the ray point lambda*r touches C
+    \param normal (out) Normal of a supporting plane of C at the hit, pointing towards the ray
+                  origin
+    \param err Incremented if the iteration does not converge
+    \returns true if the ray hits C with lambda <= lambda_max
+
+    Implements the GJK-based ray cast of G. van den Bergen, "Ray Casting against General Convex
+    Objects with Application to Continuous Collision Detection" (2004). The ray parameter only ever
+    advances to supporting planes of C, so lambda is a lower bound on the exact hit distance.
+*/
+template<class SupportFunc>
+inline bool gjk_raycast(const SupportFunc& sc,
+                        const vec3<Scalar>& r,
+                        Scalar lambda_max,
+                        Scalar tol,
+                        Scalar& lambda,
+                        vec3<Scalar>& normal,
+                        unsigned int& err)
+    {
+    const unsigned int max_iterations = 256;
+    const Scalar tol_sq = tol * tol;
+
+    lambda = Scalar(0.0);
+    normal = vec3<Scalar>(0, 0, 0);
+    vec3<Scalar> x(0, 0, 0);
+
+    // points of C spanning the current simplex
+    vec3<Scalar> p[4];
+    unsigned int n = 0;
+
+    vec3<Scalar> v = x - sc(r);
+
+    for (unsigned int iteration = 0; iteration < max_iterations; ++iteration)
+        {
+        if (dot(v, v) <= tol_sq)
+            {
+            if (normal == vec3<Scalar>(0, 0, 0))
+                normal = v;
+            return true;
+            }
+
+        vec3<Scalar> p_new = sc(v);
+        vec3<Scalar> w = x - p_new;
+        Scalar vw = dot(v, w);
+        bool advanced = false;
+        if (vw > Scalar(0.0))
+            {
+            // v defines a plane that separates x from C, advance x to the plane
+            Scalar vr = dot(v, r);
+            if (vr >= Scalar(0.0))
+                return false;
+
+            lambda -= vw / vr;
+            if (lambda > lambda_max)
+                return false;
+
+            x = lambda * r;
+            normal = v;
+            advanced = true;
+            }
+
+        // the support point may already be part of the simplex
+        bool duplicate = false;
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            vec3<Scalar> d = p[i] - p_new;
+            if (dot(d, d) <= tol_sq)
+                duplicate = true;
+            }
+
+        if (duplicate && !advanced)
+            {
+            // no further progress is possible, report a hit at the current (conservative) ray
+            // parameter
+            if (normal == vec3<Scalar>(0, 0, 0))
+                normal = v;
+            return true;
+            }
+
+        if (!duplicate)
+            p[n++] = p_new;
+
+        // find the point of x - conv(P) closest to the origin and reduce the simplex
+        vec3<Scalar> y[4];
+        for (unsigned int i = 0; i < n; ++i)
+            y[i] = x - p[i];
+
+        unsigned int subset;
+        v = closest_point_on_simplex(y, n, subset);
+
+        unsigned int k = 0;
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            if (subset & (1u << i))
+                p[k++] = p[i];
+            }
+        n = k;
+        }
+
+    // report a hit at the current (conservative) ray parameter
+    err++;
+    if (normal == vec3<Scalar>(0, 0, 0))
+        normal = v;
+    return true;
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
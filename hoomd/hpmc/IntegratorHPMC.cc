@@ -27,6 +27,15 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMC" << endl;
 
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition() && m_pdata->getDomainDecomposition()->isRCB())
+        {
+        m_exec_conf->msg->error() << "hpmc: recursive coordinate bisection is not supported"
+                                  << endl;
+        throw std::runtime_error("Error initializing IntegratorHPMC");
+        }
+#endif
+
     GlobalArray<hpmc_counters_t> counters(1, this->m_exec_conf);
     m_count_total.swap(counters);
 
@@ -18,6 +18,7 @@
 
 #include "ExternalField.h"
 #include "HPMCCounters.h"
+#include "PatchEnergyBatch.h"
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -168,6 +169,38 @@ class PatchEnergy
         return 0;
         }
 
+    //! evaluate the energies of a batch of patch interactions with a common particle i
+    /*! \param type_i Integer type index of particle i
+        \param q_i Orientation quaternion of particle i
+        \param d_i Diameter of particle i
+        \param charge_i Charge of particle i
+        \param batch The j particles, the energy of each pair is written to batch.energy
+
+        The default implementation calls energy() once per pair. Subclasses may override this
+        method to evaluate all pairs in one call.
+    */
+    virtual void energyBatch(unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             PatchEnergyBatch& batch)
+        {
+        const unsigned int n = batch.size();
+        batch.energy.resize(n);
+        for (unsigned int k = 0; k < n; ++k)
+            {
+            batch.energy[k] = energy(batch.getRij(k),
+                                     type_i,
+                                     q_i,
+                                     d_i,
+                                     charge_i,
+                                     batch.type_j[k],
+                                     batch.getQj(k),
+                                     batch.d_j[k],
+                                     batch.charge_j[k]);
+            }
+        }
+
 #ifdef ENABLE_HIP
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
@@ -17,6 +17,7 @@
 #include "HPMCPrecisionSetup.h"
 #include "IntegratorHPMC.h"
 #include "Moves.h"
+#include "CircumsphereList.h"
 #include "hoomd/AABBTree.h"
 #include "GSDHPMCSchema.h"
 #include "hoomd/Index1D.h"
@@ -504,6 +505,14 @@ class IntegratorHPMCMono : public IntegratorHPMC
         GlobalVector<Scalar> m_fugacity;            //!< Average depletant number density in free volume, per type
         GlobalVector<unsigned int> m_ntrial;        //!< Number of reinsertion attempts per depletant in overlap volume, per type
 
+        /* Patch energy cache, valid for the duration of one call to update() */
+
+        std::vector<double> m_patch_energy_cache;                     //!< Patch energy of each local particle in its current configuration
+        std::vector<unsigned char> m_patch_energy_cache_valid;        //!< Nonzero if the cached patch energy is up to date
+        std::vector< std::vector<unsigned int> > m_patch_neighbors;   //!< Neighbors within the patch cutoff in the cached configuration
+        std::vector<unsigned int> m_patch_neighbors_new;              //!< Neighbors within the patch cutoff of the trial configuration
+        PatchEnergyBatch m_patch_batch;                               //!< Pairs to evaluate with PatchEnergy::energyBatch()
+
         GlobalArray<hpmc_implicit_counters_t> m_implicit_count;               //!< Counter of depletant insertions
         std::vector<hpmc_implicit_counters_t> m_implicit_count_run_start;     //!< Counter of depletant insertions at run start
         std::vector<hpmc_implicit_counters_t> m_implicit_count_step_start;    //!< Counter of depletant insertions at step start
@@ -789,6 +798,18 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // Cache the patch energy of each particle in its current configuration. A rejected trial move leaves
+    // the cache intact, so the next trial of the same particle only evaluates the energy of the new
+    // configuration. Accepting a move invalidates the particle's neighbors. Like the AABB tree, the cache
+    // is rebuilt on every call to update() because particle data and patch parameters may change between steps.
+    const bool use_patch = m_patch && !m_patch_log;
+    if (use_patch)
+        {
+        m_patch_energy_cache.resize(m_pdata->getN());
+        m_patch_energy_cache_valid.assign(m_pdata->getN(), 0);
+        m_patch_neighbors.resize(m_pdata->getN());
+        }
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
@@ -887,6 +908,11 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
+            // patch energy of the trial configuration
+            double patch_energy_new = 0;
+            m_patch_neighbors_new.clear();
+            m_patch_batch.clear();
+
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
             const unsigned int n_images = (unsigned int)m_image_list.size();
@@ -951,18 +977,15 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     overlap = true;
                                     break;
                                     }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                                else if (use_patch && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, queue the energy evaluation
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               float(h_diameter.data[i]),
-                                                               float(h_charge.data[i]),
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               float(h_diameter.data[j]),
-                                                               float(h_charge.data[j])
-                                                               );
+                                    m_patch_batch.push_back(vec3<float>(r_ij),
+                                                            typ_j,
+                                                            quat<float>(orientation_j),
+                                                            float(h_diameter.data[j]),
+                                                            float(h_charge.data[j]));
+                                    if (j != i)
+                                        m_patch_neighbors_new.push_back(j);
                                     }
                                 }
                             }
@@ -981,80 +1004,120 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     break;
                 } // end loop over images
 
+            // evaluate the patch energy of the new configuration with all neighbors at once
+            if (use_patch && !overlap && m_patch_batch.size() > 0)
+                {
+                m_patch->energyBatch(typ_i,
+                                     quat<float>(shape_i.orientation),
+                                     float(h_diameter.data[i]),
+                                     float(h_charge.data[i]),
+                                     m_patch_batch);
+                for (unsigned int k = 0; k < m_patch_batch.size(); ++k)
+                    patch_energy_new += m_patch_batch.energy[k];
+                }
+
+            // deltaU = U_old - U_new: subtract energy of new configuration
+            patch_field_energy_diff -= patch_energy_new;
+
             // calculate old patch energy only if m_patch not NULL and no overlaps
-            if (m_patch && !m_patch_log && !overlap)
+            if (use_patch && !overlap)
                 {
-                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                if (!m_patch_energy_cache_valid[i])
                     {
-                    vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
-                    detail::AABB aabb = aabb_i_local;
-                    aabb.translate(pos_i_image);
+                    double patch_energy_old = 0;
+                    std::vector<unsigned int>& neighbors_old = m_patch_neighbors[i];
+                    neighbors_old.clear();
+                    m_patch_batch.clear();
 
-                    // stackless search
-                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                         {
-                        if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
+                        detail::AABB aabb = aabb_i_local;
+                        aabb.translate(pos_i_image);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
                             {
-                            if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
                                 {
-                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
                                     {
-                                    // read in its position and orientation
-                                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        // read in its position and orientation
+                                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                    Scalar4 postype_j;
-                                    Scalar4 orientation_j;
+                                        Scalar4 postype_j;
+                                        Scalar4 orientation_j;
 
-                                    // handle j==i situations
-                                    if ( j != i )
-                                        {
-                                        // load the position and orientation of the j particle
-                                        postype_j = h_postype.data[j];
-                                        orientation_j = h_orientation.data[j];
-                                        }
-                                    else
-                                        {
-                                        if (cur_image == 0)
+                                        // handle j==i situations
+                                        if ( j != i )
                                             {
-                                            // in the first image, skip i == j
-                                            continue;
+                                            // load the position and orientation of the j particle
+                                            postype_j = h_postype.data[j];
+                                            orientation_j = h_orientation.data[j];
                                             }
                                         else
                                             {
-                                            // If this is particle i and we are in an outside image, use the translated position and orientation
-                                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
-                                            orientation_j = quat_to_scalar4(shape_old.orientation);
+                                            if (cur_image == 0)
+                                                {
+                                                // in the first image, skip i == j
+                                                continue;
+                                                }
+                                            else
+                                                {
+                                                // If this is particle i and we are in an outside image, use the translated position and orientation
+                                                postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                                                orientation_j = quat_to_scalar4(shape_old.orientation);
+                                                }
                                             }
-                                        }
 
-                                    // put particles in coordinate system of particle i
-                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
-
-                                    Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
-
-                                    // deltaU = U_old - U_new: add energy of old configuration
-                                    if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   float(h_diameter.data[i]),
-                                                                   float(h_charge.data[i]),
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   float(h_diameter.data[j]),
-                                                                   float(h_charge.data[j]));
+                                        // put particles in coordinate system of particle i
+                                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                        Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                                        Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                                        if (dot(r_ij,r_ij) <= rcut*rcut)
+                                            {
+                                            m_patch_batch.push_back(vec3<float>(r_ij),
+                                                                    typ_j,
+                                                                    quat<float>(orientation_j),
+                                                                    float(h_diameter.data[j]),
+                                                                    float(h_charge.data[j]));
+                                            if (j != i)
+                                                neighbors_old.push_back(j);
+                                            }
+                                        }
                                     }
                                 }
-                            }
-                        else
-                            {
-                            // skip ahead
-                            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
-                            }
-                        }  // end loop over AABB nodes
-                    } // end loop over images
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+                            }  // end loop over AABB nodes
+                        } // end loop over images
+
+                    // evaluate the patch energy of the old configuration with all neighbors at once
+                    if (m_patch_batch.size() > 0)
+                        {
+                        m_patch->energyBatch(typ_i,
+                                             quat<float>(orientation_i),
+                                             float(h_diameter.data[i]),
+                                             float(h_charge.data[i]),
+                                             m_patch_batch);
+                        for (unsigned int k = 0; k < m_patch_batch.size(); ++k)
+                            patch_energy_old += m_patch_batch.energy[k];
+                        }
+
+                    m_patch_energy_cache[i] = patch_energy_old;
+                    m_patch_energy_cache_valid[i] = 1;
+                    }
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += m_patch_energy_cache[i];
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -1105,6 +1168,27 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 // store new seed
                 if (has_depletants)
                     h_vel.data[i].x = __int_as_scalar(seed_i_new);
+
+                if (use_patch)
+                    {
+                    // the pair energies between i and its old and new neighbors have changed
+                    const unsigned int N = m_pdata->getN();
+                    for (unsigned int j : m_patch_neighbors[i])
+                        {
+                        if (j < N)
+                            m_patch_energy_cache_valid[j] = 0;
+                        }
+                    for (unsigned int j : m_patch_neighbors_new)
+                        {
+                        if (j < N)
+                            m_patch_energy_cache_valid[j] = 0;
+                        }
+
+                    // the energy of the new configuration is the energy of i in its current configuration
+                    m_patch_energy_cache[i] = patch_energy_new;
+                    m_patch_neighbors[i].swap(m_patch_neighbors_new);
+                    m_patch_energy_cache_valid[i] = 1;
+                    }
                 }
             else
                 {
@@ -2328,6 +2412,9 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
     const unsigned int n_images = (unsigned int) this->m_image_list.size();
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
+    // number of depletants generated and pre-checked together (also the TBB grain size)
+    const unsigned int depletant_block_size = 32;
+
     Shape shape_old(quat<Scalar>(h_orientation[i]), this->m_params[typ_i]);
     detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
     detail::AABB aabb_i_local_old = shape_old.getAABB(vec3<Scalar>(0,0,0));
@@ -2379,6 +2466,10 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
             std::vector<unsigned int> tag_j_new;
             std::vector<unsigned int> seed_j_new;
 
+            // circumspheres of the intersecting particles, for the vectorized pre-check
+            detail::CircumsphereList spheres_j_old;
+            detail::CircumsphereList spheres_j_new;
+
             bool repulsive = fugacity < 0.0;
 
             // find neighbors whose OBBs overlap particle i's OBB in the old configuration
@@ -2465,6 +2556,8 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                                     type_j_old.push_back(typ_j);
                                     tag_j_old.push_back(h_tag[j]);
                                     seed_j_old.push_back(__scalar_as_int(h_vel[j].x));
+                                    spheres_j_old.push_back(pos_j-this->m_image_list[cur_image],
+                                        shape_j.getCircumsphereDiameter());
                                     }
                                 }
                             }
@@ -2563,6 +2656,8 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                                     type_j_new.push_back(typ_j);
                                     tag_j_new.push_back(h_tag[j]);
                                     seed_j_new.push_back(__scalar_as_int(h_vel[j].x));
+                                    spheres_j_new.push_back(pos_j-this->m_image_list[cur_image],
+                                        shape_j.getCircumsphereDiameter());
                                     }
                                 }
                             }
@@ -2581,6 +2676,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                 [=, &shape_old, &shape_i,
                     &pos_j_new, &orientation_j_new, &type_j_new,
                     &pos_j_old, &orientation_j_old, &type_j_old,
+                    &spheres_j_new, &spheres_j_old,
                     &thread_ln_denominator, &thread_ln_numerator,
                     &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& v) {
             for (unsigned int new_config = v.begin(); new_config != v.end(); ++new_config)
@@ -2596,6 +2692,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                     [=, &shape_old, &shape_i,
                         &pos_j_new, &orientation_j_new, &type_j_new,
                         &pos_j_old, &orientation_j_old, &type_j_old,
+                        &spheres_j_new, &spheres_j_old,
                         &thread_ln_denominator, &thread_ln_numerator,
                         &thread_counters, &thread_implicit_counters]
                         (const tbb::blocked_range<unsigned int>& u) {
@@ -2621,209 +2718,267 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                     // try inserting in the overlap volume
                     size_t n_intersect = new_config ? pos_j_new.size() : pos_j_old.size();
 
-                    // for every depletant
+                    // for every block of depletants
                     #ifdef ENABLE_TBB
-                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n, depletant_block_size),
                         [=, &shape_old, &shape_i,
                             &pos_j_new, &orientation_j_new, &type_j_new,
                             &pos_j_old, &orientation_j_old, &type_j_old,
+                            &spheres_j_new, &spheres_j_old,
                             &thread_ln_denominator, &thread_ln_numerator,
                             &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& t) {
-                    for (unsigned int l = t.begin(); l != t.end(); ++l)
+                    unsigned int l_begin = t.begin();
+                    unsigned int l_end = t.end();
                     #else
-                    for (unsigned int l = 0; l < n; ++l)
+                    for (unsigned int l_begin = 0; l_begin < n; l_begin += depletant_block_size)
                     #endif
                         {
-                        hoomd::RandomGenerator my_rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
-                                                                  0,
-                                                                  0),
-                                                      hoomd::Counter(new_config ? seed_i_new : seed_i_old,
-                                                                     l,
-                                                                     i_trial,
-                                                                     static_cast<uint16_t>(type_a+type_b*ntypes))
-                                                      );
+                        #ifndef ENABLE_TBB
+                        unsigned int l_end = std::min(l_begin + depletant_block_size, n);
+                        #endif
+
+                        Shape shape_test_a(quat<Scalar>(), this->m_params[type_a]);
+                        Shape shape_test_b(quat<Scalar>(), this->m_params[type_b]);
+                        OverlapReal d_test = detail::max(shape_test_a.getCircumsphereDiameter(),
+                            shape_test_b.getCircumsphereDiameter());
+
+                        // generate the positions and orientations of all depletants in this block
+                        detail::CircumsphereList block_spheres;
+                        std::vector< vec3<Scalar> > block_pos(l_end - l_begin);
+                        std::vector< quat<Scalar> > block_orientation(l_end - l_begin);
+                        for (unsigned int l = l_begin; l < l_end; ++l)
+                            {
+                            hoomd::RandomGenerator my_rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
+                                                                      0,
+                                                                      0),
+                                                          hoomd::Counter(new_config ? seed_i_new : seed_i_old,
+                                                                         l,
+                                                                         i_trial,
+                                                                         static_cast<uint16_t>(type_a+type_b*ntypes))
+                                                          );
+
+                            // rejection-free sampling
+                            vec3<Scalar> pos_test(generatePositionInOBB(my_rng, obb_i, ndim));
+                            quat<Scalar> o;
+                            if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
+                                {
+                                o = generateRandomOrientation(my_rng, ndim);
+                                }
+
+                            block_pos[l - l_begin] = pos_test;
+                            block_orientation[l - l_begin] = o;
+                            block_spheres.push_back(pos_test, d_test);
+                            }
 
                         if (! shape_i.ignoreStatistics())
                             {
                             #ifdef ENABLE_TBB
-                            thread_implicit_counters[m_depletant_idx(type_a,type_b)].local().insert_count++;
+                            thread_implicit_counters[m_depletant_idx(type_a,type_b)].local().insert_count += l_end - l_begin;
                             #else
-                            implicit_counters[m_depletant_idx(type_a,type_b)].insert_count++;
+                            implicit_counters[m_depletant_idx(type_a,type_b)].insert_count += l_end - l_begin;
                             #endif
                             }
 
-                        // rejection-free sampling
-                        vec3<Scalar> pos_test(generatePositionInOBB(my_rng, obb_i, ndim));
-
-                        Shape shape_test_a(quat<Scalar>(), this->m_params[type_a]);
-                        Shape shape_test_b(quat<Scalar>(), this->m_params[type_b]);
-                        quat<Scalar> o;
-                        if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
-                            {
-                            o = generateRandomOrientation(my_rng, ndim);
-                            }
-                        if (shape_test_a.hasOrientation())
-                            shape_test_a.orientation = o;
-                        if (shape_test_b.hasOrientation())
-                            shape_test_b.orientation = o;
+                        // vectorized pre-check of the whole block against the circumsphere of particle i
+                        const Shape& shape_i_config = !new_config ? shape_old : shape_i;
+                        std::vector<unsigned char> mask_i(l_end - l_begin);
+                        block_spheres.computeOverlapMask(new_config ? pos_i : pos_i_old,
+                            shape_i_config.getCircumsphereDiameter(), mask_i.data());
 
-                        // Check if the new (old) configuration of particle i generates an overlap
-                        bool overlap_i_a = false;
-                        bool overlap_i_b = false;
+                        // scratch space for the pre-check against the intersecting particles
+                        const detail::CircumsphereList& spheres_j = new_config ? spheres_j_new : spheres_j_old;
+                        std::vector<unsigned char> mask_j(n_intersect);
 
-                        vec3<Scalar> r_i_test = pos_test - (new_config ? pos_i : pos_i_old);
+                        for (unsigned int l = l_begin; l < l_end; ++l)
                             {
-                            const Shape& shape = !new_config ? shape_old : shape_i;
+                            vec3<Scalar> pos_test = block_pos[l - l_begin];
+                            if (shape_test_a.hasOrientation())
+                                shape_test_a.orientation = block_orientation[l - l_begin];
+                            if (shape_test_b.hasOrientation())
+                                shape_test_b.orientation = block_orientation[l - l_begin];
 
-                            OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
-                            OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                            bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                            // Check if the new (old) configuration of particle i generates an overlap
+                            bool overlap_i_a = false;
+                            bool overlap_i_b = false;
 
-                            if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
+                            vec3<Scalar> r_i_test = pos_test - (new_config ? pos_i : pos_i_old);
 
-                            if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
+                            // the depletant is outside the circumsphere of particle i, skip the exact tests
+                            if (!mask_i[l - l_begin])
                                 {
+                                unsigned int n_checks = h_overlaps[this->m_overlap_idx(type_a, typ_i)];
+                                if (type_a != type_b)
+                                    n_checks += h_overlaps[this->m_overlap_idx(type_b, typ_i)];
                                 #ifdef ENABLE_TBB
-                                thread_counters.local().overlap_checks++;
+                                thread_counters.local().overlap_checks += n_checks;
                                 #else
-                                counters.overlap_checks++;
+                                counters.overlap_checks += n_checks;
                                 #endif
+                                continue;
+                                }
 
-                                unsigned int err = 0;
-                                if (circumsphere_overlap &&
-                                    test_overlap(r_i_test, shape, shape_test_a, err))
+                                {
+                                const Shape& shape = shape_i_config;
+
+                                OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
+                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
                                     {
-                                    overlap_i_a = true;
+                                    #ifdef ENABLE_TBB
+                                    thread_counters.local().overlap_checks++;
+                                    #else
+                                    counters.overlap_checks++;
+                                    #endif
+
+                                    unsigned int err = 0;
+                                    if (circumsphere_overlap &&
+                                        test_overlap(r_i_test, shape, shape_test_a, err))
+                                        {
+                                        overlap_i_a = true;
+                                        }
+                                    if (err)
+                                    #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_err_count++;
+                                    #else
+                                        counters.overlap_err_count++;
+                                    #endif
                                     }
-                                if (err)
-                                #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_err_count++;
-                                #else
-                                    counters.overlap_err_count++;
-                                #endif
                                 }
-                            }
 
-                        if (type_b == type_a)
-                            {
-                            overlap_i_b = overlap_i_a;
-                            }
-                        else
-                            {
-                            const Shape& shape = !new_config ? shape_old : shape_i;
-
-                            OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
-                            OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                            bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                            if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
+                            if (type_b == type_a)
                                 {
-                                #ifdef ENABLE_TBB
-                                thread_counters.local().overlap_checks++;
-                                #else
-                                counters.overlap_checks++;
-                                #endif
+                                overlap_i_b = overlap_i_a;
+                                }
+                            else
+                                {
+                                const Shape& shape = shape_i_config;
 
-                                unsigned int err = 0;
-                                if (circumsphere_overlap &&
-                                    test_overlap(r_i_test, shape, shape_test_b, err))
+                                OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
+                                OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
                                     {
-                                    overlap_i_b = true;
+                                    #ifdef ENABLE_TBB
+                                    thread_counters.local().overlap_checks++;
+                                    #else
+                                    counters.overlap_checks++;
+                                    #endif
+
+                                    unsigned int err = 0;
+                                    if (circumsphere_overlap &&
+                                        test_overlap(r_i_test, shape, shape_test_b, err))
+                                        {
+                                        overlap_i_b = true;
+                                        }
+                                    if (err)
+                                    #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_err_count++;
+                                    #else
+                                        counters.overlap_err_count++;
+                                    #endif
                                     }
-                                if (err)
-                                #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_err_count++;
-                                #else
-                                    counters.overlap_err_count++;
-                                #endif
                                 }
-                            }
-                        if (!overlap_i_a && !overlap_i_b)
-                            {
-                            // reject because we can't insert in overlap volume
-                            continue;
-                            }
-
-                        unsigned int n_overlap = 0;
-                        unsigned int tag_i = h_tag[i];
-                        for (size_t m = 0; m < n_intersect; ++m)
-                            {
-                            unsigned int type_m = new_config ? type_j_new[m] : type_j_old[m];
-                            Shape shape_m(new_config ? orientation_j_new[m] : orientation_j_old[m], this->m_params[type_m]);
-                            vec3<Scalar> r_mk = (new_config ? pos_j_new[m] : pos_j_old[m]) - pos_test;
+                            if (!overlap_i_a && !overlap_i_b)
+                                {
+                                // reject because we can't insert in overlap volume
+                                continue;
+                                }
 
+                            // every intersecting particle is counted as checked, including those that
+                            // are rejected by the vectorized circumsphere test
                             #ifdef ENABLE_TBB
-                            thread_counters.local().overlap_checks++;
+                            thread_counters.local().overlap_checks += n_intersect;
                             #else
-                            counters.overlap_checks++;
+                            counters.overlap_checks += n_intersect;
                             #endif
 
-                            unsigned int err = 0;
-
-                            // check circumsphere overlap
-                            OverlapReal rsq = (OverlapReal) dot(r_mk,r_mk);
-                            OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
-                            bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                            bool overlap_j_a = h_overlaps[this->m_overlap_idx(type_a,type_m)]
-                                && circumsphere_overlap
-                                && test_overlap(r_mk, shape_test_a, shape_m, err);
-
-                            bool overlap_j_b;
-                            if (type_a == type_b)
+                            if (!spheres_j.computeOverlapMask(pos_test, d_test, mask_j.data()))
                                 {
-                                overlap_j_b = overlap_j_a;
+                                // no intersecting particle is close enough to overlap the depletant
+                                continue;
                                 }
-                            else
+
+                            unsigned int n_overlap = 0;
+                            unsigned int tag_i = h_tag[i];
+                            for (size_t m = 0; m < n_intersect; ++m)
                                 {
-                                DaDb = shape_test_b.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
-                                circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                                if (!mask_j[m])
+                                    continue;
+
+                                unsigned int type_m = new_config ? type_j_new[m] : type_j_old[m];
+                                Shape shape_m(new_config ? orientation_j_new[m] : orientation_j_old[m], this->m_params[type_m]);
+                                vec3<Scalar> r_mk = (new_config ? pos_j_new[m] : pos_j_old[m]) - pos_test;
+
+                                unsigned int err = 0;
 
-                                overlap_j_b = h_overlaps[this->m_overlap_idx(type_b,type_m)]
+                                // check circumsphere overlap
+                                OverlapReal rsq = (OverlapReal) dot(r_mk,r_mk);
+                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
+                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                bool overlap_j_a = h_overlaps[this->m_overlap_idx(type_a,type_m)]
                                     && circumsphere_overlap
-                                    && test_overlap(r_mk, shape_test_b, shape_m, err);
-                                }
+                                    && test_overlap(r_mk, shape_test_a, shape_m, err);
 
-                            // non-additive depletants
-                            if (((overlap_i_a && overlap_j_b) || (overlap_i_b && overlap_j_a)))
-                                {
-                                unsigned int tag_m = new_config ? tag_j_new[m] : tag_j_old[m];
-                                if (tag_i < tag_m)
+                                bool overlap_j_b;
+                                if (type_a == type_b)
                                     {
-                                    n_overlap++;
+                                    overlap_j_b = overlap_j_a;
                                     }
-                                }
+                                else
+                                    {
+                                    DaDb = shape_test_b.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
+                                    circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
 
-                            if (err)
-                            #ifdef ENABLE_TBB
-                                thread_counters.local().overlap_err_count++;
-                            #else
-                                counters.overlap_err_count++;
-                            #endif
-                            } // end loop over intersections
+                                    overlap_j_b = h_overlaps[this->m_overlap_idx(type_b,type_m)]
+                                        && circumsphere_overlap
+                                        && test_overlap(r_mk, shape_test_b, shape_m, err);
+                                    }
 
-                        // indicator function for MC integration
-                        unsigned int chi = n_overlap > 0;
+                                // non-additive depletants
+                                if (((overlap_i_a && overlap_j_b) || (overlap_i_b && overlap_j_a)))
+                                    {
+                                    unsigned int tag_m = new_config ? tag_j_new[m] : tag_j_old[m];
+                                    if (tag_i < tag_m)
+                                        {
+                                        n_overlap++;
+                                        }
+                                    }
 
-                        Scalar betaF = log(1.0+(Scalar)chi/(Scalar)ntrial);
+                                if (err)
+                                #ifdef ENABLE_TBB
+                                    thread_counters.local().overlap_err_count++;
+                                #else
+                                    counters.overlap_err_count++;
+                                #endif
+                                } // end loop over intersections
 
-                        if ((repulsive && new_config) || (!repulsive && !new_config))
-                            {
-                            #ifdef ENABLE_TBB
-                            thread_ln_denominator.local()[i_trial] += betaF;
-                            #else
-                            ln_denominator[i_trial] += betaF;
-                            #endif
-                            }
-                        else
-                            {
-                            #ifdef ENABLE_TBB
-                            thread_ln_numerator.local()[i_trial] += betaF;
-                            #else
-                            ln_numerator[i_trial] += betaF;
-                            #endif
-                            }
-                        } // end loop over depletants
+                            // indicator function for MC integration
+                            unsigned int chi = n_overlap > 0;
+
+                            Scalar betaF = log(1.0+(Scalar)chi/(Scalar)ntrial);
+
+                            if ((repulsive && new_config) || (!repulsive && !new_config))
+                                {
+                                #ifdef ENABLE_TBB
+                                thread_ln_denominator.local()[i_trial] += betaF;
+                                #else
+                                ln_denominator[i_trial] += betaF;
+                                #endif
+                                }
+                            else
+                                {
+                                #ifdef ENABLE_TBB
+                                thread_ln_numerator.local()[i_trial] += betaF;
+                                #else
+                                ln_numerator[i_trial] += betaF;
+                                #endif
+                                }
+                            } // end loop over depletants
+                        } // end loop over blocks
                     #ifdef ENABLE_TBB
                         });
                     #endif
@@ -2834,6 +2989,7 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                         [=, &shape_old, &shape_i,
                             &pos_j_new, &orientation_j_new, &type_j_new,
                             &pos_j_old, &orientation_j_old, &type_j_old,
+                            &spheres_j_new, &spheres_j_old,
                             &thread_ln_denominator, &thread_ln_numerator,
                             &thread_counters, &thread_implicit_counters](const tbb::blocked_range<size_t>& y) {
                     for (size_t k = y.begin(); k != y.end(); ++k)
@@ -2878,255 +3034,365 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
 
                         unsigned int n = poisson(rng_num);
 
-                        // for every depletant
+                        // for every block of depletants
                         #ifdef ENABLE_TBB
-                        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
+                        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n, depletant_block_size),
                             [=, &shape_old, &shape_i,
                                 &pos_j_new, &orientation_j_new, &type_j_new,
                                 &pos_j_old, &orientation_j_old, &type_j_old,
+                                &spheres_j_new, &spheres_j_old,
                                 &thread_ln_denominator, &thread_ln_numerator,
                                 &thread_counters, &thread_implicit_counters](const tbb::blocked_range<unsigned int>& t) {
-                        for (unsigned int l = t.begin(); l != t.end(); ++l)
+                        unsigned int l_begin = t.begin();
+                        unsigned int l_end = t.end();
                         #else
-                        for (unsigned int l = 0; l < n; ++l)
+                        for (unsigned int l_begin = 0; l_begin < n; l_begin += depletant_block_size)
                         #endif
                             {
-                            hoomd::RandomGenerator my_rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
-                                                                      0,
-                                                                      0),
-                                                          hoomd::Counter(seed_j,
-                                                                         l,
-                                                                         i_trial,
-                                                                         static_cast<uint16_t>(type_a+type_b*ntypes))
-                                                        );
+                            #ifndef ENABLE_TBB
+                            unsigned int l_end = std::min(l_begin + depletant_block_size, n);
+                            #endif
+
+                            Shape shape_test_a(quat<Scalar>(), this->m_params[type_a]);
+                            Shape shape_test_b(quat<Scalar>(), this->m_params[type_b]);
+                            OverlapReal d_test = detail::max(shape_test_a.getCircumsphereDiameter(),
+                                shape_test_b.getCircumsphereDiameter());
+
+                            // generate the positions and orientations of all depletants in this block
+                            detail::CircumsphereList block_spheres;
+                            std::vector< vec3<Scalar> > block_pos(l_end - l_begin);
+                            std::vector< quat<Scalar> > block_orientation(l_end - l_begin);
+                            for (unsigned int l = l_begin; l < l_end; ++l)
+                                {
+                                hoomd::RandomGenerator my_rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
+                                                                          0,
+                                                                          0),
+                                                              hoomd::Counter(seed_j,
+                                                                             l,
+                                                                             i_trial,
+                                                                             static_cast<uint16_t>(type_a+type_b*ntypes))
+                                                            );
+
+                                // rejection-free sampling
+                                vec3<Scalar> pos_test(generatePositionInOBB(my_rng, obb_k, ndim));
+                                quat<Scalar> o;
+                                if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
+                                    {
+                                    o = generateRandomOrientation(my_rng, ndim);
+                                    }
+
+                                block_pos[l - l_begin] = pos_test;
+                                block_orientation[l - l_begin] = o;
+                                block_spheres.push_back(pos_test, d_test);
+                                }
 
                             if (! shape_i.ignoreStatistics())
                                 {
                                 #ifdef ENABLE_TBB
-                                thread_implicit_counters[m_depletant_idx(type_a,type_b)].local().insert_count++;
+                                thread_implicit_counters[m_depletant_idx(type_a,type_b)].local().insert_count += l_end - l_begin;
                                 #else
-                                implicit_counters[m_depletant_idx(type_a,type_b)].insert_count++;
+                                implicit_counters[m_depletant_idx(type_a,type_b)].insert_count += l_end - l_begin;
                                 #endif
                                 }
 
-                            // rejection-free sampling
-                            vec3<Scalar> pos_test(generatePositionInOBB(my_rng, obb_k, ndim));
-
-                            Shape shape_test_a(quat<Scalar>(), this->m_params[type_a]);
-                            Shape shape_test_b(quat<Scalar>(), this->m_params[type_b]);
-                            quat<Scalar> o;
-                            if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
-                                {
-                                o = generateRandomOrientation(my_rng, ndim);
-                                }
-                            if (shape_test_a.hasOrientation())
-                                shape_test_a.orientation = o;
-                            if (shape_test_b.hasOrientation())
-                                shape_test_b.orientation = o;
-
-                            // Check if the particle j overlaps
-                            bool overlap_k_a = false;
-                            bool overlap_k_b = false;
+                            // vectorized pre-check of the whole block against the circumsphere of particle k
+                            std::vector<unsigned char> mask_k(l_end - l_begin);
+                            block_spheres.computeOverlapMask(new_config ? pos_j_new[k] : pos_j_old[k],
+                                shape_k.getCircumsphereDiameter(), mask_k.data());
 
-                            vec3<Scalar> r_k_test = pos_test - (new_config ? pos_j_new[k] : pos_j_old[k]);
+                            // scratch space for the pre-check against the intersecting particles
+                            const detail::CircumsphereList& spheres_j = new_config ? spheres_j_new : spheres_j_old;
+                            std::vector<unsigned char> mask_j(n_intersect);
 
+                            for (unsigned int l = l_begin; l < l_end; ++l)
                                 {
-                                OverlapReal rsq = (OverlapReal) dot(r_k_test,r_k_test);
-                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_k.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                                if (h_overlaps[this->m_overlap_idx(type_a, new_config ? type_j_new[k] : type_j_old[k])])
+                                vec3<Scalar> pos_test = block_pos[l - l_begin];
+                                if (shape_test_a.hasOrientation())
+                                    shape_test_a.orientation = block_orientation[l - l_begin];
+                                if (shape_test_b.hasOrientation())
+                                    shape_test_b.orientation = block_orientation[l - l_begin];
+
+                                // the depletant is outside the circumsphere of particle k, skip the exact tests
+                                if (!mask_k[l - l_begin])
                                     {
+                                    unsigned int n_checks = h_overlaps[this->m_overlap_idx(type_a,
+                                        new_config ? type_j_new[k] : type_j_old[k])];
+                                    if (type_a != type_b)
+                                        n_checks *= 2;
                                     #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
-
-                                    unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_k_test, shape_k, shape_test_a, err))
-                                        {
-                                        overlap_k_a = true;
-                                        }
-                                    if (err)
-                                    #ifdef ENABLE_TBB
-                                        thread_counters.local().overlap_err_count++;
+                                    thread_counters.local().overlap_checks += n_checks;
                                     #else
-                                        counters.overlap_err_count++;
+                                    counters.overlap_checks += n_checks;
                                     #endif
+                                    continue;
                                     }
-                                }
+                                // Check if the particle j overlaps
+                                bool overlap_k_a = false;
+                                bool overlap_k_b = false;
 
-                            if (type_b == type_a)
-                                {
-                                overlap_k_b = overlap_k_a;
-                                }
-                            else
-                                {
-                                OverlapReal rsq = (OverlapReal) dot(r_k_test,r_k_test);
-                                OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape_k.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                                vec3<Scalar> r_k_test = pos_test - (new_config ? pos_j_new[k] : pos_j_old[k]);
 
-                                if (h_overlaps[this->m_overlap_idx(type_a, new_config ? type_j_new[k] : type_j_old[k])])
                                     {
-                                    #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
+                                    OverlapReal rsq = (OverlapReal) dot(r_k_test,r_k_test);
+                                    OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_k.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
 
-                                    unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_k_test, shape_k, shape_test_b, err))
+                                    if (h_overlaps[this->m_overlap_idx(type_a, new_config ? type_j_new[k] : type_j_old[k])])
                                         {
-                                        overlap_k_b = true;
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_k_test, shape_k, shape_test_a, err))
+                                            {
+                                            overlap_k_a = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
                                         }
-                                    if (err)
-                                    #ifdef ENABLE_TBB
-                                        thread_counters.local().overlap_err_count++;
-                                    #else
-                                        counters.overlap_err_count++;
-                                    #endif
                                     }
-                                }
-                            if (!overlap_k_a && !overlap_k_b)
-                                {
-                                // not in j's excluded volume
-                                continue;
-                                }
 
-                            // does particle i overlap in current configuration?
-                            bool overlap_i_a = false;
-                            bool overlap_i_b = false;
+                                if (type_b == type_a)
+                                    {
+                                    overlap_k_b = overlap_k_a;
+                                    }
+                                else
+                                    {
+                                    OverlapReal rsq = (OverlapReal) dot(r_k_test,r_k_test);
+                                    OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape_k.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
 
-                            vec3<Scalar> r_i_test = pos_test - (new_config ? pos_i : pos_i_old);
-                                {
-                                const Shape& shape = new_config ? shape_i : shape_old;
+                                    if (h_overlaps[this->m_overlap_idx(type_a, new_config ? type_j_new[k] : type_j_old[k])])
+                                        {
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_k_test, shape_k, shape_test_b, err))
+                                            {
+                                            overlap_k_b = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
+                                        }
+                                    }
+                                if (!overlap_k_a && !overlap_k_b)
+                                    {
+                                    // not in j's excluded volume
+                                    continue;
+                                    }
 
-                                OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
-                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                                // does particle i overlap in current configuration?
+                                bool overlap_i_a = false;
+                                bool overlap_i_b = false;
 
-                                if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
+                                vec3<Scalar> r_i_test = pos_test - (new_config ? pos_i : pos_i_old);
                                     {
-                                    #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
+                                    const Shape& shape = new_config ? shape_i : shape_old;
 
-                                    unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_i_test, shape, shape_test_a, err))
+                                    OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
+                                    OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                    if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
                                         {
-                                        overlap_i_a = true;
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_i_test, shape, shape_test_a, err))
+                                            {
+                                            overlap_i_a = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
                                         }
-                                    if (err)
-                                    #ifdef ENABLE_TBB
-                                        thread_counters.local().overlap_err_count++;
-                                    #else
-                                        counters.overlap_err_count++;
-                                    #endif
                                     }
-                                }
 
-                            if (type_a == type_b)
-                                {
-                                overlap_i_b = overlap_i_a;
-                                }
-                            else
-                                {
-                                const Shape& shape = new_config ? shape_i : shape_old;
-
-                                OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
-                                OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                                if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
+                                if (type_a == type_b)
                                     {
-                                    #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
+                                    overlap_i_b = overlap_i_a;
+                                    }
+                                else
+                                    {
+                                    const Shape& shape = new_config ? shape_i : shape_old;
 
-                                    unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_i_test, shape, shape_test_b, err))
+                                    OverlapReal rsq = (OverlapReal) dot(r_i_test,r_i_test);
+                                    OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                    if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
                                         {
-                                        overlap_i_b = true;
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_i_test, shape, shape_test_b, err))
+                                            {
+                                            overlap_i_b = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
                                         }
-                                    if (err)
-                                    #ifdef ENABLE_TBB
-                                        thread_counters.local().overlap_err_count++;
-                                    #else
-                                        counters.overlap_err_count++;
-                                    #endif
                                     }
-                                }
 
-                            // does particle i overlap in the other configuration?
-                            bool overlap_i_other_a = false;
-                            bool overlap_i_other_b = false;
+                                // does particle i overlap in the other configuration?
+                                bool overlap_i_other_a = false;
+                                bool overlap_i_other_b = false;
 
-                            vec3<Scalar> r_i_test_other = pos_test - (!new_config ? pos_i : pos_i_old);
-                                {
-                                const Shape& shape = !new_config ? shape_i : shape_old;
+                                vec3<Scalar> r_i_test_other = pos_test - (!new_config ? pos_i : pos_i_old);
+                                    {
+                                    const Shape& shape = !new_config ? shape_i : shape_old;
 
-                                OverlapReal rsq = (OverlapReal) dot(r_i_test_other,r_i_test_other);
-                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                                    OverlapReal rsq = (OverlapReal) dot(r_i_test_other,r_i_test_other);
+                                    OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
 
-                                if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
+                                    if (h_overlaps[this->m_overlap_idx(type_a, typ_i)])
+                                        {
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_i_test_other, shape, shape_test_a, err))
+                                            {
+                                            overlap_i_other_a = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
+                                        }
+                                    }
+
+                                if (type_a == type_b)
                                     {
-                                    #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
+                                    overlap_i_other_b = overlap_i_other_a;
+                                    }
+                                else
+                                    {
+                                    const Shape& shape = !new_config ? shape_i : shape_old;
 
-                                    unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_i_test_other, shape, shape_test_a, err))
+                                    OverlapReal rsq = (OverlapReal) dot(r_i_test_other,r_i_test_other);
+                                    OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                    if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
                                         {
-                                        overlap_i_other_a = true;
+                                        #ifdef ENABLE_TBB
+                                        thread_counters.local().overlap_checks++;
+                                        #else
+                                        counters.overlap_checks++;
+                                        #endif
+
+                                        unsigned int err = 0;
+                                        if (circumsphere_overlap &&
+                                            test_overlap(r_i_test_other, shape, shape_test_b, err))
+                                            {
+                                            overlap_i_other_b = true;
+                                            }
+                                        if (err)
+                                        #ifdef ENABLE_TBB
+                                            thread_counters.local().overlap_err_count++;
+                                        #else
+                                            counters.overlap_err_count++;
+                                        #endif
                                         }
-                                    if (err)
-                                    #ifdef ENABLE_TBB
-                                        thread_counters.local().overlap_err_count++;
-                                    #else
-                                        counters.overlap_err_count++;
-                                    #endif
                                     }
-                                }
+                                unsigned int tag_i = h_tag[i];
+                                unsigned int tag_k = new_config ? tag_j_new[k] : tag_j_old[k];
+                                unsigned int n_overlap = 0;
 
-                            if (type_a == type_b)
-                                {
-                                overlap_i_other_b = overlap_i_other_a;
-                                }
-                            else
-                                {
-                                const Shape& shape = !new_config ? shape_i : shape_old;
+                                // particles rejected by the vectorized circumsphere test count as checked
+                                spheres_j.computeOverlapMask(pos_test, d_test, mask_j.data());
+                                size_t n_checked = n_intersect;
 
-                                OverlapReal rsq = (OverlapReal) dot(r_i_test_other,r_i_test_other);
-                                OverlapReal DaDb = shape_test_b.getCircumsphereDiameter() + shape.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                                if (h_overlaps[this->m_overlap_idx(type_b, typ_i)])
+                                for (unsigned int m = 0; m < n_intersect; ++m)
                                     {
-                                    #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_checks++;
-                                    #else
-                                    counters.overlap_checks++;
-                                    #endif
+                                    if (!mask_j[m])
+                                        continue;
+
+                                    unsigned int type_m = new_config ? type_j_new[m] : type_j_old[m];
+                                    Shape shape_m(new_config ? orientation_j_new[m] : orientation_j_old[m],
+                                        this->m_params[type_m]);
+                                    vec3<Scalar> r_m_test = vec3<Scalar>(pos_test) - (new_config ? pos_j_new[m] : pos_j_old[m]);
 
                                     unsigned int err = 0;
-                                    if (circumsphere_overlap &&
-                                        test_overlap(r_i_test_other, shape, shape_test_b, err))
+
+                                    // check circumsphere overlap
+                                    OverlapReal rsq = (OverlapReal) dot(r_m_test,r_m_test);
+                                    OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
+                                    bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                    bool overlap_m_a = h_overlaps[this->m_overlap_idx(type_a,type_m)]
+                                        && circumsphere_overlap
+                                        && test_overlap(r_m_test, shape_m, shape_test_a, err);
+
+                                    bool overlap_m_b;
+                                    if (type_a == type_b)
                                         {
-                                        overlap_i_other_b = true;
+                                        overlap_m_b = overlap_m_a;
+                                        }
+                                    else
+                                        {
+                                        DaDb = shape_test_b.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
+                                        circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+
+                                        overlap_m_b = h_overlaps[this->m_overlap_idx(type_b,type_m)]
+                                            && circumsphere_overlap
+                                            && test_overlap(r_m_test, shape_m, shape_test_b, err);
                                         }
+
+                                    // non-additive depletants
+                                    if ((overlap_m_a && overlap_k_b) || (overlap_m_b && overlap_k_a))
+                                        {
+                                        unsigned int tag_m = new_config ? tag_j_new[m] : tag_j_old[m];
+                                        if (tag_m > tag_k) // also excludes self-overlap, doesn't work in small boxes
+                                            {
+                                            n_overlap++;
+                                            n_checked = m + 1;
+                                            break;
+                                            }
+                                        }
+
                                     if (err)
                                     #ifdef ENABLE_TBB
                                         thread_counters.local().overlap_err_count++;
@@ -3134,98 +3400,43 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                                         counters.overlap_err_count++;
                                     #endif
                                     }
-                                }
-                            unsigned int tag_i = h_tag[i];
-                            unsigned int tag_k = new_config ? tag_j_new[k] : tag_j_old[k];
-                            unsigned int n_overlap = 0;
-
-                            for (unsigned int m = 0; m < n_intersect; ++m)
-                                {
-                                unsigned int type_m = new_config ? type_j_new[m] : type_j_old[m];
-                                Shape shape_m(new_config ? orientation_j_new[m] : orientation_j_old[m],
-                                    this->m_params[type_m]);
-                                vec3<Scalar> r_m_test = vec3<Scalar>(pos_test) - (new_config ? pos_j_new[m] : pos_j_old[m]);
 
                                 #ifdef ENABLE_TBB
-                                thread_counters.local().overlap_checks++;
+                                thread_counters.local().overlap_checks += n_checked;
                                 #else
-                                counters.overlap_checks++;
+                                counters.overlap_checks += n_checked;
                                 #endif
 
-                                unsigned int err = 0;
+                                bool overlap_ik = ((overlap_k_a && overlap_i_b) || (overlap_k_b && overlap_i_a)) && (tag_i > tag_k);
+                                bool overlap_ik_other = ((overlap_k_a && overlap_i_other_b) || (overlap_k_b && overlap_i_other_a))
+                                    && (tag_i > tag_k);
 
-                                // check circumsphere overlap
-                                OverlapReal rsq = (OverlapReal) dot(r_m_test,r_m_test);
-                                OverlapReal DaDb = shape_test_a.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
-                                bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
+                                // indicator function for MC integration
+                                unsigned int chi = 0;
 
-                                bool overlap_m_a = h_overlaps[this->m_overlap_idx(type_a,type_m)]
-                                    && circumsphere_overlap
-                                    && test_overlap(r_m_test, shape_m, shape_test_a, err);
+                                if (!overlap_ik_other && overlap_ik && !n_overlap)
+                                    chi = 1;
 
-                                bool overlap_m_b;
-                                if (type_a == type_b)
+                                Scalar betaF = log(1.0+(Scalar)chi/(Scalar)ntrial);
+
+                                if ((repulsive && new_config) || (!repulsive && !new_config))
                                     {
-                                    overlap_m_b = overlap_m_a;
+                                    #ifdef ENABLE_TBB
+                                    thread_ln_denominator.local()[i_trial] += betaF;
+                                    #else
+                                    ln_denominator[i_trial] += betaF;
+                                    #endif
                                     }
                                 else
                                     {
-                                    DaDb = shape_test_b.getCircumsphereDiameter() + shape_m.getCircumsphereDiameter();
-                                    circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                                    overlap_m_b = h_overlaps[this->m_overlap_idx(type_b,type_m)]
-                                        && circumsphere_overlap
-                                        && test_overlap(r_m_test, shape_m, shape_test_b, err);
-                                    }
-
-                                // non-additive depletants
-                                if ((overlap_m_a && overlap_k_b) || (overlap_m_b && overlap_k_a))
-                                    {
-                                    unsigned int tag_m = new_config ? tag_j_new[m] : tag_j_old[m];
-                                    if (tag_m > tag_k) // also excludes self-overlap, doesn't work in small boxes
-                                        {
-                                        n_overlap++;
-                                        break;
-                                        }
+                                    #ifdef ENABLE_TBB
+                                    thread_ln_numerator.local()[i_trial] += betaF;
+                                    #else
+                                    ln_numerator[i_trial] += betaF;
+                                    #endif
                                     }
-
-                                if (err)
-                                #ifdef ENABLE_TBB
-                                    thread_counters.local().overlap_err_count++;
-                                #else
-                                    counters.overlap_err_count++;
-                                #endif
-                                }
-
-                            bool overlap_ik = ((overlap_k_a && overlap_i_b) || (overlap_k_b && overlap_i_a)) && (tag_i > tag_k);
-                            bool overlap_ik_other = ((overlap_k_a && overlap_i_other_b) || (overlap_k_b && overlap_i_other_a))
-                                && (tag_i > tag_k);
-
-                            // indicator function for MC integration
-                            unsigned int chi = 0;
-
-                            if (!overlap_ik_other && overlap_ik && !n_overlap)
-                                chi = 1;
-
-                            Scalar betaF = log(1.0+(Scalar)chi/(Scalar)ntrial);
-
-                            if ((repulsive && new_config) || (!repulsive && !new_config))
-                                {
-                                #ifdef ENABLE_TBB
-                                thread_ln_denominator.local()[i_trial] += betaF;
-                                #else
-                                ln_denominator[i_trial] += betaF;
-                                #endif
-                                }
-                            else
-                                {
-                                #ifdef ENABLE_TBB
-                                thread_ln_numerator.local()[i_trial] += betaF;
-                                #else
-                                ln_numerator[i_trial] += betaF;
-                                #endif
-                                }
-                            } // end loop over depletants
+                                } // end loop over depletants
+                            } // end loop over blocks
                             #ifdef ENABLE_TBB
                             });
                             #endif
@@ -0,0 +1,704 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <climits>
+#include <stdexcept>
+
+/*! \file IntegratorHPMCMonoECMC.h
+    \brief Declaration of IntegratorHPMCMonoECMC
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+//! Event-chain Monte Carlo integrator for hard particles
+/*! IntegratorHPMCMonoECMC replaces the translation trial moves of IntegratorHPMCMono with event
+    chains. A chain starts at a particle and moves it along a direction until it collides with
+    another particle, at which point the remaining displacement is transferred to the particle that
+    was hit. The chain ends when its total time chain_time is consumed. Collisions are found with
+    the sweep_distance() function of the shape pair, so every move is rejection free.
+
+    Two chain types are implemented:
+     - straight: All particles in the chain move with unit speed along a direction drawn uniformly
+       at random when the chain starts.
+     - newtonian: Particles move along their velocity vectors. At each collision, the particles
+       exchange the components of their velocities along the contact normal, as in an elastic
+       collision of equal masses, and the chain continues with the particle that was hit.
+
+    Every particle starts nselect chains per time step. With probability
+    1 - translation_move_probability, a particle with an orientation performs a Metropolis
+    rotation trial move instead.
+
+    Each displacement is split into segments no longer than the translation move size d of the
+    moving particle's type, so that the periodic image list built by IntegratorHPMCMono covers all
+    collision partners. To guard against round-off in the overlap checks, a particle stops a small
+    distance short of the exact contact point.
+
+    With domain decomposition, a chain ends when it would move a particle out of the active region
+    of the domain, or when it hits a ghost particle. The grid shift applied after every time step
+    moves the domain boundaries so that the simulation remains ergodic.
+
+    Patch energies, external fields, and depletants are not supported.
+
+    \ingroup hpmc_integrators
+*/
+template<class Shape> class IntegratorHPMCMonoECMC : public IntegratorHPMCMono<Shape>
+    {
+    public:
+    //! Construct the integrator
+    IntegratorHPMCMonoECMC(std::shared_ptr<SystemDefinition> sysdef);
+    //! Destructor
+    virtual ~IntegratorHPMCMonoECMC() { }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    //! Set the total time of each chain
+    void setChainTime(Scalar chain_time)
+        {
+        if (chain_time < Scalar(0.0))
+            throw std::domain_error("chain_time must be non-negative");
+        m_chain_time = chain_time;
+        }
+
+    //! Get the total time of each chain
+    Scalar getChainTime()
+        {
+        return m_chain_time;
+        }
+
+    //! Set the chain type
+    void setChainType(const std::string& chain_type)
+        {
+        if (chain_type == "straight")
+            m_newtonian = false;
+        else if (chain_type == "newtonian")
+            m_newtonian = true;
+        else
+            throw std::domain_error("Invalid chain type " + chain_type);
+        }
+
+    //! Get the chain type
+    std::string getChainType()
+        {
+        return m_newtonian ? "newtonian" : "straight";
+        }
+
+    protected:
+    Scalar m_chain_time; //!< Total time of each chain
+    bool m_newtonian;    //!< True when particles move along their velocities
+
+    //! Find the first collision of a particle moving along a direction
+    Scalar findCollision(unsigned int k,
+                         const vec3<Scalar>& pos_k,
+                         const Shape& shape_k,
+                         unsigned int typ_k,
+                         const vec3<Scalar>& direction,
+                         Scalar max_distance,
+                         const Scalar4* h_postype,
+                         const Scalar4* h_orientation,
+                         const unsigned int* h_overlaps,
+                         hpmc_counters_t& counters,
+                         unsigned int& j_hit,
+                         vec3<Scalar>& normal);
+
+    //! Test whether a particle overlaps with any other particle
+    bool checkOverlaps(unsigned int i,
+                       const vec3<Scalar>& pos_i,
+                       const Shape& shape_i,
+                       unsigned int typ_i,
+                       const Scalar4* h_postype,
+                       const Scalar4* h_orientation,
+                       const unsigned int* h_overlaps,
+                       hpmc_counters_t& counters);
+    };
+
+/*! \param sysdef System definition
+ */
+template<class Shape>
+IntegratorHPMCMonoECMC<Shape>::IntegratorHPMCMonoECMC(std::shared_ptr<SystemDefinition> sysdef)
+    : IntegratorHPMCMono<Shape>(sysdef), m_chain_time(1.0), m_newtonian(false)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCMonoECMC" << std::endl;
+    }
+
+/*! \param timestep Current time step
+ */
+template<class Shape> void IntegratorHPMCMonoECMC<Shape>::update(uint64_t timestep)
+    {
+    Integrator::update(timestep);
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoECMC update: " << timestep << std::endl;
+    IntegratorHPMC::update(timestep);
+
+    if (this->m_patch && !this->m_patch_log)
+        throw std::runtime_error("Event chain Monte Carlo does not support patch energies.");
+
+    if (this->m_external)
+        throw std::runtime_error("Event chain Monte Carlo does not support external fields.");
+
+    for (unsigned int i = 0; i < this->m_depletant_idx.getNumElements(); ++i)
+        {
+        if (this->m_fugacity[i] != 0.0)
+            throw std::runtime_error("Event chain Monte Carlo does not support depletants.");
+        }
+
+    // get needed vars
+    ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    hpmc_counters_t& counters = h_counters.data[0];
+
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+#ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = this->m_nominal_width / npd;
+#endif
+
+    // Shuffle the order of particles for this step
+    this->m_update_order.resize(this->m_pdata->getN());
+    this->m_update_order.shuffle(timestep, this->m_sysdef->getSeed(), this->m_exec_conf->getRank());
+
+    // update the AABB Tree
+    this->buildAABBTree();
+    // limit m_d entries so that particles cannot possibly wander more than one box image in one
+    // segment
+    this->limitMoveDistances();
+    // update the image list
+    this->updateImageList();
+
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "HPMC ECMC update");
+
+    uint16_t seed = this->m_sysdef->getSeed();
+
+    // access interaction matrix
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps,
+                                         access_location::host,
+                                         access_mode::read);
+
+    // loop over local particles nselect times
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        // access particle data
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(this->m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+        // access move sizes
+        ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
+
+        // loop through N particles in a shuffled order
+        for (unsigned int cur_particle = 0; cur_particle < this->m_pdata->getN(); cur_particle++)
+            {
+            unsigned int i = this->m_update_order[cur_particle];
+
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            Scalar4 orientation_i = h_orientation.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+#ifdef ENABLE_MPI
+            if (this->m_comm)
+                {
+                // only move particle if active
+                if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z),
+                              box,
+                              ghost_fraction))
+                    continue;
+                }
+#endif
+
+            hoomd::RandomGenerator rng_i(
+                hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoECMC, timestep, seed),
+                hoomd::Counter(i, this->m_exec_conf->getRank(), i_nselect));
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(orientation_i), this->m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation()
+                                       || (move_type_select < this->m_translation_move_probability);
+
+            if (!move_type_translate)
+                {
+                // Metropolis rotation move
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+
+                bool overlap = checkOverlaps(i,
+                                             pos_i,
+                                             shape_i,
+                                             typ_i,
+                                             h_postype.data,
+                                             h_orientation.data,
+                                             h_overlaps.data,
+                                             counters);
+
+                if (!overlap)
+                    {
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    this->m_aabb_tree.update(i, shape_i.getAABB(pos_i));
+
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    }
+                else if (!shape_i.ignoreStatistics())
+                    {
+                    counters.rotate_reject_count++;
+                    }
+                continue;
+                }
+
+            // straight chains move all particles along the same random direction
+            vec3<Scalar> direction;
+            if (!m_newtonian)
+                {
+                if (ndim == 2)
+                    {
+                    Scalar theta = hoomd::UniformDistribution<Scalar>(Scalar(0.0),
+                                                                      Scalar(2.0 * M_PI))(rng_i);
+                    direction = vec3<Scalar>(slow::cos(theta), slow::sin(theta), Scalar(0.0));
+                    }
+                else
+                    {
+                    hoomd::SpherePointGenerator<Scalar>()(rng_i, direction);
+                    }
+                }
+
+            // run the event chain
+            unsigned int k = i;
+            Scalar time_left = m_chain_time;
+            unsigned int n_stalled = 0;
+            while (time_left > Scalar(0.0))
+                {
+                Scalar4 postype_k = h_postype.data[k];
+                vec3<Scalar> pos_k = vec3<Scalar>(postype_k);
+                unsigned int typ_k = __scalar_as_int(postype_k.w);
+                Shape shape_k(quat<Scalar>(h_orientation.data[k]), this->m_params[typ_k]);
+
+                Scalar speed(1.0);
+                if (m_newtonian)
+                    {
+                    vec3<Scalar> v_k(h_vel.data[k].x, h_vel.data[k].y, h_vel.data[k].z);
+                    speed = fast::sqrt(dot(v_k, v_k));
+                    if (speed == Scalar(0.0))
+                        break;
+                    direction = v_k / speed;
+                    }
+
+                // limit the length of a single collision search
+                if (h_d.data[typ_k] == 0.0)
+                    break;
+                Scalar max_distance = time_left * speed;
+                bool last_segment = true;
+                if (max_distance > h_d.data[typ_k])
+                    {
+                    max_distance = h_d.data[typ_k];
+                    last_segment = false;
+                    }
+
+                unsigned int j_hit;
+                vec3<Scalar> normal;
+                Scalar distance = findCollision(k,
+                                                pos_k,
+                                                shape_k,
+                                                typ_k,
+                                                direction,
+                                                max_distance,
+                                                h_postype.data,
+                                                h_orientation.data,
+                                                h_overlaps.data,
+                                                counters,
+                                                j_hit,
+                                                normal);
+
+                // stop short of the contact point
+                Scalar move_distance = distance;
+                if (j_hit != UINT_MAX)
+                    {
+                    Shape shape_j(quat<Scalar>(h_orientation.data[j_hit]),
+                                  this->m_params[__scalar_as_int(h_postype.data[j_hit].w)]);
+                    Scalar margin = Scalar(0.5e-5)
+                                    * (shape_k.getCircumsphereDiameter()
+                                       + shape_j.getCircumsphereDiameter());
+                    move_distance = std::max(distance - margin, Scalar(0.0));
+                    }
+
+                vec3<Scalar> pos_k_new = pos_k + move_distance * direction;
+
+#ifdef ENABLE_MPI
+                if (this->m_comm)
+                    {
+                    // end the chain at the boundary of the active region
+                    if (!isActive(vec_to_scalar3(pos_k), box, ghost_fraction)
+                        || !isActive(vec_to_scalar3(pos_k_new), box, ghost_fraction))
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            counters.translate_reject_count++;
+                        break;
+                        }
+                    }
+#endif
+
+                if (move_distance > Scalar(0.0))
+                    {
+                    h_postype.data[k] = vec_to_scalar4(pos_k_new, postype_k.w);
+                    box.wrap(h_postype.data[k], h_image.data[k]);
+                    this->m_aabb_tree.update(k,
+                                             shape_k.getAABB(vec3<Scalar>(h_postype.data[k])));
+
+                    if (!shape_k.ignoreStatistics())
+                        counters.translate_accept_count++;
+                    n_stalled = 0;
+                    }
+                else
+                    {
+                    n_stalled++;
+                    }
+
+                if (j_hit == UINT_MAX && last_segment)
+                    break;
+
+                time_left -= distance / speed;
+
+                if (j_hit == UINT_MAX)
+                    continue;
+
+                // a chain of particles that are all in contact cannot make progress
+                if (n_stalled > this->m_pdata->getN())
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.translate_reject_count++;
+                    break;
+                    }
+
+                // ghost particles are moved by other ranks, end the chain
+                if (j_hit >= this->m_pdata->getN())
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.translate_reject_count++;
+                    break;
+                    }
+
+                if (m_newtonian)
+                    {
+                    // elastic collision of equal masses
+                    vec3<Scalar> n = normal / fast::sqrt(dot(normal, normal));
+                    vec3<Scalar> v_k(h_vel.data[k].x, h_vel.data[k].y, h_vel.data[k].z);
+                    vec3<Scalar> v_j(h_vel.data[j_hit].x,
+                                     h_vel.data[j_hit].y,
+                                     h_vel.data[j_hit].z);
+                    vec3<Scalar> delta = dot(v_k - v_j, n) * n;
+                    v_k -= delta;
+                    v_j += delta;
+                    h_vel.data[k] = make_scalar4(v_k.x, v_k.y, v_k.z, h_vel.data[k].w);
+                    h_vel.data[j_hit]
+                        = make_scalar4(v_j.x, v_j.y, v_j.z, h_vel.data[j_hit].w);
+                    }
+
+                // transfer the chain to the particle that was hit
+                k = j_hit;
+                }
+            } // end loop over all particles
+        } // end loop over nselect
+
+    // perform the grid shift
+#ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+        // precalculate the grid shift
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoShift, timestep, this->m_sysdef->getSeed()),
+            hoomd::Counter());
+        Scalar3 shift = make_scalar3(0, 0, 0);
+        hoomd::UniformDistribution<Scalar> uniform(-this->m_nominal_width / Scalar(2.0),
+                                                   this->m_nominal_width / Scalar(2.0));
+        shift.x = uniform(rng);
+        shift.y = uniform(rng);
+        if (this->m_sysdef->getNDimensions() == 3)
+            {
+            shift.z = uniform(rng);
+            }
+        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
+            {
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> r_i = vec3<Scalar>(postype_i);
+            r_i += vec3<Scalar>(shift);
+            h_postype.data[i] = vec_to_scalar4(r_i, postype_i.w);
+            box.wrap(h_postype.data[i], h_image.data[i]);
+            }
+        this->m_pdata->translateOrigin(shift);
+        }
+#endif
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+
+    // migrate and exchange particles
+    this->communicate(true);
+
+    // all particle have been moved, the aabb tree is now invalid
+    this->m_aabb_tree_invalid = true;
+
+    // set current MPS value
+    hpmc_counters_t run_counters = this->getCounters(1);
+    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
+    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    }
+
+/*! \param k Index of the moving particle
+    \param pos_k Position of the moving particle
+    \param shape_k Shape of the moving particle
+    \param typ_k Type of the moving particle
+    \param direction Unit vector along which particle k moves
+    \param max_distance Maximum distance to search
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to update
+    \param j_hit (out) Index of the first particle hit, UINT_MAX if there is no collision
+    \param normal (out) Contact normal at the collision
+    \returns The distance particle k can move before it collides, or max_distance
+*/
+template<class Shape>
+Scalar IntegratorHPMCMonoECMC<Shape>::findCollision(unsigned int k,
+                                                    const vec3<Scalar>& pos_k,
+                                                    const Shape& shape_k,
+                                                    unsigned int typ_k,
+                                                    const vec3<Scalar>& direction,
+                                                    Scalar max_distance,
+                                                    const Scalar4* h_postype,
+                                                    const Scalar4* h_orientation,
+                                                    const unsigned int* h_overlaps,
+                                                    hpmc_counters_t& counters,
+                                                    unsigned int& j_hit,
+                                                    vec3<Scalar>& normal)
+    {
+    j_hit = UINT_MAX;
+    Scalar t_min = max_distance;
+
+    // the query volume contains the circumsphere of k swept along the segment
+    Scalar R_k = Scalar(0.5) * shape_k.getCircumsphereDiameter();
+    detail::AABB aabb_k_local = detail::merge(detail::AABB(vec3<Scalar>(0, 0, 0), R_k),
+                                              detail::AABB(max_distance * direction, R_k));
+
+    // All image boxes (including the primary)
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_k_image = pos_k + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_k_local;
+        aabb.translate(pos_k_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // images of k move together with k and can never be hit
+                        if (j == k)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!h_overlaps[this->m_overlap_idx(typ_k, typ_j)])
+                            continue;
+
+                        // put particles in coordinate system of particle k
+                        vec3<Scalar> r_kj = vec3<Scalar>(postype_j) - pos_k_image;
+                        Shape shape_j(quat<Scalar>(h_orientation[j]), this->m_params[typ_j]);
+
+                        // skip particles whose circumsphere does not touch the swept circumsphere
+                        Scalar R_kj = R_k + Scalar(0.5) * shape_j.getCircumsphereDiameter();
+                        Scalar s = std::min(std::max(dot(r_kj, direction), Scalar(0.0)), t_min);
+                        vec3<Scalar> dr = r_kj - s * direction;
+                        if (dot(dr, dr) > R_kj * R_kj)
+                            continue;
+
+                        counters.overlap_checks++;
+                        vec3<Scalar> normal_kj;
+                        Scalar t = sweep_distance(r_kj,
+                                                  shape_k,
+                                                  shape_j,
+                                                  direction,
+                                                  t_min,
+                                                  normal_kj,
+                                                  counters.overlap_err_count);
+                        if (t < t_min)
+                            {
+                            t_min = t;
+                            j_hit = j;
+                            normal = normal_kj;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return t_min;
+    }
+
+/*! \param i Index of the particle
+    \param pos_i Position of the particle
+    \param shape_i Shape of the particle
+    \param typ_i Type of the particle
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_overlaps Interaction matrix
+    \param counters Counters to update
+    \returns true if particle i overlaps with any other particle
+*/
+template<class Shape>
+bool IntegratorHPMCMonoECMC<Shape>::checkOverlaps(unsigned int i,
+                                                  const vec3<Scalar>& pos_i,
+                                                  const Shape& shape_i,
+                                                  unsigned int typ_i,
+                                                  const Scalar4* h_postype,
+                                                  const Scalar4* h_orientation,
+                                                  const unsigned int* h_overlaps,
+                                                  hpmc_counters_t& counters)
+    {
+    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+
+    // All image boxes (including the primary)
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        quat<Scalar> orientation_j;
+                        if (j != i)
+                            {
+                            postype_j = h_postype[j];
+                            orientation_j = quat<Scalar>(h_orientation[j]);
+                            }
+                        else
+                            {
+                            // in the first image, skip i == j
+                            if (cur_image == 0)
+                                continue;
+
+                            // in other images, use the trial configuration of i
+                            postype_j = vec_to_scalar4(pos_i, h_postype[i].w);
+                            orientation_j = shape_i.orientation;
+                            }
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(orientation_j, this->m_params[typ_j]);
+
+                        counters.overlap_checks++;
+                        if (h_overlaps[this->m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return false;
+    }
+
+//! Export the IntegratorHPMCMonoECMC class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoECMC<Shape> will be exported
+*/
+template<class Shape>
+void export_IntegratorHPMCMonoECMC(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<IntegratorHPMCMonoECMC<Shape>,
+                     IntegratorHPMCMono<Shape>,
+                     std::shared_ptr<IntegratorHPMCMonoECMC<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def_property("chain_time",
+                      &IntegratorHPMCMonoECMC<Shape>::getChainTime,
+                      &IntegratorHPMCMonoECMC<Shape>::setChainTime)
+        .def_property("chain_type",
+                      &IntegratorHPMCMonoECMC<Shape>::getChainType,
+                      &IntegratorHPMCMonoECMC<Shape>::setChainType);
+    }
+
+    } // end namespace hpmc
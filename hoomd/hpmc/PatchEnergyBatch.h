@@ -0,0 +1,98 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/VectorMath.h"
+
+#include <vector>
+
+/*! \file PatchEnergyBatch.h
+    \brief Declaration of PatchEnergyBatch
+*/
+
+namespace hpmc
+    {
+//! Structure of arrays holding a batch of patch energy evaluations with a common particle i
+/*! Trial moves evaluate the patch energy between the moved particle i and all of its neighbors j.
+    PatchEnergyBatch collects the j particle data in separate arrays so that PatchEnergy::energyBatch()
+    can evaluate all pairs in a single call. The member arrays are public so that implementations can
+    pass them directly to compiled kernels.
+
+    \ingroup hpmc_data_structs
+*/
+class PatchEnergyBatch
+    {
+    public:
+    //! Remove all pairs from the batch
+    void clear()
+        {
+        r_x.clear();
+        r_y.clear();
+        r_z.clear();
+        type_j.clear();
+        q_j_s.clear();
+        q_j_x.clear();
+        q_j_y.clear();
+        q_j_z.clear();
+        d_j.clear();
+        charge_j.clear();
+        }
+
+    //! Append a pair
+    /*! \param r_ij Vector pointing from particle i to j
+        \param type Integer type index of particle j
+        \param q_j Orientation quaternion of particle j
+        \param d Diameter of particle j
+        \param charge Charge of particle j
+    */
+    void push_back(const vec3<float>& r_ij,
+                   unsigned int type,
+                   const quat<float>& q_j,
+                   float d,
+                   float charge)
+        {
+        r_x.push_back(r_ij.x);
+        r_y.push_back(r_ij.y);
+        r_z.push_back(r_ij.z);
+        type_j.push_back(type);
+        q_j_s.push_back(q_j.s);
+        q_j_x.push_back(q_j.v.x);
+        q_j_y.push_back(q_j.v.y);
+        q_j_z.push_back(q_j.v.z);
+        d_j.push_back(d);
+        charge_j.push_back(charge);
+        }
+
+    //! Get the number of pairs in the batch
+    unsigned int size() const
+        {
+        return (unsigned int)r_x.size();
+        }
+
+    //! Get the separation vector of pair k
+    vec3<float> getRij(unsigned int k) const
+        {
+        return vec3<float>(r_x[k], r_y[k], r_z[k]);
+        }
+
+    //! Get the orientation of particle j in pair k
+    quat<float> getQj(unsigned int k) const
+        {
+        return quat<float>(q_j_s[k], vec3<float>(q_j_x[k], q_j_y[k], q_j_z[k]));
+        }
+
+    std::vector<float> r_x;           //!< x components of r_ij
+    std::vector<float> r_y;           //!< y components of r_ij
+    std::vector<float> r_z;           //!< z components of r_ij
+    std::vector<unsigned int> type_j; //!< Types of the j particles
+    std::vector<float> q_j_s;         //!< Scalar parts of the j orientations
+    std::vector<float> q_j_x;         //!< x components of the j orientations
+    std::vector<float> q_j_y;         //!< y components of the j orientations
+    std::vector<float> q_j_z;         //!< z components of the j orientations
+    std::vector<float> d_j;           //!< Diameters of the j particles
+    std::vector<float> charge_j;      //!< Charges of the j particles
+    std::vector<float> energy;        //!< Output: energy of each pair
+    };
+
+    } // end namespace hpmc
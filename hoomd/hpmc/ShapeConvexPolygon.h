@@ -16,6 +16,7 @@
 #else
 #define DEVICE
 #define HOSTDEVICE
+#include "GJKRaycast.h"
 #include <iostream>
 #if defined(__SSE__)
 #include <immintrin.h>
@@ -607,6 +608,39 @@ DEVICE inline bool test_overlap<ShapeConvexPolygon, ShapeConvexPolygon>(const ve
     }
 
 #ifndef __HIPCC__
+/** Convex polygon sweep distance
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param direction Unit vector along which shape a is translated
+    @param max_distance Maximum distance to consider
+    @param normal (out) Contact normal pointing from b towards a, set when a collision is found
+    @param err in/out variable incremented when error conditions occur
+    @returns the distance a can be translated along *direction* before it touches b
+*/
+template<>
+inline Scalar sweep_distance(const vec3<Scalar>& r_ab,
+                             const ShapeConvexPolygon& a,
+                             const ShapeConvexPolygon& b,
+                             const vec3<Scalar>& direction,
+                             Scalar max_distance,
+                             vec3<Scalar>& normal,
+                             unsigned int& err)
+    {
+    typedef detail::SupportFunc2DIn3D<detail::SupportFuncConvexPolygon> SupportFunc;
+    SupportFunc sa(detail::SupportFuncConvexPolygon(a.verts));
+    SupportFunc sb(detail::SupportFuncConvexPolygon(b.verts));
+    detail::SweepSupportFunc<SupportFunc, SupportFunc>
+        sc(sa, sb, r_ab, a.orientation, b.orientation);
+
+    Scalar tol = Scalar(1e-6) * (a.getCircumsphereDiameter() + b.getCircumsphereDiameter());
+    Scalar d;
+    if (detail::gjk_raycast(sc, direction, max_distance, tol, d, normal, err))
+        return d;
+    return max_distance;
+    }
+
 template<> inline std::string getShapeSpec(const ShapeConvexPolygon& poly)
     {
     std::ostringstream shapedef;
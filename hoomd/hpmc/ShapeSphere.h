@@ -302,6 +302,76 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
         }
     }
 
+//! Define the general sweep distance function
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which shape a is translated
+    \param max_distance Maximum distance to consider
+    \param normal (out) Contact normal pointing from b towards a, set when a collision is found
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \returns the distance a can be translated along *direction* before it touches b, or
+             *max_distance* if the shapes do not collide within that distance
+
+    The returned distance never exceeds the exact collision distance.
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline Scalar sweep_distance(const vec3<Scalar>& r_ab,
+                                    const ShapeA& a,
+                                    const ShapeB& b,
+                                    const vec3<Scalar>& direction,
+                                    Scalar max_distance,
+                                    vec3<Scalar>& normal,
+                                    unsigned int& err)
+    {
+    // default implementation returns 0, will make it obvious if something calls this
+    return Scalar(0.0);
+    }
+
+//! Sphere-Sphere sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector along which shape a is translated
+    \param max_distance Maximum distance to consider
+    \param normal (out) Contact normal pointing from b towards a, set when a collision is found
+    \param err in/out variable incremented when error conditions occur
+    \returns the distance a can be translated along *direction* before it touches b
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline Scalar sweep_distance<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_ab,
+                                                              const ShapeSphere& a,
+                                                              const ShapeSphere& b,
+                                                              const vec3<Scalar>& direction,
+                                                              Scalar max_distance,
+                                                              vec3<Scalar>& normal,
+                                                              unsigned int& err)
+    {
+    Scalar RaRb = Scalar(a.params.radius) + Scalar(b.params.radius);
+    Scalar proj = dot(r_ab, direction);
+    Scalar c = dot(r_ab, r_ab) - RaRb * RaRb;
+
+    if (c < Scalar(0.0))
+        {
+        // already in contact
+        normal = -r_ab;
+        return Scalar(0.0);
+        }
+
+    Scalar disc = proj * proj - c;
+    if (proj <= Scalar(0.0) || disc < Scalar(0.0))
+        return max_distance;
+
+    Scalar d = proj - fast::sqrt(disc);
+    if (d >= max_distance)
+        return max_distance;
+
+    normal = d * direction - r_ab;
+    return d;
+    }
+
 namespace detail
     {
 //! APIs for depletant sampling
@@ -27,6 +27,7 @@
 #endif
 
 #ifndef __HIPCC__
+#include "GJKRaycast.h"
 #include <vector>
 #endif
 
@@ -194,6 +195,39 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     }
 
 #ifndef __HIPCC__
+/** Convex spheropolyhedron sweep distance
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param direction Unit vector along which shape a is translated
+    @param max_distance Maximum distance to consider
+    @param normal (out) Contact normal pointing from b towards a, set when a collision is found
+    @param err in/out variable incremented when error conditions occur
+    @returns the distance a can be translated along *direction* before it touches b
+*/
+template<>
+inline Scalar sweep_distance(const vec3<Scalar>& r_ab,
+                             const ShapeSpheropolyhedron& a,
+                             const ShapeSpheropolyhedron& b,
+                             const vec3<Scalar>& direction,
+                             Scalar max_distance,
+                             vec3<Scalar>& normal,
+                             unsigned int& err)
+    {
+    detail::SupportFuncConvexPolyhedron sa(a.verts, a.verts.sweep_radius);
+    detail::SupportFuncConvexPolyhedron sb(b.verts, b.verts.sweep_radius);
+    detail::SweepSupportFunc<detail::SupportFuncConvexPolyhedron,
+                             detail::SupportFuncConvexPolyhedron>
+        sc(sa, sb, r_ab, a.orientation, b.orientation);
+
+    Scalar tol = Scalar(1e-6) * (a.getCircumsphereDiameter() + b.getCircumsphereDiameter());
+    Scalar d;
+    if (detail::gjk_raycast(sc, direction, max_distance, tol, d, normal, err))
+        return d;
+    return max_distance;
+    }
+
 template<> inline std::string getShapeSpec(const ShapeSpheropolyhedron& spoly)
     {
     std::ostringstream shapedef;
@@ -21,6 +21,11 @@ class FreeVolume(Compute):
     Args:
         test_particle_type (str): Test particle type.
         num_samples (int): Number of samples to evaluate.
+        target_relative_error (float): Stop sampling once the relative error of
+            the estimate falls below this value. Set to 0 to always evaluate
+            exactly `num_samples` samples.
+        max_num_samples (int): Maximum number of samples to evaluate when
+            `target_relative_error` is set.
 
     `FreeVolume` computes the free volume in the simulation state available to a
     given test particle using Monte Carlo integration. It must be used in
@@ -41,6 +46,24 @@ class FreeVolume(Compute):
     :math:`n_\mathrm{overlaps}` is the number of overlapping test placements,
     and :math:`V_\mathrm{box}` is the volume of the simulation box.
 
+    When `target_relative_error` is greater than 0, `FreeVolume` evaluates
+    samples in batches of `num_samples` until the relative standard error of
+    the estimate
+
+    .. math::
+        \frac{\sigma_{V_\mathrm{free}}}{V_\mathrm{free}} =
+        \sqrt{\frac{n_\mathrm{overlaps}}
+                    {n_\mathrm{samples} - n_\mathrm{overlaps}}
+               \frac{1}{n_\mathrm{samples}}}
+
+    falls below `target_relative_error`, or until the next batch would exceed
+    `max_num_samples` total samples.
+
+    Note:
+
+        On the GPU, `FreeVolume` always evaluates exactly `num_samples`
+        samples and ignores `target_relative_error`.
+
     Note:
 
         The test particle type must exist in the simulation state and its shape
@@ -63,14 +86,29 @@ class FreeVolume(Compute):
 
         num_samples (int): Number of samples to evaluate.
 
+        target_relative_error (float): Stop sampling once the relative error of
+            the estimate falls below this value.
+
+        max_num_samples (int): Maximum number of samples to evaluate when
+            `target_relative_error` is set.
+
     """
 
-    def __init__(self, test_particle_type, num_samples):
+    def __init__(self,
+                 test_particle_type,
+                 num_samples,
+                 target_relative_error=0.0,
+                 max_num_samples=10000000):
         # store metadata
-        param_dict = ParameterDict(test_particle_type=str, num_samples=int)
+        param_dict = ParameterDict(test_particle_type=str,
+                                   num_samples=int,
+                                   target_relative_error=float,
+                                   max_num_samples=int)
         param_dict.update(
             dict(test_particle_type=test_particle_type,
-                 num_samples=num_samples))
+                 num_samples=num_samples,
+                 target_relative_error=target_relative_error,
+                 max_num_samples=max_num_samples))
         self._param_dict.update(param_dict)
 
     def _attach(self):
@@ -102,3 +140,16 @@ class FreeVolume(Compute):
         :math:`[\\mathrm{length}^{3}]` in 3D."""
         self._cpp_obj.compute(self._simulation.timestep)
         return self._cpp_obj.free_volume
+
+    @log(requires_run=True)
+    def relative_error(self):
+        """Relative standard error of `free_volume` \
+        :math:`[\\mathrm{dimensionless}]`."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.relative_error
+
+    @log(requires_run=True)
+    def num_samples_used(self):
+        """Total number of samples evaluated in the last computation."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.num_samples_used
@@ -6,7 +6,7 @@
 
 from hoomd import _hoomd
 from hoomd.data.parameterdicts import TypeParameterDict, ParameterDict
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 from hoomd.data.typeparam import TypeParameter
 from hoomd.error import DataAccessError
 from hoomd.hpmc import _hpmc
@@ -1822,3 +1822,251 @@ class FacetedEllipsoidUnion(HPMCIntegrator):
                                              'overlap': None
                                          }))
         self._add_typeparam(typeparam_shape)
+
+
+class SphereECMC(Sphere):
+    """Hard sphere event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of a single collision search
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+
+    `SphereECMC` replaces the translation trial moves of `Sphere` with event
+    chains. An event chain moves a particle until it collides with another
+    particle and then continues with the particle that it hits. Every
+    displacement in a chain is accepted, so event chains relax dense systems
+    much faster than local trial moves.
+
+    ``'straight'`` chains move all particles with unit speed along a random
+    direction chosen when the chain starts, so ``chain_time`` is the total
+    displacement of the chain. ``'newtonian'`` chains move particles along
+    their velocities and exchange the velocity components along the contact
+    normal at each collision. Assign velocities to the particles (e.g. with
+    `hoomd.State.thermalize_particle_momenta`) before running ``'newtonian'``
+    chains.
+
+    The translation move size ``d`` sets the maximum length of a single
+    collision search. A chain takes as many searches as needed to consume
+    ``chain_time``. With domain decomposition, chains end at the boundaries
+    of the local domain.
+
+    Particles stop a small distance (:math:`10^{-5}` times the mean
+    circumsphere diameter of the colliding pair) short of contact to guard
+    against round-off error in the overlap checks.
+
+    Note:
+        `SphereECMC` runs on the CPU. It does not support patch energies,
+        external fields, or depletants.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.SphereECMC(default_d=1.0, chain_time=2.0)
+        mc.shape["A"] = dict(diameter=1.0)
+
+    Attributes:
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoSphereECMC'
+
+    def __init__(self,
+                 default_d=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_time=1.0,
+                 chain_type='straight'):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_time=float(chain_time),
+                          chain_type=OnlyFrom(['straight', 'newtonian'])))
+        self.chain_type = chain_type
+
+
+class ConvexPolygonECMC(ConvexPolygon):
+    """Hard convex polygon event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of a single collision search
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+
+    `ConvexPolygonECMC` replaces the translation trial moves of
+    `ConvexPolygon` with event chains. Rotations use trial moves. See
+    `SphereECMC` for details.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexPolygonECMC(default_d=1.0,
+                                                    default_a=0.4)
+        mc.shape["A"] = dict(vertices=[(-0.5, -0.5),
+                                       (0.5, -0.5),
+                                       (0.5, 0.5),
+                                       (-0.5, 0.5)]);
+
+    Attributes:
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoConvexPolygonECMC'
+
+    def __init__(self,
+                 default_d=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_time=1.0,
+                 chain_type='straight'):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_time=float(chain_time),
+                          chain_type=OnlyFrom(['straight', 'newtonian'])))
+        self.chain_type = chain_type
+
+
+class ConvexPolyhedronECMC(ConvexPolyhedron):
+    """Hard convex polyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of a single collision search
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+
+    `ConvexPolyhedronECMC` replaces the translation trial moves of
+    `ConvexPolyhedron` with event chains. Rotations use trial moves. See
+    `SphereECMC` for details.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexPolyhedronECMC(default_d=1.0,
+                                                       default_a=0.4)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)]);
+
+    Attributes:
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoConvexPolyhedronECMC'
+
+    def __init__(self,
+                 default_d=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_time=1.0,
+                 chain_type='straight'):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_time=float(chain_time),
+                          chain_type=OnlyFrom(['straight', 'newtonian'])))
+        self.chain_type = chain_type
+
+
+class ConvexSpheropolyhedronECMC(ConvexSpheropolyhedron):
+    """Hard convex spheropolyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of a single collision search
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+
+    `ConvexSpheropolyhedronECMC` replaces the translation trial moves of
+    `ConvexSpheropolyhedron` with event chains. Rotations use trial moves.
+    See `SphereECMC` for details.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexSpheropolyhedronECMC(default_d=1.0,
+                                                             default_a=0.4)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)],
+                             sweep_radius=0.1);
+
+    Attributes:
+        chain_time (float): Total time of each event chain
+            :math:`[\\mathrm{time}]`.
+
+        chain_type (str): Type of event chain: ``'straight'`` or
+            ``'newtonian'``.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoSpheropolyhedronECMC'
+
+    def __init__(self,
+                 default_d=1.0,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_time=1.0,
+                 chain_type='straight'):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_time=float(chain_time),
+                          chain_type=OnlyFrom(['straight', 'newtonian'])))
+        self.chain_type = chain_type
@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoECMC.h"
 
 #include "AnalyzerSDF.h"
 #include "ShapeConvexPolygon.h"
@@ -38,6 +39,7 @@ namespace hpmc
 void export_convex_polygon(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeConvexPolygon>(m, "IntegratorHPMCMonoConvexPolygon");
+    export_IntegratorHPMCMonoECMC<ShapeConvexPolygon>(m, "IntegratorHPMCMonoConvexPolygonECMC");
     export_ComputeFreeVolume<ShapeConvexPolygon>(m, "ComputeFreeVolumeConvexPolygon");
     export_AnalyzerSDF<ShapeConvexPolygon>(m, "AnalyzerSDFConvexPolygon");
     export_UpdaterMuVT<ShapeConvexPolygon>(m, "UpdaterMuVTConvexPolygon");
@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoECMC.h"
 
 #include "AnalyzerSDF.h"
 #include "ShapeSpheropolyhedron.h"
@@ -38,6 +39,7 @@ namespace hpmc
 void export_convex_spheropolyhedron(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeSpheropolyhedron>(m, "IntegratorHPMCMonoSpheropolyhedron");
+    export_IntegratorHPMCMonoECMC<ShapeSpheropolyhedron>(m, "IntegratorHPMCMonoSpheropolyhedronECMC");
     export_ComputeFreeVolume<ShapeSpheropolyhedron>(m, "ComputeFreeVolumeSpheropolyhedron");
     export_AnalyzerSDF<ShapeSpheropolyhedron>(m, "AnalyzerSDFSpheropolyhedron");
     export_UpdaterMuVT<ShapeSpheropolyhedron>(m, "UpdaterMuVTConvexSpheropolyhedron");
@@ -36,6 +36,35 @@ def test_after_attaching(simulation_factory, lattice_snapshot_factory):
     assert isinstance(free_volume.free_volume, float)
 
 
+def test_early_stopping(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=5, a=1, r=0)
+    sim = simulation_factory(snap)
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape["A"] = {'diameter': 0.8}
+    mc.shape["B"] = {'diameter': 0.1}
+    sim.operations.add(mc)
+
+    free_volume = hoomd.hpmc.compute.FreeVolume(test_particle_type='B',
+                                                num_samples=1000,
+                                                target_relative_error=0.01,
+                                                max_num_samples=100000)
+    assert free_volume.target_relative_error == 0.01
+    assert free_volume.max_num_samples == 100000
+
+    sim.operations.add(free_volume)
+    sim.run(0)
+
+    assert free_volume.free_volume > 0
+    if isinstance(sim.device, hoomd.device.CPU):
+        # sampling continues past the first batch until the target is met or
+        # the next batch would exceed max_num_samples
+        n_used = free_volume.num_samples_used
+        assert n_used > 1000
+        assert n_used <= 100000
+        assert (free_volume.relative_error <= 0.01
+                or n_used + 1000 * sim.device.communicator.num_ranks > 100000)
+
+
 _radii = [
     (0.25, 0.05),
     (0.4, 0.05),
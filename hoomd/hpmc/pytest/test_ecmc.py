@@ -0,0 +1,55 @@
+import hoomd
+import hoomd.hpmc
+import pytest
+
+_square = [(-0.5, -0.5), (0.5, -0.5), (0.5, 0.5), (-0.5, 0.5)]
+_cube = [(-0.5, -0.5, -0.5), (0.5, -0.5, -0.5), (0.5, 0.5, -0.5),
+         (-0.5, 0.5, -0.5), (-0.5, -0.5, 0.5), (0.5, -0.5, 0.5),
+         (0.5, 0.5, 0.5), (-0.5, 0.5, 0.5)]
+
+_ecmc_args = [
+    (hoomd.hpmc.integrate.SphereECMC, dict(diameter=1.0), 3),
+    (hoomd.hpmc.integrate.SphereECMC, dict(diameter=1.0), 2),
+    (hoomd.hpmc.integrate.ConvexPolygonECMC, dict(vertices=_square), 2),
+    (hoomd.hpmc.integrate.ConvexPolyhedronECMC, dict(vertices=_cube), 3),
+    (hoomd.hpmc.integrate.ConvexSpheropolyhedronECMC,
+     dict(vertices=_cube, sweep_radius=0.1), 3),
+]
+
+
+@pytest.mark.parametrize("chain_type", ['straight', 'newtonian'])
+@pytest.mark.parametrize("integrator,shape,dims", _ecmc_args)
+def test_ecmc_moves(device, simulation_factory, lattice_snapshot_factory,
+                    integrator, shape, dims, chain_type):
+    """Event chains move particles without creating overlaps."""
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("ECMC runs on the CPU")
+
+    snap = lattice_snapshot_factory(dimensions=dims, a=1.3, n=5)
+    sim = simulation_factory(snap)
+
+    mc = integrator(default_d=0.5,
+                    default_a=0.1,
+                    chain_time=2.0,
+                    chain_type=chain_type)
+    mc.shape['A'] = shape
+    sim.operations.integrator = mc
+    sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=1.0)
+
+    snap_before = sim.state.snapshot
+    sim.run(10)
+    snap_after = sim.state.snapshot
+
+    assert mc.chain_type == chain_type
+    assert mc.chain_time == 2.0
+    assert mc.overlaps == 0
+    assert sum(mc.translate_moves) > 0
+    if snap_after.communicator.rank == 0:
+        assert (snap_before.particles.position
+                != snap_after.particles.position).any()
+
+
+def test_ecmc_chain_type_validation():
+    mc = hoomd.hpmc.integrate.SphereECMC()
+    with pytest.raises(ValueError):
+        mc.chain_type = 'curved'
@@ -28,6 +28,7 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
     {
     // set to null pointer
     m_eval = NULL;
+    m_eval_batch = NULL;
 
     // initialize LLVM
     std::ostringstream sstream;
@@ -79,6 +80,9 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
         return;
         }
 
+    // the batched evaluator is optional, LLVM IR files written for older versions do not provide it
+    auto eval_batch = m_jit->findSymbol("eval_batch");
+
     auto alpha = m_jit->findSymbol("alpha_iso");
 
     if (!alpha)
@@ -97,10 +101,14 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
 
 #if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR >= 5
     m_eval = (EvalFnPtr)(long unsigned int)(cantFail(eval.getAddress()));
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr)(long unsigned int)(cantFail(eval_batch.getAddress()));
     m_alpha = (float**)(cantFail(alpha.getAddress()));
     m_alpha_union = (float**)(cantFail(alpha_union.getAddress()));
 #else
     m_eval = (EvalFnPtr)eval.getAddress();
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr)eval_batch.getAddress();
     m_alpha = (float**)alpha.getAddress();
     m_alpha_union = (float**)alpha_union.getAddress();
 #endif
@@ -20,6 +20,24 @@ class EvalFactory
                                float d_j,
                                float charge_j);
 
+    //! Batched evaluator, computes energy[k] for the pairs (i, j_k) with k < n
+    typedef void (*EvalBatchFnPtr)(unsigned int n,
+                                   const float* r_x,
+                                   const float* r_y,
+                                   const float* r_z,
+                                   unsigned int type_i,
+                                   const quat<float>& q_i,
+                                   float d_i,
+                                   float charge_i,
+                                   const unsigned int* type_j,
+                                   const float* q_j_s,
+                                   const float* q_j_x,
+                                   const float* q_j_y,
+                                   const float* q_j_z,
+                                   const float* d_j,
+                                   const float* charge_j,
+                                   float* energy);
+
     //! Constructor
     EvalFactory(const std::string& llvm_ir);
 
@@ -29,6 +47,14 @@ class EvalFactory
         return m_eval;
         }
 
+    //! Return the batched evaluator
+    /*! \returns nullptr when the LLVM module does not define eval_batch
+     */
+    EvalBatchFnPtr getEvalBatch()
+        {
+        return m_eval_batch;
+        }
+
     //! Get the error message from initialization
     const std::string& getError()
         {
@@ -62,6 +88,7 @@ class EvalFactory
     private:
     std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
     EvalFnPtr m_eval;                                  //!< Function pointer to evaluator
+    EvalBatchFnPtr m_eval_batch;                       //!< Function pointer to batched evaluator
     float** m_alpha;                                   // Pointer to alpha array
     float** m_alpha_union;                             // Pointer to alpha array for union
     std::string m_error_msg; //!< The error message if initialization fails
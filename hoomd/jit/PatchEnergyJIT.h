@@ -81,6 +81,41 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
         }
 
+    //! evaluate the energies of a batch of patch interactions with a common particle i
+    /*! Calls the batched evaluator in the JIT module when it is available, which evaluates all
+        pairs with one indirect call in a loop that LLVM can vectorize.
+    */
+    virtual void energyBatch(unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             hpmc::PatchEnergyBatch& batch)
+        {
+        if (!m_eval_batch)
+            {
+            hpmc::PatchEnergy::energyBatch(type_i, q_i, d_i, charge_i, batch);
+            return;
+            }
+
+        batch.energy.resize(batch.size());
+        m_eval_batch(batch.size(),
+                     batch.r_x.data(),
+                     batch.r_y.data(),
+                     batch.r_z.data(),
+                     type_i,
+                     q_i,
+                     d_i,
+                     charge_i,
+                     batch.type_j.data(),
+                     batch.q_j_s.data(),
+                     batch.q_j_x.data(),
+                     batch.q_j_y.data(),
+                     batch.q_j_z.data(),
+                     batch.d_j.data(),
+                     batch.charge_j.data(),
+                     batch.energy.data());
+        }
+
     static pybind11::object getAlphaNP(pybind11::object self)
         {
         auto self_cpp = self.cast<PatchEnergyJIT*>();
@@ -105,6 +140,8 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
     unsigned int m_alpha_size;              //!< Size of array
     std::vector<float, managed_allocator<float>>
         m_alpha; //!< Array containing adjustable parameters
+
+    EvalFactory::EvalBatchFnPtr m_eval_batch; //!< Pointer to the batched evaluator (may be null)
     };
 
 //! Exports the PatchEnergyJIT class to python
@@ -98,7 +98,8 @@ float PatchEnergyJITUnion::compute_leaf_leaf_energy(vec3<float> dr,
                                                     const quat<float>& orientation_a,
                                                     const quat<float>& orientation_b,
                                                     unsigned int cur_node_a,
-                                                    unsigned int cur_node_b)
+                                                    unsigned int cur_node_b,
+                                                    hpmc::PatchEnergyBatch& batch)
     {
     float energy = 0.0;
     vec3<float> r_ab = rotate(conj(quat<float>(orientation_b)), vec3<float>(dr));
@@ -118,13 +119,11 @@ float PatchEnergyJITUnion::compute_leaf_leaf_energy(vec3<float> dr,
                                  m_position[type_a][ileaf])
                           - r_ab);
 
-        // loop through leaf particles of cur_node_b
+        // collect the leaf particles of cur_node_b within the cutoff
+        batch.clear();
         for (unsigned int j = 0; j < nb; j++)
             {
             unsigned int jleaf = m_tree[type_b].getParticleByNode(cur_node_b, j);
-
-            unsigned int type_j = m_type[type_b][jleaf];
-            quat<float> orientation_j = m_orientation[type_b][jleaf];
             vec3<float> r_ij = m_position[type_b][jleaf] - pos_i;
 
             float rsq = dot(r_ij, r_ij);
@@ -132,18 +131,57 @@ float PatchEnergyJITUnion::compute_leaf_leaf_energy(vec3<float> dr,
                                + 0.5 * (m_diameter[type_a][ileaf] + m_diameter[type_b][jleaf]));
             if (rsq <= rcut * rcut)
                 {
-                // evaluate energy via JIT function
-                energy += m_eval_union(r_ij,
-                                       type_i,
-                                       orientation_i,
-                                       m_diameter[type_a][ileaf],
-                                       m_charge[type_a][ileaf],
-                                       type_j,
-                                       orientation_j,
-                                       m_diameter[type_b][jleaf],
-                                       m_charge[type_b][jleaf]);
+                batch.push_back(r_ij,
+                                m_type[type_b][jleaf],
+                                m_orientation[type_b][jleaf],
+                                m_diameter[type_b][jleaf],
+                                m_charge[type_b][jleaf]);
+                }
+            }
+
+        const unsigned int n = batch.size();
+        if (n == 0)
+            continue;
+
+        // evaluate energy via JIT function
+        batch.energy.resize(n);
+        if (m_eval_union_batch)
+            {
+            m_eval_union_batch(n,
+                               batch.r_x.data(),
+                               batch.r_y.data(),
+                               batch.r_z.data(),
+                               type_i,
+                               orientation_i,
+                               m_diameter[type_a][ileaf],
+                               m_charge[type_a][ileaf],
+                               batch.type_j.data(),
+                               batch.q_j_s.data(),
+                               batch.q_j_x.data(),
+                               batch.q_j_y.data(),
+                               batch.q_j_z.data(),
+                               batch.d_j.data(),
+                               batch.charge_j.data(),
+                               batch.energy.data());
+            }
+        else
+            {
+            for (unsigned int k = 0; k < n; k++)
+                {
+                batch.energy[k] = m_eval_union(batch.getRij(k),
+                                               type_i,
+                                               orientation_i,
+                                               m_diameter[type_a][ileaf],
+                                               m_charge[type_a][ileaf],
+                                               batch.type_j[k],
+                                               batch.getQj(k),
+                                               batch.d_j[k],
+                                               batch.charge_j[k]);
                 }
             }
+
+        for (unsigned int k = 0; k < n; k++)
+            energy += batch.energy[k];
         }
     return energy;
     }
@@ -158,6 +196,45 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
                                   float d_j,
                                   float charge_j)
     {
+    float energy = 0.0;
+
+    // evaluate isotropic part if necessary
+    if (m_r_cut >= 0.0)
+        energy += m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
+
+    energy += energyUnion(r_ij, type_i, q_i, type_j, q_j);
+    return energy;
+    }
+
+void PatchEnergyJITUnion::energyBatch(unsigned int type_i,
+                                      const quat<float>& q_i,
+                                      float d_i,
+                                      float charge_i,
+                                      hpmc::PatchEnergyBatch& batch)
+    {
+    const unsigned int n = batch.size();
+
+    // evaluate isotropic part if necessary
+    if (m_r_cut >= 0.0)
+        {
+        PatchEnergyJIT::energyBatch(type_i, q_i, d_i, charge_i, batch);
+        }
+    else
+        {
+        batch.energy.assign(n, 0.0f);
+        }
+
+    for (unsigned int k = 0; k < n; k++)
+        batch.energy[k]
+            += energyUnion(batch.getRij(k), type_i, q_i, batch.type_j[k], batch.getQj(k));
+    }
+
+float PatchEnergyJITUnion::energyUnion(const vec3<float>& r_ij,
+                                       unsigned int type_i,
+                                       const quat<float>& q_i,
+                                       unsigned int type_j,
+                                       const quat<float>& q_j)
+    {
     const hpmc::detail::GPUTree& tree_a = m_tree[type_i];
     const hpmc::detail::GPUTree& tree_b = m_tree[type_j];
 
@@ -168,10 +245,6 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
         [&]
         {
 #endif
-            // evaluate isotropic part if necessary
-            if (m_r_cut >= 0.0)
-                energy += m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
-
             if (tree_a.getNumLeaves() <= tree_b.getNumLeaves())
                 {
 #ifdef ENABLE_TBB
@@ -180,9 +253,11 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
                     0.0f,
                     [&](const tbb::blocked_range<unsigned int>& r, float energy) -> float
                     {
+                        hpmc::PatchEnergyBatch batch;
                         for (unsigned int cur_leaf_a = r.begin(); cur_leaf_a != r.end();
                              ++cur_leaf_a)
 #else
+        hpmc::PatchEnergyBatch batch;
         for (unsigned int cur_leaf_a = 0; cur_leaf_a < tree_a.getNumLeaves(); cur_leaf_a++)
 #endif
                             {
@@ -208,7 +283,8 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
                                                                        q_i,
                                                                        q_j,
                                                                        cur_node_a,
-                                                                       query_node);
+                                                                       query_node,
+                                                                       batch);
                                 }
                             }
 #ifdef ENABLE_TBB
@@ -225,9 +301,11 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
                     0.0f,
                     [&](const tbb::blocked_range<unsigned int>& r, float energy) -> float
                     {
+                        hpmc::PatchEnergyBatch batch;
                         for (unsigned int cur_leaf_b = r.begin(); cur_leaf_b != r.end();
                              ++cur_leaf_b)
 #else
+        hpmc::PatchEnergyBatch batch;
         for (unsigned int cur_leaf_b = 0; cur_leaf_b < tree_b.getNumLeaves(); cur_leaf_b++)
 #endif
                             {
@@ -253,7 +331,8 @@ float PatchEnergyJITUnion::energy(const vec3<float>& r_ij,
                                                                        q_j,
                                                                        q_i,
                                                                        cur_node_b,
-                                                                       query_node);
+                                                                       query_node,
+                                                                       batch);
                                 }
                             }
 #ifdef ENABLE_TBB
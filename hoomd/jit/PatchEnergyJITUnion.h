@@ -34,6 +34,7 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
 
         // get the evaluator
         m_eval_union = m_factory_union->getEval();
+        m_eval_union_batch = m_factory_union->getEvalBatch();
 
         if (!m_eval_union)
             {
@@ -124,6 +125,16 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
                          float d_j,
                          float charge_j);
 
+    //! evaluate the energies of a batch of patch interactions with a common particle i
+    /*! The isotropic part is evaluated by PatchEnergyJIT::energyBatch(), the constituent particle
+        energies are added to each pair.
+    */
+    virtual void energyBatch(unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             hpmc::PatchEnergyBatch& batch);
+
     //! Method to be called when number of types changes
     virtual void slotNumTypesChange()
         {
@@ -157,6 +168,13 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
     std::vector<std::vector<unsigned int>>
         m_type; // The type identifiers of the constituent particles
 
+    //! Compute the sum of the constituent particle energies between two unions
+    float energyUnion(const vec3<float>& r_ij,
+                      unsigned int type_i,
+                      const quat<float>& q_i,
+                      unsigned int type_j,
+                      const quat<float>& q_j);
+
     //! Compute the energy of two overlapping leaf nodes
     float compute_leaf_leaf_energy(vec3<float> dr,
                                    unsigned int type_a,
@@ -164,11 +182,14 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
                                    const quat<float>& orientation_a,
                                    const quat<float>& orientation_b,
                                    unsigned int cur_node_a,
-                                   unsigned int cur_node_b);
+                                   unsigned int cur_node_b,
+                                   hpmc::PatchEnergyBatch& batch);
 
     std::shared_ptr<EvalFactory>
         m_factory_union; //!< The factory for the evaluator function, for constituent ptls
     EvalFactory::EvalFnPtr m_eval_union; //!< Pointer to evaluator function inside the JIT module
+    EvalFactory::EvalBatchFnPtr
+        m_eval_union_batch; //!< Pointer to the batched constituent evaluator (may be null)
     Scalar m_rcut_union;                 //!< Cutoff on constituent particles
     std::vector<float, managed_allocator<float>> m_alpha_union; //!< Data array for union
     unsigned int m_alpha_size_union;
@@ -7,6 +7,7 @@ import hoomd
 
 import subprocess
 import os
+import platform
 
 import numpy as np
 
@@ -123,6 +124,11 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also define an extern "C" ``eval_batch`` function that
+    evaluates the energy between particle *i* and *n* particles *j* in one call.
+    HOOMD calls it when present, and calls ``eval`` once per pair otherwise.
+    See the code generated by :py:meth:`compile_user` for its signature.
+
     Compile the file with clang: ``clang -O3 --std=c++14 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -223,9 +229,8 @@ class user(object):
 float *alpha_iso;
 float *alpha_union;
 
-extern "C"
-{
-float eval(const vec3<float>& r_ij,
+static inline __attribute__((always_inline))
+float eval_inline(const vec3<float>& r_ij,
     unsigned int type_i,
     const quat<float>& q_i,
     float d_i,
@@ -239,6 +244,54 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+extern "C"
+{
+float eval(const vec3<float>& r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    unsigned int type_j,
+    const quat<float>& q_j,
+    float d_j,
+    float charge_j)
+    {
+    return eval_inline(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
+    }
+
+// evaluate the energies between particle i and n particles j in one call
+void eval_batch(unsigned int n,
+    const float* __restrict__ r_x,
+    const float* __restrict__ r_y,
+    const float* __restrict__ r_z,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int* __restrict__ type_j,
+    const float* __restrict__ q_j_s,
+    const float* __restrict__ q_j_x,
+    const float* __restrict__ q_j_y,
+    const float* __restrict__ q_j_z,
+    const float* __restrict__ d_j,
+    const float* __restrict__ charge_j,
+    float* __restrict__ energy)
+    {
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (unsigned int k = 0; k < n; k++)
+        {
+        energy[k] = eval_inline(vec3<float>(r_x[k], r_y[k], r_z[k]),
+                                type_i,
+                                q_i,
+                                d_i,
+                                charge_i,
+                                type_j[k],
+                                quat<float>(q_j_s[k], vec3<float>(q_j_x[k], q_j_y[k], q_j_z[k])),
+                                d_j[k],
+                                charge_j[k]);
+        }
+    }
 }
 """
 
@@ -250,6 +303,13 @@ float eval(const vec3<float>& r_ij,
         else:
             clang = 'clang'
 
+        # The code is compiled and executed on the same host, so let clang
+        # vectorize eval_batch for the instruction set of this CPU.
+        if platform.machine() in ('x86_64', 'AMD64', 'i386', 'i686'):
+            cpu_flags = ['-march=native']
+        else:
+            cpu_flags = ['-mcpu=native']
+
         if fn is not None:
             cmd = [
                 clang, '-O3', '--std=c++14', '-DHOOMD_LLVMJIT_BUILD', '-I',
@@ -262,6 +322,7 @@ float eval(const vec3<float>& r_ij,
                 include_path, '-I', include_path_source, '-S', '-emit-llvm',
                 '-x', 'c++', '-o', '-', '-'
             ]
+        cmd[2:2] = cpu_flags
         p = subprocess.Popen(cmd,
                              stdin=subprocess.PIPE,
                              stdout=subprocess.PIPE,
@@ -0,0 +1,156 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/jit/PatchEnergyJITUnion.h"
+
+#include <pybind11/embed.h>
+
+#include <memory>
+#include <string>
+
+/*! \file test_patch_energy_jit_union.cc
+    \brief Implements unit tests for PatchEnergyJITUnion
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+using namespace std;
+
+//! LLVM IR with a constant isotropic energy of 0.25 and a matching eval_batch
+static const string llvm_ir_iso = R"(
+%struct.vec3 = type { float, float, float }
+%struct.quat = type { float, %struct.vec3 }
+
+@alpha_iso = global float* null
+@alpha_union = global float* null
+
+define float @eval(%struct.vec3* %r_ij, i32 %type_i, %struct.quat* %q_i, float %d_i,
+                   float %charge_i, i32 %type_j, %struct.quat* %q_j, float %d_j,
+                   float %charge_j) {
+  ret float 2.500000e-01
+}
+
+define void @eval_batch(i32 %n, float* %r_x, float* %r_y, float* %r_z, i32 %type_i,
+                        %struct.quat* %q_i, float %d_i, float %charge_i, i32* %type_j,
+                        float* %q_j_s, float* %q_j_x, float* %q_j_y, float* %q_j_z,
+                        float* %d_j, float* %charge_j, float* %energy) {
+entry:
+  %empty = icmp eq i32 %n, 0
+  br i1 %empty, label %done, label %loop
+
+loop:
+  %k = phi i32 [ 0, %entry ], [ %k.next, %loop ]
+  %idx = zext i32 %k to i64
+  %e = getelementptr inbounds float, float* %energy, i64 %idx
+  store float 2.500000e-01, float* %e
+  %k.next = add nuw i32 %k, 1
+  %more = icmp ult i32 %k.next, %n
+  br i1 %more, label %loop, label %done
+
+done:
+  ret void
+}
+)";
+
+//! LLVM IR with an energy of -1 between every pair of constituent particles within the cutoff
+static const string llvm_ir_union = R"(
+%struct.vec3 = type { float, float, float }
+%struct.quat = type { float, %struct.vec3 }
+
+@alpha_iso = global float* null
+@alpha_union = global float* null
+
+define float @eval(%struct.vec3* %r_ij, i32 %type_i, %struct.quat* %q_i, float %d_i,
+                   float %charge_i, i32 %type_j, %struct.quat* %q_j, float %d_j,
+                   float %charge_j) {
+  ret float -1.000000e+00
+}
+)";
+
+//! Build a dimer of two unit diameter constituent particles at x = +/- 0.5
+void set_dimer(std::shared_ptr<PatchEnergyJITUnion> patch)
+    {
+    pybind11::list types, positions, orientations, diameters, charges;
+    for (double x : {-0.5, 0.5})
+        {
+        pybind11::list position, orientation;
+        position.append(x);
+        position.append(0.0);
+        position.append(0.0);
+        orientation.append(1.0);
+        orientation.append(0.0);
+        orientation.append(0.0);
+        orientation.append(0.0);
+
+        types.append(0);
+        positions.append(position);
+        orientations.append(orientation);
+        diameters.append(1.0);
+        charges.append(0.0);
+        }
+
+    patch->setParam(0, types, positions, orientations, diameters, charges);
+    }
+
+//! Compare the batched energies with the per-pair energies of the same pairs
+void check_batch(std::shared_ptr<PatchEnergyJITUnion> patch, float energy_iso)
+    {
+    const quat<float> q_i;
+    const quat<float> q_rot(0.70710678f, vec3<float>(0, 0, 0.70710678f));
+
+    // the pairs and the number of constituent pairs within r_cut_union + 1.0 of each other
+    hpmc::PatchEnergyBatch batch;
+    batch.push_back(vec3<float>(2.0f, 0, 0), 0, q_i, 1.0f, 0.0f);
+    batch.push_back(vec3<float>(0, 3.5f, 0), 0, q_i, 1.0f, 0.0f);
+    batch.push_back(vec3<float>(1.5f, 0, 0), 0, q_rot, 1.0f, 0.0f);
+    batch.push_back(vec3<float>(-1.0f, 0, 0), 0, q_i, 1.0f, 0.0f);
+    const float n_pairs[] = {1.0f, 0.0f, 2.0f, 3.0f};
+
+    patch->energyBatch(0, q_i, 1.0f, 0.0f, batch);
+    UP_ASSERT_EQUAL(batch.energy.size(), batch.size());
+
+    for (unsigned int k = 0; k < batch.size(); k++)
+        {
+        float energy = patch->energy(batch.getRij(k),
+                                     0,
+                                     q_i,
+                                     1.0f,
+                                     0.0f,
+                                     batch.type_j[k],
+                                     batch.getQj(k),
+                                     batch.d_j[k],
+                                     batch.charge_j[k]);
+        // all energies are sums of exactly representable values
+        UP_ASSERT_EQUAL(batch.energy[k], energy);
+        UP_ASSERT_EQUAL(energy, energy_iso - n_pairs[k]);
+        }
+    }
+
+//! Test that energyBatch includes the constituent particle energies
+UP_TEST(energy_batch_union)
+    {
+    // setParam takes python lists
+    pybind11::scoped_interpreter guard;
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(2, BoxDim(100.0), 1, 0, 0, 0, 0, exec_conf));
+
+    std::shared_ptr<PatchEnergyJITUnion> patch(
+        new PatchEnergyJITUnion(sysdef, exec_conf, llvm_ir_iso, 4.0, 1, llvm_ir_union, 0.5, 1));
+    set_dimer(patch);
+    check_batch(patch, 0.25f);
+
+    // a negative r_cut disables the isotropic part in both code paths
+    std::shared_ptr<PatchEnergyJITUnion> patch_no_iso(
+        new PatchEnergyJITUnion(sysdef, exec_conf, llvm_ir_iso, -1.0, 1, llvm_ir_union, 0.5, 1));
+    set_dimer(patch_no_iso);
+    check_batch(patch_no_iso, 0.0f);
+    }
@@ -255,14 +255,32 @@ void ActiveForceCompute::rotationalDiffusion(uint64_t timestep)
     assert(h_orientation.data != NULL);
     assert(h_tag.data != NULL);
 
-    for (unsigned int i = 0; i < m_group->getNumMembers(); i++)
+    // one normal value in 2D, two uniform values for the random direction and one normal value in
+    // 3D
+    const unsigned int group_size = m_group->getNumMembers();
+    hoomd::RandomGeneratorBatch batch(
+        hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, m_sysdef->getSeed()),
+        m_sysdef->getNDimensions() == 2 ? 1 : 3);
+
+    for (unsigned int i = 0; i < group_size; i++)
         {
         unsigned int idx = m_group->getMemberIndex(i);
         unsigned int type = __scalar_as_int(h_pos.data[idx].w);
-        unsigned int ptag = h_tag.data[idx];
-        hoomd::RandomGenerator rng(
-            hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, m_sysdef->getSeed()),
-            hoomd::Counter(ptag));
+
+        // initialize the RNG streams of the next members together
+        unsigned int lane = i % hoomd::RandomGeneratorBatch::width;
+        if (lane == 0)
+            {
+            unsigned int n_streams = 0;
+            for (; n_streams < hoomd::RandomGeneratorBatch::width && i + n_streams < group_size;
+                 n_streams++)
+                {
+                unsigned int k = m_group->getMemberIndex(i + n_streams);
+                batch.setStream(n_streams, hoomd::Counter(h_tag.data[k]));
+                }
+            batch.generate(n_streams);
+            }
+        hoomd::RandomStream rng = batch.getStream(lane);
 
         quat<Scalar> quati(h_orientation.data[idx]);
 
@@ -15,6 +15,14 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
 namespace py = pybind11;
 
 #include <iostream>
@@ -71,6 +79,55 @@ void ComputeThermo::compute(uint64_t timestep)
         }
     }
 
+//! Partial sums of the thermodynamic quantities over a block of group members
+struct ThermoSums
+    {
+    //! Indices of the summed quantities
+    enum Enum
+        {
+        kinetic_xx = 0,
+        kinetic_xy,
+        kinetic_xz,
+        kinetic_yy,
+        kinetic_yz,
+        kinetic_zz,
+        rotational_kinetic_energy,
+        potential_energy,
+        virial_xx,
+        virial_xy,
+        virial_xz,
+        virial_yy,
+        virial_yz,
+        virial_zz,
+        num_quantities
+        };
+
+    double value[num_quantities] = {};
+
+    ThermoSums& operator+=(const ThermoSums& other)
+        {
+        for (unsigned int i = 0; i < num_quantities; ++i)
+            value[i] += other.value[i];
+        return *this;
+        }
+    };
+
+//! Add the partial sums in [first, last) pairwise
+/*! The rounding error of pairwise summation grows with the logarithm of the number of blocks.
+ */
+static ThermoSums sumPairwise(const std::vector<ThermoSums>& sums, size_t first, size_t last)
+    {
+    if (last == first)
+        return ThermoSums();
+    if (last - first == 1)
+        return sums[first];
+
+    size_t middle = first + (last - first) / 2;
+    ThermoSums result = sumPairwise(sums, first, middle);
+    result += sumPairwise(sums, middle, last);
+    return result;
+    }
+
 /*! Computes all thermodynamic properties of the system in one fell swoop.
  */
 void ComputeThermo::computeProperties()
@@ -86,133 +143,145 @@ void ComputeThermo::computeProperties()
 
     assert(m_pdata);
 
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
     // access the particle data
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
                                      access_location::host,
                                      access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
     // access the net force, pe, and virial
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
-
-    // total kinetic energy
-    double ke_trans_total = 0.0;
+    size_t virial_pitch = net_virial.getPitch();
 
     PDataFlags flags = m_pdata->getFlags();
+    bool compute_pressure_tensor = flags[pdata_flag::pressure_tensor];
+    bool compute_rotational_kinetic_energy = flags[pdata_flag::rotational_kinetic_energy];
+
+    // Sum all quantities in one pass over the group. The members are split into blocks of fixed
+    // size, independent of the number of threads, and the block sums are added pairwise. The
+    // result is therefore identical for any number of threads.
+    const unsigned int block_size = ParticleGroup::reduction_block_size;
+    unsigned int n_blocks = (group_size + block_size - 1) / block_size;
+    std::vector<ThermoSums> block_sums(n_blocks);
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, n_blocks),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int block = r.begin(); block != r.end(); ++block)
+#else
+    for (unsigned int block = 0; block < n_blocks; ++block)
+#endif
+                        {
+                        ThermoSums sums;
+                        unsigned int first = block * block_size;
+                        unsigned int last = std::min(first + block_size, group_size);
+
+                        for (unsigned int group_idx = first; group_idx < last; group_idx++)
+                            {
+                            unsigned int j = h_member_idx.data[group_idx];
+
+                            // ignore rigid body constituent particles in the sum
+                            if (h_body.data[j] < MIN_FLOPPY && h_body.data[j] != h_tag.data[j])
+                                continue;
+
+                            // kinetic part of the pressure tensor
+                            double mass = h_vel.data[j].w;
+                            double vx = h_vel.data[j].x;
+                            double vy = h_vel.data[j].y;
+                            double vz = h_vel.data[j].z;
+                            sums.value[ThermoSums::kinetic_xx] += mass * vx * vx;
+                            sums.value[ThermoSums::kinetic_yy] += mass * vy * vy;
+                            sums.value[ThermoSums::kinetic_zz] += mass * vz * vz;
+
+                            sums.value[ThermoSums::potential_energy] += h_net_force.data[j].w;
+
+                            if (compute_pressure_tensor)
+                                {
+                                sums.value[ThermoSums::kinetic_xy] += mass * vx * vy;
+                                sums.value[ThermoSums::kinetic_xz] += mass * vx * vz;
+                                sums.value[ThermoSums::kinetic_yz] += mass * vy * vz;
+
+                                for (unsigned int k = 0; k < 6; ++k)
+                                    {
+                                    sums.value[ThermoSums::virial_xx + k]
+                                        += h_net_virial.data[j + k * virial_pitch];
+                                    }
+                                }
+
+                            if (compute_rotational_kinetic_energy)
+                                {
+                                Scalar3 I = h_inertia.data[j];
+                                quat<Scalar> q(h_orientation.data[j]);
+                                quat<Scalar> p(h_angmom.data[j]);
+                                quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+                                // only if the moment of inertia along one principal axis is
+                                // non-zero, that axis carries angular momentum
+                                if (I.x >= EPSILON)
+                                    {
+                                    sums.value[ThermoSums::rotational_kinetic_energy]
+                                        += s.v.x * s.v.x / I.x;
+                                    }
+                                if (I.y >= EPSILON)
+                                    {
+                                    sums.value[ThermoSums::rotational_kinetic_energy]
+                                        += s.v.y * s.v.y / I.y;
+                                    }
+                                if (I.z >= EPSILON)
+                                    {
+                                    sums.value[ThermoSums::rotational_kinetic_energy]
+                                        += s.v.z * s.v.z / I.z;
+                                    }
+                                }
+                            }
+
+                        block_sums[block] = sums;
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
+
+    ThermoSums total = sumPairwise(block_sums, 0, n_blocks);
 
-    double pressure_kinetic_xx = 0.0;
+    double pressure_kinetic_xx = total.value[ThermoSums::kinetic_xx];
+    double pressure_kinetic_yy = total.value[ThermoSums::kinetic_yy];
+    double pressure_kinetic_zz = total.value[ThermoSums::kinetic_zz];
     double pressure_kinetic_xy = 0.0;
     double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
     double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
 
-    if (flags[pdata_flag::pressure_tensor])
-        {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                double mass = h_vel.data[j].w;
-                pressure_kinetic_xx += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].x);
-                pressure_kinetic_xy += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].y);
-                pressure_kinetic_xz += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].z);
-                pressure_kinetic_yy += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].y);
-                pressure_kinetic_yz += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].z);
-                pressure_kinetic_zz += mass * ((double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
-            }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total
-            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
-        }
-    else
-        {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                ke_trans_total += (double)h_vel.data[j].w
-                                  * ((double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                     + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                     + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
-            }
-
-        ke_trans_total *= Scalar(0.5);
-        }
+    // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+    double ke_trans_total
+        = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
 
     // total rotational kinetic energy
-    double ke_rot_total = 0.0;
-
-    if (flags[pdata_flag::rotational_kinetic_energy])
-        {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                Scalar3 I = h_inertia.data[j];
-                quat<Scalar> q(h_orientation.data[j]);
-                quat<Scalar> p(h_angmom.data[j]);
-                quat<Scalar> s(Scalar(0.5) * conj(q) * p);
-
-                // only if the moment of inertia along one principal axis is non-zero, that axis
-                // carries angular momentum
-                if (I.x >= EPSILON)
-                    {
-                    ke_rot_total += s.v.x * s.v.x / I.x;
-                    }
-                if (I.y >= EPSILON)
-                    {
-                    ke_rot_total += s.v.y * s.v.y / I.y;
-                    }
-                if (I.z >= EPSILON)
-                    {
-                    ke_rot_total += s.v.z * s.v.z / I.z;
-                    }
-                }
-            }
-
-        ke_rot_total /= Scalar(2.0);
-        }
+    double ke_rot_total = total.value[ThermoSums::rotational_kinetic_energy] / Scalar(2.0);
 
     // total potential energy
-    double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-            {
-            pe_total += (double)h_net_force.data[j].w;
-            }
-        }
-
-    pe_total += m_pdata->getExternalEnergy();
+    double pe_total = total.value[ThermoSums::potential_energy] + m_pdata->getExternalEnergy();
 
     double W = 0.0;
     double virial_xx = m_pdata->getExternalVirial(0);
@@ -222,28 +291,31 @@ void ComputeThermo::computeProperties()
     double virial_yz = m_pdata->getExternalVirial(4);
     double virial_zz = m_pdata->getExternalVirial(5);
 
-    if (flags[pdata_flag::pressure_tensor])
+    if (compute_pressure_tensor)
         {
-        // Calculate upper triangular virial tensor
-        size_t virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
-                virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
-                virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
-                virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
-                virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
-                virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
-                }
-            }
+        pressure_kinetic_xy = total.value[ThermoSums::kinetic_xy];
+        pressure_kinetic_xz = total.value[ThermoSums::kinetic_xz];
+        pressure_kinetic_yz = total.value[ThermoSums::kinetic_yz];
+
+        // upper triangular virial tensor
+        virial_xx += total.value[ThermoSums::virial_xx];
+        virial_xy += total.value[ThermoSums::virial_xy];
+        virial_xz += total.value[ThermoSums::virial_xz];
+        virial_yy += total.value[ThermoSums::virial_yy];
+        virial_yz += total.value[ThermoSums::virial_yz];
+        virial_zz += total.value[ThermoSums::virial_zz];
 
         // isotropic virial = 1/3 trace of virial tensor
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
         }
+    else
+        {
+        // the diagonal is always summed for the kinetic energy, but the pressure tensor is only
+        // valid when requested
+        pressure_kinetic_xx = 0.0;
+        pressure_kinetic_yy = 0.0;
+        pressure_kinetic_zz = 0.0;
+        }
 
     // compute the pressure
     // volume/area & other 2D stuff needed
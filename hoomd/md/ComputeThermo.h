@@ -224,6 +224,10 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getPotentialEnergy()
         {
+        // return NaN if the flags are not valid
+        if (m_computed_flags[pdata_flag::skip_potential_energy])
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
 #ifdef ENABLE_MPI
         if (!m_properties_reduced)
             reduceProperties();
@@ -309,6 +313,12 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         return m_group->getNumMembersGlobal();
         }
 
+    //! Get the group over which the properties are computed
+    std::shared_ptr<ParticleGroup> getGroup()
+        {
+        return m_group;
+        }
+
     //! Get the gpu array of properties
     const GlobalArray<Scalar>& getProperties()
         {
@@ -58,14 +58,24 @@ class PYBIND11_EXPORT ComputeThermoHMA : public Compute
      */
     Scalar getPotentialEnergyHMA()
         {
+        // return NaN if the flags are not valid
+        PDataFlags flags = m_pdata->getFlags();
+        if (!flags[pdata_flag::skip_potential_energy])
+            {
 #ifdef ENABLE_MPI
-        if (!m_properties_reduced)
-            reduceProperties();
+            if (!m_properties_reduced)
+                reduceProperties();
 #endif
 
-        // return NaN if the flags are not valid
-        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
-        return h_properties.data[thermoHMA_index::potential_energyHMA];
+            ArrayHandle<Scalar> h_properties(m_properties,
+                                             access_location::host,
+                                             access_mode::read);
+            return h_properties.data[thermoHMA_index::potential_energyHMA];
+            }
+        else
+            {
+            return std::numeric_limits<Scalar>::quiet_NaN();
+            }
         }
 
     //! Returns the pressure last computed by compute()
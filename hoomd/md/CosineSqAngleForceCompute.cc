@@ -104,6 +104,18 @@ pybind11::dict CosineSqAngleForceCompute::getParams(std::string type)
  */
 void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
     {
+    zeroForces();
+    accumulateForces(timestep, m_force, m_virial);
+    }
+
+/*! \param timestep Current time step
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+ */
+void CosineSqAngleForceCompute::accumulateForces(uint64_t timestep,
+                                                 const GlobalArray<Scalar4>& force,
+                                                 const GlobalArray<Scalar>& virial)
+    {
     if (m_prof)
         m_prof->push("CosineSq Angle");
 
@@ -112,9 +124,9 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-    size_t virial_pitch = m_virial.getPitch();
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    size_t virial_pitch = virial.getPitch();
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
@@ -122,10 +134,6 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
     assert(h_pos.data);
     assert(h_rtag.data);
 
-    // Zero data for force calculation.
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
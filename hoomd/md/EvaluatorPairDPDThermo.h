@@ -227,6 +227,47 @@ class EvaluatorPairDPDThermo
                                       Scalar& pair_eng,
                                       bool energy_shift)
         {
+        unsigned int m_oi, m_oj;
+        // initialize the RNG
+        if (m_i > m_j)
+            {
+            m_oi = m_j;
+            m_oj = m_i;
+            }
+        else
+            {
+            m_oi = m_i;
+            m_oj = m_j;
+            }
+
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
+            hoomd::Counter(m_oi, m_oj));
+
+        return evalForceEnergyThermo(force_divr, force_divr_cons, pair_eng, energy_shift, rng);
+        }
+
+    //! Evaluate the force and energy using the thermostat with the given random number generator
+    /*! \param force_divr Output parameter to write the computed total force divided by r.
+        \param force_divr_cons Output parameter to write the computed conservative force divided
+            by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored. DPD always goes to 0 at the cutoff.
+        \param rng Random number generator
+
+        \a rng must produce the same stream as the generator that the overload without \a rng
+        initializes from the seed and the ordered pair of tags, e.g. a RandomStream evaluated by
+        RandomGeneratorBatch.
+
+        \return True if they are evaluated or false if they are not because we are beyond the cutoff
+    */
+    template<class RNG>
+    DEVICE bool evalForceEnergyThermo(Scalar& force_divr,
+                                      Scalar& force_divr_cons,
+                                      Scalar& pair_eng,
+                                      bool energy_shift,
+                                      RNG& rng)
+        {
         // compute the force divided by r in force_divr
         if (rsq < rcutsq)
             {
@@ -237,23 +278,6 @@ class EvaluatorPairDPDThermo
 
             // force calculation
 
-            unsigned int m_oi, m_oj;
-            // initialize the RNG
-            if (m_i > m_j)
-                {
-                m_oi = m_j;
-                m_oj = m_i;
-                }
-            else
-                {
-                m_oi = m_i;
-                m_oj = m_j;
-                }
-
-            hoomd::RandomGenerator rng(
-                hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
-                hoomd::Counter(m_oi, m_oj));
-
             // Generate a single random number
             Scalar alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
 
@@ -38,6 +38,14 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     //! Perform one minimization iteration
     virtual void update(uint64_t timestep);
 
+    //! FIRE checks the potential energy on every iteration
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags = IntegratorTwoStep::getRequestedPDataFlags();
+        flags[pdata_flag::potential_energy] = 1;
+        return flags;
+        }
+
     //! Return whether or not the minimization has converged
     bool hasConverged() const
         {
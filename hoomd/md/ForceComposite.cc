@@ -9,6 +9,12 @@
 #include <map>
 #include <sstream>
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace py = pybind11;
 
 /*! \file ForceComposite.cc
@@ -772,128 +778,149 @@ void ForceComposite::computeForces(uint64_t timestep)
         compute_virial = true;
         }
 
-    // loop over all molecules, also incomplete ones
-    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+    // loop over all molecules, also incomplete ones. Every molecule only writes to its own central
+    // and constituent particles, so the molecules are processed in parallel.
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        // get central particle tag from first particle in molecule
-        assert(h_molecule_length.data[ibody] > 0);
-        unsigned int first_idx = h_molecule_list.data[molecule_indexer(0, ibody)];
-
-        assert(first_idx < m_pdata->getN() + m_pdata->getNGhosts());
-        unsigned int central_tag = h_body.data[first_idx];
-
-        assert(central_tag <= m_pdata->getMaximumTag());
-        unsigned int central_idx = h_rtag.data[central_tag];
-
-        if (central_idx >= n_particles_local)
-            continue;
-
-        // the central particle must be present
-        assert(central_tag == h_tag.data[first_idx]);
-
-        // central particle position and orientation
-        Scalar4 postype = h_postype.data[central_idx];
-        quat<Scalar> orientation(h_orientation.data[central_idx]);
-
-        // body type
-        unsigned int type = __scalar_as_int(postype.w);
-
-        // sum up forces and torques from constituent particles
-        for (unsigned int constituent_index = 0; constituent_index < h_molecule_length.data[ibody];
-             ++constituent_index)
-            {
-            unsigned int idxj = h_molecule_list.data[molecule_indexer(constituent_index, ibody)];
-            assert(idxj < m_pdata->getN() + m_pdata->getNGhosts());
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, nmol),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int ibody = r.begin(); ibody != r.end(); ++ibody)
+#else
+    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+#endif
+                        {
+                        // get central particle tag from first particle in molecule
+                        assert(h_molecule_length.data[ibody] > 0);
+                        unsigned int first_idx
+                            = h_molecule_list.data[molecule_indexer(0, ibody)];
 
-            assert(idxj == central_idx || constituent_index > 0);
-            if (idxj == central_idx)
-                continue;
+                        assert(first_idx < m_pdata->getN() + m_pdata->getNGhosts());
+                        unsigned int central_tag = h_body.data[first_idx];
 
-            // force and torque on particle
-            Scalar4 net_force = h_net_force.data[idxj];
-            Scalar4 net_torque = h_net_torque.data[idxj];
-            vec3<Scalar> f(net_force);
+                        assert(central_tag <= m_pdata->getMaximumTag());
+                        unsigned int central_idx = h_rtag.data[central_tag];
 
-            // zero net energy on constituent particles to avoid double counting
-            // also zero net force and torque for consistency
-            h_net_force.data[idxj] = make_scalar4(0.0, 0.0, 0.0, 0.0);
-            h_net_torque.data[idxj] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+                        if (central_idx >= n_particles_local)
+                            continue;
 
-            // only add forces for local central particles
-            if (central_idx < m_pdata->getN())
-                {
-                // if the central particle is local, the molecule should be complete
-                if (h_molecule_length.data[ibody] != h_body_len.data[type] + 1)
-                    {
-                    m_exec_conf->msg->errorAllRanks()
-                        << "constrain.rigid(): Composite particle with body tag " << central_tag
-                        << " incomplete" << std::endl
-                        << std::endl;
-                    throw std::runtime_error("Error computing composite particle forces.\n");
-                    }
+                        // the central particle must be present
+                        assert(central_tag == h_tag.data[first_idx]);
 
-                // sum up center of mass force
-                h_force.data[central_idx].x += f.x;
-                h_force.data[central_idx].y += f.y;
-                h_force.data[central_idx].z += f.z;
+                        // central particle position and orientation
+                        Scalar4 postype = h_postype.data[central_idx];
+                        rotmat3<Scalar> rotation(quat<Scalar>(h_orientation.data[central_idx]));
 
-                // sum up energy
-                h_force.data[central_idx].w += net_force.w;
+                        // body type
+                        unsigned int type = __scalar_as_int(postype.w);
 
-                // fetch relative position from rigid body definition
-                vec3<Scalar> dr(h_body_pos.data[m_body_idx(type, constituent_index - 1)]);
+                        // only add forces for local central particles
+                        bool central_local = central_idx < m_pdata->getN();
 
-                // rotate into space frame
-                vec3<Scalar> dr_space = rotate(orientation, dr);
+                        // if the central particle is local, the molecule should be complete
+                        if (central_local
+                            && h_molecule_length.data[ibody] != h_body_len.data[type] + 1)
+                            {
+                            m_exec_conf->msg->errorAllRanks()
+                                << "constrain.rigid(): Composite particle with body tag "
+                                << central_tag << " incomplete" << std::endl
+                                << std::endl;
+                            throw std::runtime_error(
+                                "Error computing composite particle forces.\n");
+                            }
 
-                // torque = r x f
-                vec3<Scalar> delta_torque(cross(dr_space, f));
-                h_torque.data[central_idx].x += delta_torque.x;
-                h_torque.data[central_idx].y += delta_torque.y;
-                h_torque.data[central_idx].z += delta_torque.z;
+                        Scalar4 force = make_scalar4(0.0, 0.0, 0.0, 0.0);
+                        vec3<Scalar> torque(0.0, 0.0, 0.0);
+                        Scalar virial[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
-                /* from previous rigid body implementation: Access Torque elements from a single
-                   particle. Right now I will am assuming that the particle and rigid body reference
-                   frames are the same. Probably have to rotate first.
-                 */
-                h_torque.data[central_idx].x += net_torque.x;
-                h_torque.data[central_idx].y += net_torque.y;
-                h_torque.data[central_idx].z += net_torque.z;
+                        // sum up forces and torques from constituent particles
+                        for (unsigned int constituent_index = 1;
+                             constituent_index < h_molecule_length.data[ibody];
+                             ++constituent_index)
+                            {
+                            unsigned int idxj
+                                = h_molecule_list.data[molecule_indexer(constituent_index, ibody)];
+                            assert(idxj < m_pdata->getN() + m_pdata->getNGhosts());
+                            assert(idxj != central_idx);
+
+                            // force and torque on particle
+                            Scalar4 net_force = h_net_force.data[idxj];
+                            Scalar4 net_torque = h_net_torque.data[idxj];
+                            vec3<Scalar> f(net_force);
+
+                            // zero net energy on constituent particles to avoid double counting
+                            // also zero net force and torque for consistency
+                            h_net_force.data[idxj] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+                            h_net_torque.data[idxj] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+
+                            if (central_local)
+                                {
+                                // sum up center of mass force and energy
+                                force.x += f.x;
+                                force.y += f.y;
+                                force.z += f.z;
+                                force.w += net_force.w;
+
+                                // fetch relative position from rigid body definition and rotate it
+                                // into the space frame
+                                vec3<Scalar> dr(
+                                    h_body_pos.data[m_body_idx(type, constituent_index - 1)]);
+                                vec3<Scalar> dr_space = rotation * dr;
+
+                                // torque = r x f, plus the torque acting on the constituent
+                                torque += cross(dr_space, f) + vec3<Scalar>(net_torque);
+
+                                if (compute_virial)
+                                    {
+                                    // sum up virial, subtract intra-body virial part
+                                    virial[0] += h_net_virial.data[0 * net_virial_pitch + idxj]
+                                                 - f.x * dr_space.x;
+                                    virial[1] += h_net_virial.data[1 * net_virial_pitch + idxj]
+                                                 - f.x * dr_space.y;
+                                    virial[2] += h_net_virial.data[2 * net_virial_pitch + idxj]
+                                                 - f.x * dr_space.z;
+                                    virial[3] += h_net_virial.data[3 * net_virial_pitch + idxj]
+                                                 - f.y * dr_space.y;
+                                    virial[4] += h_net_virial.data[4 * net_virial_pitch + idxj]
+                                                 - f.y * dr_space.z;
+                                    virial[5] += h_net_virial.data[5 * net_virial_pitch + idxj]
+                                                 - f.z * dr_space.z;
+                                    }
+                                }
 
-                if (compute_virial)
-                    {
-                    // sum up virial
-                    Scalar virialxx = h_net_virial.data[0 * net_virial_pitch + idxj];
-                    Scalar virialxy = h_net_virial.data[1 * net_virial_pitch + idxj];
-                    Scalar virialxz = h_net_virial.data[2 * net_virial_pitch + idxj];
-                    Scalar virialyy = h_net_virial.data[3 * net_virial_pitch + idxj];
-                    Scalar virialyz = h_net_virial.data[4 * net_virial_pitch + idxj];
-                    Scalar virialzz = h_net_virial.data[5 * net_virial_pitch + idxj];
-
-                    // subtract intra-body virial prt
-                    h_virial.data[0 * m_virial_pitch + central_idx] += virialxx - f.x * dr_space.x;
-                    h_virial.data[1 * m_virial_pitch + central_idx] += virialxy - f.x * dr_space.y;
-                    h_virial.data[2 * m_virial_pitch + central_idx] += virialxz - f.x * dr_space.z;
-                    h_virial.data[3 * m_virial_pitch + central_idx] += virialyy - f.y * dr_space.y;
-                    h_virial.data[4 * m_virial_pitch + central_idx] += virialyz - f.y * dr_space.z;
-                    h_virial.data[5 * m_virial_pitch + central_idx] += virialzz - f.z * dr_space.z;
-                    }
-                }
+                            // zero net virial
+                            for (unsigned int k = 0; k < 6; ++k)
+                                h_net_virial.data[k * net_virial_pitch + idxj] = 0.0;
+                            }
 
-            // zero net virial
-            h_net_virial.data[0 * net_virial_pitch + idxj] = 0.0;
-            h_net_virial.data[1 * net_virial_pitch + idxj] = 0.0;
-            h_net_virial.data[2 * net_virial_pitch + idxj] = 0.0;
-            h_net_virial.data[3 * net_virial_pitch + idxj] = 0.0;
-            h_net_virial.data[4 * net_virial_pitch + idxj] = 0.0;
-            h_net_virial.data[5 * net_virial_pitch + idxj] = 0.0;
-            }
-        }
+                        if (central_local)
+                            {
+                            h_force.data[central_idx] = force;
+                            h_torque.data[central_idx]
+                                = make_scalar4(torque.x, torque.y, torque.z, 0.0);
+                            if (compute_virial)
+                                {
+                                for (unsigned int k = 0; k < 6; ++k)
+                                    h_virial.data[k * m_virial_pitch + central_idx] = virial[k];
+                                }
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
     }
 
 /* Set position and velocity of constituent particles in rigid bodies in the 1st or second half of
  * integration on the CPU based on the body center of mass and particle relative position in each
  * body frame.
+ *
+ * The molecule table stores the members of each body contiguously, ordered by tag, so the central
+ * particle is the first member and constituent k is the (k-1)th particle of the body definition.
+ * Bodies are processed in parallel in that order.
  */
 
 void ForceComposite::updateCompositeParticles(uint64_t timestep)
@@ -905,17 +932,16 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
         return;
         }
 
-    // access molecule order (this needs to be on top because of ArrayHandle scope) and its
-    // pervasive use across this function.
-    ArrayHandle<unsigned int> h_molecule_order(getMoleculeOrder(),
-                                               access_location::host,
-                                               access_mode::read);
+    // access local molecule data (this needs to be on top because of ArrayHandle scope)
+    Index2D molecule_indexer = getMoleculeIndexer();
+    unsigned int nmol = molecule_indexer.getH();
+
     ArrayHandle<unsigned int> h_molecule_len(getMoleculeLengths(),
                                              access_location::host,
                                              access_mode::read);
-    ArrayHandle<unsigned int> h_molecule_idx(getMoleculeIndex(),
-                                             access_location::host,
-                                             access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_list(getMoleculeList(),
+                                              access_location::host,
+                                              access_mode::read);
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
@@ -930,7 +956,6 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
                                      access_location::host,
                                      access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     // access body positions and orientations
     ArrayHandle<Scalar3> h_body_pos(m_body_pos, access_location::host, access_mode::read);
@@ -941,106 +966,160 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
 
     const BoxDim& box = m_pdata->getBox();
     const BoxDim& global_box = m_pdata->getGlobalBox();
+    unsigned int n_local = m_pdata->getN();
 
     // we need to update both local and ghost particles
-    unsigned int n_particles_local = m_pdata->getN() + m_pdata->getNGhosts();
-    for (unsigned int particle_index = 0; particle_index < n_particles_local; particle_index++)
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        unsigned int central_tag = h_body.data[particle_index];
-
-        // Do nothing with floppy bodies, since we don't need to update their positions or
-        // orientations here.
-        if (central_tag >= MIN_FLOPPY)
-            {
-            continue;
-            }
-
-        // body tag equals tag for central particle
-        assert(central_tag <= m_pdata->getMaximumTag());
-        unsigned int central_idx = h_rtag.data[central_tag];
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, nmol),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int ibody = r.begin(); ibody != r.end(); ++ibody)
+#else
+    for (unsigned int ibody = 0; ibody < nmol; ibody++)
+#endif
+                        {
+                        unsigned int mol_len = h_molecule_len.data[ibody];
+                        assert(mol_len > 0);
 
-        // If this is a rigid body center continue, since we do not need to update its position or
-        // orientation (the integrator methods do this).
-        if (particle_index == central_idx)
-            {
-            continue;
-            }
+                        // true when any constituent of this body is a local particle
+                        bool has_local_constituent = false;
+                        for (unsigned int k = 1; k < mol_len; ++k)
+                            {
+                            if (h_molecule_list.data[molecule_indexer(k, ibody)] < n_local)
+                                has_local_constituent = true;
+                            }
 
-        // Continue if central particle is on another rank and current index is a ghost particle
-        // since there is no updating to do.
-        if (central_idx == NOT_LOCAL && particle_index >= m_pdata->getN())
-            {
-            continue;
-            }
+                        // body tag equals tag for central particle
+                        unsigned int first_idx = h_molecule_list.data[molecule_indexer(0, ibody)];
+                        unsigned int central_tag = h_body.data[first_idx];
+                        assert(central_tag <= m_pdata->getMaximumTag());
+                        unsigned int central_idx = h_rtag.data[central_tag];
 
-        if (central_idx == NOT_LOCAL)
-            {
-            std::ostringstream error_msg;
-            error_msg << "Error updating composite particles: Missing central particle tag "
-                      << central_tag << ".";
-            throw std::runtime_error(error_msg.str());
-            }
+                        // Continue if central particle is on another rank and the constituents are
+                        // ghost particles since there is no updating to do.
+                        if (central_idx == NOT_LOCAL)
+                            {
+                            if (first_idx < n_local || has_local_constituent)
+                                {
+                                std::ostringstream error_msg;
+                                error_msg << "Error updating composite particles: Missing central "
+                                             "particle tag "
+                                          << central_tag << ".";
+                                throw std::runtime_error(error_msg.str());
+                                }
+                            continue;
+                            }
 
-        // central particle position and orientation
-        assert(central_idx <= m_pdata->getN() + m_pdata->getNGhosts());
+                        // the central particle has the lowest tag in the body
+                        assert(central_idx == first_idx);
 
-        Scalar4 postype = h_postype.data[central_idx];
-        vec3<Scalar> pos(postype);
-        quat<Scalar> orientation(h_orientation.data[central_idx]);
+                        // central particle position and orientation
+                        Scalar4 postype = h_postype.data[central_idx];
+                        vec3<Scalar> pos(postype);
+                        quat<Scalar> orientation(h_orientation.data[central_idx]);
+                        rotmat3<Scalar> rotation(orientation);
+                        int3 img = h_image.data[central_idx];
 
-        // body type
-        unsigned int type = __scalar_as_int(postype.w);
+                        // body type
+                        unsigned int type = __scalar_as_int(postype.w);
 
-        unsigned int body_len = h_body_len.data[type];
-        unsigned int mol_idx = h_molecule_idx.data[particle_index];
-        // Checks if the number of local particle in a molecule denoted by
-        // h_molecule_len.data[particle_index] is equal to the number of particles in the rigid body
-        // definition `body_len`. If this is the case for a ghost particle this is fine, otherwise
-        // somehow we are in an invalid state for the body hence the inner condition.
-        if (body_len != h_molecule_len.data[mol_idx] - 1)
-            {
-            if (particle_index < m_pdata->getN())
-                {
-                // if the molecule is incomplete and has local members, this is an error
-                std::ostringstream error_msg;
-                error_msg << "Error while updating constituent particles:"
-                          << "Composite particle with body tag " << central_tag << " incomplete.";
-                throw std::runtime_error(error_msg.str());
-                }
+                        // Checks if the number of particles in the molecule is equal to the number
+                        // of particles in the rigid body definition. If this is not the case for
+                        // ghost particles this is fine, otherwise somehow we are in an invalid
+                        // state for the body.
+                        if (h_body_len.data[type] != mol_len - 1)
+                            {
+                            if (has_local_constituent)
+                                {
+                                // if the molecule is incomplete and has local members, this is an
+                                // error
+                                std::ostringstream error_msg;
+                                error_msg << "Error while updating constituent particles:"
+                                          << "Composite particle with body tag " << central_tag
+                                          << " incomplete.";
+                                throw std::runtime_error(error_msg.str());
+                                }
 
-            // otherwise we must ignore it
-            continue;
-            }
+                            // otherwise we must ignore it
+                            continue;
+                            }
 
-        int3 img = h_image.data[central_idx];
+                        for (unsigned int k = 1; k < mol_len; ++k)
+                            {
+                            unsigned int particle_index
+                                = h_molecule_list.data[molecule_indexer(k, ibody)];
+                            unsigned int idx_in_body = k - 1;
+
+                            vec3<Scalar> local_pos(
+                                h_body_pos.data[m_body_idx(type, idx_in_body)]);
+                            vec3<Scalar> dr_space = rotation * local_pos;
+
+                            // update position and orientation
+                            vec3<Scalar> updated_pos(pos);
+                            quat<Scalar> local_orientation(
+                                h_body_orientation.data[m_body_idx(type, idx_in_body)]);
+
+                            updated_pos += dr_space;
+                            quat<Scalar> updated_orientation = orientation * local_orientation;
+
+                            // this runs before the ForceComputes,
+                            // wrap into box, allowing rigid bodies to span multiple images
+                            int3 imgi = box.getImage(vec_to_scalar3(updated_pos));
+                            int3 negimgi = make_int3(-imgi.x, -imgi.y, -imgi.z);
+                            updated_pos = global_box.shift(updated_pos, negimgi);
+
+                            h_postype.data[particle_index]
+                                = make_scalar4(updated_pos.x,
+                                               updated_pos.y,
+                                               updated_pos.z,
+                                               h_postype.data[particle_index].w);
+                            h_orientation.data[particle_index]
+                                = quat_to_scalar4(updated_orientation);
+                            h_image.data[particle_index] = img + imgi;
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
+    }
 
-        // fetch relative index in body from molecule list
-        assert(h_molecule_order.data[particle_index] > 0);
-        unsigned int idx_in_body = h_molecule_order.data[particle_index] - 1;
+/*! \param num_iters Number of iterations to average for the benchmark
+    \returns Milliseconds of execution time per update
 
-        vec3<Scalar> local_pos(h_body_pos.data[m_body_idx(type, idx_in_body)]);
-        vec3<Scalar> dr_space = rotate(orientation, local_pos);
+    Calls updateCompositeParticles repeatedly to benchmark the constituent particle update.
+*/
+double ForceComposite::benchmarkUpdate(unsigned int num_iters)
+    {
+    ClockSource t;
+    // warm up run
+    updateCompositeParticles(0);
 
-        // update position and orientation
-        vec3<Scalar> updated_pos(pos);
-        quat<Scalar> local_orientation(h_body_orientation.data[m_body_idx(type, idx_in_body)]);
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipDeviceSynchronize();
+        CHECK_CUDA_ERROR();
+        }
+#endif
 
-        updated_pos += dr_space;
-        quat<Scalar> updated_orientation = orientation * local_orientation;
+    // benchmark
+    uint64_t start_time = t.getTime();
+    for (unsigned int i = 0; i < num_iters; i++)
+        updateCompositeParticles(0);
 
-        // this runs before the ForceComputes,
-        // wrap into box, allowing rigid bodies to span multiple images
-        int3 imgi = box.getImage(vec_to_scalar3(updated_pos));
-        int3 negimgi = make_int3(-imgi.x, -imgi.y, -imgi.z);
-        updated_pos = global_box.shift(updated_pos, negimgi);
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        hipDeviceSynchronize();
+#endif
+    uint64_t total_time_ns = t.getTime() - start_time;
 
-        h_postype.data[particle_index] = make_scalar4(updated_pos.x,
-                                                      updated_pos.y,
-                                                      updated_pos.z,
-                                                      h_postype.data[particle_index].w);
-        h_orientation.data[particle_index] = quat_to_scalar4(updated_orientation);
-        h_image.data[particle_index] = img + imgi;
-        }
+    // convert the run time to milliseconds
+    return double(total_time_ns) / 1e6 / double(num_iters);
     }
 
 void export_ForceComposite(py::module& m)
@@ -1053,5 +1132,6 @@ void export_ForceComposite(py::module& m)
         .def("getBody", &ForceComposite::getBody)
         .def("validateRigidBodies", &ForceComposite::validateRigidBodies)
         .def("createRigidBodies", &ForceComposite::createRigidBodies)
-        .def("updateCompositeParticles", &ForceComposite::updateCompositeParticles);
+        .def("updateCompositeParticles", &ForceComposite::updateCompositeParticles)
+        .def("benchmarkUpdate", &ForceComposite::benchmarkUpdate);
     }
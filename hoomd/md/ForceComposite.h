@@ -79,6 +79,9 @@ class PYBIND11_EXPORT ForceComposite : public MolecularForceCompute
     /// and orientation of the central particle.
     virtual void updateCompositeParticles(uint64_t timestep);
 
+    /// Benchmark updateCompositeParticles, returns milliseconds per update
+    double benchmarkUpdate(unsigned int num_iters);
+
     /// Validate rigid body constituent particles. The method purposely does not check
     /// positions or orientation.
     virtual void validateRigidBodies();
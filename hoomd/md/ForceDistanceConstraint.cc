@@ -5,7 +5,15 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <atomic>
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -19,7 +27,9 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0),
+      m_iterative(false), m_solver_tol(1e-8), m_max_iterations(1000), m_num_iterations(0),
+      m_num_unconverged(0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -105,19 +115,33 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
         throw std::runtime_error("Error computing constraints.\n");
         }
 
-    // reallocate through amortized resizin
-    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint * n_constraint);
-    m_cvec.resize(n_constraint);
+    if (m_iterative)
+        {
+        // populate the non-zero terms of the matrix vector equation
+        fillSparseSystem(timestep);
 
-    // populate the terms in the matrix vector equation
-    fillMatrixVector(timestep);
+        // check violations
+        checkConstraints(timestep);
 
-    // check violations
-    checkConstraints(timestep);
+        // solve the matrix vector equation
+        solveConstraintsIterative(timestep);
+        }
+    else
+        {
+        // reallocate through amortized resizin
+        unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+        m_cmatrix.resize(n_constraint * n_constraint);
+        m_cvec.resize(n_constraint);
+
+        // populate the terms in the matrix vector equation
+        fillMatrixVector(timestep);
 
-    // solve the matrix vector equation
-    solveConstraints(timestep);
+        // check violations
+        checkConstraints(timestep);
+
+        // solve the matrix vector equation
+        solveConstraints(timestep);
+        }
 
     // compute forces
     computeConstraintForces(timestep);
@@ -435,6 +459,484 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
         m_prof->pop();
     }
 
+/*! \param solver Name of the solver, "lu" or "iterative"
+ */
+void ForceDistanceConstraint::setSolver(const std::string& solver)
+    {
+    bool iterative;
+    if (solver == "lu")
+        {
+        iterative = false;
+        }
+    else if (solver == "iterative")
+        {
+        iterative = true;
+        }
+    else
+        {
+        throw std::invalid_argument("Invalid solver " + solver);
+        }
+
+    if (iterative != m_iterative)
+        {
+        m_iterative = iterative;
+
+        // the sparse LU solver keeps state from previous steps, rebuild it from scratch
+        m_constraint_reorder = true;
+        m_condition.resetFlags(1);
+        }
+    }
+
+std::string ForceDistanceConstraint::getSolver()
+    {
+    return m_iterative ? "iterative" : "lu";
+    }
+
+/*! Assembles the same linear system as fillMatrixVector(), but only stores the diagonal and the
+    couplings between constraints that share a particle, in compressed row format. Constraints that
+    form isolated dimers or triangles are flagged for the closed form solution.
+
+    \param timestep Current timestep
+*/
+void ForceDistanceConstraint::fillSparseSystem(uint64_t timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // access particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    m_cvec.resize(n_constraint);
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    std::vector<unsigned int> idx_a(n_constraint);
+    std::vector<unsigned int> idx_b(n_constraint);
+    std::vector<vec3<Scalar>> rn(n_constraint);
+    std::vector<vec3<Scalar>> qn(n_constraint);
+
+    m_ptl_constraint_start.assign(max_local + 1, 0);
+
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        // lookup the tag of each of the particles participating in the constraint
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        assert(constraint.tag[0] <= m_pdata->getMaximumTag());
+        assert(constraint.tag[1] <= m_pdata->getMaximumTag());
+
+        // transform a and b into indices into the particle data arrays
+        unsigned int a = h_rtag.data[constraint.tag[0]];
+        unsigned int b = h_rtag.data[constraint.tag[1]];
+
+        if (a >= max_local || b >= max_local)
+            {
+            this->m_exec_conf->msg->error()
+                << "constrain.distance(): constraint " << constraint.tag[0] << " "
+                << constraint.tag[1] << " incomplete." << std::endl
+                << std::endl;
+            throw std::runtime_error("Error in constraint calculation");
+            }
+
+        idx_a[n] = a;
+        idx_b[n] = b;
+        m_ptl_constraint_start[a + 1]++;
+        m_ptl_constraint_start[b + 1]++;
+
+        vec3<Scalar> ra(h_pos.data[a]);
+        vec3<Scalar> rb(h_pos.data[b]);
+
+        // apply minimum image
+        rn[n] = box.minImage(ra - rb);
+
+        vec3<Scalar> va(h_vel.data[a]);
+        Scalar ma(h_vel.data[a].w);
+        vec3<Scalar> vb(h_vel.data[b]);
+        Scalar mb(h_vel.data[b].w);
+
+        qn[n] = rn[n] + (va - vb) * m_deltaT;
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn[n], rn[n])) - d >= m_rel_tol * d || std::isnan(dot(rn[n], rn[n])))
+            {
+            m_constraint_violated.resetFlags(n + 1);
+            }
+
+        // fill vector component
+        h_cvec.data[n] = (dot(qn[n], qn[n]) - d * d) / m_deltaT / m_deltaT;
+        h_cvec.data[n]
+            += double(2.0)
+               * dot(qn[n],
+                     vec3<Scalar>(h_netforce.data[a]) / ma - vec3<Scalar>(h_netforce.data[b]) / mb);
+        }
+
+    // build the list of constraints per particle
+    for (unsigned int i = 0; i < max_local; ++i)
+        m_ptl_constraint_start[i + 1] += m_ptl_constraint_start[i];
+
+    m_ptl_constraint.resize(2 * n_constraint);
+    std::vector<unsigned int> ptl_count(m_ptl_constraint_start.begin(),
+                                        m_ptl_constraint_start.end() - 1);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        m_ptl_constraint[ptl_count[idx_a[n]]++] = n;
+        m_ptl_constraint[ptl_count[idx_b[n]]++] = n;
+        }
+
+    // every constraint couples to the other constraints of both of its particles
+    m_coupling_start.resize(n_constraint + 1);
+    m_coupling_start[0] = 0;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        unsigned int deg_a
+            = m_ptl_constraint_start[idx_a[n] + 1] - m_ptl_constraint_start[idx_a[n]];
+        unsigned int deg_b
+            = m_ptl_constraint_start[idx_b[n] + 1] - m_ptl_constraint_start[idx_b[n]];
+        m_coupling_start[n + 1] = m_coupling_start[n] + deg_a + deg_b - 2;
+        }
+
+    m_diag.resize(n_constraint);
+    m_closed_form.resize(n_constraint);
+    m_coupling_idx.resize(m_coupling_start[n_constraint]);
+    m_coupling_val.resize(m_coupling_start[n_constraint]);
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, n_constraint),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int n = r.begin(); n != r.end(); ++n)
+#else
+    for (unsigned int n = 0; n < n_constraint; ++n)
+#endif
+                        {
+                        unsigned int a = idx_a[n];
+                        unsigned int b = idx_b[n];
+                        Scalar ma(h_vel.data[a].w);
+                        Scalar mb(h_vel.data[b].w);
+                        unsigned int k = m_coupling_start[n];
+
+                        for (unsigned int j = m_ptl_constraint_start[a];
+                             j < m_ptl_constraint_start[a + 1];
+                             ++j)
+                            {
+                            unsigned int m = m_ptl_constraint[j];
+                            double qr = double(4.0) * dot(qn[n], rn[m]);
+
+                            double delta(0.0);
+                            if (idx_a[m] == a)
+                                delta += qr / ma;
+                            if (idx_b[m] == a)
+                                delta -= qr / ma;
+                            if (idx_a[m] == b)
+                                delta -= qr / mb;
+                            if (idx_b[m] == b)
+                                delta += qr / mb;
+
+                            if (m == n)
+                                {
+                                m_diag[n] = delta;
+                                }
+                            else
+                                {
+                                m_coupling_idx[k] = m;
+                                m_coupling_val[k++] = delta;
+                                }
+                            }
+
+                        for (unsigned int j = m_ptl_constraint_start[b];
+                             j < m_ptl_constraint_start[b + 1];
+                             ++j)
+                            {
+                            unsigned int m = m_ptl_constraint[j];
+                            if (m == n)
+                                continue;
+
+                            double delta(0.0);
+
+                            // constraints that also involve a have been accounted for above
+                            if (idx_a[m] != a && idx_b[m] != a)
+                                {
+                                double qr = double(4.0) * dot(qn[n], rn[m]);
+                                if (idx_a[m] == b)
+                                    delta -= qr / mb;
+                                if (idx_b[m] == b)
+                                    delta += qr / mb;
+                                }
+
+                            m_coupling_idx[k] = m;
+                            m_coupling_val[k++] = delta;
+                            }
+
+                        // detect isolated dimers and triangles (e.g. rigid water)
+                        unsigned int deg_a
+                            = m_ptl_constraint_start[a + 1] - m_ptl_constraint_start[a];
+                        unsigned int deg_b
+                            = m_ptl_constraint_start[b + 1] - m_ptl_constraint_start[b];
+                        m_closed_form[n] = ClosedForm::None;
+
+                        if (deg_a == 1 && deg_b == 1)
+                            {
+                            m_closed_form[n] = ClosedForm::Dimer;
+                            }
+                        else if (deg_a == 2 && deg_b == 2)
+                            {
+                            // the other constraints of a and b, in the order of the coupling list
+                            unsigned int p = m_coupling_idx[m_coupling_start[n]];
+                            unsigned int q = m_coupling_idx[m_coupling_start[n] + 1];
+                            unsigned int c_p = idx_a[p] == a ? idx_b[p] : idx_a[p];
+                            unsigned int c_q = idx_a[q] == b ? idx_b[q] : idx_a[q];
+
+                            if (c_p == c_q && c_p != a && c_p != b
+                                && m_ptl_constraint_start[c_p + 1] - m_ptl_constraint_start[c_p]
+                                       == 2)
+                                {
+                                m_closed_form[n] = ClosedForm::Triangle;
+                                }
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
+    }
+
+/*! Solves the equations of isolated dimers and triangles in closed form, and performs Jacobi
+    sweeps over the remaining constraints, starting from the Lagrange multipliers of the previous
+    step. The iteration stops when the largest residual drops below the solver tolerance times the
+    largest element of the right hand side.
+
+    \param timestep Current timestep
+*/
+void ForceDistanceConstraint::solveConstraintsIterative(uint64_t timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0)
+        return;
+
+    if (m_prof)
+        m_prof->push("solve");
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    ArrayHandle<unsigned int> h_group_tag(m_cdata->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+
+    // warm start from the previous solution, constraints may have been reordered or migrated
+    m_lagrange_by_tag.resize(m_cdata->getMaximumTag() + 1, 0.0);
+
+    m_general.clear();
+    double c_max(0.0);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        if (m_diag[n] == double(0.0))
+            {
+            m_exec_conf->msg->error()
+                << "Could not solve linear system of constraint equations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
+            }
+
+        if (m_closed_form[n] == ClosedForm::None)
+            {
+            m_general.push_back(n);
+            h_lagrange.data[n] = m_lagrange_by_tag[h_group_tag.data[n]];
+            c_max = std::max(c_max, fabs(h_cvec.data[n]));
+            }
+        }
+
+    // solve isolated dimers and triangles directly
+    std::atomic<bool> singular(false);
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, n_constraint),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int n = r.begin(); n != r.end(); ++n)
+#else
+    for (unsigned int n = 0; n < n_constraint; ++n)
+#endif
+                        {
+                        if (m_closed_form[n] == ClosedForm::Dimer)
+                            {
+                            h_lagrange.data[n] = h_cvec.data[n] / m_diag[n];
+                            }
+                        else if (m_closed_form[n] == ClosedForm::Triangle)
+                            {
+                            // the triangle is solved by its constraint with the lowest index
+                            unsigned int c[3];
+                            c[0] = n;
+                            c[1] = m_coupling_idx[m_coupling_start[n]];
+                            c[2] = m_coupling_idx[m_coupling_start[n] + 1];
+                            if (c[1] < n || c[2] < n)
+                                continue;
+
+                            // assemble the 3x3 system
+                            double A[3][3];
+                            double rhs[3];
+                            for (unsigned int i = 0; i < 3; ++i)
+                                {
+                                rhs[i] = h_cvec.data[c[i]];
+                                for (unsigned int j = 0; j < 3; ++j)
+                                    A[i][j] = i == j ? m_diag[c[i]] : 0.0;
+
+                                for (unsigned int k = m_coupling_start[c[i]];
+                                     k < m_coupling_start[c[i] + 1];
+                                     ++k)
+                                    {
+                                    for (unsigned int j = 0; j < 3; ++j)
+                                        {
+                                        if (m_coupling_idx[k] == c[j])
+                                            A[i][j] += m_coupling_val[k];
+                                        }
+                                    }
+                                }
+
+                            // invert using the cofactors
+                            double C[3][3];
+                            for (unsigned int i = 0; i < 3; ++i)
+                                {
+                                for (unsigned int j = 0; j < 3; ++j)
+                                    {
+                                    unsigned int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+                                    unsigned int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                                    C[i][j] = A[i1][j1] * A[i2][j2] - A[i1][j2] * A[i2][j1];
+                                    }
+                                }
+
+                            double det
+                                = A[0][0] * C[0][0] + A[0][1] * C[0][1] + A[0][2] * C[0][2];
+                            if (det == 0.0)
+                                {
+                                singular = true;
+                                continue;
+                                }
+
+                            for (unsigned int j = 0; j < 3; ++j)
+                                {
+                                double x = C[0][j] * rhs[0] + C[1][j] * rhs[1] + C[2][j] * rhs[2];
+                                h_lagrange.data[c[j]] = x / det;
+                                }
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
+
+    if (singular)
+        {
+        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations."
+                                  << std::endl;
+        throw std::runtime_error("Error evaluating constraint forces.\n");
+        }
+
+    if (c_max == double(0.0))
+        {
+        // the trivial solution
+        for (unsigned int n : m_general)
+            h_lagrange.data[n] = 0.0;
+        }
+
+    m_lagrange_old.resize(n_constraint);
+    double tol = double(m_solver_tol) * c_max;
+    bool converged = c_max == double(0.0);
+    m_num_iterations = 0;
+    unsigned int n_general = (unsigned int)m_general.size();
+
+    while (c_max != double(0.0) && m_num_iterations < m_max_iterations)
+        {
+        for (unsigned int n : m_general)
+            m_lagrange_old[n] = h_lagrange.data[n];
+        m_num_iterations++;
+
+        // one Jacobi sweep, which also yields the residual of the previous iterate
+        double residual(0.0);
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                residual = tbb::parallel_reduce(
+                    tbb::blocked_range<unsigned int>(0, n_general),
+                    0.0,
+                    [&](const tbb::blocked_range<unsigned int>& r, double res) -> double
+                    {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+#else
+        double& res = residual;
+        for (unsigned int i = 0; i < n_general; ++i)
+#endif
+                            {
+                            unsigned int n = m_general[i];
+                            double sum = h_cvec.data[n];
+                            for (unsigned int k = m_coupling_start[n]; k < m_coupling_start[n + 1];
+                                 ++k)
+                                {
+                                sum -= m_coupling_val[k] * m_lagrange_old[m_coupling_idx[k]];
+                                }
+
+                            res = std::max(res, fabs(sum - m_diag[n] * m_lagrange_old[n]));
+                            h_lagrange.data[n] = sum / m_diag[n];
+                            }
+#ifdef ENABLE_TBB
+                        return res;
+                    },
+                    [](double x, double y) -> double { return std::max(x, y); });
+            });
+#endif
+
+        if (!std::isfinite(residual))
+            {
+            m_exec_conf->msg->error()
+                << "Could not solve linear system of constraint equations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
+            }
+
+        if (residual <= tol)
+            {
+            converged = true;
+            break;
+            }
+        }
+
+    if (!converged)
+        {
+        if (m_num_unconverged == 0)
+            {
+            m_exec_conf->msg->warning()
+                << "constrain.distance(): iterative solver did not converge within "
+                << m_max_iterations << " iterations." << std::endl;
+            }
+        m_num_unconverged++;
+        }
+
+    // store the solution for the next step
+    for (unsigned int n : m_general)
+        m_lagrange_by_tag[h_group_tag.data[n]] = h_lagrange.data[n];
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(uint64_t timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -666,5 +1168,19 @@ void export_ForceDistanceConstraint(py::module& m)
                MolecularForceCompute,
                std::shared_ptr<ForceDistanceConstraint>>(m, "ForceDistanceConstraint")
         .def(py::init<std::shared_ptr<SystemDefinition>>())
-        .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance);
+        .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("tolerance",
+                      &ForceDistanceConstraint::getRelativeTolerance,
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver)
+        .def_property("solver_tolerance",
+                      &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance)
+        .def_property("max_iterations",
+                      &ForceDistanceConstraint::getMaxIterations,
+                      &ForceDistanceConstraint::setMaxIterations)
+        .def_property_readonly("num_iterations", &ForceDistanceConstraint::getNumIterations)
+        .def_property_readonly("num_unconverged", &ForceDistanceConstraint::getNumUnconverged);
     }
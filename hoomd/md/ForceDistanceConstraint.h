@@ -24,6 +24,9 @@
 #include <Eigen/Dense>
 #include <Eigen/SparseLU>
 
+#include <string>
+#include <vector>
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for
@@ -31,6 +34,14 @@
    M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics
    Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    By default, the linear system of equations for the Lagrange multipliers is solved with a sparse
+    LU factorization. Alternatively, the system can be solved iteratively with Jacobi sweeps that
+    are warm-started from the multipliers of the previous step, in the spirit of SHAKE and the
+    matrix expansion of LINCS. The iterative solver only assembles the non-zero couplings between
+    constraints that share a particle and parallelizes over constraints. Constraints of isolated
+    dimers and triangles (such as rigid 3-site water) are not coupled to any other constraint, the
+    iterative solver solves their equations in closed form per molecule.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -55,6 +66,58 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         m_rel_tol = rel_tol;
         }
 
+    //! Get the relative tolerance for constraint warnings
+    Scalar getRelativeTolerance()
+        {
+        return m_rel_tol;
+        }
+
+    //! Set the solver for the constraint equations ("lu" or "iterative")
+    void setSolver(const std::string& solver);
+
+    //! Get the solver for the constraint equations
+    std::string getSolver();
+
+    //! Set the relative residual at which the iterative solver stops
+    void setSolverTolerance(Scalar solver_tol)
+        {
+        if (solver_tol <= Scalar(0.0))
+            throw std::domain_error("solver_tolerance must be positive");
+        m_solver_tol = solver_tol;
+        }
+
+    //! Get the relative residual at which the iterative solver stops
+    Scalar getSolverTolerance()
+        {
+        return m_solver_tol;
+        }
+
+    //! Set the maximum number of sweeps of the iterative solver
+    void setMaxIterations(unsigned int max_iterations)
+        {
+        if (max_iterations == 0)
+            throw std::domain_error("max_iterations must be positive");
+        m_max_iterations = max_iterations;
+        }
+
+    //! Get the maximum number of sweeps of the iterative solver
+    unsigned int getMaxIterations()
+        {
+        return m_max_iterations;
+        }
+
+    //! Get the number of sweeps the iterative solver performed in the last step
+    unsigned int getNumIterations()
+        {
+        return m_num_iterations;
+        }
+
+    //! Get the number of steps in which the iterative solver did not converge
+    uint64_t getNumUnconverged()
+        {
+        return m_num_unconverged;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -87,6 +150,32 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
 
     Scalar m_d_max; //!< Maximum constraint extension
 
+    bool m_iterative;              //!< True if the iterative solver is used
+    Scalar m_solver_tol;           //!< Relative residual at which the iterative solver stops
+    unsigned int m_max_iterations; //!< Maximum number of sweeps of the iterative solver
+    unsigned int m_num_iterations; //!< Number of sweeps performed in the last step
+    uint64_t m_num_unconverged;    //!< Number of steps without convergence
+
+    std::vector<double> m_diag;                 //!< Diagonal elements of the constraint matrix
+    std::vector<unsigned int> m_coupling_start; //!< Start of each row in the coupling list
+    std::vector<unsigned int> m_coupling_idx;   //!< Column indices of the off-diagonal elements
+    std::vector<double> m_coupling_val;         //!< Values of the off-diagonal elements
+    std::vector<unsigned int> m_ptl_constraint_start; //!< Start of each particle's constraint list
+    std::vector<unsigned int> m_ptl_constraint;       //!< Constraints involving each particle
+    std::vector<double> m_lagrange_old;    //!< Lagrange multipliers of the last sweep
+    std::vector<double> m_lagrange_by_tag; //!< Multipliers of the previous step, indexed by tag
+
+    //! Constraints whose equations are solved in closed form
+    enum class ClosedForm : unsigned char
+        {
+        None,    //!< Coupled to an arbitrary number of constraints, solved iteratively
+        Dimer,   //!< Not coupled to other constraints
+        Triangle //!< Part of an isolated triangle of three constraints (e.g. rigid water)
+        };
+
+    std::vector<ClosedForm> m_closed_form; //!< Closed form solution type per constraint
+    std::vector<unsigned int> m_general;   //!< Constraints that are solved iteratively
+
     //! Compute the forces
     virtual void computeForces(uint64_t timestep);
 
@@ -102,6 +191,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     //! Solve the linear matrix-vector equation
     virtual void computeConstraintForces(uint64_t timestep);
 
+    //! Populate the sparse constraint-force equation for the iterative solver
+    void fillSparseSystem(uint64_t timestep);
+
+    //! Solve the sparse constraint-force equation iteratively
+    void solveConstraintsIterative(uint64_t timestep);
+
     //! Method called when constraint order changes
     virtual void slotConstraintReorder()
         {
@@ -0,0 +1,102 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "FusedBondedForceCompute.h"
+
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file FusedBondedForceCompute.cc
+    \brief Contains code for the FusedBondedForceCompute class
+*/
+
+/*! \param sysdef System to compute forces on
+ */
+FusedBondedForceCompute::FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef)
+    : ForceCompute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FusedBondedForceCompute" << endl;
+    }
+
+FusedBondedForceCompute::~FusedBondedForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FusedBondedForceCompute" << endl;
+    }
+
+/*! \param force Bonded force compute to add
+
+    \a force must support accumulation and operate on the same system definition.
+*/
+void FusedBondedForceCompute::addForce(std::shared_ptr<ForceCompute> force)
+    {
+    if (!force->supportsAccumulation())
+        {
+        m_exec_conf->msg->error() << "FusedBonded: force does not support fused evaluation" << endl;
+        throw invalid_argument("Error adding force to FusedBondedForceCompute");
+        }
+
+    force->setProfiler(m_prof);
+    m_forces.push_back(force);
+    }
+
+/*! \param prof Profiler to use
+ */
+void FusedBondedForceCompute::setProfiler(std::shared_ptr<Profiler> prof)
+    {
+    ForceCompute::setProfiler(prof);
+    for (auto& force : m_forces)
+        force->setProfiler(prof);
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags FusedBondedForceCompute::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = ForceCompute::getRequestedCommFlags(timestep);
+    for (auto& force : m_forces)
+        flags |= force->getRequestedCommFlags(timestep);
+    return flags;
+    }
+#endif
+
+/*! Zeroes the force and virial arrays once and adds the forces of every term to them
+    \param timestep Current time step
+ */
+void FusedBondedForceCompute::computeForces(uint64_t timestep)
+    {
+    // some terms leave their energy out, so the sum of all terms is not valid either
+    m_energy_skipped = m_pdata->getFlags()[pdata_flag::skip_potential_energy];
+    zeroForces();
+    accumulateForces(timestep, m_force, m_virial);
+    }
+
+/*! \param timestep Current time step
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+ */
+void FusedBondedForceCompute::accumulateForces(uint64_t timestep,
+                                               const GlobalArray<Scalar4>& force,
+                                               const GlobalArray<Scalar>& virial)
+    {
+    if (m_prof)
+        m_prof->push("Fused bonded");
+
+    for (auto& term : m_forces)
+        term->accumulateForces(timestep, force, virial);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_FusedBondedForceCompute(py::module& m)
+    {
+    py::class_<FusedBondedForceCompute, ForceCompute, std::shared_ptr<FusedBondedForceCompute>>(
+        m,
+        "FusedBondedForceCompute")
+        .def(py::init<std::shared_ptr<SystemDefinition>>())
+        .def("addForce", &FusedBondedForceCompute::addForce)
+        .def("clearForces", &FusedBondedForceCompute::clearForces);
+    }
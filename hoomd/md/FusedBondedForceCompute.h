@@ -0,0 +1,83 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file FusedBondedForceCompute.h
+    \brief Declares FusedBondedForceCompute
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTE_H__
+#define __FUSEDBONDEDFORCECOMPUTE_H__
+
+//! Evaluates several bonded force computes into a single set of force arrays
+/*! A molecular system typically attaches a bond, an angle, and a dihedral force to the integrator.
+    Each of them zeroes its own per-particle force and virial arrays every step, and
+    Integrator::computeNetForce() reads every one of them back to form the net force.
+
+    FusedBondedForceCompute owns the bonded force computes (the terms) instead. It zeroes its
+    m_force and m_virial arrays once and has each term add its forces to them with
+    ForceCompute::accumulateForces(), so the integrator sums one array for all bonded interactions.
+    The terms keep their own arrays, which are only filled when a term is computed on its own (e.g.
+    to log its energy). FusedBondedForceCompute itself supports accumulation, in which case the
+    terms add their forces directly to the net force.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceCompute : public ForceCompute
+    {
+    public:
+    //! Constructs the compute
+    FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Destructor
+    virtual ~FusedBondedForceCompute();
+
+    //! Add a bonded force compute
+    void addForce(std::shared_ptr<ForceCompute> force);
+
+    //! Remove all bonded force computes
+    void clearForces()
+        {
+        m_forces.clear();
+        }
+
+    //! This compute supports accumulation
+    virtual bool supportsAccumulation()
+        {
+        return true;
+        }
+
+    //! Add the forces of all terms to the given arrays
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial);
+
+    //! Set the profiler used by this compute and its terms
+    virtual void setProfiler(std::shared_ptr<Profiler> prof);
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by the terms
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+
+    protected:
+    std::vector<std::shared_ptr<ForceCompute>> m_forces; //!< The bonded force computes
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+    };
+
+//! Exports the FusedBondedForceCompute class to python
+void export_FusedBondedForceCompute(pybind11::module& m);
+
+#endif
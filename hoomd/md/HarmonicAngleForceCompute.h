@@ -73,6 +73,17 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
     /// Get the parameters for a type
     pybind11::dict getParams(std::string type);
 
+    //! Add the forces of all local groups to the given arrays
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial);
+
+    //! This compute supports accumulation
+    virtual bool supportsAccumulation()
+        {
+        return true;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
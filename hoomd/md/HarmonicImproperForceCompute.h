@@ -41,6 +41,17 @@ class PYBIND11_EXPORT HarmonicImproperForceCompute : public ForceCompute
     //! Set the parameters
     virtual void setParams(unsigned int type, Scalar K, Scalar chi);
 
+    //! Add the forces of all local groups to the given arrays
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial);
+
+    //! This compute supports accumulation
+    virtual bool supportsAccumulation()
+        {
+        return true;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -12,8 +12,10 @@
 #include "MolecularForceCompute.cuh"
 #endif
 
-#include <map>
+#include <algorithm>
 #include <string.h>
+#include <utility>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -287,15 +289,10 @@ void MolecularForceCompute::initMolecules()
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-    std::set<unsigned int> local_molecule_tags;
-
-    unsigned int n_local_molecules = 0;
-
-    std::vector<unsigned int> local_molecule_idx(nptl_local, NO_MOLECULE);
-
-    // keep track of particle with lowest tag within a molecule. This is assumed/required to be the
-    // central particle for the molecule.
-    std::map<unsigned int, unsigned int> lowest_tag_by_molecule;
+    // collect the (molecule tag, particle tag) pairs of all local and ghost molecule members and
+    // sort them, so that members of a molecule are contiguous and ordered by particle tag
+    std::vector<std::pair<unsigned int, unsigned int>> members;
+    members.reserve(nptl_local);
 
     for (unsigned int particle_index = 0; particle_index < nptl_local; ++particle_index)
         {
@@ -308,83 +305,47 @@ void MolecularForceCompute::initMolecules()
             continue;
             }
 
-        auto it = lowest_tag_by_molecule.find(mol_tag);
-        unsigned int min_tag = tag;
-        if (it != lowest_tag_by_molecule.end())
-            {
-            min_tag = std::min(it->second, tag);
-            }
-
-        lowest_tag_by_molecule[mol_tag] = min_tag;
+        members.push_back(std::make_pair(mol_tag, tag));
         }
 
-    // sort local molecules by the index of the smallest particle tag in a molecule, and sort within
-    // the molecule by particle tag.
-    std::map<unsigned int, std::set<unsigned int>> local_molecules_sorted;
+    std::sort(members.begin(), members.end());
 
-    for (unsigned int particle_index = 0; particle_index < nptl_local; ++particle_index)
+    // find the first member of every molecule. The first member has the lowest tag, which is
+    // assumed/required to be the central particle of the molecule.
+    std::vector<unsigned int> molecule_start;
+    for (unsigned int i = 0; i < members.size(); ++i)
         {
-        unsigned int tag = h_tag.data[particle_index];
-        assert(tag < m_molecule_tag.getNumElements());
-
-        unsigned int mol_tag = h_molecule_tag.data[tag];
-        if (mol_tag == NO_MOLECULE)
+        if (i == 0 || members[i].first != members[i - 1].first)
             {
-            continue;
+            molecule_start.push_back(i);
             }
-
-        unsigned int lowest_tag = lowest_tag_by_molecule[mol_tag];
-        unsigned int lowest_idx = h_rtag.data[lowest_tag];
-        assert(lowest_idx < m_pdata->getN() + m_pdata->getNGhosts());
-
-        local_molecules_sorted[lowest_idx].insert(tag);
         }
 
-    n_local_molecules = static_cast<unsigned int>(local_molecules_sorted.size());
+    unsigned int n_local_molecules = static_cast<unsigned int>(molecule_start.size());
+    molecule_start.push_back(static_cast<unsigned int>(members.size()));
 
-    m_exec_conf->msg->notice(7) << "MolecularForceCompute: " << n_local_molecules << " molecules"
-                                << std::endl;
-
-    m_molecule_length.resize(n_local_molecules);
-
-    ArrayHandle<unsigned int> h_molecule_length(m_molecule_length,
-                                                access_location::host,
-                                                access_mode::overwrite);
-
-    // reset lengths
-    for (unsigned int imol = 0; imol < n_local_molecules; ++imol)
+    // sort local molecules by the index of the particle with the smallest tag in the molecule
+    std::vector<std::pair<unsigned int, unsigned int>> lowest_idx_by_molecule(n_local_molecules);
+    unsigned nmax = 0;
+    for (unsigned int i = 0; i < n_local_molecules; ++i)
         {
-        h_molecule_length.data[imol] = 0;
+        unsigned int lowest_idx = h_rtag.data[members[molecule_start[i]].second];
+        assert(lowest_idx < m_pdata->getN() + m_pdata->getNGhosts());
+        lowest_idx_by_molecule[i] = std::make_pair(lowest_idx, i);
+        nmax = std::max(nmax, molecule_start[i + 1] - molecule_start[i]);
         }
 
-    // count molecule lengths
-    unsigned int i = 0;
-    for (auto it = local_molecules_sorted.begin(); it != local_molecules_sorted.end(); ++it)
-        {
-        h_molecule_length.data[i++] = (unsigned int)it->second.size();
-        }
+    std::sort(lowest_idx_by_molecule.begin(), lowest_idx_by_molecule.end());
 
-    // find maximum length
-    unsigned nmax = 0;
-    for (unsigned int imol = 0; imol < n_local_molecules; ++imol)
-        {
-        if (h_molecule_length.data[imol] > nmax)
-            {
-            nmax = h_molecule_length.data[imol];
-            }
-        }
+    m_exec_conf->msg->notice(7) << "MolecularForceCompute: " << n_local_molecules << " molecules"
+                                << std::endl;
 
     // set up indexer
     m_molecule_indexer = Index2D(nmax, n_local_molecules);
 
-    // resize molecule list
+    // resize molecule list and lengths
     m_molecule_list.resize(m_molecule_indexer.getNumElements());
-
-    // reset lengths again
-    for (unsigned int imol = 0; imol < n_local_molecules; ++imol)
-        {
-        h_molecule_length.data[imol] = 0;
-        }
+    m_molecule_length.resize(n_local_molecules);
 
     // resize and reset molecule lookup to size of local particle data
     m_molecule_order.resize(m_pdata->getMaxN());
@@ -399,6 +360,9 @@ void MolecularForceCompute::initMolecules()
     m_molecule_idx.resize(nptl_local);
 
     // fill molecule list
+    ArrayHandle<unsigned int> h_molecule_length(m_molecule_length,
+                                                access_location::host,
+                                                access_mode::overwrite);
     ArrayHandle<unsigned int> h_molecule_list(m_molecule_list,
                                               access_location::host,
                                               access_mode::overwrite);
@@ -409,27 +373,23 @@ void MolecularForceCompute::initMolecules()
     // reset reverse lookup
     memset(h_molecule_idx.data, 0, sizeof(unsigned int) * nptl_local);
 
-    unsigned int i_mol = 0;
-    for (auto it_mol = local_molecules_sorted.begin(); it_mol != local_molecules_sorted.end();
-         ++it_mol)
+    for (unsigned int i_mol = 0; i_mol < n_local_molecules; ++i_mol)
         {
-        // Since the set is ordered by value, and this orders the particles within the molecule by
-        // tag, and types should have been validated by validateRigidBodies, then this ordering in
-        // h_molecule_order should preserve types even though it is indexed by particle index.
-        for (std::set<unsigned int>::iterator it_tag = it_mol->second.begin();
-             it_tag != it_mol->second.end();
-             ++it_tag)
+        // Members are ordered by tag, and types should have been validated by
+        // validateRigidBodies, so this ordering in h_molecule_order preserves types even though it
+        // is indexed by particle index.
+        unsigned int i = lowest_idx_by_molecule[i_mol].second;
+        unsigned int n_members = molecule_start[i + 1] - molecule_start[i];
+        h_molecule_length.data[i_mol] = n_members;
+
+        for (unsigned int n = 0; n < n_members; ++n)
             {
-            unsigned int particle_index = h_rtag.data[*it_tag];
+            unsigned int particle_index = h_rtag.data[members[molecule_start[i] + n].second];
             assert(particle_index < m_pdata->getN() + m_pdata->getNGhosts());
-            // Gets the current molecule index for the particle while incrementing the length of the
-            // molecule.
-            unsigned int n = h_molecule_length.data[i_mol]++;
             h_molecule_list.data[m_molecule_indexer(n, i_mol)] = particle_index;
             h_molecule_idx.data[particle_index] = i_mol;
             h_molecule_order.data[particle_index] = n;
             }
-        i_mol++;
         }
 
     if (m_prof)
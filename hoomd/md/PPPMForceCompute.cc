@@ -87,6 +87,13 @@ void PPPMForceCompute::setParams(unsigned int nx,
         {
         const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
 
+        if (m_pdata->getDomainDecomposition()->isRCB())
+            {
+            m_exec_conf->msg->error()
+                << "charge.pppm: recursive coordinate bisection is not supported" << std::endl;
+            throw std::runtime_error("Error initializing charge.pppm");
+            }
+
         if (!is_pow2(m_mesh_points.x) || !is_pow2(m_mesh_points.y) || !is_pow2(m_mesh_points.z))
             {
             m_exec_conf->msg->error()
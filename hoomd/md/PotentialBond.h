@@ -46,6 +46,17 @@ template<class evaluator> class PotentialBond : public ForceCompute
     /// Validate bond type
     virtual void validateType(unsigned int type, std::string action);
 
+    //! Add the forces of all local bonds to the given arrays
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial);
+
+    //! This compute supports accumulation
+    virtual bool supportsAccumulation()
+        {
+        return true;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -58,6 +69,10 @@ template<class evaluator> class PotentialBond : public ForceCompute
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Add the bond forces to the given arrays, optionally with energies and virials
+    template<bool compute_energy, bool compute_virial>
+    void accumulateBondForces(const GlobalArray<Scalar4>& force, const GlobalArray<Scalar>& virial);
     };
 
 /*! \param sysdef System to compute forces on
@@ -142,9 +157,50 @@ template<class evaluator> pybind11::dict PotentialBond<evaluator>::getParams(std
  */
 template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t timestep)
     {
+    zeroForces();
+    accumulateForces(timestep, m_force, m_virial);
+    m_energy_skipped = m_pdata->getFlags()[pdata_flag::skip_potential_energy];
+    }
+
+/*! \param timestep Current time step
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+ */
+template<class evaluator>
+void PotentialBond<evaluator>::accumulateForces(uint64_t timestep,
+                                                const GlobalArray<Scalar4>& force,
+                                                const GlobalArray<Scalar>& virial)
+    {
     if (m_prof)
         m_prof->push(m_prof_name);
 
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_energy = !flags[pdata_flag::skip_potential_energy];
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    if (compute_energy && compute_virial)
+        accumulateBondForces<true, true>(force, virial);
+    else if (compute_energy)
+        accumulateBondForces<true, false>(force, virial);
+    else if (compute_virial)
+        accumulateBondForces<false, true>(force, virial);
+    else
+        accumulateBondForces<false, false>(force, virial);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \tparam compute_energy Set to true to add the bond energy to the force array
+    \tparam compute_virial Set to true to add the virial to the virial array
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+ */
+template<class evaluator>
+template<bool compute_energy, bool compute_virial>
+void PotentialBond<evaluator>::accumulateBondForces(const GlobalArray<Scalar4>& force,
+                                                    const GlobalArray<Scalar>& virial)
+    {
     assert(m_pdata);
 
     // access the particle data arrays
@@ -155,8 +211,9 @@ template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t
                                    access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    size_t virial_pitch = virial.getPitch();
 
     // access the parameters
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
@@ -168,22 +225,11 @@ template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t
     assert(h_diameter.data);
     assert(h_charge.data);
 
-    // Zero data for force calculation
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
     // we are using the minimum image of the global box here
     // to ensure that ghosts are always correctly wrapped (even if a bond exceeds half the domain
     // length)
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i < 6; i++)
-        bond_virial[i] = Scalar(0.0);
-
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(),
                                                       access_location::host,
                                                       access_mode::read);
@@ -194,123 +240,124 @@ template<class evaluator> void PotentialBond<evaluator>::computeForces(uint64_t
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
 
     // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-
-    for (unsigned int i = 0; i < size; i++)
+    m_bond_data->forEachLocalGroup(
+        [&](unsigned int i)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond " << bond.tag[0] << " " << bond.tag[1]
-                << " incomplete." << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-
-        // calculate d\vec{r}
-        // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
-
-        Scalar3 dx = posb - posa;
-
-        // access diameter (if needed)
-        Scalar diameter_a = Scalar(0.0);
-        Scalar diameter_b = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            {
-            diameter_a = h_diameter.data[idx_a];
-            diameter_b = h_diameter.data[idx_b];
-            }
-
-        // access charge (if needed)
-        Scalar charge_a = Scalar(0.0);
-        Scalar charge_b = Scalar(0.0);
-        if (evaluator::needsCharge())
-            {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
-            }
-
-        // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
-
-        // calculate r_ab squared
-        Scalar rsq = dot(dx, dx);
-
-        // compute the force and potential energy
-        Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
-        evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
-        if (evaluator::needsDiameter())
-            eval.setDiameter(diameter_a, diameter_b);
-        if (evaluator::needsCharge())
-            eval.setCharge(charge_a, charge_b);
-
-        bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
-
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
-
-        if (evaluated)
-            {
-            // calculate virial
-            if (compute_virial)
+            // lookup the tag of each of the particles participating in the bond
+            const typename BondData::members_t& bond = h_bonds.data[i];
+            assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
+            assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
+
+            // transform a and b into indices into the particle data arrays
+            // (MEM TRANSFER: 4 integers)
+            unsigned int idx_a = h_rtag.data[bond.tag[0]];
+            unsigned int idx_b = h_rtag.data[bond.tag[1]];
+
+            // throw an error if this bond is incomplete
+            if (idx_a >= max_local || idx_b >= max_local)
                 {
-                Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond " << bond.tag[0] << " "
+                    << bond.tag[1] << " incomplete." << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
                 }
 
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
+            // calculate d\vec{r}
+            // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
+            Scalar3 posa
+                = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+            Scalar3 posb
+                = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+
+            Scalar3 dx = posb - posa;
+
+            // access diameter (if needed)
+            Scalar diameter_a = Scalar(0.0);
+            Scalar diameter_b = Scalar(0.0);
+            if (evaluator::needsDiameter())
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_b] += bond_virial[i];
+                diameter_a = h_diameter.data[idx_a];
+                diameter_b = h_diameter.data[idx_b];
                 }
 
-            if (idx_a < m_pdata->getN())
+            // access charge (if needed)
+            Scalar charge_a = Scalar(0.0);
+            Scalar charge_b = Scalar(0.0);
+            if (evaluator::needsCharge())
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_a] += bond_virial[i];
+                charge_a = h_charge.data[idx_a];
+                charge_b = h_charge.data[idx_b];
                 }
-            }
-        else
-            {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-        }
 
-    if (m_prof)
-        m_prof->pop();
+            // if the vector crosses the box, pull it back
+            dx = box.minImage(dx);
+
+            // calculate r_ab squared
+            Scalar rsq = dot(dx, dx);
+
+            // compute the force and potential energy
+            Scalar force_divr = Scalar(0.0);
+            Scalar bond_eng = Scalar(0.0);
+            evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
+            if (evaluator::needsDiameter())
+                eval.setDiameter(diameter_a, diameter_b);
+            if (evaluator::needsCharge())
+                eval.setCharge(charge_a, charge_b);
+
+            bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
+
+            // Bond energy must be halved
+            bond_eng *= Scalar(0.5);
+
+            if (evaluated)
+                {
+                // calculate virial
+                Scalar bond_virial[6];
+                if (compute_virial)
+                    {
+                    Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
+                    bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+                    bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+                    bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+                    bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+                    bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+                    bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+                    }
+
+                // add the force to the particles (only for non-ghost particles)
+                if (idx_b < m_pdata->getN())
+                    {
+                    h_force.data[idx_b].x += force_divr * dx.x;
+                    h_force.data[idx_b].y += force_divr * dx.y;
+                    h_force.data[idx_b].z += force_divr * dx.z;
+                    if (compute_energy)
+                        h_force.data[idx_b].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            h_virial.data[i * virial_pitch + idx_b] += bond_virial[i];
+                    }
+
+                if (idx_a < m_pdata->getN())
+                    {
+                    h_force.data[idx_a].x -= force_divr * dx.x;
+                    h_force.data[idx_a].y -= force_divr * dx.y;
+                    h_force.data[idx_a].z -= force_divr * dx.z;
+                    if (compute_energy)
+                        h_force.data[idx_a].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            h_virial.data[i * virial_pitch + idx_a] += bond_virial[i];
+                    }
+                }
+            else
+                {
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
+                }
+        });
     }
 
 #ifdef ENABLE_MPI
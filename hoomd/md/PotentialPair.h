@@ -6,6 +6,7 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <pybind11/numpy.h>
@@ -28,6 +29,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -182,6 +189,17 @@ template<class evaluator> class PotentialPair : public ForceCompute
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
 #endif
 
+    //! This compute supports accumulation
+    virtual bool supportsAccumulation()
+        {
+        return true;
+        }
+
+    //! Add the pair forces to the given arrays
+    virtual void accumulateForces(uint64_t timestep,
+                                  const GlobalArray<Scalar4>& force,
+                                  const GlobalArray<Scalar>& virial);
+
     //! Calculates the energy between two lists of particles.
     template<class InputIterator>
     void computeEnergyBetweenSets(InputIterator first1,
@@ -224,6 +242,10 @@ template<class evaluator> class PotentialPair : public ForceCompute
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Add the pair forces to the given arrays, optionally with energies and virials
+    template<bool compute_energy, bool compute_virial>
+    void accumulatePairForces(const GlobalArray<Scalar4>& force, const GlobalArray<Scalar>& virial);
+
     //! Method to be called when number of types changes
     virtual void slotNumTypesChange()
         {
@@ -557,13 +579,28 @@ int PotentialPair<evaluator>::slotWriteGSDShapeSpec(gsd_handle& handle) const
     return retval;
     }
 
-/*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is
-   called to ensure that it is up to date before proceeding.
+/*! \post The pair forces are computed for the given timestep.
 
     \param timestep specifies the current time step of the simulation
 */
 template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t timestep)
     {
+    zeroForces();
+    accumulateForces(timestep, m_force, m_virial);
+    m_energy_skipped = m_pdata->getFlags()[pdata_flag::skip_potential_energy];
+    }
+
+/*! The neighborlist's compute method is called to ensure that it is up to date before proceeding.
+
+    \param timestep specifies the current time step of the simulation
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::accumulateForces(uint64_t timestep,
+                                                const GlobalArray<Scalar4>& force,
+                                                const GlobalArray<Scalar>& virial)
+    {
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -571,6 +608,36 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     if (m_prof)
         m_prof->push(m_prof_name);
 
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_energy = !flags[pdata_flag::skip_potential_energy];
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    if (compute_energy && compute_virial)
+        accumulatePairForces<true, true>(force, virial);
+    else if (compute_energy)
+        accumulatePairForces<true, false>(force, virial);
+    else if (compute_virial)
+        accumulatePairForces<false, true>(force, virial);
+    else
+        accumulatePairForces<false, false>(force, virial);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \tparam compute_energy Set to true to add the potential energy to the force array
+    \tparam compute_virial Set to true to add the virial to the virial array
+    \param force Per-particle force and energy array to add to
+    \param virial Per-particle virial array to add to
+
+    The evaluator is inlined into this loop. When \a compute_energy is false, the pair energy it
+    returns is unused and the compiler removes the energy math from the specialization.
+*/
+template<class evaluator>
+template<bool compute_energy, bool compute_virial>
+void PotentialPair<evaluator>::accumulatePairForces(const GlobalArray<Scalar4>& force,
+                                                    const GlobalArray<Scalar>& virial)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -594,198 +661,228 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // force arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    const size_t virial_pitch = virial.getPitch();
 
     const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    // With a full neighbor list, every particle only writes its own force and the particles are
+    // processed by the threads in parallel. With a half neighbor list, the forces are also added
+    // to the neighbors, so a single range that cannot be split keeps the loop serial. The static
+    // partition gives every thread the block of particles whose memory it placed with the
+    // first_touch memory policy.
+    const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+    const unsigned int grain_size = third_law ? std::max(N, 1u) : 1u;
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
-            {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, N, grain_size),
+                [&](const tbb::blocked_range<unsigned int>& r)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-            if (evaluated)
-                {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx * force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
-                    {
-                    virialxxi += force_div2r * dx.x * dx.x;
-                    virialxyi += force_div2r * dx.x * dx.y;
-                    virialxzi += force_div2r * dx.x * dx.z;
-                    virialyyi += force_div2r * dx.y * dx.y;
-                    virialyzi += force_div2r * dx.y * dx.z;
-                    virialzzi += force_div2r * dx.z * dx.z;
-                    }
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
-                    {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
+                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+#else
+    for (unsigned int i = 0; i < N; i++)
+#endif
                         {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+                        Scalar3 pi
+                            = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+
+                        // sanity check
+                        assert(typei < m_pdata->getNTypes());
+
+                        // access diameter and charge (if needed)
+                        Scalar di = Scalar(0.0);
+                        Scalar qi = Scalar(0.0);
+                        if (evaluator::needsDiameter())
+                            di = h_diameter.data[i];
+                        if (evaluator::needsCharge())
+                            qi = h_charge.data[i];
+
+                        // initialize current particle force, potential energy, and virial to 0
+                        Scalar3 fi = make_scalar3(0, 0, 0);
+                        Scalar pei = 0.0;
+                        Scalar virialxxi = 0.0;
+                        Scalar virialxyi = 0.0;
+                        Scalar virialxzi = 0.0;
+                        Scalar virialyyi = 0.0;
+                        Scalar virialyzi = 0.0;
+                        Scalar virialzzi = 0.0;
+
+                        // loop over all of the neighbors of this particle
+                        const unsigned int myHead = h_head_list.data[i];
+                        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                        for (unsigned int k = 0; k < size; k++)
+                            {
+                            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                            unsigned int j = h_nlist.data[myHead + k];
+                            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                            Scalar3 pj
+                                = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                            Scalar3 dx = pi - pj;
+
+                            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                            assert(typej < m_pdata->getNTypes());
+
+                            // access diameter and charge (if needed)
+                            Scalar dj = Scalar(0.0);
+                            Scalar qj = Scalar(0.0);
+                            if (evaluator::needsDiameter())
+                                dj = h_diameter.data[j];
+                            if (evaluator::needsCharge())
+                                qj = h_charge.data[j];
+
+                            // apply periodic boundary conditions
+                            dx = box.minImage(dx);
+
+                            // calculate r_ij squared (FLOPS: 5)
+                            Scalar rsq = dot(dx, dx);
+
+                            // get parameters for this type pair
+                            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                            param_type param = h_params.data[typpair_idx];
+                            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                            Scalar ronsq = Scalar(0.0);
+                            if (m_shift_mode == xplor)
+                                ronsq = h_ronsq.data[typpair_idx];
+
+                            // design specifies that energies are shifted if
+                            // 1) shift mode is set to shift
+                            // or 2) shift mode is explor and ron > rcut
+                            bool energy_shift = false;
+                            if (m_shift_mode == shift)
+                                energy_shift = true;
+                            else if (m_shift_mode == xplor)
+                                {
+                                if (ronsq > rcutsq)
+                                    energy_shift = true;
+                                }
+
+                            // compute the force and potential energy
+                            Scalar force_divr = Scalar(0.0);
+                            Scalar pair_eng = Scalar(0.0);
+                            evaluator eval(rsq, rcutsq, param);
+                            if (evaluator::needsDiameter())
+                                eval.setDiameter(di, dj);
+                            if (evaluator::needsCharge())
+                                eval.setCharge(qi, qj);
+
+                            bool evaluated
+                                = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                            if (evaluated)
+                                {
+                                // modify the potential for xplor shifting
+                                if (m_shift_mode == xplor)
+                                    {
+                                    if (rsq >= ronsq && rsq < rcutsq)
+                                        {
+                                        // Implement XPLOR smoothing (FLOPS: 16)
+                                        Scalar old_pair_eng = pair_eng;
+                                        Scalar old_force_divr = force_divr;
+
+                                        // calculate 1.0 / (xplor denominator)
+                                        Scalar xplor_denom_inv
+                                            = Scalar(1.0)
+                                              / ((rcutsq - ronsq) * (rcutsq - ronsq)
+                                                 * (rcutsq - ronsq));
+
+                                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                                        Scalar s
+                                            = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                                              * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
+                                              * xplor_denom_inv;
+                                        Scalar ds_dr_divr
+                                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq
+                                              * xplor_denom_inv;
+
+                                        // make modifications to the old pair energy and force
+                                        pair_eng = old_pair_eng * s;
+                                        // note: I'm not sure why the minus sign needs to be
+                                        // there: my notes have a + But this is verified correct
+                                        // via plotting
+                                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                                        }
+                                    }
+
+                                Scalar force_div2r = force_divr * Scalar(0.5);
+                                // add the force, potential energy and virial to the particle i
+                                // (FLOPS: 8)
+                                fi += dx * force_divr;
+                                if (compute_energy)
+                                    pei += pair_eng * Scalar(0.5);
+                                if (compute_virial)
+                                    {
+                                    virialxxi += force_div2r * dx.x * dx.x;
+                                    virialxyi += force_div2r * dx.x * dx.y;
+                                    virialxzi += force_div2r * dx.x * dx.z;
+                                    virialyyi += force_div2r * dx.y * dx.y;
+                                    virialyzi += force_div2r * dx.y * dx.z;
+                                    virialzzi += force_div2r * dx.z * dx.z;
+                                    }
+
+                                // add the force to particle j if we are using the third law
+                                // (MEM TRANSFER: 10 scalars / FLOPS: 8) only add force to local
+                                // particles
+                                if (third_law && j < m_pdata->getN())
+                                    {
+                                    unsigned int mem_idx = j;
+                                    h_force.data[mem_idx].x -= dx.x * force_divr;
+                                    h_force.data[mem_idx].y -= dx.y * force_divr;
+                                    h_force.data[mem_idx].z -= dx.z * force_divr;
+                                    if (compute_energy)
+                                        h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                                    if (compute_virial)
+                                        {
+                                        h_virial.data[0 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.x * dx.x;
+                                        h_virial.data[1 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.x * dx.y;
+                                        h_virial.data[2 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.x * dx.z;
+                                        h_virial.data[3 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.y * dx.y;
+                                        h_virial.data[4 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.y * dx.z;
+                                        h_virial.data[5 * virial_pitch + mem_idx]
+                                            += force_div2r * dx.z * dx.z;
+                                        }
+                                    }
+                                }
+                            }
+
+                        // finally, increment the force, potential energy and virial for particle i
+                        unsigned int mem_idx = i;
+                        h_force.data[mem_idx].x += fi.x;
+                        h_force.data[mem_idx].y += fi.y;
+                        h_force.data[mem_idx].z += fi.z;
+                        if (compute_energy)
+                            h_force.data[mem_idx].w += pei;
+                        if (compute_virial)
+                            {
+                            h_virial.data[0 * virial_pitch + mem_idx] += virialxxi;
+                            h_virial.data[1 * virial_pitch + mem_idx] += virialxyi;
+                            h_virial.data[2 * virial_pitch + mem_idx] += virialxzi;
+                            h_virial.data[3 * virial_pitch + mem_idx] += virialyyi;
+                            h_virial.data[4 * virial_pitch + mem_idx] += virialyzi;
+                            h_virial.data[5 * virial_pitch + mem_idx] += virialzzi;
+                            }
                         }
-                    }
-                }
-            }
-
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
-            {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
-            }
-        }
-
-    if (m_prof)
-        m_prof->pop();
+#ifdef ENABLE_TBB
+                },
+                tbb::static_partitioner());
+        });
+#endif
     }
 
 #ifdef ENABLE_MPI
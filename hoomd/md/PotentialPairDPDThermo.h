@@ -7,6 +7,8 @@
 #define __POTENTIAL_PAIR_DPDTHERMO_H__
 
 #include "PotentialPair.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
 #include "hoomd/Variant.h"
 
 /*! \file PotentialPairDPDThermo.h
@@ -62,6 +64,12 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
 #endif
 
+    //! The thermostat forces are only computed by computeForces()
+    virtual bool supportsAccumulation()
+        {
+        return false;
+        }
+
     protected:
     std::shared_ptr<Variant> m_T; //!< Temperature for the DPD thermostat
 
@@ -146,6 +154,11 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
 
     uint16_t seed = this->m_sysdef->getSeed();
 
+    // the thermostat draws one random value per pair
+    hoomd::RandomGeneratorBatch batch(
+        hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, timestep, seed),
+        1);
+
     // for each particle
     for (int i = 0; i < (int)this->m_pdata->getN(); i++)
         {
@@ -174,6 +187,25 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             unsigned int j = h_nlist.data[head_i + k];
             assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts());
 
+            // initialize the thermostat RNG streams of the next neighbors together, with the
+            // counter ordered by tag as in the evaluator
+            unsigned int lane = k % hoomd::RandomGeneratorBatch::width;
+            if (lane == 0)
+                {
+                unsigned int tag_i = h_tag.data[i];
+                unsigned int n_streams = 0;
+                for (; n_streams < hoomd::RandomGeneratorBatch::width && k + n_streams < size;
+                     n_streams++)
+                    {
+                    unsigned int tag_j = h_tag.data[h_nlist.data[head_i + k + n_streams]];
+                    batch.setStream(n_streams,
+                                    tag_i > tag_j ? hoomd::Counter(tag_j, tag_i)
+                                                  : hoomd::Counter(tag_i, tag_j));
+                    }
+                batch.generate(n_streams);
+                }
+            hoomd::RandomStream rng = batch.getStream(lane);
+
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
             Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
             Scalar3 dx = pi - pj;
@@ -223,8 +255,11 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             eval.setRDotV(rdotv);
             eval.setT(currentTemp);
 
-            bool evaluated
-                = eval.evalForceEnergyThermo(force_divr, force_divr_cons, pair_eng, energy_shift);
+            bool evaluated = eval.evalForceEnergyThermo(force_divr,
+                                                        force_divr_cons,
+                                                        pair_eng,
+                                                        energy_shift,
+                                                        rng);
 
             if (evaluated)
                 {
@@ -87,17 +87,32 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
 
     uint16_t seed = m_sysdef->getSeed();
 
+    // three uniform values for the force, three normal values for the velocity and six normal
+    // values for the rotation per member
+    RandomGeneratorBatch batch(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                               m_aniso ? 12 : 6);
+
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
 
-        // Initialize the RNG
-        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
-                            hoomd::Counter(ptag));
+        // Initialize the RNG streams of the next members together
+        unsigned int lane = group_idx % RandomGeneratorBatch::width;
+        if (lane == 0)
+            {
+            unsigned int n_streams = 0;
+            for (; n_streams < RandomGeneratorBatch::width && group_idx + n_streams < group_size;
+                 n_streams++)
+                {
+                unsigned int k = m_group->getMemberIndex(group_idx + n_streams);
+                batch.setStream(n_streams, hoomd::Counter(h_tag.data[k]));
+                }
+            batch.generate(n_streams);
+            }
+        RandomStream rng = batch.getStream(lane);
 
         // compute the random force
         UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
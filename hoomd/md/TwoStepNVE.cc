@@ -6,6 +6,11 @@
 #include "TwoStepNVE.h"
 #include "hoomd/VectorMath.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -105,6 +110,10 @@ void TwoStepNVE::integrateStepOne(uint64_t timestep)
     if (m_prof)
         m_prof->push("NVE step 1");
 
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                access_location::host,
                                access_mode::readwrite);
@@ -114,176 +123,184 @@ void TwoStepNVE::integrateStepOne(uint64_t timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                access_location::host,
                                access_mode::readwrite);
-
-    // perform the first half step of velocity verlet
-    // r(t+deltaT) = r(t) + v(t)*deltaT + (1/2)a(t)*deltaT^2
-    // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        if (m_zero_force)
-            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
-
-        Scalar dx = h_vel.data[j].x * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT * m_deltaT;
-        Scalar dy = h_vel.data[j].y * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT * m_deltaT;
-        Scalar dz = h_vel.data[j].z * m_deltaT
-                    + Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT * m_deltaT;
-
-        // limit the movement of the particles
-        if (m_limit)
-            {
-            Scalar len = sqrt(dx * dx + dy * dy + dz * dz);
-            if (len > m_limit_val)
-                {
-                dx = dx / len * m_limit_val;
-                dy = dy / len * m_limit_val;
-                dz = dz / len * m_limit_val;
-                }
-            }
-
-        h_pos.data[j].x += dx;
-        h_pos.data[j].y += dy;
-        h_pos.data[j].z += dz;
-
-        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
-        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
-        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
-        }
-
-    // particles may have been moved slightly outside the box by the above steps, wrap them back
-    // into place
-    const BoxDim& box = m_pdata->getBox();
-
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        box.wrap(h_pos.data[j], h_image.data[j]);
-        }
-
-    // Integration of angular degrees of freedom using symplectic and
-    // time-reversal symmetric integration scheme of Miller et al.
-    if (m_aniso)
-        {
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::readwrite);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::readwrite);
-        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                        access_location::host,
-                                       access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
-            // using Trotter factorization of rotation Liouvillian
-            p += m_deltaT * q * t;
-
-            quat<Scalar> p1, p2, p3; // permutated quaternions
-            quat<Scalar> q1, q2, q3;
-            Scalar phi1, cphi1, sphi1;
-            Scalar phi2, cphi2, sphi2;
-            Scalar phi3, cphi3, sphi3;
-
-            if (!z_zero)
-                {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
-
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
-
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
-
-            if (!x_zero)
-                {
-                p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
-                q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
-                phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
-                cphi1 = slow::cos(m_deltaT * phi1);
-                sphi1 = slow::sin(m_deltaT * phi1);
-
-                p = cphi1 * p + sphi1 * p1;
-                q = cphi1 * q + sphi1 * q1;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+                                       access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
+    const BoxDim& box = m_pdata->getBox();
 
-            if (!z_zero)
+    // advance the translational and rotational degrees of freedom of each member in one sweep,
+    // members are independent and are processed in parallel
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, group_size),
+                [&](const tbb::blocked_range<unsigned int>& r)
                 {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
-
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
-
-            // renormalize (improves stability)
-            q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-
-            h_orientation.data[j] = quat_to_scalar4(q);
-            h_angmom.data[j] = quat_to_scalar4(p);
-            }
-        }
+                    for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+#else
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+#endif
+                        {
+                        unsigned int j = h_member_idx.data[group_idx];
+
+                        // perform the first half step of velocity verlet
+                        // r(t+deltaT) = r(t) + v(t)*deltaT + (1/2)a(t)*deltaT^2
+                        // v(t+deltaT/2) = v(t) + (1/2)a*deltaT
+                        if (m_zero_force)
+                            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
+
+                        Scalar dx = h_vel.data[j].x * m_deltaT
+                                    + Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT * m_deltaT;
+                        Scalar dy = h_vel.data[j].y * m_deltaT
+                                    + Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT * m_deltaT;
+                        Scalar dz = h_vel.data[j].z * m_deltaT
+                                    + Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT * m_deltaT;
+
+                        // limit the movement of the particles
+                        if (m_limit)
+                            {
+                            Scalar len = sqrt(dx * dx + dy * dy + dz * dz);
+                            if (len > m_limit_val)
+                                {
+                                dx = dx / len * m_limit_val;
+                                dy = dy / len * m_limit_val;
+                                dz = dz / len * m_limit_val;
+                                }
+                            }
+
+                        h_pos.data[j].x += dx;
+                        h_pos.data[j].y += dy;
+                        h_pos.data[j].z += dz;
+
+                        // particles may have been moved slightly outside the box, wrap them
+                        // back into place
+                        box.wrap(h_pos.data[j], h_image.data[j]);
+
+                        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
+                        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
+                        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
+
+                        // Integration of angular degrees of freedom using symplectic and
+                        // time-reversal symmetric integration scheme of Miller et al.
+                        if (m_aniso)
+                            {
+                            quat<Scalar> q(h_orientation.data[j]);
+                            quat<Scalar> p(h_angmom.data[j]);
+                            vec3<Scalar> t(h_net_torque.data[j]);
+                            vec3<Scalar> I(h_inertia.data[j]);
+
+                            // rotate torque into principal frame
+                            t = rotate(conj(q), t);
+
+                            // check for zero moment of inertia
+                            bool x_zero, y_zero, z_zero;
+                            x_zero = (I.x < EPSILON);
+                            y_zero = (I.y < EPSILON);
+                            z_zero = (I.z < EPSILON);
+
+                            // ignore torque component along an axis for which the moment of inertia
+                            // zero
+                            if (x_zero)
+                                t.x = 0;
+                            if (y_zero)
+                                t.y = 0;
+                            if (z_zero)
+                                t.z = 0;
+
+                            // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
+                            // using Trotter factorization of rotation Liouvillian
+                            p += m_deltaT * q * t;
+
+                            quat<Scalar> p1, p2, p3; // permutated quaternions
+                            quat<Scalar> q1, q2, q3;
+                            Scalar phi1, cphi1, sphi1;
+                            Scalar phi2, cphi2, sphi2;
+                            Scalar phi3, cphi3, sphi3;
+
+                            if (!z_zero)
+                                {
+                                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                                p = cphi3 * p + sphi3 * p3;
+                                q = cphi3 * q + sphi3 * q3;
+                                }
+
+                            if (!y_zero)
+                                {
+                                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                                p = cphi2 * p + sphi2 * p2;
+                                q = cphi2 * q + sphi2 * q2;
+                                }
+
+                            if (!x_zero)
+                                {
+                                p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
+                                q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
+                                phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
+                                cphi1 = slow::cos(m_deltaT * phi1);
+                                sphi1 = slow::sin(m_deltaT * phi1);
+
+                                p = cphi1 * p + sphi1 * p1;
+                                q = cphi1 * q + sphi1 * q1;
+                                }
+
+                            if (!y_zero)
+                                {
+                                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                                p = cphi2 * p + sphi2 * p2;
+                                q = cphi2 * q + sphi2 * q2;
+                                }
+
+                            if (!z_zero)
+                                {
+                                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                                p = cphi3 * p + sphi3 * p3;
+                                q = cphi3 * q + sphi3 * q3;
+                                }
+
+                            // renormalize (improves stability)
+                            q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+
+                            h_orientation.data[j] = quat_to_scalar4(q);
+                            h_angmom.data[j] = quat_to_scalar4(p);
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
 
     // done profiling
     if (m_prof)
@@ -303,100 +320,116 @@ void TwoStepNVE::integrateStepTwo(uint64_t timestep)
     if (m_prof)
         m_prof->push("NVE step 2");
 
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                access_location::host,
                                access_mode::readwrite);
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
                                  access_location::host,
                                  access_mode::readwrite);
-
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
-
-    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        if (m_zero_force)
-            {
-            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
-            }
-        else
-            {
-            // first, calculate acceleration from the net force
-            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
-            h_accel.data[j].x = h_net_force.data[j].x * minv;
-            h_accel.data[j].y = h_net_force.data[j].y * minv;
-            h_accel.data[j].z = h_net_force.data[j].z * minv;
-            }
-
-        // then, update the velocity
-        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
-        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
-        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
-
-        // limit the movement of the particles
-        if (m_limit)
-            {
-            Scalar vel = sqrt(h_vel.data[j].x * h_vel.data[j].x + h_vel.data[j].y * h_vel.data[j].y
-                              + h_vel.data[j].z * h_vel.data[j].z);
-            if ((vel * m_deltaT) > m_limit_val)
-                {
-                h_vel.data[j].x = h_vel.data[j].x / vel * m_limit_val / m_deltaT;
-                h_vel.data[j].y = h_vel.data[j].y / vel * m_limit_val / m_deltaT;
-                h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
-                }
-            }
-        }
-
-    if (m_aniso)
-        {
-        // angular degrees of freedom
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::readwrite);
-        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                        access_location::host,
                                        access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // advance p(t+deltaT/2)->p(t+deltaT)
-            p += m_deltaT * q * t;
-
-            h_angmom.data[j] = quat_to_scalar4(p);
-            }
-        }
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+
+    // complete the velocity verlet step of the translational and rotational degrees of freedom
+    // of each member in one sweep
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, group_size),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+#else
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+#endif
+                        {
+                        unsigned int j = h_member_idx.data[group_idx];
+
+                        // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
+                        if (m_zero_force)
+                            {
+                            h_accel.data[j].x = h_accel.data[j].y = h_accel.data[j].z = 0.0;
+                            }
+                        else
+                            {
+                            // first, calculate acceleration from the net force
+                            Scalar minv = Scalar(1.0) / h_vel.data[j].w;
+                            h_accel.data[j].x = h_net_force.data[j].x * minv;
+                            h_accel.data[j].y = h_net_force.data[j].y * minv;
+                            h_accel.data[j].z = h_net_force.data[j].z * minv;
+                            }
+
+                        // then, update the velocity
+                        h_vel.data[j].x += Scalar(1.0 / 2.0) * h_accel.data[j].x * m_deltaT;
+                        h_vel.data[j].y += Scalar(1.0 / 2.0) * h_accel.data[j].y * m_deltaT;
+                        h_vel.data[j].z += Scalar(1.0 / 2.0) * h_accel.data[j].z * m_deltaT;
+
+                        // limit the movement of the particles
+                        if (m_limit)
+                            {
+                            Scalar vel = sqrt(h_vel.data[j].x * h_vel.data[j].x
+                                              + h_vel.data[j].y * h_vel.data[j].y
+                                              + h_vel.data[j].z * h_vel.data[j].z);
+                            if ((vel * m_deltaT) > m_limit_val)
+                                {
+                                h_vel.data[j].x = h_vel.data[j].x / vel * m_limit_val / m_deltaT;
+                                h_vel.data[j].y = h_vel.data[j].y / vel * m_limit_val / m_deltaT;
+                                h_vel.data[j].z = h_vel.data[j].z / vel * m_limit_val / m_deltaT;
+                                }
+                            }
+
+                        // angular degrees of freedom
+                        if (m_aniso)
+                            {
+                            quat<Scalar> q(h_orientation.data[j]);
+                            quat<Scalar> p(h_angmom.data[j]);
+                            vec3<Scalar> t(h_net_torque.data[j]);
+                            vec3<Scalar> I(h_inertia.data[j]);
+
+                            // rotate torque into principal frame
+                            t = rotate(conj(q), t);
+
+                            // check for zero moment of inertia
+                            bool x_zero, y_zero, z_zero;
+                            x_zero = (I.x < EPSILON);
+                            y_zero = (I.y < EPSILON);
+                            z_zero = (I.z < EPSILON);
+
+                            // ignore torque component along an axis for which the moment of inertia
+                            // zero
+                            if (x_zero)
+                                t.x = 0;
+                            if (y_zero)
+                                t.y = 0;
+                            if (z_zero)
+                                t.z = 0;
+
+                            // advance p(t+deltaT/2)->p(t+deltaT)
+                            p += m_deltaT * q * t;
+
+                            h_angmom.data[j] = quat_to_scalar4(p);
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
 
     // done profiling
     if (m_prof)
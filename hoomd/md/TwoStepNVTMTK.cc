@@ -12,6 +12,14 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
 using namespace std;
 namespace py = pybind11;
 
@@ -75,8 +83,26 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
         m_prof->push("NVT step 1");
         }
 
+    // thermostat factor of the rotational degrees of freedom
+    Scalar exp_fac = Scalar(1.0);
+    if (m_aniso)
+        {
+        IntegratorVariables v = getIntegratorVariables();
+        Scalar xi_rot = v.variable[2];
+        exp_fac = exp(-m_deltaT / Scalar(2.0) * xi_rot);
+        }
+
+    // the members are split into blocks of fixed size that are processed in parallel
+    const unsigned int block_size = ParticleGroup::reduction_block_size;
+    unsigned int n_blocks = (group_size + block_size - 1) / block_size;
+    std::vector<double> block_ke(2 * n_blocks);
+
     // scope array handles for proper releasing before calling the thermo compute
         {
+        ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                               access_location::host,
+                                               access_mode::read);
+
         ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                    access_location::host,
                                    access_mode::readwrite);
@@ -86,59 +112,9 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::readwrite);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            // load variables
-            Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 accel = h_accel.data[j];
-
-            // update velocity and position
-            v = v + Scalar(1.0 / 2.0) * accel * m_deltaT;
-
-            // rescale velocity
-            v *= m_exp_thermo_fac;
-
-            pos += m_deltaT * v;
-
-            // store updated variables
-            h_vel.data[j].x = v.x;
-            h_vel.data[j].y = v.y;
-            h_vel.data[j].z = v.z;
-
-            h_pos.data[j].x = pos.x;
-            h_pos.data[j].y = pos.y;
-            h_pos.data[j].z = pos.z;
-            }
-
-        // particles may have been moved slightly outside the box by the above steps, wrap them back
-        // into place
-        const BoxDim& box = m_pdata->getBox();
-
         ArrayHandle<int3> h_image(m_pdata->getImages(),
                                   access_location::host,
                                   access_mode::readwrite);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // wrap the particles around the box
-            box.wrap(h_pos.data[j], h_image.data[j]);
-            }
-        }
-
-    // Integration of angular degrees of freedom using symplectic and
-    // time-reversal symmetric integration scheme of Miller et al., extended by thermostat
-    if (m_aniso)
-        {
-        // thermostat factor
-        IntegratorVariables v = getIntegratorVariables();
-        Scalar xi_rot = v.variable[2];
-        Scalar exp_fac = exp(-m_deltaT / Scalar(2.0) * xi_rot);
-
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::readwrite);
@@ -151,116 +127,239 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
                                        access_location::host,
                                        access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
-            // using Trotter factorization of rotation Liouvillian
-            p += m_deltaT * q * t;
-
-            // apply thermostat
-            p = p * exp_fac;
-
-            quat<Scalar> p1, p2, p3; // permutated quaternions
-            quat<Scalar> q1, q2, q3;
-            Scalar phi1, cphi1, sphi1;
-            Scalar phi2, cphi2, sphi2;
-            Scalar phi3, cphi3, sphi3;
-
-            if (!z_zero)
-                {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
-
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
-
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
-
-            if (!x_zero)
-                {
-                p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
-                q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
-                phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
-                cphi1 = slow::cos(m_deltaT * phi1);
-                sphi1 = slow::sin(m_deltaT * phi1);
-
-                p = cphi1 * p + sphi1 * p1;
-                q = cphi1 * q + sphi1 * q1;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
-
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
-
-            if (!z_zero)
-                {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+        const BoxDim& box = m_pdata->getBox();
 
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
+        // advance the translational and rotational degrees of freedom of each member and sum the
+        // kinetic energies for the thermostat in one sweep
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_blocks),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int block = r.begin(); block != r.end(); ++block)
+#else
+        for (unsigned int block = 0; block < n_blocks; ++block)
+#endif
+                            {
+                            unsigned int first = block * block_size;
+                            unsigned int last = std::min(first + block_size, group_size);
+                            double ke_trans = 0.0;
+                            double ke_rot = 0.0;
+
+                            for (unsigned int group_idx = first; group_idx < last; group_idx++)
+                                {
+                                unsigned int j = h_member_idx.data[group_idx];
+
+                                // load variables
+                                Scalar3 v = make_scalar3(h_vel.data[j].x,
+                                                         h_vel.data[j].y,
+                                                         h_vel.data[j].z);
+                                Scalar3 pos = make_scalar3(h_pos.data[j].x,
+                                                           h_pos.data[j].y,
+                                                           h_pos.data[j].z);
+                                Scalar3 accel = h_accel.data[j];
+
+                                // update velocity and position
+                                v = v + Scalar(1.0 / 2.0) * accel * m_deltaT;
+
+                                // rescale velocity
+                                v *= m_exp_thermo_fac;
+
+                                pos += m_deltaT * v;
+
+                                // store updated variables
+                                h_vel.data[j].x = v.x;
+                                h_vel.data[j].y = v.y;
+                                h_vel.data[j].z = v.z;
+
+                                h_pos.data[j].x = pos.x;
+                                h_pos.data[j].y = pos.y;
+                                h_pos.data[j].z = pos.z;
+
+                                // particles may have been moved slightly outside the box,
+                                // wrap them back into place
+                                box.wrap(h_pos.data[j], h_image.data[j]);
+
+                                // ignore rigid body constituent particles in the kinetic
+                                // energy, like ComputeThermo
+                                bool constituent = h_body.data[j] < MIN_FLOPPY
+                                                   && h_body.data[j] != h_tag.data[j];
+                                if (!constituent)
+                                    ke_trans += h_vel.data[j].w * dot(v, v);
+
+                                // Integration of angular degrees of freedom using symplectic
+                                // and time-reversal symmetric integration scheme of Miller et
+                                // al., extended by thermostat
+                                if (m_aniso)
+                                    {
+                                    quat<Scalar> q(h_orientation.data[j]);
+                                    quat<Scalar> p(h_angmom.data[j]);
+                                    vec3<Scalar> t(h_net_torque.data[j]);
+                                    vec3<Scalar> I(h_inertia.data[j]);
+
+                                    // rotate torque into principal frame
+                                    t = rotate(conj(q), t);
+
+                                    // check for zero moment of inertia
+                                    bool x_zero, y_zero, z_zero;
+                                    x_zero = (I.x < EPSILON);
+                                    y_zero = (I.y < EPSILON);
+                                    z_zero = (I.z < EPSILON);
+
+                                    // ignore torque component along an axis for which the moment of
+                                    // inertia zero
+                                    if (x_zero)
+                                        t.x = 0;
+                                    if (y_zero)
+                                        t.y = 0;
+                                    if (z_zero)
+                                        t.z = 0;
+
+                                    // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
+                                    // using Trotter factorization of rotation Liouvillian
+                                    p += m_deltaT * q * t;
+
+                                    // apply thermostat
+                                    p = p * exp_fac;
+
+                                    quat<Scalar> p1, p2, p3; // permutated quaternions
+                                    quat<Scalar> q1, q2, q3;
+                                    Scalar phi1, cphi1, sphi1;
+                                    Scalar phi2, cphi2, sphi2;
+                                    Scalar phi3, cphi3, sphi3;
+
+                                    if (!z_zero)
+                                        {
+                                        p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                                        q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                                        phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                                        cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                                        sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                                        p = cphi3 * p + sphi3 * p3;
+                                        q = cphi3 * q + sphi3 * q3;
+                                        }
+
+                                    if (!y_zero)
+                                        {
+                                        p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                                        q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                                        phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                                        cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                                        sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                                        p = cphi2 * p + sphi2 * p2;
+                                        q = cphi2 * q + sphi2 * q2;
+                                        }
+
+                                    if (!x_zero)
+                                        {
+                                        p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
+                                        q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
+                                        phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
+                                        cphi1 = slow::cos(m_deltaT * phi1);
+                                        sphi1 = slow::sin(m_deltaT * phi1);
+
+                                        p = cphi1 * p + sphi1 * p1;
+                                        q = cphi1 * q + sphi1 * q1;
+                                        }
+
+                                    if (!y_zero)
+                                        {
+                                        p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                                        q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                                        phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                                        cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                                        sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                                        p = cphi2 * p + sphi2 * p2;
+                                        q = cphi2 * q + sphi2 * q2;
+                                        }
+
+                                    if (!z_zero)
+                                        {
+                                        p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                                        q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                                        phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                                        cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                                        sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                                        p = cphi3 * p + sphi3 * p3;
+                                        q = cphi3 * q + sphi3 * q3;
+                                        }
+
+                                    // renormalize (improves stability)
+                                    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+
+                                    h_orientation.data[j] = quat_to_scalar4(q);
+                                    h_angmom.data[j] = quat_to_scalar4(p);
+
+                                    if (!constituent)
+                                        {
+                                        quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+                                        if (!x_zero)
+                                            ke_rot += s.v.x * s.v.x / I.x;
+                                        if (!y_zero)
+                                            ke_rot += s.v.y * s.v.y / I.y;
+                                        if (!z_zero)
+                                            ke_rot += s.v.z * s.v.z / I.z;
+                                        }
+                                    }
+                                }
+
+                            block_ke[2 * block] = ke_trans;
+                            block_ke[2 * block + 1] = ke_rot;
+                            }
+#ifdef ENABLE_TBB
+                    });
+            });
+#endif
+        }
 
-            // renormalize (improves stability)
-            q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+    // get temperature and advance thermostat
+    if (m_thermo->getGroup() == m_group)
+        {
+        // add the block sums in a fixed order, independent of the number of threads
+        double ke[2] = {0.0, 0.0};
+        for (unsigned int block = 0; block < n_blocks; ++block)
+            {
+            ke[0] += block_ke[2 * block];
+            ke[1] += block_ke[2 * block + 1];
+            }
 
-            h_orientation.data[j] = quat_to_scalar4(q);
-            h_angmom.data[j] = quat_to_scalar4(p);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          ke,
+                          2,
+                          MPI_DOUBLE,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
             }
-        }
+#endif
 
-    // get temperature and advance thermostat
-    advanceThermostat(timestep);
+        Scalar ke_trans = Scalar(0.5) * ke[0];
+        Scalar ke_rot = Scalar(0.5) * ke[1];
+        Scalar ndof_trans = m_group->getTranslationalDOF();
+        Scalar curr_T_trans = ndof_trans > 0 ? Scalar(2.0) / ndof_trans * ke_trans : Scalar(0.0);
+        updateThermostat(timestep, curr_T_trans, ke_rot);
+        }
+    else
+        {
+        // the thermostat acts on the temperature of a different group
+        advanceThermostat(timestep);
+        }
 
     // done profiling
     if (m_prof)
@@ -280,103 +379,123 @@ void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
     if (m_prof)
         m_prof->push("NVT step 2");
 
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                access_location::host,
                                access_mode::readwrite);
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
                                  access_location::host,
                                  access_mode::readwrite);
-
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
-    // perform second half step of Nose-Hoover integration
-
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // load velocity
-        Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-        Scalar3 accel = h_accel.data[j];
-        Scalar3 net_force
-            = make_scalar3(h_net_force.data[j].x, h_net_force.data[j].y, h_net_force.data[j].z);
-
-        // first, calculate acceleration from the net force
-        Scalar m = h_vel.data[j].w;
-        Scalar minv = Scalar(1.0) / m;
-        accel = net_force * minv;
-
-        // rescale velocity
-        v *= m_exp_thermo_fac;
-
-        // update velocity
-        v += Scalar(1.0 / 2.0) * m_deltaT * accel;
-
-        // store velocity
-        h_vel.data[j].x = v.x;
-        h_vel.data[j].y = v.y;
-        h_vel.data[j].z = v.z;
-
-        // store acceleration
-        h_accel.data[j] = accel;
-        }
-
+    // thermostat factor of the rotational degrees of freedom
+    Scalar exp_fac = Scalar(1.0);
     if (m_aniso)
         {
         IntegratorVariables v = getIntegratorVariables();
         Scalar xi_rot = v.variable[2];
-        Scalar exp_fac = exp(-m_deltaT / Scalar(2.0) * xi_rot);
-
-        // angular degrees of freedom
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::readwrite);
-        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // apply thermostat
-            p = p * exp_fac;
-
-            // advance p(t+deltaT/2)->p(t+deltaT)
-            p += m_deltaT * q * t;
-
-            h_angmom.data[j] = quat_to_scalar4(p);
-            }
+        exp_fac = exp(-m_deltaT / Scalar(2.0) * xi_rot);
         }
 
+    // perform second half step of Nose-Hoover integration of the translational and rotational
+    // degrees of freedom of each member in one sweep
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, group_size),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                    for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+#else
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+#endif
+                        {
+                        unsigned int j = h_member_idx.data[group_idx];
+
+                        // load velocity
+                        Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                        Scalar3 accel = h_accel.data[j];
+                        Scalar3 net_force
+                            = make_scalar3(h_net_force.data[j].x,
+                                           h_net_force.data[j].y,
+                                           h_net_force.data[j].z);
+
+                        // first, calculate acceleration from the net force
+                        Scalar m = h_vel.data[j].w;
+                        Scalar minv = Scalar(1.0) / m;
+                        accel = net_force * minv;
+
+                        // rescale velocity
+                        v *= m_exp_thermo_fac;
+
+                        // update velocity
+                        v += Scalar(1.0 / 2.0) * m_deltaT * accel;
+
+                        // store velocity
+                        h_vel.data[j].x = v.x;
+                        h_vel.data[j].y = v.y;
+                        h_vel.data[j].z = v.z;
+
+                        // store acceleration
+                        h_accel.data[j] = accel;
+
+                        // angular degrees of freedom
+                        if (m_aniso)
+                            {
+                            quat<Scalar> q(h_orientation.data[j]);
+                            quat<Scalar> p(h_angmom.data[j]);
+                            vec3<Scalar> t(h_net_torque.data[j]);
+                            vec3<Scalar> I(h_inertia.data[j]);
+
+                            // rotate torque into principal frame
+                            t = rotate(conj(q), t);
+
+                            // check for zero moment of inertia
+                            bool x_zero, y_zero, z_zero;
+                            x_zero = (I.x < EPSILON);
+                            y_zero = (I.y < EPSILON);
+                            z_zero = (I.z < EPSILON);
+
+                            // ignore torque component along an axis for which the moment of inertia
+                            // zero
+                            if (x_zero)
+                                t.x = 0;
+                            if (y_zero)
+                                t.y = 0;
+                            if (z_zero)
+                                t.z = 0;
+
+                            // apply thermostat
+                            p = p * exp_fac;
+
+                            // advance p(t+deltaT/2)->p(t+deltaT)
+                            p += m_deltaT * q * t;
+
+                            h_angmom.data[j] = quat_to_scalar4(p);
+                            }
+                        }
+#ifdef ENABLE_TBB
+                });
+        });
+#endif
+
     // done profiling
     if (m_prof)
         m_prof->pop();
@@ -384,14 +503,28 @@ void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
 
 void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
     {
-    IntegratorVariables v = getIntegratorVariables();
-    Scalar& xi = v.variable[0];
-    Scalar& eta = v.variable[1];
-
     // compute the current thermodynamic properties
     m_thermo->compute(timestep + 1);
 
     Scalar curr_T_trans = m_thermo->getTranslationalTemperature();
+    Scalar curr_ke_rot = m_aniso ? m_thermo->getRotationalKineticEnergy() : Scalar(0.0);
+
+    updateThermostat(timestep, curr_T_trans, curr_ke_rot, broadcast);
+    }
+
+/*! \param timestep The time step
+    \param curr_T_trans Current translational temperature of the group
+    \param curr_ke_rot Current rotational kinetic energy of the group
+    \param broadcast True if we should broadcast the integrator variables via MPI
+*/
+void TwoStepNVTMTK::updateThermostat(uint64_t timestep,
+                                     Scalar curr_T_trans,
+                                     Scalar curr_ke_rot,
+                                     bool broadcast)
+    {
+    IntegratorVariables v = getIntegratorVariables();
+    Scalar& xi = v.variable[0];
+    Scalar& eta = v.variable[1];
 
     // update the state variables Xi and eta
     Scalar xi_prime = xi
@@ -420,7 +553,6 @@ void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
         Scalar& xi_rot = v.variable[2];
         Scalar& eta_rot = v.variable[3];
 
-        Scalar curr_ke_rot = m_thermo->getRotationalKineticEnergy();
         Scalar ndof_rot = m_group->getRotationalDOF();
 
         Scalar xi_prime_rot
@@ -153,11 +153,17 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
 
     Scalar m_exp_thermo_fac; //!< Thermostat rescaling factor
 
-    //! advance the thermostat
+    //! advance the thermostat using the temperature computed by m_thermo
     /*!\param timestep The time step
      * \param broadcast True if we should broadcast the integrator variables via MPI
      */
     void advanceThermostat(uint64_t timestep, bool broadcast = true);
+
+    //! advance the thermostat with the given temperature and rotational kinetic energy
+    void updateThermostat(uint64_t timestep,
+                          Scalar curr_T_trans,
+                          Scalar curr_ke_rot,
+                          bool broadcast = true);
     };
 
 //! Exports the TwoStepNVTMTK class to python
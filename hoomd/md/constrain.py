@@ -22,9 +22,10 @@ accounted for in `hoomd.md.ThermodynamicQuantities`.
 """
 
 from hoomd.md import _md
-from hoomd.data.parameterdicts import TypeParameterDict
+from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
+from hoomd.logging import log
 import hoomd
 from hoomd.operation import _HOOMDBaseObject
 
@@ -44,11 +45,20 @@ class Constraint(_HOOMDBaseObject):
         super()._attach()
 
 
-class distance(Constraint):
+class Distance(Constraint):
     R"""Constrain pairwise particle distances.
 
-    :py:class:`distance` specifies that forces will be applied to all particles
-    pairs for which constraints have been defined.
+    Args:
+        tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Solver for the constraint equations, ``'lu'`` or
+            ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
+        max_iterations (int): Maximum number of sweeps of the iterative
+            solver.
+
+    `Distance` applies forces between particles that constrain the distances
+    between particles to specific values.
 
     The constraint algorithm implemented is described in:
 
@@ -66,6 +76,20 @@ class distance(Constraint):
     is solved. Because constraints are satisfied at :math:`t + 2 \Delta t`, the
     scheme is self-correcting and drifts are avoided.
 
+    With ``solver='lu'`` (the default), the linear system is solved with a
+    sparse LU factorization. ``solver='iterative'`` solves it with Jacobi
+    sweeps that start from the Lagrange multipliers of the previous step, in the
+    spirit of SHAKE and LINCS. The iteration stops when the largest residual is
+    less than ``solver_tolerance`` times the largest element of the right hand
+    side, or after ``max_iterations`` sweeps. The iterative solver only stores
+    the couplings between constraints that share a particle, uses multiple
+    threads when HOOMD is built with TBB, and always runs on the CPU.
+    Convergence slows down for long chains of nearly collinear constraints.
+
+    The iterative solver detects molecules made of a single constraint or of
+    three constraints that form a triangle (such as rigid 3-site water models)
+    and solves their equations exactly, per molecule, without iterating.
+
     Warning:
         In MPI simulations, all particles connected through constraints will be
         communicated between processors as ghost particles. Therefore, it is an
@@ -73,44 +97,48 @@ class distance(Constraint):
         the local domain size.
 
     .. caution::
-        constrain.distance() does not currently interoperate with
-        integrate.brownian() or integrate.langevin()
+        `Distance` does not currently interoperate with
+        `hoomd.md.methods.Brownian` or `hoomd.md.methods.Langevin`.
 
     Example::
 
-        constrain.distance()
-
+        distance = hoomd.md.constrain.Distance(solver='iterative')
+        integrator.constraints.append(distance)
+
+    Attributes:
+        tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Solver for the constraint equations, ``'lu'`` or
+            ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
+        max_iterations (int): Maximum number of sweeps of the iterative
+            solver.
     """
 
-    def __init__(self):
-
-        # initialize the base class
-        Constraint.__init__(self)
-
-        # create the c++ mirror class
-        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
-            self.cpp_force = _md.ForceDistanceConstraint(
-                hoomd.context.current.system_definition)
-        else:
-            self.cpp_force = _md.ForceDistanceConstraintGPU(
-                hoomd.context.current.system_definition)
-
-        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name)
-
-    def set_params(self, rel_tol=None):
-        R"""Set parameters for constraint computation.
-
-        Args:
-            rel_tol (float): The relative tolerance with which constraint
-                violations are detected (**optional**).
-
-        Example::
-
-            dist = constrain.distance()
-            dist.set_params(rel_tol=0.0001)
-        """
-        if rel_tol is not None:
-            self.cpp_force.setRelativeTolerance(float(rel_tol))
+    _cpp_class_name = "ForceDistanceConstraint"
+
+    def __init__(self,
+                 tolerance=1e-3,
+                 solver='lu',
+                 solver_tolerance=1e-8,
+                 max_iterations=1000):
+        params = ParameterDict(tolerance=float(tolerance),
+                               solver=OnlyFrom(['lu', 'iterative']),
+                               solver_tolerance=float(solver_tolerance),
+                               max_iterations=int(max_iterations))
+        params['solver'] = solver
+        self._param_dict.update(params)
+
+    @log(requires_run=True)
+    def num_iterations(self):
+        """int: Number of sweeps of the iterative solver in the last step."""
+        return self._cpp_obj.num_iterations
+
+    @log(requires_run=True)
+    def num_unconverged(self):
+        """int: Number of steps in which the iterative solver did not \
+        converge."""
+        return self._cpp_obj.num_unconverged
 
 
 class Rigid(Constraint):
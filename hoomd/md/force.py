@@ -399,3 +399,77 @@ class Active(Force):
 
         # Attach param_dict and typeparam_dict
         super()._attach()
+
+
+class FusedBonded(Force):
+    r"""Evaluate several bonded forces in a single force compute.
+
+    Args:
+        forces (list[`hoomd.md.force.Force`]): Bond, angle, and dihedral
+            forces to evaluate.
+
+    `FusedBonded` computes the sum of the given bond (`hoomd.md.bond`), angle
+    (`hoomd.md.angle`), and dihedral (`hoomd.md.dihedral`) forces. Add the
+    `FusedBonded` object to the integrator in place of the individual forces.
+    The forces all add to one set of per-particle arrays, which saves memory
+    bandwidth in every time step compared to adding each bonded force to the
+    integrator on its own.
+
+    The individual forces remain usable: set their parameters as usual and log
+    their loggable quantities to obtain the contribution of each force.
+
+    Note:
+        `FusedBonded` runs on the CPU.
+
+    Example::
+
+        harmonic = hoomd.md.bond.Harmonic()
+        harmonic.params['A-A'] = dict(k=3.0, r0=2.38)
+        angle = hoomd.md.angle.Harmonic()
+        angle.params['A-A-A'] = dict(k=3.0, t0=0.7851)
+        bonded = hoomd.md.force.FusedBonded([harmonic, angle])
+        integrator.forces.append(bonded)
+
+    Attributes:
+        bonded_forces (tuple[`hoomd.md.force.Force`]): The bonded forces.
+    """
+
+    def __init__(self, forces):
+        from hoomd.md.bond import Bond
+        from hoomd.md.angle import Angle
+        from hoomd.md.dihedral import Dihedral
+
+        forces = tuple(forces)
+        for force in forces:
+            if not isinstance(force, (Bond, Angle, Dihedral)):
+                raise TypeError("FusedBonded accepts bond, angle, and dihedral "
+                                "forces, got {}.".format(type(force)))
+        self._bonded_forces = forces
+
+    @property
+    def bonded_forces(self):
+        return self._bonded_forces
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            raise RuntimeError("FusedBonded is not supported on the GPU.")
+
+        for force in self._bonded_forces:
+            if not force._added:
+                force._add(self._simulation)
+            elif self._simulation != force._simulation:
+                raise RuntimeError("{} object's force is used in a different "
+                                   "simulation.".format(type(self)))
+            if not force._attached:
+                force._attach()
+
+        self._cpp_obj = _md.FusedBondedForceCompute(
+            self._simulation.state._cpp_sys_def)
+        for force in self._bonded_forces:
+            self._cpp_obj.addForce(force._cpp_obj)
+
+        super()._attach()
+
+    @property
+    def _children(self):
+        return list(self._bonded_forces)
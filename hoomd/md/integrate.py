@@ -168,6 +168,9 @@ class Integrator(_DynamicIntegrator):
         rigid (hoomd.md.constrain.Rigid): A rigid bodies object defining the
             rigid bodies in the simulation.
 
+        accumulate_forces (bool): When `True`, forces that support it add
+            directly to the net force on the CPU.
+
 
     The following classes can be used as elements in `methods`
 
@@ -194,6 +197,17 @@ class Integrator(_DynamicIntegrator):
 
     - `hoomd.md.constrain`
 
+    By default, each force computes its own per-particle force, energy, and
+    virial arrays, and the integrator sums them into the net force. Set
+    ``accumulate_forces`` to `True` to have pair (`hoomd.md.pair`), bond,
+    angle, dihedral, and `hoomd.md.force.FusedBonded` forces add their
+    contributions directly to the net force instead. This saves a pass over the
+    per-particle arrays of each of these forces in every time step. The
+    per-force quantities (e.g. `hoomd.md.force.Force.energy` or
+    `hoomd.md.force.Force.forces`) remain available: the force computes them
+    separately when they are accessed. ``accumulate_forces`` has no effect on
+    the GPU.
+
     Examples::
 
         nlist = hoomd.md.nlist.Cell()
@@ -222,6 +236,9 @@ class Integrator(_DynamicIntegrator):
 
         rigid (hoomd.md.constrain.Rigid): The rigid body definition for the
             simulation associated with the integrator.
+
+        accumulate_forces (bool): When `True`, forces that support it add
+            directly to the net force on the CPU.
     """
 
     def __init__(self,
@@ -230,12 +247,14 @@ class Integrator(_DynamicIntegrator):
                  forces=None,
                  constraints=None,
                  methods=None,
-                 rigid=None):
+                 rigid=None,
+                 accumulate_forces=False):
 
         super().__init__(forces, constraints, methods, rigid)
 
         self._param_dict.update(
             ParameterDict(dt=float(dt),
+                          accumulate_forces=bool(accumulate_forces),
                           aniso=OnlyFrom(['true', 'false', 'auto'],
                                          preprocess=_preprocess_aniso),
                           _defaults={"aniso": "auto"}))
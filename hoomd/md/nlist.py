@@ -70,6 +70,17 @@ class NList(_HOOMDBaseObject):
     largest value that any particle's diameter will achieve (where **diameter**
     is the per particle quantity stored in the `hoomd.State`).
 
+    .. rubric:: Threads
+
+    On the CPU, pair potentials store each pair once and apply the force to
+    both particles, so they compute the forces serially. Set `full_list` to
+    `True` to store each pair for both particles: the pair potentials then
+    compute the forces on independent particles in parallel with
+    `hoomd.device.Device.num_cpu_threads` threads, at the cost of twice the
+    neighbor list memory and pair evaluations. `full_list` applies to all pair
+    potentials that share the neighbor list. On the GPU, the neighbor list
+    always stores each pair for both particles.
+
     Attributes:
         buffer (float): Buffer width :math:`[\mathrm{length}]`.
         exclusions (tuple[str]): Defines which particles to exlclude from the
@@ -89,7 +100,7 @@ class NList(_HOOMDBaseObject):
     }
 
     def __init__(self, buffer, exclusions, rebuild_check_delay, diameter_shift,
-                 check_dist, max_diameter):
+                 check_dist, max_diameter, full_list):
 
         validate_exclusions = OnlyFrom([
             'bond', 'angle', 'constraint', 'dihedral', 'special_pair', 'body',
@@ -104,6 +115,22 @@ class NList(_HOOMDBaseObject):
                                max_diameter=float(max_diameter),
                                _defaults={'exclusions': exclusions})
         self._param_dict.update(params)
+        self._full_list = bool(full_list)
+
+    @property
+    def full_list(self):
+        """bool: Store each pair for both particles on the CPU.
+
+        See the threads section above. `full_list` cannot be set after
+        scheduling.
+        """
+        return self._full_list
+
+    @full_list.setter
+    def full_list(self, value):
+        if self._attached:
+            raise RuntimeError("full_list cannot be set after scheduling.")
+        self._full_list = bool(value)
 
     @log(requires_run=True)
     def shortest_rebuild(self):
@@ -132,6 +159,8 @@ class Cell(NList):
             :math:`[\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        full_list (bool): Store each pair for both particles on the CPU, see
+            more details in `NList`.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -156,10 +185,11 @@ class Cell(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False,
+                 full_list=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, full_list)
 
         self._param_dict.update(
             ParameterDict(deterministic=bool(deterministic)))
@@ -191,6 +221,8 @@ class Stencil(NList):
             :math:`[\\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        full_list (bool): Store each pair for both particles on the CPU, see
+            more details in `NList`.
 
     `Stencil` creates a cell list based neighbor list object to which pair
     potentials can be attached for computing non-bonded pairwise interactions.
@@ -235,10 +267,11 @@ class Stencil(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False,
+                 full_list=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, full_list)
 
         params = ParameterDict(deterministic=bool(deterministic),
                                cell_width=float(cell_width))
@@ -268,6 +301,8 @@ class Tree(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\\mathrm{length}]`.
+        full_list (bool): Store each pair for both particles on the CPU, see
+            more details in `NList`.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal. A BVH tree of axis-aligned bounding boxes is constructed per
@@ -297,10 +332,11 @@ class Tree(NList):
                  rebuild_check_delay=1,
                  diameter_shift=False,
                  check_dist=True,
-                 max_diameter=1.0):
+                 max_diameter=1.0,
+                 full_list=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, full_list)
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
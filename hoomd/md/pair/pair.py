@@ -186,8 +186,13 @@ class Pair(force.Force):
             self.nlist._attach()
         if isinstance(self._simulation.device, hoomd.device.CPU):
             cls = getattr(_md, self._cpp_class_name)
-            self.nlist._cpp_obj.setStorageMode(
-                _md.NeighborList.storageMode.half)
+            # threads compute the forces in parallel with a full neighbor list
+            if self.nlist.full_list:
+                self.nlist._cpp_obj.setStorageMode(
+                    _md.NeighborList.storageMode.full)
+            else:
+                self.nlist._cpp_obj.setStorageMode(
+                    _md.NeighborList.storageMode.half)
         else:
             cls = getattr(_md, self._cpp_class_name + "GPU")
             self.nlist._cpp_obj.setStorageMode(
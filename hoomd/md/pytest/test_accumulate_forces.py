@@ -0,0 +1,75 @@
+import numpy as np
+import pytest
+
+import hoomd
+import hoomd.md as md
+
+
+def make_forces():
+    nlist = md.nlist.Cell()
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+
+    # DPD does not support accumulation, so the integrator mixes both paths
+    dpd = md.pair.DPD(nlist=nlist, kT=1.0, default_r_cut=1.0)
+    dpd.params[('A', 'A')] = dict(A=5.0, gamma=1.0)
+    return [lj, dpd]
+
+
+def run(simulation_factory, lattice_snapshot_factory, accumulate_forces):
+    sim = simulation_factory(lattice_snapshot_factory(a=1.2, n=6, r=0.05))
+    sim.seed = 4
+    forces = make_forces()
+    integrator = md.Integrator(dt=0.002,
+                               forces=forces,
+                               accumulate_forces=accumulate_forces)
+    integrator.methods.append(md.methods.NVE(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+
+    thermo = md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+    sim.always_compute_pressure = True
+    sim.run(20)
+
+    snap = sim.state.snapshot
+    position = None
+    if snap.communicator.rank == 0:
+        position = snap.particles.position[:]
+
+    return dict(position=position,
+                lj_energy=forces[0].energy,
+                potential_energy=thermo.potential_energy,
+                pressure=thermo.pressure)
+
+
+def test_accumulate_forces(simulation_factory, lattice_snapshot_factory):
+    reference = run(simulation_factory, lattice_snapshot_factory, False)
+    accumulated = run(simulation_factory, lattice_snapshot_factory, True)
+
+    if reference['position'] is not None:
+        np.testing.assert_allclose(accumulated['position'],
+                                   reference['position'],
+                                   atol=1e-5)
+
+    # per-force quantities are computed on demand
+    np.testing.assert_allclose(accumulated['lj_energy'],
+                               reference['lj_energy'],
+                               rtol=1e-5)
+    np.testing.assert_allclose(accumulated['potential_energy'],
+                               reference['potential_energy'],
+                               rtol=1e-5)
+    np.testing.assert_allclose(accumulated['pressure'],
+                               reference['pressure'],
+                               rtol=1e-5)
+
+
+def test_set_accumulate_forces(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    integrator = md.Integrator(dt=0.002)
+    assert not integrator.accumulate_forces
+
+    sim.operations.integrator = integrator
+    sim.run(0)
+    integrator.accumulate_forces = True
+    assert integrator.accumulate_forces
+    assert integrator._cpp_obj.accumulate_forces
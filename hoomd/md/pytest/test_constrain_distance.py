@@ -0,0 +1,150 @@
+import numpy as np
+import pytest
+
+import hoomd
+import hoomd.md as md
+
+
+@pytest.fixture
+def molecule_snapshot_factory(device):
+    """Make a snapshot of molecules held together by distance constraints.
+
+    Molecules are either rigid triangles or zig-zag chains of four particles.
+    """
+
+    def make_snapshot(molecule='triangle', n=3, a=4):
+        s = hoomd.Snapshot(device.communicator)
+
+        if s.communicator.rank == 0:
+            L = n * a
+            s.configuration.box = [L, L, L, 0, 0, 0]
+            s.particles.types = ['A']
+
+            if molecule == 'triangle':
+                sites = np.array([[0, 0, 0], [1, 0, 0],
+                                  [0.5, np.sqrt(3) / 2, 0]])
+                bonds = [[0, 1], [1, 2], [2, 0]]
+            else:
+                sites = np.array([[0, 0, 0], [1, 0, 0],
+                                  [1.5, np.sqrt(3) / 2, 0],
+                                  [2.5, np.sqrt(3) / 2, 0]])
+                bonds = [[0, 1], [1, 2], [2, 3]]
+            n_sites = len(sites)
+            centers = np.array([[i, j, k]
+                                for i in range(n)
+                                for j in range(n)
+                                for k in range(n)]) * a - L / 2 + 0.1
+            N_molecules = len(centers)
+
+            s.particles.N = n_sites * N_molecules
+            s.particles.position[:] = (centers[:, np.newaxis, :]
+                                       + sites[np.newaxis, :, :]).reshape(
+                                           -1, 3)
+            s.particles.mass[:] = 1.0
+
+            rng = np.random.default_rng(3)
+            s.particles.velocity[:] = rng.normal(0,
+                                                 0.5,
+                                                 size=(n_sites * N_molecules,
+                                                       3))
+
+            group = [[n_sites * m + i, n_sites * m + j]
+                     for m in range(N_molecules)
+                     for i, j in bonds]
+            s.constraints.N = len(group)
+            s.constraints.group[:] = group
+            s.constraints.value[:] = 1.0
+
+        return s
+
+    return make_snapshot
+
+
+def _constraint_lengths(snap):
+    box = hoomd.Box.from_box(snap.configuration.box)
+    pos = snap.particles.position
+    group = snap.constraints.group
+    r = pos[group[:, 0]] - pos[group[:, 1]]
+    r -= np.round(r / box.L) * box.L
+    return np.linalg.norm(r, axis=1)
+
+
+def test_attributes():
+    distance = md.constrain.Distance()
+
+    assert distance.tolerance == 1e-3
+    assert distance.solver == 'lu'
+    assert distance.solver_tolerance == 1e-8
+    assert distance.max_iterations == 1000
+
+    distance.solver = 'iterative'
+    assert distance.solver == 'iterative'
+
+    with pytest.raises(hoomd.data.typeconverter.TypeConversionError):
+        distance.solver = 'cg'
+
+
+def test_attributes_attached(simulation_factory, molecule_snapshot_factory):
+    sim = simulation_factory(molecule_snapshot_factory())
+    distance = md.constrain.Distance(solver='iterative',
+                                     solver_tolerance=1e-10,
+                                     max_iterations=500)
+    nve = md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = md.Integrator(dt=0.002,
+                                              methods=[nve],
+                                              constraints=[distance])
+    sim.run(0)
+
+    assert distance.solver == 'iterative'
+    assert distance.solver_tolerance == 1e-10
+    assert distance.max_iterations == 500
+
+    distance.solver = 'lu'
+    assert distance.solver == 'lu'
+
+
+@pytest.mark.parametrize("molecule", ['triangle', 'chain'])
+@pytest.mark.parametrize("solver", ['lu', 'iterative'])
+def test_constraint_lengths(simulation_factory, molecule_snapshot_factory,
+                            solver, molecule):
+    sim = simulation_factory(molecule_snapshot_factory(molecule=molecule))
+    distance = md.constrain.Distance(solver=solver)
+    nve = md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = md.Integrator(dt=0.002,
+                                              methods=[nve],
+                                              constraints=[distance])
+    sim.run(200)
+
+    snap = sim.state.snapshot
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(_constraint_lengths(snap), 1.0, rtol=1e-3)
+
+    if solver == 'iterative':
+        # rigid triangles are solved in closed form
+        if molecule == 'triangle':
+            assert distance.num_iterations == 0
+        else:
+            assert distance.num_iterations > 0
+        assert distance.num_unconverged == 0
+
+
+@pytest.mark.parametrize("molecule", ['triangle', 'chain'])
+def test_solvers_agree(simulation_factory, molecule_snapshot_factory,
+                       molecule):
+    snapshots = {}
+    for solver in ['lu', 'iterative']:
+        sim = simulation_factory(
+            molecule_snapshot_factory(molecule=molecule))
+        distance = md.constrain.Distance(solver=solver,
+                                         solver_tolerance=1e-12)
+        nve = md.methods.NVE(filter=hoomd.filter.All())
+        sim.operations.integrator = md.Integrator(dt=0.002,
+                                                  methods=[nve],
+                                                  constraints=[distance])
+        sim.run(20)
+        snapshots[solver] = sim.state.snapshot
+
+    if snapshots['lu'].communicator.rank == 0:
+        np.testing.assert_allclose(snapshots['lu'].particles.position,
+                                   snapshots['iterative'].particles.position,
+                                   atol=1e-5)
@@ -40,3 +40,57 @@ def test_per_particle_virial(simulation_factory, lattice_snapshot_factory):
 
 
 # TODO: test compute thermo once it is implemented
+
+
+def test_potential_energy(simulation_factory, lattice_snapshot_factory):
+    cell = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist=cell)
+    lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+    lj.r_cut[('A', 'A')] = 2.5
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.2))
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.operations.integrator.forces.append(lj)
+    sim.operations._schedule()
+
+    assert sim.always_compute_energy
+    sim.run(0)
+    energy = lj.energy
+    assert energy < 0.0
+
+    # energies are not computed when no operation requests them, the GPU
+    # kernels always compute them
+    sim.always_compute_energy = False
+    sim.run(1)
+    if isinstance(sim.device, hoomd.device.CPU):
+        assert numpy.isnan(lj.energy)
+
+        energies = lj.energies
+        if sim.device.communicator.rank == 0:
+            assert energies is None
+
+    # energies are valid after setting flags
+    sim.always_compute_energy = True
+    assert lj.energy < 0.0
+
+
+def test_potential_energy_always_computed(simulation_factory,
+                                          lattice_snapshot_factory):
+    """Forces that always compute the energy report it without the flag."""
+    cell = hoomd.md.nlist.Cell()
+    dpd = hoomd.md.pair.DPD(nlist=cell, kT=1.0, default_r_cut=1.0)
+    dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=0.8))
+    sim.seed = 2
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.operations.integrator.forces.append(dpd)
+    sim.operations._schedule()
+
+    sim.always_compute_energy = False
+    sim.run(1)
+    assert dpd.energy > 0.0
+
+    energies = dpd.energies
+    if sim.device.communicator.rank == 0:
+        assert numpy.all(energies > 0.0)
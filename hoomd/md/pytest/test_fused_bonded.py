@@ -0,0 +1,130 @@
+import itertools
+
+import numpy as np
+import pytest
+
+import hoomd
+import hoomd.md as md
+
+
+def make_chain_snapshot(lattice_snapshot_factory, n=6):
+    """Make a lattice snapshot with chains of bonds, angles, and dihedrals.
+
+    Every 2x2x2 block of the lattice holds one chain of four particles that
+    turns by 90 degrees at both inner particles.
+    """
+    s = lattice_snapshot_factory(n=n, a=1.1, r=0.05)
+
+    if s.communicator.rank == 0:
+        chains = []
+        for ix, iy, iz in itertools.product(range(0, n, 2), repeat=3):
+            sites = [(ix, iy, iz), (ix, iy, iz + 1), (ix, iy + 1, iz + 1),
+                     (ix + 1, iy + 1, iz + 1)]
+            # the lattice index runs fastest along z
+            chains.append([(x * n + y) * n + z for x, y, z in sites])
+
+        s.bonds.types = ['A-A']
+        s.bonds.N = 3 * len(chains)
+        s.bonds.group[:] = [c[i:i + 2] for c in chains for i in range(3)]
+        s.angles.types = ['A-A-A']
+        s.angles.N = 2 * len(chains)
+        s.angles.group[:] = [c[i:i + 3] for c in chains for i in range(2)]
+        s.dihedrals.types = ['A-A-A-A']
+        s.dihedrals.N = len(chains)
+        s.dihedrals.group[:] = chains
+
+    return s
+
+
+def make_bonded_forces():
+    bond = md.bond.Harmonic()
+    bond.params['A-A'] = dict(k=30.0, r0=1.1)
+    angle = md.angle.Harmonic()
+    angle.params['A-A-A'] = dict(k=5.0, t0=2.0)
+    dihedral = md.dihedral.OPLS()
+    dihedral.params['A-A-A-A'] = dict(k1=1.0, k2=0.5, k3=0.25, k4=0.1)
+    return [bond, angle, dihedral]
+
+
+@pytest.mark.cpu
+def test_matches_individual_forces(lattice_snapshot_factory,
+                                   simulation_factory):
+    sim = simulation_factory(make_chain_snapshot(lattice_snapshot_factory))
+    forces = make_bonded_forces()
+    fused = md.force.FusedBonded(forces)
+    assert fused.bonded_forces == tuple(forces)
+
+    integrator = md.Integrator(dt=0.005)
+    integrator.forces.append(fused)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    energy = sum(force.energy for force in forces)
+    np.testing.assert_allclose(fused.energy, energy, rtol=1e-6)
+
+    # the loggable per-particle arrays of Force are not shadowed
+    fused_forces = fused.forces
+    fused_energies = fused.energies
+    separate_forces = [force.forces for force in forces]
+    separate_energies = [force.energies for force in forces]
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(fused_forces,
+                                   sum(separate_forces),
+                                   rtol=1e-6,
+                                   atol=1e-9)
+        np.testing.assert_allclose(fused_energies,
+                                   sum(separate_energies),
+                                   rtol=1e-6,
+                                   atol=1e-9)
+
+
+@pytest.mark.cpu
+def test_trajectory(lattice_snapshot_factory, simulation_factory):
+    """The fused force produces the same trajectory as the separate forces."""
+    snap = make_chain_snapshot(lattice_snapshot_factory)
+    positions = []
+    for fuse in (False, True):
+        sim = simulation_factory(snap)
+        forces = make_bonded_forces()
+
+        integrator = md.Integrator(dt=0.002)
+        if fuse:
+            integrator.forces.append(md.force.FusedBonded(forces))
+        else:
+            integrator.forces.extend(forces)
+        integrator.methods.append(md.methods.NVE(filter=hoomd.filter.All()))
+        sim.operations.integrator = integrator
+        sim.run(50)
+
+        final = sim.state.snapshot
+        if final.communicator.rank == 0:
+            positions.append(final.particles.position[:])
+
+    if len(positions) == 2:
+        np.testing.assert_allclose(positions[0], positions[1], atol=1e-5)
+
+
+@pytest.mark.cpu
+def test_energy_not_computed(lattice_snapshot_factory, simulation_factory):
+    """The fused energy is NaN when the bond term leaves its energy out."""
+    sim = simulation_factory(make_chain_snapshot(lattice_snapshot_factory))
+    fused = md.force.FusedBonded(make_bonded_forces())
+
+    integrator = md.Integrator(dt=0.005)
+    integrator.forces.append(fused)
+    sim.operations.integrator = integrator
+    sim.always_compute_energy = False
+    sim.run(1)
+
+    assert np.isnan(fused.energy)
+    energies = fused.energies
+    if sim.device.communicator.rank == 0:
+        assert energies is None
+
+    sim.always_compute_energy = True
+    assert np.isfinite(fused.energy)
+
+
+def test_invalid_force():
+    with pytest.raises(TypeError):
+        md.force.FusedBonded([md.force.Active(filter=hoomd.filter.All())])
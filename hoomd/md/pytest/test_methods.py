@@ -1,5 +1,6 @@
 import hoomd
 from hoomd.conftest import pickling_check
+import numpy as np
 import pytest
 from copy import deepcopy
 from collections import namedtuple
@@ -512,3 +513,63 @@ def test_pickling(method_base_params, simulation_factory,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(method)
+
+
+def _make_fused_method(name):
+    all_ = hoomd.filter.All()
+    if name == 'NVE':
+        return hoomd.md.methods.NVE(filter=all_)
+    if name == 'NVT':
+        return hoomd.md.methods.NVT(filter=all_, kT=1.5, tau=0.5)
+    return hoomd.md.methods.Langevin(filter=all_,
+                                     kT=1.5,
+                                     tally_reservoir_energy=True)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required to set the number of threads")
+@pytest.mark.parametrize("method_name", ['NVE', 'NVT', 'Langevin'])
+def test_thread_count_independence(simulation_factory, lattice_snapshot_factory,
+                                   run_with_num_cpu_threads, method_name):
+    """Integration methods produce the same trajectory for any number of
+    threads."""
+    snap = lattice_snapshot_factory(n=10, a=1.5, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.moment_inertia[:] = [1, 2, 3]
+
+    def run():
+        sim = simulation_factory(snap)
+        sim.seed = 10
+        sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+        method = _make_fused_method(method_name)
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.002,
+                                                        methods=[method],
+                                                        forces=[lj],
+                                                        aniso=True)
+        sim.run(20)
+
+        snap = sim.state.snapshot
+        result = {}
+        if snap.communicator.rank == 0:
+            result['position'] = snap.particles.position[:]
+            result['velocity'] = snap.particles.velocity[:]
+            result['angmom'] = snap.particles.angmom[:]
+        if method_name == 'NVT':
+            result['thermostat'] = (method.translational_thermostat_dof,
+                                    method.rotational_thermostat_dof)
+        if method_name == 'Langevin':
+            result['reservoir_energy'] = method.reservoir_energy
+        return result
+
+    reference, threaded = run_with_num_cpu_threads(run)
+
+    assert reference.keys() == threaded.keys()
+    for key in reference:
+        if key in ('position', 'velocity', 'angmom'):
+            np.testing.assert_array_equal(threaded[key], reference[key])
+        else:
+            assert threaded[key] == reference[key]
@@ -37,7 +37,8 @@ def test_common_params(nlist_params):
         "rebuild_check_delay": 1,
         "diameter_shift": False,
         "check_dist": True,
-        "max_diameter": 1.0
+        "max_diameter": 1.0,
+        "full_list": False
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -55,7 +56,9 @@ def test_common_params(nlist_params):
         "check_dist":
             False,
         "max_diameter":
-            np.random.uniform(10.3)
+            np.random.uniform(10.3),
+        "full_list":
+            True
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -96,3 +99,55 @@ def test_simple_simulation(nlist_params, simulation_factory,
     sim = simulation_factory(lattice_snapshot_factory(n=10))
     sim.operations.integrator = integrator
     sim.run(2)
+
+
+def test_full_list_after_scheduling(simulation_factory,
+                                    two_particle_snapshot_factory):
+    nlist = Cell(full_list=True)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    sim.run(0)
+
+    assert nlist.full_list
+    with pytest.raises(RuntimeError):
+        nlist.full_list = False
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required to set the number of threads")
+def test_full_list_thread_count_independence(simulation_factory,
+                                             lattice_snapshot_factory,
+                                             run_with_num_cpu_threads):
+    """Threaded pair forces and nlist builds match the serial ones."""
+    snap = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+
+    def compute(full_list=True):
+        sim = simulation_factory(snap)
+        lj = hoomd.md.pair.LJ(Cell(full_list=full_list), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        sim.run(0)
+
+        forces, energies = lj.forces, lj.energies
+        if sim.device.communicator.rank == 0:
+            return np.array(forces), np.array(energies)
+        return None
+
+    # the pair order in the threaded nlist build and the summation order
+    # differ between the runs
+    results = run_with_num_cpu_threads(compute)
+    results.append(compute(full_list=False))
+    if snap.communicator.rank == 0:
+        reference = results[0]
+        for forces, energies in results[1:]:
+            np.testing.assert_allclose(forces,
+                                       reference[0],
+                                       rtol=1e-5,
+                                       atol=1e-6)
+            np.testing.assert_allclose(energies,
+                                       reference[1],
+                                       rtol=1e-5,
+                                       atol=1e-6)
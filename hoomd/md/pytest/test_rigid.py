@@ -201,6 +201,94 @@ def test_running_simulation(simulation_factory, two_particle_snapshot_factory,
         check_bodies(snapshot, valid_body_definition)
 
 
+def _run_many_bodies(simulation_factory, lattice_snapshot_factory,
+                     body_definition):
+    """Run a system of 64 rigid bodies and return the final snapshot."""
+    rigid = md.constrain.Rigid()
+    rigid.body["A"] = body_definition
+    langevin = md.methods.Langevin(kT=1.0, filter=hoomd.filter.Rigid())
+    lj = hoomd.md.pair.LJ(nlist=md.nlist.Cell(), mode="shift")
+    lj.params.default = {"epsilon": 0.0, "sigma": 1}
+    lj.params[("B", "B")] = {"epsilon": 1.0}
+    lj.r_cut.default = 2**(1.0 / 6.0)
+    integrator = md.Integrator(dt=0.002,
+                               methods=[langevin],
+                               forces=[lj],
+                               aniso=True)
+    integrator.rigid = rigid
+
+    initial_snapshot = lattice_snapshot_factory(particle_types=["A", "B"],
+                                                a=3.0,
+                                                n=4)
+    if initial_snapshot.communicator.rank == 0:
+        N = initial_snapshot.particles.N
+        initial_snapshot.particles.moment_inertia[:] = [1.0, 1.0, 1.0]
+        rng = np.random.default_rng(3)
+        initial_snapshot.particles.orientation[:] = rowan.normalize(
+            rng.normal(size=(N, 4)))
+    sim = simulation_factory(initial_snapshot)
+    sim.seed = 5
+
+    rigid.create_bodies(sim.state)
+    sim.operations += integrator
+    sim.run(10)
+
+    return sim.state.snapshot
+
+
+def test_many_bodies(simulation_factory, lattice_snapshot_factory,
+                     valid_body_definition):
+    """Constituent particles follow their central particles in larger systems.
+
+    The constituent update and the force and torque summation process the
+    bodies in parallel when built with TBB.
+    """
+    snapshot = _run_many_bodies(simulation_factory, lattice_snapshot_factory,
+                                valid_body_definition)
+    if snapshot.communicator.rank == 0:
+        L = snapshot.configuration.box[0]
+        body = snapshot.particles.body
+        position = snapshot.particles.position
+        orientation = snapshot.particles.orientation
+        n_bodies = 4**3
+        for i in range(n_bodies, snapshot.particles.N):
+            central = body[i]
+            k = (i - n_bodies) % 4
+            d_pos = position[i] - position[central]
+            d_pos -= L * np.round(d_pos / L)
+            expected = rowan.rotate(orientation[central],
+                                    valid_body_definition["positions"][k])
+            np.testing.assert_allclose(d_pos, expected, atol=1e-5)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required to set the number of threads")
+def test_many_bodies_thread_count_independence(simulation_factory,
+                                               lattice_snapshot_factory,
+                                               valid_body_definition,
+                                               run_with_num_cpu_threads):
+    """Threaded rigid body updates follow the single threaded trajectory."""
+
+    def run():
+        snapshot = _run_many_bodies(simulation_factory,
+                                    lattice_snapshot_factory,
+                                    valid_body_definition)
+        if snapshot.communicator.rank == 0:
+            particles = snapshot.particles
+            return [
+                np.array(particles.position),
+                np.array(particles.velocity),
+                np.array(particles.orientation),
+                np.array(particles.angmom)
+            ]
+
+    reference, threaded = run_with_num_cpu_threads(run)
+    if reference is not None:
+        for ref, thr in zip(reference, threaded):
+            np.testing.assert_allclose(thr, ref, rtol=1e-5, atol=1e-6)
+
+
 def test_running_without_body_definition(simulation_factory,
                                          two_particle_snapshot_factory):
     rigid = md.constrain.Rigid()
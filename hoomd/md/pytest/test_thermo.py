@@ -162,3 +162,45 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory):
     thermo = hoomd.md.compute.ThermodynamicQuantities(filter_)
     sim = simulation_factory(two_particle_snapshot_factory())
     operation_pickling_check(thermo, sim)
+
+
+def _random_snapshot(lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=12, a=1.5, r=0.1)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(10)
+        snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        snap.particles.mass[:] = rng.uniform(0.5, 2.0, size=snap.particles.N)
+    return snap
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required to set the number of threads")
+def test_thread_count_independence(simulation_factory,
+                                   lattice_snapshot_factory,
+                                   run_with_num_cpu_threads):
+    """The sums over the group do not depend on the number of threads."""
+    snap = _random_snapshot(lattice_snapshot_factory)
+
+    def compute():
+        sim = simulation_factory(snap)
+        sim.always_compute_pressure = True
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        sim.run(0)
+
+        return (thermo.kinetic_energy, thermo.potential_energy,
+                thermo.pressure, thermo.pressure_tensor)
+
+    reference, threaded = run_with_num_cpu_threads(compute)
+    assert threaded == reference
+
+    if snap.communicator.rank == 0:
+        kinetic_energy = 0.5 * np.sum(
+            snap.particles.mass * np.sum(snap.particles.velocity**2, axis=1))
+        np.testing.assert_allclose(reference[0], kinetic_energy, rtol=1e-5)
@@ -25,6 +25,8 @@ HOOMD_UP_MAIN()
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #define TO_TRICLINIC(v) dest_box.makeCoordinates(ref_box.makeFraction(make_scalar3(v.x, v.y, v.z)))
 #define TO_POS4(v) make_scalar4(v.x, v.y, v.z, h_pos.data[rtag].w)
@@ -3623,6 +3625,132 @@ void test_communicator_ghosts_per_type(communicator_creator comm_creator,
         }
     }
 
+//! Displacement of a particle in the compressed ghost test
+vec3<Scalar> ghost_test_displacement(unsigned int tag)
+    {
+    return vec3<Scalar>(Scalar(0.05) * sin(Scalar(tag)),
+                        Scalar(0.05) * cos(Scalar(tag)),
+                        Scalar(0.05) * sin(Scalar(2 * tag)));
+    }
+
+//! Test that compressed ghost position updates reproduce the uncompressed ghost positions
+void test_communicator_compressed_ghosts(communicator_creator comm_creator,
+                                         std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                         const BoxDim& box,
+                                         std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    unsigned int n = 1000;
+
+    Scalar3 lo = box.getLo();
+    Scalar3 L = box.getL();
+
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+
+    srand(12345);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        snap.pos[i] = vec3<Scalar>(lo.x + (Scalar)rand() / (Scalar)RAND_MAX * L.x,
+                                   lo.y + (Scalar)rand() / (Scalar)RAND_MAX * L.y,
+                                   lo.z + (Scalar)rand() / (Scalar)RAND_MAX * L.z);
+        }
+
+    // the same system, once with compressed and once with full ghost position updates
+    std::vector<std::shared_ptr<ParticleData>> pdatas;
+    std::vector<std::shared_ptr<Communicator>> comms;
+    ghost_layer_width g(0.2);
+    for (bool compress : {true, false})
+        {
+        std::shared_ptr<SystemDefinition> sysdef(
+            new SystemDefinition(n,   // number of particles
+                                 box, // box dimensions
+                                 1,   // number of particle types
+                                 0,   // number of bond types
+                                 0,   // number of angle types
+                                 0,   // number of dihedral types
+                                 0,   // number of dihedral types
+                                 exec_conf));
+        std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+        std::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+        comm->setCompressGhostPositions(compress);
+
+        pdata->setDomainDecomposition(decomposition);
+        pdata->initializeFromSnapshot(snap);
+
+        comm->getGhostLayerWidthRequestSignal()
+            .connect<ghost_layer_width, &ghost_layer_width::get>(g);
+
+        CommFlags flags(0);
+        flags[comm_flag::position] = 1;
+        flags[comm_flag::tag] = 1;
+        comm->setFlags(flags);
+
+        comm->migrateParticles();
+        comm->exchangeGhosts();
+
+        // displace every particle, some of them out of their domain
+            {
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::read);
+            for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+                {
+                vec3<Scalar> d = ghost_test_displacement(h_tag.data[idx]);
+                h_pos.data[idx].x += d.x;
+                h_pos.data[idx].y += d.y;
+                h_pos.data[idx].z += d.z;
+                }
+            }
+
+        comm->beginUpdateGhosts(1);
+        comm->finishUpdateGhosts(1);
+
+        pdatas.push_back(pdata);
+        comms.push_back(comm);
+        }
+
+    std::shared_ptr<ParticleData> pdata = pdatas[0];
+    std::shared_ptr<ParticleData> pdata_ref = pdatas[1];
+
+    // both systems hold the same ghosts in the same order, the exchange does not depend on the
+    // compression
+    UP_ASSERT(pdata->getNGhosts() > 0);
+    UP_ASSERT_EQUAL(pdata->getN(), pdata_ref->getN());
+    UP_ASSERT_EQUAL(pdata->getNGhosts(), pdata_ref->getNGhosts());
+
+    // every fractional coordinate is resolved to 2^-31 of the domain width, which is at most the
+    // box length, and the conversion to the fraction and back rounds
+    Scalar L_max = std::max(L.x, std::max(L.y, L.z));
+    Scalar tol = L_max
+                 * (Scalar(std::ldexp(1.0, -29))
+                    + Scalar(16.0) * std::numeric_limits<Scalar>::epsilon());
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos_ref(pdata_ref->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_tag_ref(pdata_ref->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+    for (unsigned int idx = pdata->getN(); idx < pdata->getN() + pdata->getNGhosts(); ++idx)
+        {
+        UP_ASSERT_EQUAL(h_tag.data[idx], h_tag_ref.data[idx]);
+
+        // compare the coordinates directly, a ghost in the wrong periodic image fails
+        UP_ASSERT(fabs(h_pos.data[idx].x - h_pos_ref.data[idx].x) <= tol);
+        UP_ASSERT(fabs(h_pos.data[idx].y - h_pos_ref.data[idx].y) <= tol);
+        UP_ASSERT(fabs(h_pos.data[idx].z - h_pos_ref.data[idx].z) <= tol);
+
+        // the type is kept from the last exchange
+        UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[idx].w), 0);
+        }
+    }
+
 //! Communicator creator for unit tests
 std::shared_ptr<Communicator>
 base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3631,6 +3759,16 @@ base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
     return std::shared_ptr<Communicator>(new Communicator(sysdef, decomposition));
     }
 
+//! Communicator creator for unit tests of the single stage ghost exchange
+std::shared_ptr<Communicator>
+neighbor_collectives_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                          std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    comm->setNeighborCollectives(true);
+    return comm;
+    }
+
 #ifdef ENABLE_HIP
 std::shared_ptr<Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3903,6 +4041,111 @@ UP_TEST(communicator_ghost_layer_per_type_test)
     test_communicator_ghosts_per_type(communicator_creator_base, exec_conf_cpu, BoxDim(2.0));
     }
 
+//! Tests compressed ghost position updates
+UP_TEST(communicator_compressed_ghosts_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+
+    // cubic box
+        {
+        BoxDim box(2.0);
+        test_communicator_compressed_ghosts(communicator_creator_base,
+                                            exec_conf_cpu,
+                                            box,
+                                            std::shared_ptr<DomainDecomposition>(
+                                                new DomainDecomposition(exec_conf_cpu,
+                                                                        box.getL())));
+        }
+    // triclinic box with uneven cuts
+        {
+        BoxDim box(2.0, .1, .2, .3);
+        vector<Scalar> fx(1), fy(1), fz(1);
+        fx[0] = 0.55;
+        fy[0] = 0.45;
+        fz[0] = 0.7;
+        test_communicator_compressed_ghosts(communicator_creator_base,
+                                            exec_conf_cpu,
+                                            box,
+                                            std::shared_ptr<DomainDecomposition>(
+                                                new DomainDecomposition(exec_conf_cpu,
+                                                                        box.getL(),
+                                                                        fx,
+                                                                        fy,
+                                                                        fz)));
+        }
+    }
+
+//! Tests the single stage ghost exchange
+UP_TEST(communicator_neighbor_collectives_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    communicator_creator communicator_creator_graph
+        = bind(neighbor_collectives_communicator_creator, _1, _2);
+
+    // test in a cubic box
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(communicator_creator_graph,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+    // triclinic box
+        {
+        BoxDim box(1.0, .1, .2, .3);
+        test_communicator_ghosts(communicator_creator_graph,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+
+    test_communicator_ghost_fields(communicator_creator_graph, exec_conf_cpu);
+
+    // compressed ghost positions in a single stage
+        {
+        BoxDim box(2.0, .1, .2, .3);
+        test_communicator_compressed_ghosts(communicator_creator_graph,
+                                            exec_conf_cpu,
+                                            box,
+                                            std::shared_ptr<DomainDecomposition>(
+                                                new DomainDecomposition(exec_conf_cpu,
+                                                                        box.getL())));
+        }
+
+    // compare to the staged exchange with uneven cuts
+        {
+        BoxDim box(2.0);
+        vector<Scalar> fx(1), fy(1), fz(1);
+        fx[0] = 0.55;
+        fy[0] = 0.45;
+        fz[0] = 0.7;
+
+        std::shared_ptr<DomainDecomposition> decomposition_1(
+            new DomainDecomposition(exec_conf_cpu, box.getL(), fx, fy, fz));
+        std::shared_ptr<DomainDecomposition> decomposition_2(
+            new DomainDecomposition(exec_conf_cpu, box.getL(), fx, fy, fz));
+        test_communicator_compare(communicator_creator_base,
+                                  communicator_creator_graph,
+                                  exec_conf_cpu,
+                                  exec_conf_cpu,
+                                  box,
+                                  decomposition_1,
+                                  decomposition_2);
+        }
+    }
+
 UP_SUITE_END();
 
 #ifdef ENABLE_HIP
@@ -502,6 +502,103 @@ void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
         }
     }
 
+//! Check the bond coloring and that the forces do not depend on the number of threads
+void bond_force_coloring_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // a linear chain, and a hub particle bonded to every tenth particle
+    std::shared_ptr<BondData> bond_data = sysdef->getBondData();
+    for (unsigned int i = 0; i < N - 1; i++)
+        bond_data->addBondedGroup(Bond(0, i, i + 1));
+    for (unsigned int i = 10; i < N; i += 10)
+        bond_data->addBondedGroup(Bond(0, 0, i));
+
+    // every bond has exactly one color, and bonds of the same color share no particle
+        {
+        const std::vector<unsigned int>& colored_bonds = bond_data->getColoredGroups();
+        const std::vector<unsigned int>& color_offsets = bond_data->getColorOffsets();
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        UP_ASSERT_EQUAL(colored_bonds.size(), bond_data->getN());
+        UP_ASSERT_EQUAL(color_offsets.back(), bond_data->getN());
+
+        std::vector<unsigned int> n_seen(bond_data->getN(), 0);
+        std::vector<unsigned int> last_color(N, 0xffffffff);
+        for (unsigned int color = 0; color + 1 < color_offsets.size(); ++color)
+            {
+            for (unsigned int k = color_offsets[color]; k < color_offsets[color + 1]; ++k)
+                {
+                unsigned int i = colored_bonds[k];
+                n_seen[i]++;
+
+                const BondData::members_t bond = bond_data->getMembersByIndex(i);
+                for (unsigned int j = 0; j < 2; ++j)
+                    {
+                    unsigned int idx = h_rtag.data[bond.tag[j]];
+                    UP_ASSERT(last_color[idx] != color);
+                    last_color[idx] = color;
+                    }
+                }
+            }
+
+        for (unsigned int i = 0; i < bond_data->getN(); ++i)
+            UP_ASSERT_EQUAL(n_seen[i], 1);
+        }
+
+#ifdef ENABLE_TBB
+    std::shared_ptr<PotentialBondHarmonic> fc(new PotentialBondHarmonic(sysdef));
+    fc->setParams(0, harmonic_params(Scalar(300.0), Scalar(1.6)));
+
+    exec_conf->setNumThreads(1);
+    fc->compute(0);
+    std::vector<Scalar4> force_serial(N);
+    std::vector<Scalar> virial_serial(6 * N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        size_t pitch = fc->getVirialArray().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            force_serial[i] = h_force.data[i];
+            for (unsigned int j = 0; j < 6; j++)
+                virial_serial[6 * i + j] = h_virial.data[j * pitch + i];
+            }
+        }
+
+    // the results must be bitwise identical
+    exec_conf->setNumThreads(4);
+    fc->compute(1);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        size_t pitch = fc->getVirialArray().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            UP_ASSERT(h_force.data[i].x == force_serial[i].x);
+            UP_ASSERT(h_force.data[i].y == force_serial[i].y);
+            UP_ASSERT(h_force.data[i].z == force_serial[i].z);
+            UP_ASSERT(h_force.data[i].w == force_serial[i].w);
+            for (unsigned int j = 0; j < 6; j++)
+                UP_ASSERT(h_virial.data[j * pitch + i] == virial_serial[6 * i + j]);
+            }
+        }
+#endif
+    }
+
 //! PotentialBondHarmonic creator for bond_force_basic_tests()
 std::shared_ptr<PotentialBondHarmonic>
 base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef)
@@ -526,6 +623,13 @@ UP_TEST(PotentialBondHarmonic_basic)
                                new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the bond coloring used by the threaded CPU computation
+UP_TEST(PotentialBondHarmonic_coloring)
+    {
+    bond_force_coloring_tests(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
 UP_TEST(PotentialBondHarmonicGPU_basic)
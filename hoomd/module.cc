@@ -51,6 +51,7 @@
 // include MPI classes
 #ifdef ENABLE_MPI
 #include "Communicator.h"
+#include "CommunicatorRCB.h"
 #include "DomainDecomposition.h"
 #include "LoadBalancer.h"
 
@@ -286,6 +287,7 @@ PYBIND11_MODULE(_hoomd, m)
 
 #ifdef ENABLE_MPI
     export_Communicator(m);
+    export_CommunicatorRCB(m);
     export_DomainDecomposition(m);
     export_LoadBalancer(m);
 #ifdef ENABLE_HIP
@@ -59,6 +59,68 @@ def test_common_properties(device, tmp_path):
             device_type(shared_msg_file=str(tmp_path / "shared.txt"))
 
 
+def test_pin_cpu_threads(device):
+    saved = (device.num_cpu_threads, device.pin_cpu_threads)
+    try:
+        device.pin_cpu_threads = False
+        assert not device.pin_cpu_threads
+
+        device.pin_cpu_threads = True
+        if hoomd.version.tbb_enabled:
+            assert device.pin_cpu_threads
+        else:
+            assert not device.pin_cpu_threads
+
+        # pinning applies to the arena created for a new number of threads
+        device.num_cpu_threads = 2
+        device.pin_cpu_threads = False
+        assert not device.pin_cpu_threads
+    finally:
+        device.num_cpu_threads, device.pin_cpu_threads = saved
+
+
+def test_memory_policy(device):
+    saved = device.memory_policy
+    try:
+        device.memory_policy = 'local'
+        assert device.memory_policy == 'local'
+
+        device.memory_policy = 'first_touch'
+        assert device.memory_policy == 'first_touch'
+
+        with pytest.raises(ValueError):
+            device.memory_policy = 'bind'
+        assert device.memory_policy == 'first_touch'
+    finally:
+        device.memory_policy = saved
+
+
+def test_host_arena_statistics(device, simulation_factory,
+                               two_particle_snapshot_factory):
+    # only the MPI communicator allocates temporary buffers from the arena
+    if device.communicator.num_ranks == 1:
+        pytest.skip("The arena is only used with more than one rank")
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.methods.append(hoomd.md.methods.NVE(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    sim.run(10)
+
+    stats = sim.device.host_arena_statistics
+    assert stats['num_allocations'] > 0
+    assert stats['peak_bytes'] >= stats['bytes_in_use']
+    assert stats['capacity'] >= stats['bytes_in_use']
+
+    # steps in the steady state do not allocate memory from the system
+    sim.run(1)
+    num_system_allocations = sim.device.host_arena_statistics[
+        'num_system_allocations']
+    sim.run(10)
+    assert sim.device.host_arena_statistics[
+        'num_system_allocations'] == num_system_allocations
+
+
 def _assert_gpu_properties(dev, mem_traceback, gpu_error_checking):
     """Assert properties specific to GPU objects are correct."""
     assert dev.memory_traceback == mem_traceback
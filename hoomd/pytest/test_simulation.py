@@ -385,3 +385,25 @@ def test_operations_setting(simulation_factory, lattice_snapshot_factory):
     new_operations += hoomd.write.Table(20,
                                         logger=hoomd.logging.Logger(['scalar']))
     check_operation_setting(sim, sim.operations, new_operations)
+
+
+@pytest.mark.parametrize('attr',
+                         ['neighbor_collectives', 'compress_ghost_positions'])
+def test_ghost_exchange_unsupported(device, lattice_snapshot_factory, attr):
+    """Check that options the communicator does not implement raise."""
+    if device.communicator.num_ranks == 1:
+        pytest.skip("Ghosts are exchanged only with more than one rank.")
+
+    sim = hoomd.Simulation(device)
+    if isinstance(device, hoomd.device.CPU):
+        sim.create_state_from_snapshot(lattice_snapshot_factory(),
+                                       domain_decomposition='rcb')
+    else:
+        sim.create_state_from_snapshot(lattice_snapshot_factory())
+
+    with pytest.raises(RuntimeError):
+        setattr(sim, attr, True)
+    assert not getattr(sim, attr)
+
+    setattr(sim, attr, False)
+    assert not getattr(sim, attr)
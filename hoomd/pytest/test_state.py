@@ -218,3 +218,143 @@ def test_thermalize_angular_momentum(simulation_factory,
         # too large for an allclose check.
         expected_K = (3 * snap.particles.N) / 2 * 1.5
         assert K > expected_K * 3 / 4 and K < expected_K * 4 / 3
+
+
+def sorted_groups(group, typeid):
+    """Bonded groups in a canonical order, independent of their tags."""
+    rows = numpy.column_stack((group, typeid))
+    return rows[numpy.lexsort(rows.T[::-1])]
+
+
+def test_distributed_snapshot(simulation_factory, snap):
+    sim = simulation_factory(snap)
+
+    dsnap = sim.state.distributed_snapshot
+    assert isinstance(dsnap, hoomd.DistributedSnapshot)
+    assert dsnap.particles.types == sim.state.particle_types
+    assert len(dsnap.particle_tags) == dsnap.particles.N
+
+    # a state created from the slices holds the same particles and groups
+    sim2 = simulation_factory(dsnap)
+    snap2 = sim2.state.snapshot
+    if snap.communicator.rank == 0:
+        assert snap2.particles.N == snap.particles.N
+        numpy.testing.assert_allclose(snap2.particles.position,
+                                      snap.particles.position)
+        numpy.testing.assert_allclose(snap2.particles.velocity,
+                                      snap.particles.velocity)
+        numpy.testing.assert_equal(snap2.particles.typeid,
+                                   snap.particles.typeid)
+        numpy.testing.assert_equal(snap2.particles.image, snap.particles.image)
+        numpy.testing.assert_allclose(snap2.particles.angmom,
+                                      snap.particles.angmom)
+
+        for section in ('bonds', 'angles', 'dihedrals', 'impropers', 'pairs'):
+            s1 = getattr(snap, section)
+            s2 = getattr(snap2, section)
+            assert s1.N == s2.N
+            assert s1.types == s2.types
+            numpy.testing.assert_equal(sorted_groups(s1.group, s1.typeid),
+                                       sorted_groups(s2.group, s2.typeid))
+
+        assert snap2.constraints.N == snap.constraints.N
+
+
+def test_set_distributed_snapshot(simulation_factory, snap):
+    sim = simulation_factory(snap)
+
+    dsnap = sim.state.distributed_snapshot
+    dsnap.particles.velocity[:] *= 2
+    sim.state.snapshot = dsnap
+
+    snap2 = sim.state.snapshot
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap2.particles.velocity,
+                                      2 * snap.particles.velocity)
+        numpy.testing.assert_allclose(snap2.particles.position,
+                                      snap.particles.position)
+        assert snap2.bonds.N == snap.bonds.N
+
+
+def test_set_distributed_snapshot_types_on_root(simulation_factory, snap):
+    sim = simulation_factory(snap)
+
+    # only rank 0 needs to name the types
+    dsnap = sim.state.distributed_snapshot
+    if dsnap.communicator.rank != 0:
+        dsnap.particles.types = []
+        dsnap.bonds.types = []
+    dsnap.particles.velocity[:] *= 2
+    sim.state.snapshot = dsnap
+
+    snap2 = sim.state.snapshot
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(snap2.particles.velocity,
+                                      2 * snap.particles.velocity)
+
+    # a type count mismatch on rank 0 raises on all ranks
+    dsnap = sim.state.distributed_snapshot
+    if dsnap.communicator.rank == 0:
+        dsnap.particles.types = dsnap.particles.types + ['new_type']
+    else:
+        dsnap.particles.types = []
+    with pytest.raises(RuntimeError):
+        sim.state.snapshot = dsnap
+
+
+def test_create_from_distributed_snapshot(simulation_factory, device):
+    communicator = device.communicator
+    n = 100
+    N = n * communicator.num_ranks
+
+    # each rank builds the particles with tags rank * n to (rank + 1) * n - 1
+    dsnap = hoomd.DistributedSnapshot(communicator)
+    dsnap.configuration.box = [20, 20, 20, 0, 0, 0]
+    dsnap.particles.types = ['A', 'B']
+    dsnap.particles.N = n
+    tags = numpy.arange(communicator.rank * n, (communicator.rank + 1) * n)
+    dsnap.particle_tags[:] = tags
+    dsnap.particles.position[:, 0] = tags / N * 19 - 9.5
+    dsnap.particles.typeid[:] = tags % 2
+
+    # and the bonds between its particles
+    dsnap.bonds.types = ['b']
+    dsnap.bonds.N = n - 1
+    dsnap.bonds.group[:] = numpy.column_stack((tags[:-1], tags[1:]))
+
+    sim = simulation_factory(dsnap)
+    assert sim.state.N_particles == N
+    assert sim.state.N_bonds == communicator.num_ranks * (n - 1)
+
+    snap = sim.state.snapshot
+    if communicator.rank == 0:
+        numpy.testing.assert_allclose(snap.particles.position[:, 0],
+                                      numpy.arange(N) / N * 19 - 9.5,
+                                      rtol=1e-6)
+        numpy.testing.assert_equal(snap.particles.typeid, numpy.arange(N) % 2)
+
+
+def test_distributed_snapshot_invalid_tags(simulation_factory, device):
+    dsnap = hoomd.DistributedSnapshot(device.communicator)
+    dsnap.configuration.box = [20, 20, 20, 0, 0, 0]
+    dsnap.particles.types = ['A']
+    dsnap.particles.N = 2
+
+    # the slice holds tag 0 twice
+    dsnap.particle_tags[:] = [0, 0]
+    with pytest.raises(RuntimeError):
+        simulation_factory(dsnap)
+
+
+def test_distributed_snapshot_out_of_box(simulation_factory, device):
+    dsnap = hoomd.DistributedSnapshot(device.communicator)
+    dsnap.configuration.box = [20, 20, 20, 0, 0, 0]
+    dsnap.particles.types = ['A']
+    dsnap.particles.N = 1
+
+    # every rank holds one valid tag, only the particle of rank 0 is outside
+    dsnap.particle_tags[:] = [device.communicator.rank]
+    if device.communicator.rank == 0:
+        dsnap.particles.position[:] = [[15, 0, 0]]
+    with pytest.raises(RuntimeError):
+        simulation_factory(dsnap)
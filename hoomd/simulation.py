@@ -8,7 +8,7 @@ import inspect
 import hoomd._hoomd as _hoomd
 from hoomd.logging import log, Loggable
 from hoomd.state import State
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd.operations import Operations
 import hoomd
 import json
@@ -132,7 +132,10 @@ class Simulation(metaclass=Loggable):
             decomposition = pdata.getDomainDecomposition()
             if decomposition is not None:
                 # create the c++ Communicator
-                if isinstance(self.device, hoomd.device.CPU):
+                if decomposition.isRCB():
+                    cpp_communicator = _hoomd.CommunicatorRCB(
+                        self.state._cpp_sys_def, decomposition)
+                elif isinstance(self.device, hoomd.device.CPU):
                     cpp_communicator = _hoomd.Communicator(
                         self.state._cpp_sys_def, decomposition)
                 else:
@@ -152,7 +155,10 @@ class Simulation(metaclass=Loggable):
             self.device._cpp_msg.warning(
                 "Simulation.seed is not set, using default seed=0\n")
 
-    def create_state_from_gsd(self, filename, frame=-1):
+    def create_state_from_gsd(self,
+                              filename,
+                              frame=-1,
+                              domain_decomposition='grid'):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -160,6 +166,18 @@ class Simulation(metaclass=Loggable):
 
             frame (int): Index of the frame to read from the file. Negative
                 values index back from the last frame in the file.
+
+            domain_decomposition (str): Layout of the MPI domains, ``'grid'``
+                or ``'rcb'`` (see below).
+
+        With ``domain_decomposition='rcb'``, the box is divided by recursive
+        coordinate bisection: the box is cut in two along its longest
+        direction, and each part is cut again until there is one domain per
+        rank. Unlike the grid, the domains need not line up, so
+        `hoomd.tune.LoadBalancer` can balance each domain independently.
+        The recursive coordinate bisection supports MD simulations on the CPU
+        without bonds, angles, dihedrals, impropers, constraints, special
+        pairs, or PPPM.
         """
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
@@ -171,19 +189,24 @@ class Simulation(metaclass=Loggable):
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
-        self._state = State(self, snapshot)
+        self._state = State(self, snapshot, domain_decomposition)
 
         reader.clearSnapshot()
 
         self._init_system(step)
 
-    def create_state_from_snapshot(self, snapshot):
+    def create_state_from_snapshot(self,
+                                   snapshot,
+                                   domain_decomposition='grid'):
         """Create the simulations state from a `Snapshot`.
 
         Args:
-            snapshot (Snapshot or gsd.hoomd.Snapshot): Snapshot to initialize
-                the state from. A `gsd.hoomd.Snapshot` will first be
-                converted to a `hoomd.Snapshot`.
+            snapshot (Snapshot, DistributedSnapshot, or gsd.hoomd.Snapshot):
+                Snapshot to initialize the state from. A `gsd.hoomd.Snapshot`
+                will first be converted to a `hoomd.Snapshot`.
+
+            domain_decomposition (str): Layout of the MPI domains, ``'grid'``
+                or ``'rcb'`` (see `create_state_from_gsd`).
 
 
         When `timestep` is `None` before calling, `create_state_from_snapshot`
@@ -192,17 +215,17 @@ class Simulation(metaclass=Loggable):
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
 
-        if isinstance(snapshot, Snapshot):
-            # snapshot is hoomd.Snapshot
-            self._state = State(self, snapshot)
+        if isinstance(snapshot, (Snapshot, DistributedSnapshot)):
+            # snapshot is hoomd.Snapshot or hoomd.DistributedSnapshot
+            self._state = State(self, snapshot, domain_decomposition)
         elif _match_class_path(snapshot, 'gsd.hoomd.Snapshot'):
             # snapshot is gsd.hoomd.Snapshot
             snapshot = Snapshot.from_gsd_snapshot(snapshot,
                                                   self._device.communicator)
-            self._state = State(self, snapshot)
+            self._state = State(self, snapshot, domain_decomposition)
         else:
-            raise TypeError(
-                "Snapshot must be a hoomd.Snapshot or gsd.hoomd.Snapshot.")
+            raise TypeError("Snapshot must be a hoomd.Snapshot, "
+                            "hoomd.DistributedSnapshot, or gsd.hoomd.Snapshot.")
 
         step = 0
         if self.timestep is not None:
@@ -323,6 +346,109 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def always_compute_energy(self):
+        """bool: Always compute the potential energy (defaults to ``True``).
+
+        By default, HOOMD computes the potential energy of every force on every
+        timestep. Set `always_compute_energy` to False to compute the potential
+        energy only on timesteps where it is needed (when
+        :py:class:`hoomd.write.GSD` writes log data to a file, when
+        :py:class:`hoomd.write.Table` writes, or when the integrator needs
+        it). Pair and bond potentials skip the energy evaluation on the other
+        timesteps.
+
+        Note:
+            When `always_compute_energy` is False, the energy of a pair or
+            bond potential, or of a `hoomd.md.force.FusedBonded` force, is
+            NaN and its per particle energies are `None` on timesteps where no
+            operation requested the energy. The potential
+            energies computed by the thermodynamic quantity computes in
+            :py:mod:`hoomd.md.compute` are NaN on those timesteps as well.
+            Other forces always compute their energy.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return True
+        else:
+            return self._cpp_sys.getEnergyFlag()
+
+    @always_compute_energy.setter
+    def always_compute_energy(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        else:
+            self._cpp_sys.setEnergyFlag(value)
+
+            # if the flag is true, also set it in the particle data
+            if value:
+                self._state._cpp_sys_def.getParticleData().setEnergyFlag()
+
+    @property
+    def neighbor_collectives(self):
+        """bool: Exchange ghosts in a single stage (defaults to ``False``).
+
+        By default, MPI ranks exchange ghost particles in six stages, one for
+        each face of the domain, and forward the ghosts needed by the ranks
+        across edges and corners in the later stages. Set
+        `neighbor_collectives` to True to send the ghost particles directly to
+        all (up to 26) neighboring ranks with MPI neighborhood collectives,
+        which pays the message latency once per ghost update instead of six
+        times. This helps most at large rank counts with few particles per
+        rank.
+
+        Note:
+            `neighbor_collectives` applies to simulations on the CPU with the
+            grid domain decomposition. Setting it to True on the GPU or with
+            ``domain_decomposition='rcb'`` raises a `RuntimeError`. When an
+            operation needs the reverse communication of ghost forces, ghosts
+            are exchanged in stages.
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return False
+        else:
+            return self._system_communicator.neighbor_collectives
+
+    @neighbor_collectives.setter
+    def neighbor_collectives(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.neighbor_collectives = bool(value)
+
+    @property
+    def compress_ghost_positions(self):
+        """bool: Send compressed ghost positions (defaults to ``False``).
+
+        Between neighbor list builds, MPI ranks send the positions of the
+        ghost particles to their neighbors on every step. Set
+        `compress_ghost_positions` to True to send each position as three 32
+        bit fixed point numbers relative to the receiving domain instead of
+        the full precision coordinates and type. This reduces a position
+        update from 32 to 12 bytes per ghost in double precision builds (16 to
+        12 bytes in single precision builds). Types are sent only when the
+        ghosts are exchanged again.
+
+        Note:
+            The error of a compressed ghost coordinate is at most
+            :math:`2^{-31}` times the width of the receiving domain along each
+            box vector. Forces on local particles are computed from the ghost
+            positions, so results differ slightly from uncompressed runs.
+            `compress_ghost_positions` applies to simulations on the CPU with
+            the grid domain decomposition. Setting it to True on the GPU or
+            with ``domain_decomposition='rcb'`` raises a `RuntimeError`.
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return False
+        else:
+            return self._system_communicator.compress_ghost_positions
+
+    @compress_ghost_positions.setter
+    def compress_ghost_positions(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.compress_ghost_positions = bool(value)
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -373,3 +373,135 @@ class Snapshot:
         snap._broadcast_box()
 
         return snap
+
+
+class DistributedSnapshot:
+    """Slice of the simulation `State` that belongs to one MPI rank.
+
+    Args:
+        communicator (Communicator): MPI communicator to be used with the
+          simulation.
+
+    Attributes:
+        communicator (Communicator): MPI communicator.
+
+    `DistributedSnapshot` holds the same data as `Snapshot`, but no rank holds
+    all of it. Each rank holds its own slice of the particles and bonded
+    groups, which may be empty. Together, the slices of all ranks hold every
+    particle and every bonded group exactly once. Use `DistributedSnapshot`
+    for systems that are too large to fit in the memory of a single rank.
+
+    Each particle in a slice has a global tag, stored in `particle_tags`. The
+    tags of all slices together must be the integers from 0 to
+    :math:`N_\\mathrm{particles} - 1`. The members in ``group`` of the bonded
+    groups are global particle tags, and any rank may hold a bonded group. Each
+    rank can access and write its slice independently of the other ranks,
+    e.g. to read or write one file per rank.
+    `Simulation.create_state_from_snapshot` and `State.snapshot` send every
+    particle to the rank that owns it.
+
+    `State.distributed_snapshot` returns a `DistributedSnapshot` in which each
+    rank holds the particles in its domain and the bonded groups whose first
+    member it holds.
+
+    The box, dimensions, and type names on rank 0 apply to all ranks.
+
+    Note:
+        The arrays in each slice have the same names, shapes, and types as in
+        `Snapshot` with *N* the number of particles or bonded groups in the
+        slice. Set ``N`` to change the size of the arrays.
+
+    .. seealso:
+        `Simulation.create_state_from_snapshot`
+
+        `State.distributed_snapshot`
+    """
+
+    def __init__(self, communicator=None):
+        if communicator is None:
+            self.communicator = hoomd.communicator.Communicator()
+        else:
+            self.communicator = communicator
+
+        self._cpp_obj = _hoomd.DistributedSnapshotSystemData_double()
+
+    @property
+    def configuration(self):
+        """Snapshot box configuration.
+
+        See `Snapshot.configuration`.
+        """
+        return _ConfigurationData(self._cpp_obj)
+
+    @property
+    def particles(self):
+        """Particles in the slice of this rank.
+
+        See `Snapshot.particles`.
+        """
+        return self._cpp_obj.particles
+
+    @property
+    def particle_tags(self):
+        """((*N*, ) `numpy.ndarray` of ``numpy.uint32``): Global particle tags.
+
+        The tag of each particle in `particles`.
+        """
+        return self._cpp_obj.particle_tags
+
+    @property
+    def bonds(self):
+        """Bonds in the slice of this rank.
+
+        See `Snapshot.bonds`.
+        """
+        return self._cpp_obj.bonds
+
+    @property
+    def angles(self):
+        """Angles in the slice of this rank.
+
+        See `Snapshot.angles`.
+        """
+        return self._cpp_obj.angles
+
+    @property
+    def dihedrals(self):
+        """Dihedrals in the slice of this rank.
+
+        See `Snapshot.dihedrals`.
+        """
+        return self._cpp_obj.dihedrals
+
+    @property
+    def impropers(self):
+        """Impropers in the slice of this rank.
+
+        See `Snapshot.impropers`.
+        """
+        return self._cpp_obj.impropers
+
+    @property
+    def pairs(self):
+        """Special pairs in the slice of this rank.
+
+        See `Snapshot.pairs`.
+        """
+        return self._cpp_obj.pairs
+
+    @property
+    def constraints(self):
+        """Constraints in the slice of this rank.
+
+        See `Snapshot.constraints`.
+        """
+        return self._cpp_obj.constraints
+
+    @classmethod
+    def _from_cpp_snapshot(cls, snapshot, communicator):
+        sp = cls(communicator=communicator)
+        sp._cpp_obj = snapshot
+        return sp
+
+    def _broadcast_box(self):
+        self._cpp_obj._broadcast_box(self.communicator.cpp_mpi_conf)
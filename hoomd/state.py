@@ -8,18 +8,25 @@ from collections import defaultdict
 
 from . import _hoomd
 from hoomd.box import Box
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd.data import LocalSnapshot, LocalSnapshotGPU
 import hoomd
 
 
-def _create_domain_decomposition(device, box):
+def _create_domain_decomposition(device, box, layout='grid'):
     """Create a default domain decomposition.
 
     This method is a quick hack to get basic MPI simulations working with
     the new API. We will need to consider designing an appropriate user-facing
     API to set the domain decomposition.
+
+    Args:
+        layout (str): ``'grid'`` to decompose the box into a grid of domains,
+            ``'rcb'`` for a recursive coordinate bisection.
     """
+    if layout not in ('grid', 'rcb'):
+        raise ValueError(f"Invalid domain decomposition {layout}.")
+
     if not hoomd.version.mpi_enabled:
         return None
 
@@ -28,6 +35,14 @@ def _create_domain_decomposition(device, box):
     if device.communicator.num_ranks == 1:
         return None
 
+    if layout == 'rcb':
+        if not isinstance(device, hoomd.device.CPU):
+            raise RuntimeError(
+                "Recursive coordinate bisection is not supported on the GPU.")
+        return _hoomd.DomainDecomposition(
+            device._cpp_exec_conf, box.getL(),
+            _hoomd.DomainDecomposition.layoutMode.rcb)
+
     # create a default domain decomposition
     result = _hoomd.DomainDecomposition(device._cpp_exec_conf, box.getL(), 0, 0,
                                         0, False)
@@ -55,11 +70,12 @@ class State:
         `State` object.
     """
 
-    def __init__(self, simulation, snapshot):
+    def __init__(self, simulation, snapshot, domain_decomposition='grid'):
         self._simulation = simulation
         snapshot._broadcast_box()
         domain_decomp = _create_domain_decomposition(
-            simulation.device, snapshot._cpp_obj._global_box)
+            simulation.device, snapshot._cpp_obj._global_box,
+            domain_decomposition)
 
         if domain_decomp is not None:
             self._cpp_sys_def = _hoomd.SystemDefinition(
@@ -91,7 +107,8 @@ class State:
         attempting to access data on a non-root rank.
 
         This property can be set to replace the system state with the given
-        `hoomd.Snapshot` object.  Example use cases in which a simulation's
+        `hoomd.Snapshot` or `hoomd.DistributedSnapshot` object.  Example use
+        cases in which a simulation's
         state may be reset from a snapshot include Monte Carlo schemes
         implemented at the Python script level, where the current snapshot is
         passed to the Monte Carlo simulation before being passed back after
@@ -105,6 +122,10 @@ class State:
         Note:
             Setting or getting a snapshot is an order :math:`O(N_{particles}
             + N_{bonds} + \ldots)` operation.
+
+        See Also:
+            `State.distributed_snapshot` to access the state of large systems
+            without gathering it on the root MPI rank.
         """
         cpp_snapshot = self._cpp_sys_def.takeSnapshot_double()
         return Snapshot._from_cpp_snapshot(cpp_snapshot,
@@ -115,24 +136,55 @@ class State:
         if self._in_context_manager:
             raise RuntimeError(
                 "Cannot set state to new snapshot inside local snapshot.")
+        # the type names come from rank 0, check them there and raise the
+        # error on all ranks so that no rank waits in the initialization
+        error = ''
         if self._simulation.device.communicator.rank == 0:
-            if len(snapshot.particles.types) != len(self.particle_types):
-                raise RuntimeError(
-                    "Number of particle types must remain the same")
-            if len(snapshot.bonds.types) != len(self.bond_types):
-                raise RuntimeError("Number of bond types must remain the same")
-            if len(snapshot.angles.types) != len(self.angle_types):
-                raise RuntimeError("Number of angle types must remain the same")
-            if len(snapshot.dihedrals.types) != len(self.dihedral_types):
-                raise RuntimeError(
-                    "Number of dihedral types must remain the same")
-            if len(snapshot.impropers.types) != len(self.improper_types):
-                raise RuntimeError(
-                    "Number of dihedral types must remain the same")
-            if len(snapshot.pairs.types) != len(self.special_pair_types):
-                raise RuntimeError("Number of pair types must remain the same")
-
-        self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
+            error = self._check_snapshot_types(snapshot)
+        error = _hoomd.mpi_bcast_str(error,
+                                     self._simulation.device._cpp_exec_conf)
+        if error:
+            raise RuntimeError(error)
+
+        if isinstance(snapshot, DistributedSnapshot):
+            self._cpp_sys_def.initializeFromDistributedSnapshot(
+                snapshot._cpp_obj)
+        else:
+            self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
+
+    def _check_snapshot_types(self, snapshot):
+        """Return an error message if the number of types changes."""
+        if len(snapshot.particles.types) != len(self.particle_types):
+            return "Number of particle types must remain the same"
+        if len(snapshot.bonds.types) != len(self.bond_types):
+            return "Number of bond types must remain the same"
+        if len(snapshot.angles.types) != len(self.angle_types):
+            return "Number of angle types must remain the same"
+        if len(snapshot.dihedrals.types) != len(self.dihedral_types):
+            return "Number of dihedral types must remain the same"
+        if len(snapshot.impropers.types) != len(self.improper_types):
+            return "Number of improper types must remain the same"
+        if len(snapshot.pairs.types) != len(self.special_pair_types):
+            return "Number of pair types must remain the same"
+        return ''
+
+    @property
+    def distributed_snapshot(self):
+        r"""hoomd.DistributedSnapshot: The slice of the state on this rank.
+
+        Each MPI rank holds the particles in its domain and the bonded groups
+        whose first member is one of them, without any communication between
+        ranks. Set `State.snapshot` to a `hoomd.DistributedSnapshot` to replace
+        the system state.
+
+        Note:
+            Getting a distributed snapshot is an order
+            :math:`O(N_{particles} / N_{ranks} + N_{bonds} / N_{ranks} +
+            \ldots)` operation on each rank.
+        """
+        cpp_snapshot = self._cpp_sys_def.takeDistributedSnapshot_double()
+        return DistributedSnapshot._from_cpp_snapshot(
+            cpp_snapshot, self._simulation.device.communicator)
 
     @property
     def particle_types(self):
@@ -503,6 +503,40 @@ UP_TEST(rng_seeding)
     UP_ASSERT_EQUAL(g.getCounter()[3], 0x9876);
     }
 
+//! Test that RandomGeneratorBatch streams match RandomGenerator
+UP_TEST(rng_batch)
+    {
+    auto s = hoomd::Seed(hoomd::RNGIdentifier::TwoStepLangevin, 0xabcdef1234567890, 0x5eed);
+
+    // a partially filled batch with fewer precomputed values than are drawn
+    const unsigned int n_streams = 5;
+    hoomd::RandomGeneratorBatch batch(s, 3);
+    for (unsigned int lane = 0; lane < n_streams; lane++)
+        batch.setStream(lane, hoomd::Counter(lane * 1000, 0xffffffff - lane, 7));
+    batch.generate(n_streams);
+
+    for (unsigned int lane = 0; lane < n_streams; lane++)
+        {
+        hoomd::RandomGenerator g(s, hoomd::Counter(lane * 1000, 0xffffffff - lane, 7));
+        hoomd::RandomStream stream = batch.getStream(lane);
+        for (unsigned int i = 0; i < 6; i++)
+            {
+            auto u = g();
+            auto v = stream();
+            for (unsigned int w = 0; w < 4; w++)
+                UP_ASSERT_EQUAL(u[w], v[w]);
+            }
+        }
+
+    // the distributions draw the same values
+    hoomd::RandomGenerator g(s, hoomd::Counter(0, 0xffffffff, 7));
+    hoomd::RandomStream stream = batch.getStream(0);
+    UP_ASSERT_EQUAL(hoomd::UniformDistribution<double>(-1, 1)(g),
+                    hoomd::UniformDistribution<double>(-1, 1)(stream));
+    UP_ASSERT_EQUAL(hoomd::NormalDistribution<double>(2.0)(g),
+                    hoomd::NormalDistribution<double>(2.0)(stream));
+    }
+
 // //! Find performance crossover
 // /*! Note: this code was written for a one time use to find the empirical crossover. It requires
 // that the private:
@@ -342,6 +342,37 @@ UP_TEST(GPUArray_resize_tests)
         }
     }
 
+//! test case for clearing and resizing large arrays with the first touch memory policy
+UP_TEST(GPUArray_first_touch_tests)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setMemoryPolicy(ExecutionConfiguration::first_touch);
+
+    // large enough to be cleared by all threads
+    unsigned int N = 1 << 20;
+    GPUArray<unsigned int> a(N, exec_conf);
+
+        {
+        ArrayHandle<unsigned int> h_handle(a, access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            UP_ASSERT_EQUAL(h_handle.data[i], (unsigned int)0);
+            h_handle.data[i] = i;
+            }
+        }
+
+    // resizing copies the data and clears the new elements
+    a.resize(2 * N);
+        {
+        ArrayHandle<unsigned int> h_handle(a, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            UP_ASSERT_EQUAL(h_handle.data[i], i);
+        for (unsigned int i = N; i < 2 * N; i++)
+            UP_ASSERT_EQUAL(h_handle.data[i], (unsigned int)0);
+        }
+    }
+
 //! Tests GPUVector
 UP_TEST(GPUVector_basic_tests)
     {
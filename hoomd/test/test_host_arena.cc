@@ -0,0 +1,66 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/HostArena.h"
+
+using namespace std;
+
+/*! \file test_host_arena.cc
+    \brief Implements unit tests for HostArena and ArenaAllocator
+    \ingroup unit_tests
+*/
+
+//! test case for allocating from and resetting the arena
+UP_TEST(HostArena_basic)
+    {
+    HostArena arena(1024);
+    UP_ASSERT_EQUAL(arena.getCapacity(), (size_t)0);
+    UP_ASSERT_EQUAL(arena.getBytesInUse(), (size_t)0);
+
+    void* a = arena.allocate(100);
+    void* b = arena.allocate(100);
+    UP_ASSERT(a != b);
+    UP_ASSERT_EQUAL((size_t)a % 32, (size_t)0);
+    UP_ASSERT_EQUAL((size_t)b % 32, (size_t)0);
+    UP_ASSERT_EQUAL(arena.getCapacity(), (size_t)1024);
+    UP_ASSERT_EQUAL(arena.getNumAllocations(), (unsigned long long)2);
+    UP_ASSERT_EQUAL(arena.getNumSystemAllocations(), (unsigned long long)1);
+
+    // freeing the most recent allocation returns its memory
+    arena.deallocate(b, 100);
+    void* c = arena.allocate(100);
+    UP_ASSERT(b == c);
+
+    arena.reset();
+    UP_ASSERT_EQUAL(arena.getBytesInUse(), (size_t)0);
+    UP_ASSERT(arena.getPeakBytes() >= 200);
+    UP_ASSERT(arena.allocate(100) == a);
+    }
+
+//! test that the arena stops allocating from the system in the steady state
+UP_TEST(HostArena_steady_state)
+    {
+    HostArena arena(1024);
+
+    for (unsigned int step = 0; step < 4; step++)
+        {
+        arena.reset();
+        ArenaVector<unsigned int> small(10, 1, ArenaAllocator<unsigned int>(arena));
+        ArenaVector<double> large(10000, 2.0, ArenaAllocator<double>(arena));
+        UP_ASSERT_EQUAL(small[9], (unsigned int)1);
+        UP_ASSERT_EQUAL(large[9999], 2.0);
+        }
+
+    // the first reset after the arena grew coalesced its blocks
+    UP_ASSERT_EQUAL(arena.getNumSystemAllocations(), (unsigned long long)3);
+    UP_ASSERT_EQUAL(arena.getNumAllocations(), (unsigned long long)8);
+    }
@@ -14,6 +14,7 @@ HOOMD_UP_MAIN();
 #include <memory>
 
 #include "hoomd/Communicator.h"
+#include "hoomd/CommunicatorRCB.h"
 #include "hoomd/ExecutionConfiguration.h"
 #include "hoomd/LoadBalancer.h"
 #ifdef ENABLE_HIP
@@ -365,6 +366,254 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1, 0, 1));
     }
 
+template<class LB>
+void test_load_balancer_time(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                             const BoxDim& dest_box)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    // create a system with one particle in the center of each octant
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,        // number of particles
+                                                                  dest_box, // box dimensions
+                                                                  1, // number of particle types
+                                                                  0, // number of bond types
+                                                                  0, // number of angle types
+                                                                  0, // number of dihedral types
+                                                                  0, // number of dihedral types
+                                                                  exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    pdata->setPosition(0, TO_TRICLINIC(make_scalar3(-0.5, -0.5, -0.5)), false);
+    pdata->setPosition(1, TO_TRICLINIC(make_scalar3(-0.5, -0.5, 0.5)), false);
+    pdata->setPosition(2, TO_TRICLINIC(make_scalar3(-0.5, 0.5, -0.5)), false);
+    pdata->setPosition(3, TO_TRICLINIC(make_scalar3(-0.5, 0.5, 0.5)), false);
+    pdata->setPosition(4, TO_TRICLINIC(make_scalar3(0.5, -0.5, -0.5)), false);
+    pdata->setPosition(5, TO_TRICLINIC(make_scalar3(0.5, -0.5, 0.5)), false);
+    pdata->setPosition(6, TO_TRICLINIC(make_scalar3(0.5, 0.5, -0.5)), false);
+    pdata->setPosition(7, TO_TRICLINIC(make_scalar3(0.5, 0.5, 0.5)), false);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    auto trigger = std::make_shared<PeriodicTrigger>(1);
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef, decomposition, trigger));
+    lb->setCommunicator(comm);
+
+    comm->migrateParticles();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+
+    // the particle count is balanced, so nothing happens
+    lb->update(0);
+    UP_ASSERT_CLOSE(lb->getImbalance(), Scalar(1.0), tol_small);
+    UP_ASSERT_EQUAL(lb->getNumRebalances(), 0);
+
+    // particles in the upper half in x are three times as expensive
+    lb->setMetric("time");
+    const uint3 grid_pos = decomposition->getGridPos();
+    comm->addComputeTime(grid_pos.x == 1 ? 3000 : 1000);
+    lb->update(1);
+
+    // the load is 3/2 of the average on the expensive ranks, and their domains shrink
+    UP_ASSERT_CLOSE(lb->getImbalance(), Scalar(1.5), tol_small);
+    UP_ASSERT_EQUAL(lb->getNumRebalances(), 1);
+    UP_ASSERT_GREATER(decomposition->getCumulativeFractions(0)[1], Scalar(0.5));
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+
+    // the measurements are damped: with equal costs, the estimate only halves the difference
+    comm->addComputeTime(1000);
+    lb->update(2);
+    UP_ASSERT_CLOSE(lb->getImbalance(), Scalar(4.0 / 3.0), tol_small);
+    }
+
+template<class LB>
+void test_load_balancer_rcb(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                            const BoxDim& dest_box)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    // create a system with eight particles
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,        // number of particles
+                                                                  dest_box, // box dimensions
+                                                                  1, // number of particle types
+                                                                  0, // number of bond types
+                                                                  0, // number of angle types
+                                                                  0, // number of dihedral types
+                                                                  0, // number of dihedral types
+                                                                  exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // all particles are in the same octant of the box
+    pdata->setPosition(0, dest_box.makeCoordinates(make_scalar3(0.625, 0.375, 0.625)), false);
+    pdata->setPosition(1, dest_box.makeCoordinates(make_scalar3(0.625, 0.375, 0.875)), false);
+    pdata->setPosition(2, dest_box.makeCoordinates(make_scalar3(0.625, 0.125, 0.625)), false);
+    pdata->setPosition(3, dest_box.makeCoordinates(make_scalar3(0.625, 0.125, 0.875)), false);
+    pdata->setPosition(4, dest_box.makeCoordinates(make_scalar3(0.875, 0.375, 0.625)), false);
+    pdata->setPosition(5, dest_box.makeCoordinates(make_scalar3(0.875, 0.375, 0.875)), false);
+    pdata->setPosition(6, dest_box.makeCoordinates(make_scalar3(0.875, 0.125, 0.625)), false);
+    pdata->setPosition(7, dest_box.makeCoordinates(make_scalar3(0.875, 0.125, 0.875)), false);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    // the bisection of a cube into eight domains cuts x, y, and z in half
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, pdata->getBox().getL(), DomainDecomposition::rcb));
+    UP_ASSERT(decomposition->isRCB());
+    std::shared_ptr<Communicator> comm(new CommunicatorRCB(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    unsigned int rank = exec_conf->getRank();
+    Scalar3 lo = decomposition->getDomainLo(rank);
+    Scalar3 hi = decomposition->getDomainHi(rank);
+    UP_ASSERT_CLOSE(lo.x, Scalar(rank & 4 ? 0.5 : 0.0), tol_small);
+    UP_ASSERT_CLOSE(lo.y, Scalar(rank & 2 ? 0.5 : 0.0), tol_small);
+    UP_ASSERT_CLOSE(lo.z, Scalar(rank & 1 ? 0.5 : 0.0), tol_small);
+    UP_ASSERT_CLOSE(hi.x - lo.x, Scalar(0.5), tol_small);
+    UP_ASSERT_CLOSE(hi.y - lo.y, Scalar(0.5), tol_small);
+    UP_ASSERT_CLOSE(hi.z - lo.z, Scalar(0.5), tol_small);
+
+    auto trigger = std::make_shared<PeriodicTrigger>(1);
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef, decomposition, trigger));
+    lb->setCommunicator(comm);
+    lb->setMaxIterations(2);
+
+    // migrate atoms
+    comm->migrateParticles();
+    for (unsigned int tag = 0; tag < 8; ++tag)
+        UP_ASSERT_EQUAL(pdata->getOwnerRank(tag), 5);
+
+    // adjust the cuts
+    for (unsigned int t = 0; t < 10; ++t)
+        {
+        lb->update(t);
+        }
+
+    // each rank should own one particle
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(0), 2);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(1), 3);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(2), 0);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(3), 1);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(4), 6);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(5), 7);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(6), 4);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(7), 5);
+    }
+
+void test_communicator_rcb_ghosts(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    BoxDim box(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2,   // number of particles
+                                                                  box, // box dimensions
+                                                                  1, // number of particle types
+                                                                  0, // number of bond types
+                                                                  0, // number of angle types
+                                                                  0, // number of dihedral types
+                                                                  0, // number of dihedral types
+                                                                  exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // both particles are on rank 0, the first near the global boundary and the second near a
+    // corner of three other domains
+    pdata->setPosition(0, make_scalar3(-0.98, -0.5, -0.5), false);
+    pdata->setPosition(1, make_scalar3(-0.02, -0.02, -0.5), false);
+
+    SnapshotParticleData<Scalar> snap(2);
+    pdata->takeSnapshot(snap);
+
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, pdata->getBox().getL(), DomainDecomposition::rcb));
+    std::shared_ptr<Communicator> comm(new CommunicatorRCB(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    ghost_layer_width_request g(Scalar(0.05));
+    comm->getGhostLayerWidthRequestSignal()
+        .connect<ghost_layer_width_request, &ghost_layer_width_request::get>(g);
+
+    comm->migrateParticles();
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::tag] = 1;
+    comm->setFlags(flags);
+    comm->exchangeGhosts();
+
+    unsigned int rank = exec_conf->getRank();
+    if (rank == 4)
+        {
+        // the first particle is sent across the periodic boundary
+        UP_ASSERT_EQUAL(pdata->getNGhosts(), 2);
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        UP_ASSERT_CLOSE(h_pos.data[h_rtag.data[0]].x, Scalar(1.02), tol_small);
+        UP_ASSERT_CLOSE(h_pos.data[h_rtag.data[1]].x, Scalar(-0.02), tol_small);
+        }
+    else if (rank == 2 || rank == 6)
+        {
+        UP_ASSERT_EQUAL(pdata->getNGhosts(), 1);
+        }
+    else
+        {
+        UP_ASSERT_EQUAL(pdata->getNGhosts(), 0);
+        }
+
+    // move the first particle and update the ghosts
+    if (rank == 0)
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        h_pos.data[h_rtag.data[0]].x = Scalar(-0.97);
+        }
+    comm->beginUpdateGhosts(0);
+    comm->finishUpdateGhosts(0);
+
+    if (rank == 4)
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        UP_ASSERT_CLOSE(h_pos.data[h_rtag.data[0]].x, Scalar(1.03), tol_small);
+        }
+    }
+
 //! Tests basic particle redistribution
 UP_TEST(LoadBalancer_test_basic)
     {
@@ -404,6 +653,33 @@ UP_TEST(LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0, -.6, .7, .5));
     }
 
+//! Tests balancing of the measured compute time
+UP_TEST(LoadBalancer_test_time)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    test_load_balancer_time<LoadBalancer>(exec_conf, BoxDim(2.0));
+    }
+
+//! Tests balancing of a recursive coordinate bisection
+UP_TEST(LoadBalancer_test_rcb)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_rcb<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_rcb<LoadBalancer>(exec_conf, BoxDim(1.0, .1, .2, .3));
+    }
+
+//! Tests the ghost exchange of a recursive coordinate bisection
+UP_TEST(CommunicatorRCB_test_ghosts)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    test_communicator_rcb_ghosts(exec_conf);
+    }
+
 #ifdef ENABLE_HIP
 //! Tests basic particle redistribution on the GPU
 UP_TEST(LoadBalancerGPU_test_basic)
@@ -0,0 +1,212 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_MPI
+
+// this has to be included after naming the test module
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+#include "hoomd/HOOMDMPI.h"
+
+#include <vector>
+
+using namespace std;
+
+/*! \file test_mpi_gather.cc
+    \brief Unit tests for the chunked collectives and the all to all exchange in HOOMDMPI.h
+    \ingroup unit_tests
+*/
+
+//! Record used in the tests
+struct test_element
+    {
+    Scalar value;     //!< Value derived from the tag
+    unsigned int tag; //!< Global index of the record
+    };
+
+//! Number of records on a rank, rank 1 has none
+unsigned int test_count(int rank)
+    {
+    return rank == 1 ? 0 : (rank * 7) % 11 + 1;
+    }
+
+//! Numbers of ranks per node, 0 splits the ranks by shared memory
+const int test_ranks_per_node[] = {0, 1, 2};
+
+//! Gather records with chunks of a few records to every root
+UP_TEST(gather_chunked_test)
+    {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    unsigned int first = 0, total = 0;
+    for (int i = 0; i < size; i++)
+        {
+        if (i < rank)
+            first += test_count(i);
+        total += test_count(i);
+        }
+
+    std::vector<test_element> local(test_count(rank));
+    for (unsigned int i = 0; i < local.size(); i++)
+        {
+        local[i].tag = first + i;
+        local[i].value = Scalar(2.0) * Scalar(first + i);
+        }
+
+    for (int root = 0; root < size; root++)
+        {
+        for (int ranks_per_node : test_ranks_per_node)
+            {
+            for (size_t chunk_bytes :
+                 {sizeof(test_element), 3 * sizeof(test_element), mpi_chunk_bytes})
+                {
+                std::vector<unsigned int> seen(total, 0);
+                auto consume = [&](const test_element* values, unsigned int n)
+                    {
+                    for (unsigned int i = 0; i < n; i++)
+                        {
+                        UP_ASSERT(values[i].tag < total);
+                        UP_ASSERT_EQUAL(values[i].value, Scalar(2.0) * Scalar(values[i].tag));
+                        seen[values[i].tag]++;
+                        }
+                    };
+                gather_chunked(local, consume, root, MPI_COMM_WORLD, chunk_bytes, ranks_per_node);
+
+                if (rank == root)
+                    for (unsigned int tag = 0; tag < total; tag++)
+                        UP_ASSERT_EQUAL(seen[tag], (unsigned int)1);
+                }
+            }
+        }
+    }
+
+//! Scatter records with chunks of a few records from every root
+UP_TEST(scatter_chunked_test)
+    {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    for (int root = 0; root < size; root++)
+        {
+        for (int ranks_per_node : test_ranks_per_node)
+            {
+            for (size_t chunk_bytes :
+                 {sizeof(test_element), 3 * sizeof(test_element), mpi_chunk_bytes})
+                {
+                std::vector<unsigned int> counts;
+                std::vector<unsigned int> next;
+                if (rank == root)
+                    {
+                    for (int i = 0; i < size; i++)
+                        counts.push_back(test_count(i));
+                    next.resize(size, 0);
+                    }
+
+                auto produce = [&](unsigned int dest, test_element* values, unsigned int n)
+                    {
+                    for (unsigned int i = 0; i < n; i++)
+                        {
+                        values[i].tag = dest;
+                        values[i].value = Scalar(next[dest]++);
+                        }
+                    };
+
+                std::vector<test_element> local;
+                scatter_chunked(counts,
+                                produce,
+                                local,
+                                root,
+                                MPI_COMM_WORLD,
+                                chunk_bytes,
+                                ranks_per_node);
+
+                UP_ASSERT_EQUAL((unsigned int)local.size(), test_count(rank));
+                for (unsigned int i = 0; i < local.size(); i++)
+                    {
+                    UP_ASSERT_EQUAL(local[i].tag, (unsigned int)rank);
+                    UP_ASSERT_EQUAL(local[i].value, Scalar(i));
+                    }
+                }
+            }
+        }
+    }
+
+//! Broadcast records with chunks of a few records from every root
+UP_TEST(bcast_chunked_test)
+    {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    for (int root = 0; root < size; root++)
+        {
+        for (size_t chunk_bytes : {sizeof(test_element), 3 * sizeof(test_element), mpi_chunk_bytes})
+            {
+            unsigned int next = 0;
+            auto produce = [&](test_element* values, unsigned int n)
+                {
+                for (unsigned int i = 0; i < n; i++, next++)
+                    {
+                    values[i].tag = next;
+                    values[i].value = Scalar(root);
+                    }
+                };
+
+            unsigned int received = 0;
+            auto consume = [&](const test_element* values, unsigned int n)
+                {
+                for (unsigned int i = 0; i < n; i++, received++)
+                    {
+                    UP_ASSERT_EQUAL(values[i].tag, received);
+                    UP_ASSERT_EQUAL(values[i].value, Scalar(root));
+                    }
+                };
+
+            // only the count on root matters
+            unsigned int count = rank == root ? test_count(root) : 0;
+            bcast_chunked<test_element>(count, produce, consume, root, MPI_COMM_WORLD, chunk_bytes);
+            UP_ASSERT_EQUAL(received, test_count(root));
+            }
+        }
+    }
+
+//! Exchange records between all ranks
+UP_TEST(all_to_all_v_test)
+    {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    // send dest + 1 records to every rank dest, except to rank 1
+    std::vector<int> send_counts(size);
+    std::vector<test_element> send_values;
+    for (int dest = 0; dest < size; dest++)
+        {
+        send_counts[dest] = dest == 1 ? 0 : dest + 1;
+        for (int i = 0; i < send_counts[dest]; i++)
+            {
+            test_element e;
+            e.tag = rank;
+            e.value = Scalar(i);
+            send_values.push_back(e);
+            }
+        }
+
+    std::vector<test_element> recv_values;
+    all_to_all_v(send_values, send_counts, recv_values, MPI_COMM_WORLD);
+
+    unsigned int n_expected = rank == 1 ? 0 : size * (rank + 1);
+    UP_ASSERT_EQUAL((unsigned int)recv_values.size(), n_expected);
+    for (unsigned int i = 0; i < recv_values.size(); i++)
+        {
+        // records are ordered by source rank
+        UP_ASSERT_EQUAL(recv_values[i].tag, i / (rank + 1));
+        UP_ASSERT_EQUAL(recv_values[i].value, Scalar(i % (rank + 1)));
+        }
+    }
+
+#endif // ENABLE_MPI
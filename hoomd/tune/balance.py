@@ -1,6 +1,8 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
+from hoomd.logging import log
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -19,6 +21,10 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        metric (`str`): Load metric to balance, ``'particles'`` or
+            ``'time'``.
+        damping (`float`): Weight of the previous estimate of the cost per
+            particle when *metric* is ``'time'``, in [0, 1).
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -48,6 +54,23 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    Set *metric* to ``'time'`` to balance the measured cost instead. The load
+    of rank :math:`i` is then :math:`W_i = N_i c_i`, where :math:`c_i` is the
+    wall time the integrator spent computing forces on rank :math:`i` since the
+    previous balancing step divided by :math:`N_i`, and the imbalance is
+    :math:`I = W_i / \langle W \rangle`. Successive measurements of
+    :math:`c_i` are averaged:
+
+    .. math::
+
+        c_i \leftarrow d \, c_i + (1 - d) \, c_i^\mathrm{measured}
+
+    where :math:`d` is *damping*. Larger values of *damping* respond more
+    slowly to changes in the cost, but prevent the domain boundaries from
+    oscillating due to noise in the timings. The time is measured in MD
+    simulations on the CPU. Without any measurement (e.g. in HPMC simulations),
+    `LoadBalancer` balances the number of particles.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -62,6 +85,14 @@ class LoadBalancer(Tuner):
     normal to the :math:`z` axis, then it may be advantageous to disable
     balancing along :math:`x` and :math:`y`.
 
+    When the state uses a recursive coordinate bisection
+    (``domain_decomposition='rcb'`` in `hoomd.Simulation.create_state_from_gsd`
+    or `hoomd.Simulation.create_state_from_snapshot`), `LoadBalancer` moves
+    each cut of the bisection so that the load on either side is proportional
+    to the number of ranks on that side, one level of the bisection at a time.
+    A cut moves by at most 5% of the extent of the part of the box it divides.
+    Cuts along disabled directions do not move.
+
     In systems that are well-behaved, there is minimal overhead of balancing
     with a small update. However, if the system is not capable of being balanced
     (for example, due to the density distribution or minimum domain size),
@@ -82,6 +113,10 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        metric (`str`): Load metric to balance, ``'particles'`` or
+            ``'time'``.
+        damping (`float`): Weight of the previous estimate of the cost per
+            particle when *metric* is ``'time'``, in [0, 1).
     """
 
     def __init__(self,
@@ -90,18 +125,24 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 metric='particles',
+                 damping=0.5):
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
                         max_iterations=max_iterations,
+                        metric=metric,
+                        damping=damping,
                         trigger=trigger)
         self._param_dict = ParameterDict(x=bool,
                                          y=bool,
                                          z=bool,
                                          max_iterations=int,
                                          tolerance=float,
+                                         metric=OnlyFrom(['particles', 'time']),
+                                         damping=float,
                                          trigger=Trigger)
         self._param_dict.update(defaults)
 
@@ -116,3 +157,25 @@ class LoadBalancer(Tuner):
             ), self.trigger)
 
         super()._attach()
+
+    @log(requires_run=True)
+    def imbalance(self):
+        """float: Maximum load imbalance before the last balancing step."""
+        return self._cpp_obj.imbalance
+
+    @log(requires_run=True)
+    def largest_imbalance(self):
+        """float: Largest maximum load imbalance during the last run."""
+        return self._cpp_obj.largest_imbalance
+
+    @log(requires_run=True)
+    def average_imbalance(self):
+        """float: Average maximum load imbalance before balancing during the \
+        last run."""
+        return self._cpp_obj.average_imbalance
+
+    @log(requires_run=True)
+    def num_rebalances(self):
+        """int: Number of times the domains were adjusted during the last \
+        run."""
+        return self._cpp_obj.num_rebalances
@@ -158,6 +158,9 @@ class _TableInternal(_InternalAction):
         'improper', 'pair', 'constraint', 'strings'
     ])
 
+    # logged energies must be valid when always_compute_energy is False
+    flags = [_InternalAction.Flags.POTENTIAL_ENERGY]
+
     def __init__(self,
                  logger,
                  output=stdout,